@@ -26,9 +26,9 @@ void App::print(void) {
       << std::endl;
 
     // Print out the hands.
-    const gungi::SharedUnitPtrVector vecs[] = {
-      m_controller.black().inactiveUnits(),
-      m_controller.white().inactiveUnits()
+    const gungi::UnitPtrVector *hands[] = {
+      &m_controller.black().inactiveUnits(),
+      &m_controller.white().inactiveUnits()
     };
 
     for (unsigned int i = 0; i < 2; i++) {
@@ -38,7 +38,7 @@ void App::print(void) {
         << std::endl;
 
       unsigned int count = 0;
-      for (const gungi::SharedUnitPtr& unit : vecs[i]) {
+      for (const gungi::Unit *unit : *hands[i]) {
         if (count > 0 && count % 5 == 0) {
           std::cout << std::endl;
         }
@@ -62,7 +62,11 @@ void App::handleInput(const std::string& input) {
   unsigned int col1, row1, tier1, col2, row2, tier2;
   gungi::error_t error = gungi::GUNGI_ERROR_NONE;
 
-  std::stringstream recordedMove;
+  move_t move = move_t();
+  move.colour = m_controller.isPlayersTurn(gungi::BLACK) ? gungi::BLACK
+                                                         : gungi::WHITE;
+  gungi::GNDecoder::token_t& token = move.token;
+  token.type = gungi::GNDecoder::TOKEN_NONE;
   m_errorString = "";
 
   if (sscanf(input.c_str(),
@@ -78,15 +82,12 @@ void App::handleInput(const std::string& input) {
     m_controller.dropUnit(frontPiece, backPiece, to, error);
 
     if (error == gungi::GUNGI_ERROR_NONE) {
-      recordedMove
-        << front[0]
-        << back[0]
-        << '*'
-        << col1
-        << '-'
-        << row1
-        << '-'
-        << m_controller.board()[to.index()].height() - 1;
+      token.type = gungi::GNDecoder::TOKEN_DROP;
+      token.front = *gungi::piece_to_gn_identifier(frontPiece);
+      token.back = *gungi::piece_to_gn_identifier(backPiece);
+      token.col = col1;
+      token.row = row1;
+      token.tier = m_controller.board()[to.index()].height() - 1;
     }
   } else if (sscanf(input.c_str(),
                     "m %u-%u-%u %u-%u",
@@ -98,24 +99,17 @@ void App::handleInput(const std::string& input) {
     // Move
     gungi::Posn from(col1, row1);
     gungi::Posn to(col2, row2);
+    identify(from, tier1, token);
     m_controller.moveUnit(from, tier1, to, error);
 
     if (error == gungi::GUNGI_ERROR_NONE) {
-      recordedMove
-        << front[0]
-        << back[0]
-        << '<'
-        << col1
-        << '-'
-        << row1
-        << '-'
-        << tier1
-        << '>'
-        << col2
-        << '-'
-        << row2
-        << '-'
-        << m_controller.board()[to.index()].height() - 1;
+      token.type = gungi::GNDecoder::TOKEN_MOVE;
+      token.col = col1;
+      token.row = row1;
+      token.tier = tier1;
+      token.toCol = col2;
+      token.toRow = row2;
+      token.toTier = m_controller.board()[to.index()].height() - 1;
     }
   } else if (sscanf(input.c_str(),
                     "i %u-%u-%u %u",
@@ -125,71 +119,37 @@ void App::handleInput(const std::string& input) {
                     &tier2) == 4) {
     // Immobile Strike
     gungi::Posn posn(col1, row1);
+    identify(posn, tier1, token);
     m_controller.immobileStrike(posn, tier1, tier2, error);
 
     if (error == gungi::GUNGI_ERROR_NONE) {
-      recordedMove
-        << front[0]
-        << back[0]
-        << '<'
-        << col1
-        << '-'
-        << row1
-        << '-'
-        << tier1
-        << 'x'
-        << tier2;
+      token.type = gungi::GNDecoder::TOKEN_IMMOBILE_STRIKE;
+      token.col = col1;
+      token.row = row1;
+      token.tier = tier1;
+      token.toTier = tier2;
     }
-  } else if (input == "fr") {
-    // Forced Recovery
-    if (input.substr(2).find_first_not_of(" \r\n\t") != std::string::npos) {
-      m_errorString = "Invalid command.";
-      return;
-    }
-
-    const gungi::Unit *unit = m_controller.forcedRecoveryUnit();
-    if (unit) {
-      gungi::colour_t colour =
-             static_cast<gungi::colour_t>(m_controller.forcedRecoveryColour());
-      const gungi::Tower *tower = m_controller.forcedRecoveryTower();
-      const gungi::Posn& posn = tower->posn();
-      recordedMove
-        << gungi::piece_to_gn_identifier(unit->front())
-        << gungi::piece_to_gn_identifier(unit->back())
-        << (m_controller.isPlayersTurn(colour) ? '+' : '^')
-        << posn.col()
-        << '-'
-        << posn.row()
-        << '-'
-        << tower->height() - 1;
-    }
-
-    m_controller.forceRecover(true, error);
-  } else if (input == "nfr") {
-    // Reject Forced Recovery
-    if (input.substr(3).find_first_not_of(" \r\n\t") != std::string::npos) {
-      m_errorString = "Invalid command.";
-      return;
-    }
-
+  } else if (input == "fr" || input == "nfr") {
+    // Forced Recovery, or Reject Forced Recovery
+    const bool recover = input == "fr";
     const gungi::Unit *unit = m_controller.forcedRecoveryUnit();
     if (unit) {
       gungi::colour_t colour =
              static_cast<gungi::colour_t>(m_controller.forcedRecoveryColour());
       const gungi::Tower *tower = m_controller.forcedRecoveryTower();
       const gungi::Posn& posn = tower->posn();
-      recordedMove
-        << gungi::piece_to_gn_identifier(unit->front())
-        << gungi::piece_to_gn_identifier(unit->back())
-        << '='
-        << posn.col()
-        << '-'
-        << posn.row()
-        << '-'
-        << tower->height() - 1;
+      token.type = !recover ? gungi::GNDecoder::TOKEN_NO_RECOVER
+                 : m_controller.isPlayersTurn(colour) ?
+                   gungi::GNDecoder::TOKEN_RECOVER :
+                   gungi::GNDecoder::TOKEN_RECOVER_TO_OPPONENT;
+      token.front = *gungi::piece_to_gn_identifier(unit->front());
+      token.back = *gungi::piece_to_gn_identifier(unit->back());
+      token.col = posn.col();
+      token.row = posn.row();
+      token.tier = tower->height() - 1;
     }
 
-    m_controller.forceRecover(false, error);
+    m_controller.forceRecover(recover, error);
   } else if (sscanf(input.c_str(),
                     "s %u-%u-%u %u-%u-%u",
                     &col1,
@@ -202,24 +162,17 @@ void App::handleInput(const std::string& input) {
     gungi::effect_t exch = gungi::GUNGI_EFFECT_SUBSTITUTION;
     gungi::Posn from(col1, row1);
     gungi::Posn to(col2, row2);
+    identify(from, tier1, token);
     m_controller.exchangeUnits(exch, from, tier1, to, tier2, error);
 
     if (error == gungi::GUNGI_ERROR_NONE) {
-      recordedMove
-        << front[0]
-        << back[0]
-        << '<'
-        << col1
-        << '-'
-        << row1
-        << '-'
-        << tier1
-        << '&'
-        << col2
-        << '-'
-        << row2
-        << '-'
-        << tier2;
+      token.type = gungi::GNDecoder::TOKEN_SUBSTITUTION;
+      token.col = col1;
+      token.row = row1;
+      token.tier = tier1;
+      token.toCol = col2;
+      token.toRow = row2;
+      token.toTier = tier2;
     }
   } else if (sscanf(input.c_str(),
                     "t %u-%u-%u %u",
@@ -231,20 +184,15 @@ void App::handleInput(const std::string& input) {
     gungi::effect_t exch = gungi::GUNGI_EFFECT_1_3_TIER_EXCHANGE;
     gungi::Posn from(col1, row1);
     gungi::Posn to = from;
+    identify(from, tier1, token);
     m_controller.exchangeUnits(exch, from, tier1, to, tier2, error);
 
     if (error == gungi::GUNGI_ERROR_NONE) {
-      recordedMove
-        << front[0]
-        << back[0]
-        << '<'
-        << col1
-        << '-'
-        << row1
-        << '-'
-        << tier1
-        << '&'
-        << tier2;
+      token.type = gungi::GNDecoder::TOKEN_TIER_EXCHANGE;
+      token.col = col1;
+      token.row = row1;
+      token.tier = tier1;
+      token.toTier = tier2;
     }
   } else {
     m_errorString = "Invalid command.";
@@ -253,13 +201,29 @@ void App::handleInput(const std::string& input) {
 
   if (error != gungi::GUNGI_ERROR_NONE) {
     m_errorString = gungi::error_to_string(error);
-  } else {
-    m_outputStream
-      << (m_outputStream.str().size() ? " " : "")
-      << m_moveCount
-      << ". "
-      << gungi::Util::toUpperCase(recordedMove.str());
-    m_moveCount++;
+  } else if (token.type != gungi::GNDecoder::TOKEN_NONE) {
+    m_moves.push_back(move);
+  }
+}
+
+// PRIVATE ACCESSORS
+void App::identify(const gungi::Posn&         posn,
+                   unsigned int               tier,
+                   gungi::GNDecoder::token_t& token) const {
+  // The moving unit is looked up before it moves, as the move is only made
+  // if the unit is there.
+  token.front = '-';
+  token.back = '-';
+  if (!posn.isValid()) {
+    return;
+  }
+
+  gungi::error_t error;
+  const gungi::Unit *unit =
+    m_controller.unit(m_controller.board()[posn.index()].at(tier, error));
+  if (unit) {
+    token.front = *gungi::piece_to_gn_identifier(unit->front());
+    token.back = *gungi::piece_to_gn_identifier(unit->back());
   }
 }
 
@@ -267,8 +231,7 @@ void App::handleInput(const std::string& input) {
 App::App(CommandParser& commandParser)
 : m_commandParser(commandParser)
 , m_controller(commandParser.controller)
-, m_outputStream()
-, m_moveCount(commandParser.moveCount + 1)
+, m_moves()
 , m_errorString("")
 {
   // DO NOTHING
@@ -320,13 +283,17 @@ int App::run(void) {
     break;
   }
 
-  std::string data = m_commandParser.metadata.header(m_controller) +
-                     m_outputStream.str();
-  if (m_commandParser.outputFile.is_open()) {
-    unsigned int len = data.size();
-    m_commandParser.outputFile.write(data.c_str(), len);
-  } else {
-    std::cout << data << std::endl;
+  // The header is written once the game is done, as it holds the result.
+  std::cout.flush();
+  gungi::GNEncoder encoder(m_commandParser.outputFile);
+  bool written = encoder.writeHeader(m_commandParser.metadata, m_controller);
+  for (const move_t& move : m_moves) {
+    written = written && encoder.writeMove(move.token, move.colour);
+  }
+
+  if (!written || !encoder.endGame() || !encoder.flush()) {
+    std::cerr << "Failed to write the game." << std::endl;
+    return -1;
   }
 
   return 0;
@@ -23,28 +23,34 @@
 
 #include <gungi/gungi.hpp>
 
-#include <sstream>
 #include <string>
+#include <vector>
 
 class App {
   // Demo application interface.
 
 private:
-  // INSTANCE MEMBERS
-  CommandParser&      m_commandParser;
-                       // Command-line parser.
+  // STRUCTURES
+  typedef struct move_t {
+    // Move made, as it is written to the Gungi Notation output.
+    gungi::GNDecoder::token_t  token;
+
+    // Colour of the player whose turn it was.
+    gungi::colour_t            colour;
+  } move_t;
 
-  gungi::Controller&  m_controller;
-                       // Logic controller.
+  // INSTANCE MEMBERS
+  CommandParser&       m_commandParser;
+                        // Command-line parser.
 
-  std::ostringstream  m_outputStream;
-                       // Output string stream.
+  gungi::Controller&   m_controller;
+                        // Logic controller.
 
-  unsigned int        m_moveCount;
-                       // Count of moves that have been made.
+  std::vector<move_t>  m_moves;
+                        // Moves that have been made.
 
-  std::string         m_errorString;
-                       // The error message stored in the application.
+  std::string          m_errorString;
+                        // The error message stored in the application.
 
 private:
   // PRIVATE MANIPULATORS
@@ -54,6 +60,14 @@ private:
   void handleInput(const std::string& input);
     // Handles the given 'input' command.
 
+  // PRIVATE ACCESSORS
+  void identify(const gungi::Posn&         posn,
+                unsigned int               tier,
+                gungi::GNDecoder::token_t& token) const;
+    // Loads into the given 'token' the identifiers of the unit at the given
+    // 'tier' of the tower at the given 'posn', otherwise '-' if there is no
+    // unit there.
+
 public:
   // CREATORS
   App(CommandParser& commandParser);
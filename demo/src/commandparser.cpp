@@ -9,6 +9,9 @@
 #include <sstream>
 #include <string>
 
+#include <fcntl.h>
+#include <unistd.h>
+
 namespace {
 
 static std::string readFile(std::ifstream& ifs);
@@ -34,10 +37,9 @@ std::string readFile(std::ifstream& ifs) {
 CommandParser::CommandParser(int argc, char *argv[])
 : progName(argv[0])
 , inputFile()
-, outputFile()
+, outputFile(STDOUT_FILENO)
 , controller()
 , metadata()
-, moveCount(0)
 {
   std::stringstream ss;
   for (int i = 1; i < argc; i++) {
@@ -70,8 +72,12 @@ CommandParser::CommandParser(int argc, char *argv[])
     }
 
     if (opt == "-o" || opt == "--output") {
-      outputFile.open(value.c_str());
-      if (outputFile.fail()) {
+      if (outputFile != STDOUT_FILENO) {
+        close(outputFile);
+      }
+
+      outputFile = open(value.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if (outputFile < 0) {
         std::cerr
           << "Invalid input file: "
           << value
@@ -117,7 +123,9 @@ CommandParser::CommandParser(int argc, char *argv[])
 }
 
 CommandParser::~CommandParser(void) {
-  // DO NOTHING
+  if (outputFile != STDOUT_FILENO) {
+    close(outputFile);
+  }
 }
 
 // ACCESSORS
@@ -22,15 +22,13 @@ public:
   std::ifstream     inputFile;
                      // The input file to read from.
 
-  std::ofstream     outputFile;
-                     // The output file to write to.
+  int               outputFile;
+                     // File descriptor of the output file to write to,
+                     // otherwise 'STDOUT_FILENO'.
 
   gungi::Controller controller;
                      // Game logic controller.
 
-  unsigned int      moveCount;
-                     // Number of moves loaded from the 'inputFile'.
-
   gungi::GNMetadata metadata;
                      // Game metadata.
 
@@ -41,7 +39,7 @@ public:
     // comand-line argument count, 'argc', and command-line arguments, 'argv'.
 
   ~CommandParser(void);
-    // Default destructor.
+    // Destroys the parser, closing the output file, if any.
 
   // ACCESSORS
   std::string usage(void) const;
@@ -0,0 +1,126 @@
+// main.cpp                                                           -*-C++-*-
+//@DESCRIPTION:
+//  This component provides the entry point of the Gungi Notation reader tool.
+//  The tool reads every game of one or more '.gn' files of many games each,
+//  and reports how many were read and how fast, in gigabytes of notation per
+//  second.  With '--replay', the moves of each game are also decoded and
+//  played, and the games with an illegal or malformed move are counted.
+#include <gungi/gungi.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+static std::string usage(const std::string& progName);
+  // Returns a string specifying the program usage for the program with the
+  // given 'progName'.
+
+std::string usage(const std::string& progName) {
+  std::ostringstream oss;
+  oss
+    << progName
+    << " [ optional arguments ] FILE..."
+    << std::endl
+    << std::endl
+    << "Optional Args:"
+    << std::endl
+    << "  -h, --help                          show this dialog"
+    << std::endl
+    << "  -r, --replay                        play the moves of each game";
+  return oss.str();
+}
+
+}  // close unnamed namespace
+
+int main(int argc, char *argv[]) {
+  const std::string progName(argv[0]);
+  std::vector<std::string> paths;
+  bool replay = false;
+
+  for (int i = 1; i < argc; i++) {
+    const std::string opt(argv[i]);
+    if (opt == "-h" || opt == "--help") {
+      std::cout << usage(progName) << std::endl;
+      return 0;
+    } else if (opt == "-r" || opt == "--replay") {
+      replay = true;
+    } else if (!opt.empty() && opt[0] == '-') {
+      std::cerr
+        << "Invalid command: "
+        << opt
+        << std::endl
+        << usage(progName)
+        << std::endl;
+      return -1;
+    } else {
+      paths.push_back(opt);
+    }
+  }
+
+  if (paths.empty()) {
+    std::cerr
+      << "Missing input file"
+      << std::endl
+      << usage(progName)
+      << std::endl;
+    return -1;
+  }
+
+  uint64_t bytes = 0;
+  uint64_t games = 0;
+  uint64_t malformed = 0;
+  uint64_t illegal = 0;
+  uint64_t plies = 0;
+
+  const std::chrono::steady_clock::time_point start =
+                                              std::chrono::steady_clock::now();
+  for (const std::string& path : paths) {
+    gungi::GNReader reader;
+    if (!reader.open(path)) {
+      std::cerr << "Invalid input file: " << path << std::endl;
+      return -2;
+    }
+
+    bytes += reader.size();
+    games += reader.read([&](const gungi::GNReader::game_t& game) {
+      if (!game.valid) {
+        malformed++;
+      } else if (replay) {
+        gungi::Controller controller;
+        unsigned int played;
+        if (!gungi::GNReader::replay(game, controller, played)) {
+          illegal++;
+        }
+        plies += played;
+      }
+      return true;
+    });
+  }
+  const std::chrono::steady_clock::time_point end =
+                                              std::chrono::steady_clock::now();
+
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  std::cout
+    << "Files: " << paths.size() << std::endl
+    << "Games: " << games << std::endl
+    << "Malformed headers: " << malformed << std::endl;
+
+  if (replay) {
+    std::cout
+      << "Illegal games: " << illegal << std::endl
+      << "Plies: " << plies << std::endl;
+  }
+
+  std::cout
+    << "Bytes: " << bytes << std::endl
+    << "Time: " << seconds << "s" << std::endl
+    << "GB/second: " << (seconds > 0 ? bytes / seconds / 1e9 : 0)
+    << std::endl;
+
+  return 0;
+}
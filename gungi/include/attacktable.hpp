@@ -0,0 +1,161 @@
+// attacktable.hpp                                                    -*-C++-*-
+#pragma once
+//@DESCRIPTION:
+//  This component provides lookup tables for unit movement.  For every piece,
+//  tier, starting square, and orientation, the table holds the set of squares
+//  that a unit can walk to according to its moveset (see 'k_UNIT_MOVES'),
+//  ignoring the other units on the board.  For every pair of squares, the
+//  table holds the set of squares crossed by a straight line between them
+//  (see 'Util::crossed'), and for every piece, tier, starting square, and
+//  orientation, the union of the lines to each reachable square: the squares
+//  whose units could block the piece.  Together they reduce the reachability
+//  and blocking tests of a move to a few word operations.
+//
+//  For both mobile range expansion effects, every square, and both colours,
+//  the table also holds the set of squares in the expansion of a unit with
+//  that effect on that square: the column in front of a Fortress, and the
+//  diamond within the territory around a Catapult.
+//
+//  The tables are built the first time they are used, which takes a few
+//  milliseconds, and are never modified afterwards, so they may be read from
+//  any number of threads.
+//
+//@CLASSES:
+//  'gungi::AttackTable': precomputed movement lookup tables.
+#include "bitboard.hpp"
+#include "gtypes.hpp"
+#include "posn.hpp"
+
+namespace gungi {
+
+class AttackTable {
+  // Precomputed movement lookup tables.  Squares are identified by their
+  // index, as returned by 'Posn::index()'.
+
+public:
+  // STATIC CLASS MEMBERS
+  static const unsigned int k_NUM_SQUARES = Bitboard::k_NUM_SQUARES;
+    // Number of squares on the board.
+
+private:
+  // INSTANCE MEMBERS
+  Bitboard  m_reach[GUNGI_NUM_PIECES][k_MAX_TOWER_SIZE][k_NUM_SQUARES][2];
+             // Squares reachable by a piece at a tier from a square, indexed
+             // last by whether the movement is inverted.
+
+  Bitboard  m_between[k_NUM_SQUARES][k_NUM_SQUARES];
+             // Squares crossed by a straight line between two squares,
+             // excluding both.
+
+  Bitboard  m_lines[GUNGI_NUM_PIECES][k_MAX_TOWER_SIZE][k_NUM_SQUARES][2];
+             // Squares crossed on the way to the squares reachable by a piece
+             // at a tier from a square, indexed last by whether the movement
+             // is inverted.
+
+  Bitboard  m_expansion[2][k_NUM_SQUARES][2];
+             // Squares in the mobile range expansion of a unit on a square,
+             // indexed first by whether the effect is the Catapult's, and
+             // last by whether the unit is black.
+
+private:
+  // PRIVATE CLASS METHODS
+  static const AttackTable& instance(void);
+    // Returns the tables, building them on first use.
+
+  static bool isReachable(piece_id_t  piece,
+                          tier_t      tier,
+                          const Posn& start,
+                          const Posn& end,
+                          bool        invert);
+    // Returns 'true' if any path of the moveset of the given 'piece' at the
+    // given 'tier' walks from the given 'start' position to the given 'end'
+    // position, otherwise 'false'.  The given 'invert' parameter determines
+    // if the walk is top-down ('true'), otherwise bottom-up ('false').
+
+  static Bitboard expansionOf(effect_t    effect,
+                              const Posn& posn,
+                              colour_t    colour);
+    // Returns the set of squares in the mobile range expansion with the given
+    // 'effect' of a unit of the given 'colour' at the given 'posn'.
+
+  // PRIVATE CREATORS
+  AttackTable(void);
+    // Creates the tables.
+
+  AttackTable(const AttackTable&);
+    // Not implemented.
+
+  AttackTable& operator=(const AttackTable&);
+    // Not implemented.
+
+public:
+  // STATIC CLASS METHODS
+  static const Bitboard& reach(piece_id_t   piece,
+                               tier_t       tier,
+                               unsigned int square,
+                               bool         inverted);
+    // Returns the set of squares that a unit with the given front 'piece' at
+    // the given 'tier' can walk to from the square with index 'square' on an
+    // empty board.  The given 'inverted' parameter determines if the movement
+    // is top-down ('true'), otherwise bottom-up ('false').
+
+  static const Bitboard& between(unsigned int from, unsigned int to);
+    // Returns the set of squares crossed by a straight line from the square
+    // with index 'from' to the square with index 'to', excluding both.
+
+  static const Bitboard& lines(piece_id_t   piece,
+                               tier_t       tier,
+                               unsigned int square,
+                               bool         inverted);
+    // Returns the set of squares crossed by the straight lines from the
+    // square with index 'square' to each square in
+    // 'reach(piece, tier, square, inverted)'; a unit at any other square can
+    // not block a unit with the given front 'piece' at the given 'tier' on
+    // that square.  The given 'inverted' parameter determines if the movement
+    // is top-down ('true'), otherwise bottom-up ('false').
+
+  static const Bitboard& expansion(effect_t     effect,
+                                   unsigned int square,
+                                   colour_t     colour);
+    // Returns the set of squares in the mobile range expansion of a unit of
+    // the given 'colour' on the square with index 'square', for the given
+    // 'effect'.  The behaviour is undefined unless 'effect' is
+    // 'GUNGI_EFFECT_MOBILE_RANGE_EXPANSION_1' (Fortress), or
+    // 'GUNGI_EFFECT_MOBILE_RANGE_EXPANSION_2' (Catapult).
+};
+
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+// STATIC CLASS METHODS
+inline const Bitboard& AttackTable::reach(piece_id_t   piece,
+                                          tier_t       tier,
+                                          unsigned int square,
+                                          bool         inverted) {
+  return instance().m_reach[piece][tier][square][inverted ? 1 : 0];
+}
+
+inline const Bitboard& AttackTable::between(unsigned int from,
+                                            unsigned int to) {
+  return instance().m_between[from][to];
+}
+
+inline const Bitboard& AttackTable::lines(piece_id_t   piece,
+                                          tier_t       tier,
+                                          unsigned int square,
+                                          bool         inverted) {
+  return instance().m_lines[piece][tier][square][inverted ? 1 : 0];
+}
+
+inline const Bitboard& AttackTable::expansion(effect_t     effect,
+                                              unsigned int square,
+                                              colour_t     colour) {
+  return instance().m_expansion
+    [effect == GUNGI_EFFECT_MOBILE_RANGE_EXPANSION_2 ? 1 : 0]
+    [square]
+    [colour == BLACK ? 1 : 0];
+}
+
+}  // close 'gungi' namespace
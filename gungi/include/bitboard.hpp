@@ -0,0 +1,336 @@
+// bitboard.hpp                                                       -*-C++-*-
+#pragma once
+//@DESCRIPTION:
+//  This component provides a definition for a set of squares on the Gungi
+//  board.  The board has 'k_BOARD_LENGTH * k_BOARD_LENGTH' (81) squares, so a
+//  set is packed into two 64-bit words, with one bit per square index as
+//  returned by 'Posn::index()'.  Tests and set operations are a handful of
+//  word operations, and do not allocate.  The squares of a set are visited in
+//  index order by repeatedly removing the lowest square:
+//..
+//  Bitboard squares = ...;
+//  while (squares.any()) {
+//    const unsigned int idx = squares.pop();
+//    ...
+//  }
+//..
+//
+//@CLASSES:
+//  'gungi::Bitboard': set of squares on the board.
+#include "gtypes.hpp"
+#include "posn.hpp"
+
+#include <cstdint>
+#include <iostream>
+
+namespace gungi {
+
+class Bitboard {
+  // A 'gungi::Bitboard' is a set of squares on the board.  Bit 'i' of the set
+  // is the square with index 'i'.
+
+public:
+  // STATIC CLASS MEMBERS
+  static const unsigned int k_NUM_SQUARES = k_BOARD_LENGTH * k_BOARD_LENGTH;
+    // Number of squares on the board.
+
+  static const uint64_t k_HIGH_MASK = (1ULL << (k_NUM_SQUARES - 64)) - 1;
+    // Mask of the bits in the high word that correspond to squares.
+
+private:
+  // INSTANCE MEMBERS
+  uint64_t  m_low;
+             // Squares with an index in '[0, 64)'.
+
+  uint64_t  m_high;
+             // Squares with an index in '[64, k_NUM_SQUARES)'.
+
+public:
+  // STATIC CLASS METHODS
+  static Bitboard square(unsigned int idx);
+    // Returns a set containing only the square with the given index, 'idx'.
+
+  static Bitboard file(unsigned int col);
+    // Returns the set of squares in the given column, 'col'.
+
+  static Bitboard rank(unsigned int row);
+    // Returns the set of squares in the given row, 'row'.
+
+  static Bitboard all(void);
+    // Returns the set of every square on the board.
+
+  static Bitboard fromPosns(const PosnSet& posns);
+    // Returns the set of squares at the given 'posns'.  Positions that are not
+    // on the board are ignored.
+
+public:
+  // CREATORS
+  Bitboard(void);
+    // Creates an empty set.
+
+  Bitboard(uint64_t low, uint64_t high);
+    // Creates a set from the given 'low' and 'high' words.  Bits in the
+    // 'high' word that do not correspond to a square are discarded.
+
+  // MANIPULATORS
+  void set(unsigned int idx);
+    // Adds the square with the given index, 'idx', to this set.
+
+  void set(const Posn& posn);
+    // Adds the square at the given 'posn' to this set.
+
+  void reset(unsigned int idx);
+    // Removes the square with the given index, 'idx', from this set.
+
+  void reset(const Posn& posn);
+    // Removes the square at the given 'posn' from this set.
+
+  void clear(void);
+    // Removes every square from this set.
+
+  unsigned int pop(void);
+    // Removes the square with the lowest index from this set, and returns its
+    // index.  The behaviour is undefined unless this set is non-empty.
+
+  // ACCESSORS
+  bool test(unsigned int idx) const;
+    // Returns 'true' if the square with the given index, 'idx', is in this
+    // set, otherwise 'false'.
+
+  bool test(const Posn& posn) const;
+    // Returns 'true' if the square at the given 'posn' is in this set,
+    // otherwise 'false'.
+
+  bool any(void) const;
+    // Returns 'true' if this set contains at least one square, otherwise
+    // 'false'.
+
+  bool none(void) const;
+    // Returns 'true' if this set is empty, otherwise 'false'.
+
+  unsigned int count(void) const;
+    // Returns the number of squares in this set.
+
+  unsigned int first(void) const;
+    // Returns the index of the square with the lowest index in this set.  The
+    // behaviour is undefined unless this set is non-empty.
+
+  PosnSet toPosns(void) const;
+    // Returns the positions of the squares in this set, in index order.
+
+  uint64_t low(void) const;
+    // Returns the word holding the squares with an index in '[0, 64)'.
+
+  uint64_t high(void) const;
+    // Returns the word holding the squares with an index of '64' or above.
+
+  // OPERATORS
+  Bitboard operator&(const Bitboard& other) const;
+    // Returns the intersection of this set and the given 'other' set.
+
+  Bitboard operator|(const Bitboard& other) const;
+    // Returns the union of this set and the given 'other' set.
+
+  Bitboard operator^(const Bitboard& other) const;
+    // Returns the symmetric difference of this set and the given 'other' set.
+
+  Bitboard operator-(const Bitboard& other) const;
+    // Returns the difference of this set and the given 'other' set.
+
+  Bitboard operator~(void) const;
+    // Returns the set of squares on the board not in this set.
+
+  Bitboard& operator&=(const Bitboard& other);
+    // Intersects this set with the given 'other' set, and returns a reference
+    // to this set.
+
+  Bitboard& operator|=(const Bitboard& other);
+    // Adds the squares of the given 'other' set to this set, and returns a
+    // reference to this set.
+
+  Bitboard& operator^=(const Bitboard& other);
+    // Toggles the squares of the given 'other' set in this set, and returns a
+    // reference to this set.
+
+  Bitboard& operator-=(const Bitboard& other);
+    // Removes the squares of the given 'other' set from this set, and returns
+    // a reference to this set.
+
+  bool operator==(const Bitboard& other) const;
+    // Returns 'true' if this set and the given 'other' set contain the same
+    // squares, otherwise 'false'.
+
+  bool operator!=(const Bitboard& other) const;
+    // Returns 'true' if this set and the given 'other' set differ, otherwise
+    // 'false'.
+
+  friend std::ostream& operator<<(std::ostream& os, const Bitboard& board);
+    // Writes the given 'board' out to the given output stream, 'os', as a
+    // grid with the top row first, and returns the modified stream.
+};
+
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+// STATIC CLASS METHODS
+inline Bitboard Bitboard::square(unsigned int idx) {
+  Bitboard board;
+  board.set(idx);
+  return board;
+}
+
+inline Bitboard Bitboard::all(void) {
+  return Bitboard(~0ULL, k_HIGH_MASK);
+}
+
+// CREATORS
+inline Bitboard::Bitboard(void)
+: m_low(0)
+, m_high(0)
+{
+  // DO NOTHING
+}
+
+inline Bitboard::Bitboard(uint64_t low, uint64_t high)
+: m_low(low)
+, m_high(high & k_HIGH_MASK)
+{
+  // DO NOTHING
+}
+
+// MANIPULATORS
+inline void Bitboard::set(unsigned int idx) {
+  if (idx < 64) {
+    m_low |= 1ULL << idx;
+  } else {
+    m_high |= 1ULL << (idx - 64);
+  }
+}
+
+inline void Bitboard::set(const Posn& posn) {
+  set(posn.index());
+}
+
+inline void Bitboard::reset(unsigned int idx) {
+  if (idx < 64) {
+    m_low &= ~(1ULL << idx);
+  } else {
+    m_high &= ~(1ULL << (idx - 64));
+  }
+}
+
+inline void Bitboard::reset(const Posn& posn) {
+  reset(posn.index());
+}
+
+inline void Bitboard::clear(void) {
+  m_low = 0;
+  m_high = 0;
+}
+
+inline unsigned int Bitboard::pop(void) {
+  const unsigned int idx = first();
+  if (m_low) {
+    m_low &= m_low - 1;
+  } else {
+    m_high &= m_high - 1;
+  }
+  return idx;
+}
+
+// ACCESSORS
+inline bool Bitboard::test(unsigned int idx) const {
+  if (idx < 64) {
+    return (m_low >> idx) & 1;
+  }
+  return (m_high >> (idx - 64)) & 1;
+}
+
+inline bool Bitboard::test(const Posn& posn) const {
+  return test(posn.index());
+}
+
+inline bool Bitboard::any(void) const {
+  return (m_low | m_high) != 0;
+}
+
+inline bool Bitboard::none(void) const {
+  return (m_low | m_high) == 0;
+}
+
+inline unsigned int Bitboard::count(void) const {
+  return __builtin_popcountll(m_low) + __builtin_popcountll(m_high);
+}
+
+inline unsigned int Bitboard::first(void) const {
+  GASSERT(any());
+  if (m_low) {
+    return __builtin_ctzll(m_low);
+  }
+  return 64 + __builtin_ctzll(m_high);
+}
+
+inline uint64_t Bitboard::low(void) const {
+  return m_low;
+}
+
+inline uint64_t Bitboard::high(void) const {
+  return m_high;
+}
+
+// OPERATORS
+inline Bitboard Bitboard::operator&(const Bitboard& other) const {
+  return Bitboard(m_low & other.m_low, m_high & other.m_high);
+}
+
+inline Bitboard Bitboard::operator|(const Bitboard& other) const {
+  return Bitboard(m_low | other.m_low, m_high | other.m_high);
+}
+
+inline Bitboard Bitboard::operator^(const Bitboard& other) const {
+  return Bitboard(m_low ^ other.m_low, m_high ^ other.m_high);
+}
+
+inline Bitboard Bitboard::operator-(const Bitboard& other) const {
+  return Bitboard(m_low & ~other.m_low, m_high & ~other.m_high);
+}
+
+inline Bitboard Bitboard::operator~(void) const {
+  return Bitboard(~m_low, ~m_high);
+}
+
+inline Bitboard& Bitboard::operator&=(const Bitboard& other) {
+  m_low &= other.m_low;
+  m_high &= other.m_high;
+  return *this;
+}
+
+inline Bitboard& Bitboard::operator|=(const Bitboard& other) {
+  m_low |= other.m_low;
+  m_high |= other.m_high;
+  return *this;
+}
+
+inline Bitboard& Bitboard::operator^=(const Bitboard& other) {
+  m_low ^= other.m_low;
+  m_high ^= other.m_high;
+  return *this;
+}
+
+inline Bitboard& Bitboard::operator-=(const Bitboard& other) {
+  m_low &= ~other.m_low;
+  m_high &= ~other.m_high;
+  return *this;
+}
+
+inline bool Bitboard::operator==(const Bitboard& other) const {
+  return m_low == other.m_low && m_high == other.m_high;
+}
+
+inline bool Bitboard::operator!=(const Bitboard& other) const {
+  return !(*this == other);
+}
+
+}  // close 'gungi' namespace
@@ -0,0 +1,237 @@
+// engine.hpp                                                         -*-C++-*-
+#pragma once
+//@DESCRIPTION:
+//  This component provides a search engine that finds the best move in a
+//  game: a negamax search with alpha-beta pruning, deepened one ply at a time
+//  until a depth, node, or time limit is reached.  Each iteration searches
+//  the principal variation of the previous one first, which narrows the
+//  window early and lets an interrupted iteration fall back on the last one
+//  that completed.
+//
+//  The search walks the tree of moves in a single game, playing each move
+//  with 'Logician::makeMove()' and taking it back with
+//  'Logician::unmakeMove()', rather than copying the game at every position.
+//  The moves are those of 'Logician::generateMoves()', so the search plays by
+//  the same rules as the game.
+//
+//  Positions are scored from the point of view of the player whose turn it
+//  is, by the value of the units each player holds, on the board or in hand,
+//  and by the number of squares their units attack.  A checkmate scores
+//  'k_MATE_SCORE' less the number of plies to reach it, so that nearer mates
+//  are preferred.
+//
+//  The results of the search are kept in a 'TranspositionTable', which gives
+//  the best move found before for a position to search first, and cuts off
+//  positions already searched deep enough.  The table outlives a search, so
+//  the next search starts from what the last one found.
+//
+//  An engine may search on several threads, following the Lazy SMP scheme:
+//  every thread searches the whole tree from its own copy of the game, and
+//  the threads share nothing but the table and the signal to stop.  A thread
+//  finds the moves that another stored first, so together they search deeper
+//  than one thread alone.  Half of the helper threads start one ply deeper,
+//  so that the threads spread over the depths.  The line of the first thread
+//  is the one reported; the search stops when it completes.
+//
+//@CLASSES:
+//  'gungi::Engine': alpha-beta search engine.
+#include "gtypes.hpp"
+#include "logician.hpp"
+#include "move.hpp"
+#include "threadpool.hpp"
+#include "transpositiontable.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace gungi {
+
+class Engine {
+  // Search engine for the best move in a game.  An 'Engine' keeps the
+  // buffers for its search between calls, so searching again does not
+  // allocate.  An 'Engine' runs one search at a time.
+
+public:
+  // STRUCTURES
+  typedef struct limits_t {
+    // Maximum depth to search to, in plies, or zero for 'k_MAX_PLY'.
+    unsigned int  depth;
+
+    // Maximum number of positions to visit, over every thread, or zero for
+    // no limit.
+    uint64_t      nodes;
+
+    // Maximum time to search for, in milliseconds, or zero for no limit.
+    unsigned int  milliseconds;
+  } limits_t;
+
+  // STATIC CLASS MEMBERS
+  static const unsigned int k_MAX_PLY = 32;
+    // Maximum depth of a search, in plies.
+
+  static const int k_MATE_SCORE = 1000000;
+    // Score of a checkmate of the enemy on the current turn.
+
+  static const unsigned int k_TABLE_MEGABYTES = 16;
+    // Default size of the transposition table, in megabytes.
+
+private:
+  // STRUCTURES
+  typedef struct ply_t {
+    // Moves of the position at the ply.
+    MoveList  moves;
+
+    // Order in which the moves are searched, best first.
+    int       scores[MoveList::k_CAPACITY];
+  } ply_t;
+
+  typedef struct worker_t {
+    // Copy of the game being searched by the worker.
+    Logician               game;
+
+    // Moves of each ply of the line being searched.
+    std::vector<ply_t>     plies;
+
+    // Best line found from each ply, starting at the ply's index.
+    Move                   pv[k_MAX_PLY][k_MAX_PLY];
+
+    // Index one past the end of the best line from each ply.
+    unsigned int           pvLength[k_MAX_PLY + 1];
+
+    // Principal variation of the last completed iteration.
+    std::vector<Move>      line;
+
+    // Score of 'line'.
+    int                    score;
+
+    // Depth of the last completed iteration.
+    unsigned int           depth;
+
+    // Number of positions visited, read by the other workers.
+    std::atomic<uint64_t>  nodes;
+  } worker_t;
+
+  // INSTANCE MEMBERS
+  std::vector<std::unique_ptr<worker_t> >  m_workers;
+                                            // State of each search thread;
+                                            // the first is the main thread.
+
+  std::unique_ptr<ThreadPool>              m_pool;
+                                            // Threads running the workers,
+                                            // if there is more than one.
+
+  TranspositionTable                       m_table;
+                                            // Results shared by the
+                                            // workers.
+
+  limits_t                                 m_limits;
+                                            // Limits of the current search.
+
+  std::chrono::steady_clock::time_point    m_start;
+                                            // Time the current search
+                                            // started.
+
+  std::atomic<bool>                        m_stopped;
+                                            // 'true' if the current search
+                                            // hit a limit, or the main
+                                            // thread completed it.
+
+private:
+  // PRIVATE MANIPULATORS
+  void iterate(worker_t& worker, unsigned int idx);
+    // Runs the iterative deepening of the given 'worker', which has the
+    // given index, 'idx', among the workers, until the search is stopped or
+    // reaches its depth limit.
+
+  int negamax(worker_t&    worker,
+              unsigned int depth,
+              unsigned int ply,
+              int          alpha,
+              int          beta);
+    // Returns the score of the game of the given 'worker', from the point of
+    // view of the player whose turn it is, found by searching the given
+    // 'depth' of plies below it, within the window given by 'alpha' and
+    // 'beta'.  The given 'ply' is the number of moves made since the root.
+    // The best line is loaded into 'worker.pv[ply]'.  Returns zero if the
+    // search is stopped.
+
+  void orderMoves(worker_t& worker, unsigned int ply, const Move& hashMove);
+    // Scores the moves of the given 'worker' at the given 'ply' for the order
+    // in which they are searched: the move of the last principal variation,
+    // then the given 'hashMove' from the transposition table, then captures
+    // of the most valuable units, then the other moves.
+
+  const Move& nextMove(worker_t& worker, unsigned int ply, unsigned int idx);
+    // Returns the best scored move of the given 'worker' at the given 'ply'
+    // among those from the given index, 'idx', on, moving it to 'idx'.
+
+  bool isStopped(worker_t& worker);
+    // Returns 'true' if the search was stopped, otherwise checks the node
+    // and time limits of the search if the given 'worker' is the main
+    // thread, and returns 'true' if one was reached, otherwise 'false'.
+
+  // PRIVATE CREATORS
+  Engine(const Engine&);
+    // Not implemented.
+
+  Engine& operator=(const Engine&);
+    // Not implemented.
+
+public:
+  // STATIC CLASS METHODS
+  static int evaluate(const Logician& game);
+    // Returns the score of the given 'game' from the point of view of the
+    // player whose turn it is, without searching.
+
+  static int value(piece_id_t piece);
+    // Returns the value of a unit with the given 'piece' at its front.  The
+    // Commander has no value, as it cannot be captured.
+
+  // CREATORS
+  explicit Engine(unsigned int numThreads = 1,
+                  unsigned int megabytes = k_TABLE_MEGABYTES,
+                  bool         hugePages = false);
+    // Creates an engine with no search results that searches on the given
+    // 'numThreads' threads, with a transposition table of the given number
+    // of 'megabytes'.  If 'numThreads' is zero, searches on one thread per
+    // hardware thread.  If 'hugePages' is 'true', backs the table with huge
+    // pages where the system allows it.
+
+  // MANIPULATORS
+  void clear(void);
+    // Forgets the results of the previous searches.
+
+  Move search(const Logician& game, const limits_t& limits);
+    // Searches the given 'game' for the best move of the player whose turn it
+    // is, within the given 'limits', and returns it.  Returns a move of type
+    // 'Move::MOVE_TYPE_NONE' if the game is over or there is no legal move.
+    // The 'game' is copied once per thread; it is not changed.
+
+  // ACCESSORS
+  int score(void) const;
+    // Returns the score of the last search, from the point of view of the
+    // player whose turn it was.
+
+  unsigned int depth(void) const;
+    // Returns the depth of the last iteration that the last search
+    // completed.
+
+  uint64_t nodes(void) const;
+    // Returns the number of positions visited by the last search, over every
+    // thread.
+
+  unsigned int numThreads(void) const;
+    // Returns the number of threads that the engine searches on.
+
+  const TranspositionTable& table(void) const;
+    // Returns the transposition table of the engine.
+
+  const std::vector<Move>& principalVariation(void) const;
+    // Returns the line of best play found by the last search, starting with
+    // the move it returned.
+};
+
+}  // close 'gungi' namespace
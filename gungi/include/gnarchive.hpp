@@ -0,0 +1,360 @@
+// gnarchive.hpp                                                      -*-C++-*-
+#pragma once
+//@DESCRIPTION:
+//  This component provides a binary archive of games, a compact alternative
+//  to a file of Gungi Notation games in which any game, or any move of a
+//  game, is found without reading the games before it.
+//
+//  Each move is packed into 'k_PLY_SIZE' bytes: the kind of the move, and
+//  the squares and tiers it names, as in its Gungi Notation.  Drops and
+//  forced recoveries also keep the identifiers of their unit, but the other
+//  moves leave them out, as they name the unit at the square and tier moved
+//  from, which is known once the moves before it are played.  A move is
+//  unpacked without playing the moves before it, save for the identifiers
+//  left out.
+//
+//  The moves of every game are stored one after another, followed by a
+//  table of the games, a table of strings, and a footer.  The table of games
+//  gives the offset of each game's first move, its number of moves, and the
+//  identifiers of the strings of its metadata; each distinct string is
+//  stored once.  The footer gives the offsets of the tables, so an archive
+//  is written in one pass, and read from a mapping of the file.  Every
+//  number is stored in little-endian byte order:
+//  ```
+//  +-----------------+---------------------------------------------------+
+//  | Magic           | "GNARCHIV"                                        |
+//  | Moves           | 'k_PLY_SIZE' bytes per move                       |
+//  | Games           | per game: offset (8), moves (4), event, date,     |
+//  |                 | location, white and black string identifiers (4)  |
+//  | Strings         | offsets (8) of 'numStrings + 1' strings, then the |
+//  |                 | characters of the strings                         |
+//  | Footer          | offsets of the games (8) and strings (8), number  |
+//  |                 | of games (4) and strings (4), "GNARCHIV"          |
+//  +-----------------+---------------------------------------------------+
+//  ```
+//  The result of a game is not stored, as it is that of its moves.  Moving
+//  a game from Gungi Notation to an archive and back gives the text that
+//  'GNEncoder' writes for the game.
+//
+//@CLASSES:
+//  'gungi::GNArchive': reader of an archive of games.
+//  'gungi::GNArchiveWriter': writer of an archive of games.
+//
+//@EXAMPLE:
+//  ```
+//  {
+//    GNArchiveWriter writer(fd);
+//    GNReader reader;
+//    reader.open("archive.gn");
+//    reader.read([&writer](const GNReader::game_t& game) {
+//      return writer.addGame(game);
+//    });
+//    writer.finish();
+//  }
+//
+//  GNArchive archive;
+//  if (archive.open("archive.gna")) {
+//    Controller controller;
+//    unsigned int plies;
+//    archive.replay(42, 10, controller, plies);
+//  }
+//  ```
+#include "gndecoder.hpp"
+#include "gnencoder.hpp"
+#include "gnreader.hpp"
+#include "gtypes.hpp"
+#include "logician.hpp"
+#include "move.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace gungi {
+
+                               // ===============
+                               // class GNArchive
+                               // ===============
+
+class GNArchive {
+  // Reader of an archive of games, or of an archive in memory.
+
+public:
+  // STATIC CLASS MEMBERS
+  static const size_t k_PLY_SIZE = 3;
+    // Number of bytes of a move.
+
+  static const size_t k_MAGIC_SIZE = 8;
+    // Number of bytes of the magic string at the start and the end of an
+    // archive.
+
+  static const size_t k_GAME_SIZE = 32;
+    // Number of bytes of a game in the table of games.
+
+  static const size_t k_FOOTER_SIZE = 24 + k_MAGIC_SIZE;
+    // Number of bytes of the footer.
+
+  static const char k_MAGIC[k_MAGIC_SIZE + 1];
+    // Magic string at the start and the end of an archive.
+
+private:
+  // INSTANCE MEMBERS
+  const uint8_t  *m_data;
+                  // First byte of the archive.
+
+  size_t          m_length;
+                  // Number of bytes in the archive.
+
+  void           *m_map;
+                  // Mapping of the open file, if any.
+
+  const uint8_t  *m_games;
+                  // Table of games.
+
+  const uint8_t  *m_strings;
+                  // Offsets of the strings.
+
+  const uint8_t  *m_characters;
+                  // Characters of the strings.
+
+  uint32_t        m_numGames;
+                  // Number of games in the archive.
+
+  uint32_t        m_numStrings;
+                  // Number of strings in the archive.
+
+private:
+  // PRIVATE MANIPULATORS
+  bool index(void);
+    // Reads the footer and the tables of the archive.  Returns 'true' on
+    // success, otherwise 'false' if the archive is malformed.
+
+  // PRIVATE ACCESSORS
+  const uint8_t *game(size_t game) const;
+    // Returns the entry of the given 'game' in the table of games.  The
+    // behaviour is undefined unless 'game < numGames()'.
+
+  bool string(uint32_t id, std::string& value) const;
+    // Loads into the given output parameter, 'value', the string with the
+    // given 'id'.  Returns 'true' on success, otherwise 'false'.
+
+  bool play(size_t                           game,
+            unsigned int                     numPlies,
+            Controller&                      controller,
+            unsigned int&                    plies,
+            std::vector<GNDecoder::token_t> *tokens,
+            std::vector<colour_t>           *colours) const;
+    // Plays up to the given 'numPlies' first moves of the given 'game' on the
+    // given 'controller', as 'replay()' does.  Appends each move played, with
+    // the identifiers of its unit, to the given 'tokens', and the colour of
+    // the player who made it to the given 'colours', unless they are 'NULL'.
+
+  // PRIVATE CREATORS
+  GNArchive(const GNArchive&);
+    // Not implemented.
+
+  GNArchive& operator=(const GNArchive&);
+    // Not implemented.
+
+public:
+  // CREATORS
+  GNArchive(void);
+    // Creates a reader with no archive to read.
+
+  ~GNArchive(void);
+    // Destroys the reader, unmapping its file, if any.
+
+  // MANIPULATORS
+  bool open(const std::string& path);
+    // Maps the archive at the given 'path' into memory, and reads from it
+    // instead of the archive held before.  Returns 'true' on success,
+    // otherwise 'false' and the reader has no archive to read.
+
+  bool open(const char *data, size_t length);
+    // Reads the archive of the given 'length' bytes starting at the given
+    // 'data', instead of the archive held before.  The bytes are not copied,
+    // and must outlive the reader.  Returns 'true' on success, otherwise
+    // 'false' and the reader has no archive to read.
+
+  void close(void);
+    // Unmaps the open file, if any, and leaves the reader with no archive to
+    // read.
+
+  // ACCESSORS
+  size_t numGames(void) const;
+    // Returns the number of games in the archive.
+
+  unsigned int numPlies(size_t game) const;
+    // Returns the number of moves of the given 'game', otherwise zero if
+    // there is no such game.
+
+  bool metadata(size_t game, GNMetadata& md) const;
+    // Loads into the given output parameter, 'md', the metadata of the given
+    // 'game'.  Returns 'true' on success, otherwise 'false'.
+
+  bool move(size_t              game,
+            unsigned int        ply,
+            GNDecoder::token_t& token) const;
+    // Loads into the given output parameter, 'token', the move at the given
+    // 'ply' of the given 'game', counting from zero.  The identifiers of the
+    // unit are '\0' unless the move is a drop or a forced recovery.  Returns
+    // 'true' on success, otherwise 'false'.
+
+  bool replay(size_t        game,
+              unsigned int  numPlies,
+              Controller&   controller,
+              unsigned int& plies) const;
+    // Plays up to the given 'numPlies' first moves of the given 'game' on the
+    // given 'controller', which is expected to be at the start of a game.
+    // Loads into the given output parameter, 'plies', the number of moves
+    // played.  Returns 'true' if the moves were played, otherwise 'false'.
+    // On failure, the move after the last move played is either illegal or
+    // malformed.
+
+  bool write(size_t game, GNEncoder& encoder) const;
+    // Writes the given 'game' as Gungi Notation with the given 'encoder'.
+    // Returns 'true' on success, otherwise 'false' if a move is illegal, in
+    // which case nothing is written, or the write failed.
+
+  size_t size(void) const;
+    // Returns the number of bytes in the archive.
+
+  // STATIC CLASS MEMBERS
+  static bool packMove(const GNDecoder::token_t& token, uint8_t *bytes);
+    // Loads into the given output parameter, 'bytes', the 'k_PLY_SIZE' bytes
+    // of the given 'token'.  Returns 'true' on success, otherwise 'false' if
+    // the token is malformed.
+
+  static bool unpackMove(const uint8_t *bytes, GNDecoder::token_t& token);
+    // Loads into the given output parameter, 'token', the move packed into
+    // the 'k_PLY_SIZE' given 'bytes'.  The identifiers of the unit are '\0'
+    // unless the move is a drop or a forced recovery.  Returns 'true' on
+    // success, otherwise 'false' if the bytes are malformed.
+};
+
+                            // =====================
+                            // class GNArchiveWriter
+                            // =====================
+
+class GNArchiveWriter {
+  // Writer of an archive of games to a file descriptor.  The moves are
+  // written out as the games are added, while the tables of games and
+  // strings are held until 'finish()'.  A writer stops writing at the first
+  // write that fails.
+
+public:
+  // STATIC CLASS MEMBERS
+  static const size_t k_BUFFER_SIZE = 1 << 16;
+    // Number of bytes buffered before they are written out.
+
+private:
+  // INSTANCE MEMBERS
+  std::unique_ptr<uint8_t[]>                 m_buffer;
+                                              // Bytes not yet written out.
+
+  size_t                                     m_length;
+                                              // Number of bytes in
+                                              // 'm_buffer'.
+
+  uint64_t                                   m_offset;
+                                              // Number of bytes written,
+                                              // including 'm_buffer'.
+
+  int                                        m_fd;
+                                              // File descriptor written to.
+
+  bool                                       m_failed;
+                                              // 'true' if a write failed.
+
+  bool                                       m_finished;
+                                              // 'true' once the archive is
+                                              // finished.
+
+  std::vector<uint8_t>                       m_games;
+                                              // Table of games.
+
+  std::vector<std::string>                   m_strings;
+                                              // Strings, in order of their
+                                              // identifiers.
+
+  std::unordered_map<std::string, uint32_t>  m_stringIds;
+                                              // Identifier of each string.
+
+  std::vector<GNDecoder::token_t>            m_tokens;
+                                              // Moves of the game being
+                                              // added.
+
+  std::vector<uint8_t>                       m_plies;
+                                              // Packed moves of the game
+                                              // being added.
+
+private:
+  // PRIVATE MANIPULATORS
+  bool write(const void *bytes, size_t length);
+    // Appends the given 'length' bytes starting at the given 'bytes' to the
+    // archive.  Returns 'true' on success, otherwise 'false'.
+
+  bool flush(void);
+    // Writes out the bytes buffered.  Returns 'true' on success, otherwise
+    // 'false'.
+
+  uint32_t intern(const std::string& value);
+    // Returns the identifier of the given 'value' in the table of strings,
+    // adding it if needed.
+
+  // PRIVATE CREATORS
+  GNArchiveWriter(const GNArchiveWriter&);
+    // Not implemented.
+
+  GNArchiveWriter& operator=(const GNArchiveWriter&);
+    // Not implemented.
+
+public:
+  // CREATORS
+  explicit GNArchiveWriter(int fd);
+    // Creates a writer of an archive to the given file descriptor, 'fd'.  The
+    // descriptor is neither owned nor closed by the writer.
+
+  ~GNArchiveWriter(void);
+    // Destroys the writer, finishing the archive if it is not finished.
+
+  // MANIPULATORS
+  bool addGame(const GNMetadata&                      md,
+               const std::vector<GNDecoder::token_t>& tokens);
+    // Adds the game of the given 'tokens' with the given metadata, 'md'.  The
+    // moves are not played, so the game is expected to be legal.  Returns
+    // 'true' on success, otherwise 'false' if a token is malformed, in which
+    // case the game is not added, or the write failed.
+
+  bool addGame(const GNMetadata& md, const std::vector<Move>& moves);
+    // Adds the game of the given 'moves', played in order from the start of
+    // a game, with the given metadata, 'md'.  Returns 'true' on success,
+    // otherwise 'false' if a move is illegal, in which case the game is not
+    // added, or the write failed.
+
+  bool addGame(const GNReader::game_t& game);
+    // Adds the given Gungi Notation 'game', after playing its moves.  Returns
+    // 'true' on success, otherwise 'false' if the header or a move of the
+    // game is malformed or illegal, in which case the game is not added, or
+    // the write failed.
+
+  bool finish(void);
+    // Writes the tables and the footer of the archive, and the bytes still
+    // buffered.  No game may be added afterwards.  Returns 'true' on
+    // success, otherwise 'false'.
+
+  // ACCESSORS
+  size_t numGames(void) const;
+    // Returns the number of games added.
+
+  uint64_t size(void) const;
+    // Returns the number of bytes written, including those still buffered.
+
+  bool good(void) const;
+    // Returns 'true' if every write succeeded, otherwise 'false'.
+};
+
+}  // close 'gungi' namespace
@@ -25,6 +25,8 @@
 #include "gtypes.hpp"
 #include "logician.hpp"
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <sstream>
 
@@ -97,6 +99,10 @@ public:
 
   void setBlack(const std::string& name);
     // Sets the black player to the given 'name'.
+
+  void clear(void);
+    // Sets every string of the metadata to the empty string.  The storage of
+    // the strings is kept, so that reusing the metadata does not allocate.
 };
 
 
@@ -107,6 +113,44 @@ public:
 class GNDecoder {
   // Utility class for decoding '.gn' files.
 
+public:
+  // ENUMERATIONS
+  typedef enum token_type_t {
+    // Enumeration for the kinds of move in movetext.
+    TOKEN_NONE,
+    TOKEN_MOVE,
+    TOKEN_DROP,
+    TOKEN_MOBILE_STRIKE,
+    TOKEN_IMMOBILE_STRIKE,
+    TOKEN_RECOVER,
+    TOKEN_RECOVER_TO_OPPONENT,
+    TOKEN_NO_RECOVER,
+    TOKEN_SUBSTITUTION,
+    TOKEN_TIER_EXCHANGE,
+  } token_type_t;
+
+  // STRUCTURES
+  typedef struct token_t {
+    // Kind of the move ('token_type_t').
+    uint8_t  type;
+
+    // Identifiers of the front and back of the unit.
+    char     front;
+    char     back;
+
+    // Column, row and tier of the unit, or of the square dropped to or
+    // recovered from.
+    uint8_t  col;
+    uint8_t  row;
+    uint8_t  tier;
+
+    // Column, row and tier moved to, struck or exchanged with.  Only the
+    // tier is set for an immobile strike or a 1-3 tier exchange.
+    uint8_t  toCol;
+    uint8_t  toRow;
+    uint8_t  toTier;
+  } token_t;
+
 private:
   // PRIVATE STATIC CLASS MEMBERS
   static bool decodeComment(std::stringstream& ss);
@@ -125,7 +169,25 @@ private:
 
 public:
   // STATIC CLASS MEMBERS
-  static bool decodeMove(std::string move, Controller& controller);
+  static bool parseMove(const char *move, size_t length, token_t& token);
+    // Loads into the given output parameter, 'token', the move of the given
+    // 'length' characters starting at the given 'move'.  Returns 'true' on
+    // success, otherwise 'false' if the move is malformed.  The move is read
+    // in one pass: its kind is told by its length and separators, which sit
+    // at fixed offsets, as every coordinate is one digit.
+
+  static bool applyMove(const token_t& token, Controller& controller);
+    // Plays the move of the given 'token' on the given 'controller'.  Returns
+    // 'true' if the move was valid, otherwise 'false'.
+
+  static bool decodeMove(const char  *move,
+                         size_t       length,
+                         Controller&  controller);
+    // Decodes the move of the given 'length' characters starting at the given
+    // 'move', updating the given 'controller' based on the move.  Returns
+    // 'true' if the move was valid, or is only whitespace, otherwise 'false'.
+
+  static bool decodeMove(const std::string& move, Controller& controller);
     // Decodes the given 'move', updating the given 'controller' based on the
     // move.  Returns 'true' if the move was valid, otherwise 'false'.
 
@@ -0,0 +1,210 @@
+// gnencoder.hpp                                                      -*-C++-*-
+#pragma once
+//@DESCRIPTION:
+//  This component provides a writer of Gungi Notation: a header built from a
+//  'GNMetadata', followed by the movetext of a sequence of moves.  The text
+//  is written into a buffer supplied by the caller, or into a file
+//  descriptor through a buffer held by the encoder, which is written out
+//  whenever it fills.  Numbers and moves are formatted by hand, a character
+//  at a time, rather than through a stream, so that writing a move costs a
+//  few stores.
+//
+//  Moves are numbered in pairs, with the move indicator giving whose turn it
+//  is, so the text written is read back by 'GNDecoder' and 'GNReader'.  Games
+//  written one after another by the same encoder are separated by a blank
+//  line, as in an archive of games.
+//
+//@CLASSES:
+//  'gungi::GNEncoder': writer of Gungi Notation.
+//
+//@EXAMPLE:
+//  ```
+//  std::vector<Move> moves;
+//  ...
+//  GNMetadata md;
+//  md.setEvent("Selection");
+//
+//  GNEncoder encoder(STDOUT_FILENO);
+//  if (!encoder.writeGame(md, moves) || !encoder.flush()) {
+//    std::cerr << "Failed to write the game." << std::endl;
+//  }
+//  ```
+#include "gndecoder.hpp"
+#include "gtypes.hpp"
+#include "logician.hpp"
+#include "move.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gungi {
+
+class GNEncoder {
+  // Writer of Gungi Notation into a buffer, or a file descriptor.  An encoder
+  // stops writing at the first write that fails; the text written before it
+  // is kept.
+
+public:
+  // STATIC CLASS MEMBERS
+  static const size_t k_BUFFER_SIZE = 1 << 16;
+    // Number of characters buffered before they are written out to a file
+    // descriptor.
+
+  static const size_t k_MAX_MOVE_LENGTH = 14;
+    // Maximum number of characters of a move.
+
+  static const unsigned int k_LINE_WIDTH = 79;
+    // Number of characters after which movetext is wrapped onto a new line.
+
+private:
+  // STRUCTURES
+  typedef struct ply_t {
+    // Move to write.
+    GNDecoder::token_t  token;
+
+    // Colour of the player whose turn it was.
+    uint8_t             colour;
+  } ply_t;
+
+  // INSTANCE MEMBERS
+  std::unique_ptr<char[]>  m_storage;
+                            // Buffer for the text written to a file
+                            // descriptor.
+
+  char                    *m_buffer;
+                            // Buffer the text is written into.
+
+  size_t                   m_capacity;
+                            // Number of characters 'm_buffer' holds.
+
+  size_t                   m_length;
+                            // Number of characters in 'm_buffer'.
+
+  size_t                   m_flushed;
+                            // Number of characters written out of
+                            // 'm_buffer' to the file descriptor.
+
+  int                      m_fd;
+                            // File descriptor written to, otherwise '-1'.
+
+  bool                     m_failed;
+                            // 'true' if a write failed.
+
+  bool                     m_started;
+                            // 'true' if a game was started.
+
+  unsigned int             m_moveCount;
+                            // Number of the last move indicator written.
+
+  unsigned int             m_numMoves;
+                            // Number of moves written since the last move
+                            // indicator.
+
+  unsigned int             m_column;
+                            // Number of characters on the current line.
+
+  std::vector<ply_t>       m_plies;
+                            // Moves of the game being written by
+                            // 'writeGame()'.
+
+private:
+  // PRIVATE MANIPULATORS
+  bool reserve(size_t length);
+    // Makes room in the buffer for the given 'length' characters, writing
+    // the buffer out to the file descriptor if needed.  Returns 'true' on
+    // success, otherwise 'false'.
+
+  bool write(const char *text, size_t length);
+    // Appends the given 'length' characters starting at the given 'text' to
+    // the buffer.  Returns 'true' on success, otherwise 'false'.
+
+  bool writeOut(const char *text, size_t length);
+    // Writes the given 'length' characters starting at the given 'text' out
+    // to the file descriptor.  Returns 'true' on success, otherwise 'false'.
+
+  bool writeTag(const char *name, size_t length, const std::string& value);
+    // Appends the header tag with the given 'name' of the given 'length', and
+    // the given 'value', unless the 'value' is empty.  Returns 'true' on
+    // success, otherwise 'false'.
+
+  // PRIVATE CREATORS
+  GNEncoder(const GNEncoder&);
+    // Not implemented.
+
+  GNEncoder& operator=(const GNEncoder&);
+    // Not implemented.
+
+public:
+  // CREATORS
+  GNEncoder(char *buffer, size_t capacity);
+    // Creates an encoder that writes into the given 'buffer' of the given
+    // 'capacity' characters.  The text is not terminated with a null
+    // character.  The 'buffer' must outlive the encoder.
+
+  explicit GNEncoder(int fd);
+    // Creates an encoder that writes to the given file descriptor, 'fd'.  The
+    // descriptor is neither owned nor closed by the encoder.
+
+  ~GNEncoder(void);
+    // Destroys the encoder, writing out the text still buffered, if any.
+
+  // MANIPULATORS
+  bool writeHeader(const GNMetadata& md, const Controller& controller);
+    // Ends the game before, if any, and starts a new game with its header
+    // from the given 'md', and the result of the given 'controller'.  The
+    // tags of 'md' that are empty are left out.  Returns 'true' on success,
+    // otherwise 'false'.
+
+  bool writeMove(const GNDecoder::token_t& token, colour_t colour);
+    // Writes the move of the given 'token', made on the turn of the player of
+    // the given 'colour', to the movetext of the current game.  Returns
+    // 'true' on success, otherwise 'false' if the token is malformed or the
+    // write failed.
+
+  bool writeMove(const Controller& controller, const Move& move);
+    // Writes the given 'move', which is to be played next in the given
+    // 'controller', to the movetext of the current game.  Returns 'true' on
+    // success, otherwise 'false'.
+
+  bool writeGame(const GNMetadata& md, const std::vector<Move>& moves);
+    // Writes the game of the given 'moves', played in order from the start of
+    // a game, with the header from the given 'md'.  Returns 'true' on
+    // success, otherwise 'false' if a move is illegal, in which case nothing
+    // is written, or the write failed.
+
+  bool endGame(void);
+    // Ends the movetext of the current game with a newline, if it has any
+    // moves not yet ended.  Returns 'true' on success, otherwise 'false'.
+
+  bool flush(void);
+    // Writes out the text buffered for the file descriptor, if any.  Returns
+    // 'true' on success, otherwise 'false'.
+
+  // ACCESSORS
+  size_t size(void) const;
+    // Returns the number of characters written, including those still
+    // buffered.
+
+  bool good(void) const;
+    // Returns 'true' if every write succeeded, otherwise 'false'.
+
+  // STATIC CLASS MEMBERS
+  static size_t encodeMove(const GNDecoder::token_t& token, char *move);
+    // Loads into the given output parameter, 'move', the text of the given
+    // 'token', which is at most 'k_MAX_MOVE_LENGTH' characters, and returns
+    // its length.  Returns zero, with nothing written, if the token is
+    // malformed.
+
+  static bool tokenize(const Controller&   controller,
+                       const Move&         move,
+                       GNDecoder::token_t& token);
+    // Loads into the given output parameter, 'token', the given 'move', which
+    // is to be played next in the given 'controller'.  Returns 'true' on
+    // success, otherwise 'false' if the units of the move are not where the
+    // move requires.
+};
+
+}  // close 'gungi' namespace
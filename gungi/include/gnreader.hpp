@@ -0,0 +1,152 @@
+// gnreader.hpp                                                       -*-C++-*-
+#pragma once
+//@DESCRIPTION:
+//  This component provides a reader for files holding many Gungi Notation
+//  games one after another, such as an archive of games.  The file is mapped
+//  into memory instead of being read into a buffer.  Each game is handed to
+//  a callback as a slice of the mapping, together with the metadata decoded
+//  from its header.  Neither the games nor the tokens of their movetext are
+//  copied.
+//
+//  A game starts at its header.  The next game starts at the first line after
+//  the movetext that starts with '[' and is not inside an inline comment.
+//  This means games without a header cannot follow one another in a file.
+//  The reader only splits the games and decodes their headers.  Movetext is
+//  skipped by searching it for the few characters that can end it, with
+//  'memchr()', rather than a character or a line at a time.
+//  'GNReader::replay()' decodes the moves of a game and plays them.
+//
+//@CLASSES:
+//  'gungi::GNReader': reader of files of Gungi Notation games.
+//
+//@EXAMPLE:
+//  ```
+//  GNReader reader;
+//  if (reader.open("archive.gn")) {
+//    reader.read([](const GNReader::game_t& game) {
+//      Controller controller;
+//      unsigned int plies;
+//      if (!game.valid || !GNReader::replay(game, controller, plies)) {
+//        std::cerr << "Malformed game at byte " << game.offset << std::endl;
+//      }
+//      return true;
+//    });
+//  }
+//  ```
+#include "gndecoder.hpp"
+#include "logician.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace gungi {
+
+class GNReader {
+  // Reader for the games of a Gungi Notation file, or of a buffer in memory.
+
+public:
+  // STRUCTURES
+  typedef struct slice_t {
+    // First character of the slice.
+    const char  *data;
+
+    // Number of characters in the slice.
+    size_t       length;
+  } slice_t;
+
+  typedef struct game_t {
+    // Metadata decoded from the header of the game.
+    GNMetadata  metadata;
+
+    // Text of the game, from its header to the end of its movetext.
+    slice_t     text;
+
+    // Movetext of the game.
+    slice_t     movetext;
+
+    // Offset of the game from the start of the text read, in bytes.
+    size_t      offset;
+
+    // 'true' if the header of the game was decoded, otherwise 'false'.
+    bool        valid;
+  } game_t;
+
+  // TYPE DEFINITIONS
+  typedef std::function<bool(const game_t&)> callback_t;
+    // Type definition for the callback that is handed each game.  It returns
+    // 'true' to keep reading, otherwise 'false' to stop.  The game and its
+    // slices are only valid during the call, and while the reader holds the
+    // text.
+
+private:
+  // INSTANCE MEMBERS
+  const char  *m_data;
+                // First character of the text being read.
+
+  size_t       m_length;
+                // Number of characters in the text being read.
+
+  void        *m_map;
+                // Mapping of the open file, if any.
+
+private:
+  // PRIVATE CREATORS
+  GNReader(const GNReader&);
+    // Not implemented.
+
+  GNReader& operator=(const GNReader&);
+    // Not implemented.
+
+public:
+  // CREATORS
+  GNReader(void);
+    // Creates a reader with no text to read.
+
+  GNReader(const char *data, size_t length);
+    // Creates a reader for the given 'length' characters starting at the
+    // given 'data'.  The characters are not copied, and must outlive the
+    // reader.
+
+  ~GNReader(void);
+    // Destroys the reader, unmapping its file, if any.
+
+  // MANIPULATORS
+  bool open(const std::string& path);
+    // Maps the file at the given 'path' into memory, and reads from it
+    // instead of the text held before.  Returns 'true' on success, otherwise
+    // 'false' and the reader has no text to read.
+
+  void close(void);
+    // Unmaps the open file, if any, and leaves the reader with no text to
+    // read.
+
+  // ACCESSORS
+  size_t read(const callback_t& callback) const;
+    // Hands every game of the text, in order, to the given 'callback', until
+    // it returns 'false'.  Returns the number of games handed to it.
+
+  size_t size(void) const;
+    // Returns the number of characters in the text being read.
+
+  // STATIC CLASS MEMBERS
+  static bool replay(const game_t& game,
+                     Controller&   controller,
+                     unsigned int& plies);
+    // Decodes the movetext of the given 'game' and plays its moves on the
+    // given 'controller'.  Loads into the given output parameter, 'plies',
+    // the number of moves played.  Returns 'true' if every move was played,
+    // otherwise 'false'.  On failure, the move after the last move played is
+    // either illegal or malformed.
+
+  static bool replay(const game_t&                    game,
+                     Controller&                      controller,
+                     unsigned int&                    plies,
+                     std::vector<GNDecoder::token_t>& tokens);
+    // Decodes the movetext of the given 'game' and plays its moves on the
+    // given 'controller', as above, and loads into the given output
+    // parameter, 'tokens', the moves played.
+};
+
+}  // close 'gungi' namespace
@@ -11,9 +11,9 @@
 //  'gungi::move_dir_t': enumeration specifying the different move directions.
 //  'gungi::move_mod_t': enumeration specifying how to interpret a move.
 //  'gungi::move_t': structure representing a move which is a mod and dir pair.
-//  'gungi::move_vector_t': type definition for a vector of moves.
+//  'gungi::move_span_t': structure representing a range of a moveset table.
 //  'gungi::moveset_t': type definition for the piece moves in a tower.
-//  'gungi::moveset_ptr_t': type definition for a pointer to a move vector.
+//  'gungi::moveset_ptr_t': type definition for a pointer to a moveset.
 //  'gungi::const_moveset_ptr_t': constant 'gungi::moveset_ptr'.
 //  'gungi::effect_t': enumeration specifying the identifiers for effects.
 //  'gungi::effect_bitfield_t': type definition for effect bitfields
@@ -27,10 +27,13 @@
 //  'gungi::k_BOARD_LENGTH': length of the gungi board.
 //  'gungi::k_UNIT_EFFECT': array of unit effect bitfields.
 //  'gungi::k_UNIT_IMMUNITY': array of unit immunity bitfields.
+//  'gungi::k_MAX_PATH_STEPS': constant for the max number of steps in a path.
+//  'gungi::k_NUM_MOVE_STEPS': constant for the number of moveset steps.
+//  'gungi::k_NUM_MOVE_PATHS': constant for the number of moveset paths.
+//  'gungi::k_MOVE_STEPS': array of the steps of every moveset path.
+//  'gungi::k_MOVE_PATHS': array of the paths of every unit moveset.
 //  'gungi::k_UNIT_MOVES': array of unit movesets.
 //  'gungi::k_START_HAND': starting hand for a player.
-#include <vector>
-
 namespace gungi {
 
 #define GASSERT(cond, ...) gassert(__FILE__, __LINE__, #cond, (cond), ## __VA_ARGS__)
@@ -49,6 +52,15 @@ const unsigned int k_BOARD_LENGTH = 9;
   // Length of the board.  Since the board is square, the total size of the
   // board is 'k_BOARD_LENGTH * k_BOARD_LENGTH'.
 
+const unsigned int k_MAX_PATH_STEPS = 2;
+  // The maximum number of steps in a single path of a moveset.
+
+const unsigned int k_NUM_MOVE_STEPS = 290;
+  // The number of steps in the paths of every moveset.
+
+const unsigned int k_NUM_MOVE_PATHS = 247;
+  // The number of paths in every moveset.
+
 typedef enum colour_t {
   // The different player colours.
   WHITE = (1 << 0),
@@ -115,21 +127,29 @@ typedef struct move_t {
   move_mod_t move_modifier;
 } move_t;
 
-typedef std::vector<std::vector<move_t> > move_vector_t;
-  // Type definition for a vector of moves.  A piece has multiple moves it can
-  // make based on its height within a tower.  This vector is used to contain
-  // the moves at a particular height.
+typedef struct move_span_t {
+  // Offset of the first element of the span.
+  unsigned short first;
 
-typedef move_vector_t moveset_t[k_MAX_TOWER_SIZE];
+  // Number of elements in the span.
+  unsigned short count;
+} move_span_t;
+  // Type definition for a contiguous range of a flat moveset table.  A path
+  // is a span of 'k_MOVE_STEPS' which must be walked in order, and the moves
+  // available to a piece at a particular height within a tower are a span of
+  // 'k_MOVE_PATHS'.
+
+typedef move_span_t moveset_t[k_MAX_TOWER_SIZE];
   // Type definition for a set of moves.  A piece has a different list of moves
   // based on its height within a tower; the set is the entire collection of
   // the available moves for every height.
 
-typedef move_vector_t* moveset_ptr_t;
-  // Type definition for a pointer to a move vector.
+typedef move_span_t* moveset_ptr_t;
+  // Type definition for a pointer to the spans of paths of a moveset.
 
-typedef move_vector_t const * const_moveset_ptr_t;
-  // Type definition for a pointer to an array of constant move vectors.
+typedef move_span_t const * const_moveset_ptr_t;
+  // Type definition for a pointer to the constant spans of paths of a
+  // moveset.
 
 typedef enum effect_t {
   // Placeholder.
@@ -209,8 +229,16 @@ extern const effect_bitfield_t k_UNIT_EFFECT[GUNGI_NUM_PIECES];
 extern const effect_bitfield_t k_UNIT_IMMUNITY[GUNGI_NUM_PIECES];
   // Effect bitfields specifying immunities for each unit.
 
+extern const move_t k_MOVE_STEPS[k_NUM_MOVE_STEPS];
+  // Steps of every path, grouped by path.  A step moves once in its
+  // direction, or repeatedly if its modifier is unlimited.
+
+extern const move_span_t k_MOVE_PATHS[k_NUM_MOVE_PATHS];
+  // Paths of every moveset, as spans of 'k_MOVE_STEPS', grouped by piece and
+  // tier.
+
 extern const moveset_t k_UNIT_MOVES[GUNGI_NUM_PIECES];
-  // Moveset for each unit.
+  // Moveset for each unit, as a span of 'k_MOVE_PATHS' for each tier.
 
 extern const int k_START_HAND[12][3];
   // Multi-dimensional array specifying the number of front pieces of a
@@ -40,21 +40,59 @@
 //  Arrangement'.  Each player must have a 'Pawn' in every 'file' by the end of
 //  this phase.
 //
+//  A 'Logician' can be copied to fork a game, e.g. to explore a line of play
+//  and then restore the saved position by assignment.  The board, the units,
+//  the bitboards and the per-unit tables are fixed-size and copied whole; the
+//  players and the recorded positions are flat arrays of pointers and keys.
+//  Towers hold unit handles, which are the same in the copy, but units and
+//  players refer to each other by pointer, so a copy then rebinds those
+//  pointers to its own storage, visiting each unit; the copy shares nothing
+//  with the original.  The recorded positions grow by one key per turn, so a
+//  search that only makes and unmakes moves on one game, rather than copying
+//  it, never copies them.
+//
+//  Check is detected from attack maps: the set of squares that each unit
+//  attacks, and the union of those sets for each colour.  The maps are kept
+//  up to date as the towers change, recomputing only the units whose walks
+//  start at, or cross, a square that changed; whether a Commander is in check,
+//  or can escape to a square, is then a lookup.
+//
+//  A check is stopped by taking or covering every unit giving check, or by
+//  putting a unit on the squares between them and the Commander: the check
+//  points.  A unit leaving its square can still expose the Commander, if it
+//  is the only unit between the Commander and an enemy unit, or if it covers
+//  an enemy unit; such units are pinned.  Only a pinned unit, or one taking
+//  an enemy Bronze from the Commander's file, needs the board after its move
+//  to be looked at, and that is done on the rays to the Commander rather
+//  than by playing the move.
+//
+//  Whether the current player is in check is found after every turn, but
+//  their check points, escape routes and pins are only needed if they are in
+//  check.  A 'Logician' can also be asked to leave those, and so whether the
+//  check is checkmate, to the first query that needs them: the game state, a
+//  move validation, or the move generation.  The answer is kept until the
+//  next turn.  A Pawn or Bronze drop that gives check is still decided at
+//  once, as a checkmate by such a drop is foul play that rejects the drop.
+//  As queries then update the game state, a game in this mode must not be
+//  shared between threads, even through a 'const' reference.
+//
 //@CLASSES:
 //  'gungi::BoardRecorder': class to record the board positions.
 //  'gungi::Logician': logic controller class.
 //
 //@TYPES:
 //  'gungi::Controller': alias for the 'Logician'.
+#include "bitboard.hpp"
 #include "builder.hpp"
 #include "gtypes.hpp"
+#include "move.hpp"
 #include "player.hpp"
 #include "posn.hpp"
 #include "tower.hpp"
+#include "unitarena.hpp"
 
 #include <cstdint>
 #include <iostream>
-#include <memory>
 #include <vector>
 
 namespace gungi {
@@ -69,22 +107,16 @@ class Unit;
 class BoardRecorder {
   // Class to record the board positions.  This is necessary to ensure that the
   // same position does not repeat more than 'k_MAX_POSITION_REPETITIONS'.
-
-public:
-  // STRUCTURES
-  typedef struct position_t {
-    std::vector<std::vector<piece_id_t> > board;
-
-    unsigned int repetitions;
-  } position_t;
+  // Positions are identified by their 64-bit key (see 'Zobrist') and kept in
+  // the order they were recorded, one key per turn: copying the recorder is a
+  // single copy of the keys, and taking back turns truncates them.  Counting
+  // the repetitions of a position is a scan of the keys.
 
 private:
   // INSTANCE MEMBERS
-  const unsigned int      m_boardSize;
-                           // Size of the board.
-
-  std::vector<position_t> m_positions;
-                           // Vector of board positions.
+  std::vector<uint64_t> m_keys;
+                         // Keys of the recorded positions, in the order they
+                         // were recorded.
 
 public:
   // CREATORS
@@ -95,22 +127,28 @@ public:
     // Default destructor.
 
   // ACCESSORS
-  const position_t *position(const std::vector<Tower>& board) const;
-    // Returns a pointer to the 'position_t' object that corresponds to the
-    // given 'board' if the given 'board' matches any of the stored
-    // positions, otherwise 'NULL'.
+  unsigned int repetitions(uint64_t key) const;
+    // Returns the number of times the position with the given 'key' has been
+    // recorded.
+
+  unsigned int count(void) const;
+    // Returns the number of recordings made, of any position.
 
   // MANIPULATORS
   void reset(void);
     // Resets the recorder instance, clearing any stored positions.
 
-  unsigned int record(const std::vector<Tower>& board);
-    // Records the given 'board' position and returns the repetition count.
+  unsigned int record(uint64_t key);
+    // Records the position with the given 'key' and returns the number of
+    // times it had been recorded before.
+
+  void truncate(unsigned int count);
+    // Removes the recordings made after the first 'count' recordings.  The
+    // behaviour is undefined unless 'count <= this->count()'.
 
   // OPERATORS
-  friend unsigned int operator<<(BoardRecorder&            recorder,
-                                 const std::vector<Tower>& board);
-    // Records the given 'board' position into the given 'recorder'.
+  friend unsigned int operator<<(BoardRecorder& recorder, uint64_t key);
+    // Records the position with the given 'key' into the given 'recorder'.
 };
 
 
@@ -134,10 +172,14 @@ public:
     GAME_STATE_DRAW                 = (1 << 5),
   };
 
+  // TYPE DEFINITIONS
+  typedef unsigned int game_state_t;
+    // Type definition for the bitfield that holds the game state.
+
   // STRUCTURES
   typedef struct recover_t {
-    // Pointer to the unit being recovered.
-    SharedUnitPtr  unit;
+    // Handle of the unit being recovered.
+    unit_handle_t  unit;
 
     // Pointer to the player whose hand the recovered unit will be added to.
     Player  *player;
@@ -146,9 +188,57 @@ public:
     const Tower *tower;
   } recover_t;
 
-  // TYPE DEFINITIONS
-  typedef unsigned int game_state_t;
-    // Type definition for the bitfield that holds the game state.
+  typedef struct undo_t {
+    // The move that was made.
+    Move           move;
+
+    // Index of the square the moving unit left, for a move or a recovery.
+    uint8_t        from;
+
+    // Tier the moving unit left, for a move or a recovery.
+    uint8_t        fromTier;
+
+    // Handle of the unit captured by the move, if any.  A recovered unit
+    // added to the enemy's hand is captured by the recovery.
+    unit_handle_t  captured;
+
+    // Tier the captured unit was taken from.
+    uint8_t        capturedTier;
+
+    // 'true' if the captured unit was flipped over when it was captured.
+    bool           flipped;
+
+    // Handles of the units that betrayed their team, in order.
+    unit_handle_t  betrayed[k_MAX_TOWER_SIZE];
+
+    // Number of entries in 'betrayed'.
+    uint8_t        numBetrayed;
+  } undo_t;
+
+  typedef struct turn_t {
+    // Changes made to the board and the armies by the move.
+    undo_t         undo;
+
+    // Game state before the move.
+    game_state_t   state;
+
+    // Handle of the unit being rearranged before the move.
+    unit_handle_t  toRearrange;
+
+    // Forced recovery information before the move.
+    recover_t      recovery;
+
+    // Escape routes, check points, and pins before the move.
+    Bitboard       escapeRoutes;
+    Bitboard       checkPoints;
+    Bitboard       pinned;
+
+    // 'true' if the evasions from check were pending before the move.
+    bool           evasionsPending;
+
+    // Number of positions recorded before the move.
+    unsigned int   recorded;
+  } turn_t;
 
 public:
   // STATIC CLASS MEMBERS
@@ -173,46 +263,118 @@ private:
   Player                               m_white;
                                         // White player.
 
-  SharedUnitPtrVector                  m_units;
-                                        // Vector of shared pointers to units.
-
-  std::vector<Tower>                   m_board;
-                                        // Vector of towers that make up the
-                                        // board.
+  UnitArena                            m_arena;
+                                        // Arena owning every unit in the
+                                        // game.
+
+  board_t                              m_board;
+                                        // Towers that make up the board, by
+                                        // square index.
+
+  Bitboard                             m_occupancy[k_NUM_PLAYERS]
+                                                  [k_MAX_TOWER_SIZE];
+                                        // Squares holding a unit of each
+                                        // colour at each tier, indexed by
+                                        // colour and tier.  Kept in sync with
+                                        // 'm_board'.
+
+  Bitboard                             m_pieces[k_NUM_PLAYERS]
+                                               [GUNGI_NUM_PIECES];
+                                        // Squares holding a unit of each
+                                        // colour with each front identifier,
+                                        // indexed by colour and identifier.
+                                        // Kept in sync with 'm_board'.
+
+  uint64_t                             m_boardKey;
+                                        // Exclusive-or of the 'Zobrist' keys
+                                        // of the units on the board.  Kept in
+                                        // sync with 'm_board'.
+
+  uint64_t                             m_handKey;
+                                        // Sum of the 'Zobrist' keys of the
+                                        // units in both players' hands.
 
   BoardRecorder                        m_boardRecorder;
                                         // Board position recording class.
 
   // STATE VARIABLES
-  game_state_t                         m_gameState;
-                                        // Current game state.
+  mutable game_state_t                 m_gameState;
+                                        // Current game state.  Checkmate is
+                                        // set on demand if the evasions are
+                                        // pending.
 
-  SharedUnitPtr                        m_toRearrange;
-                                        // Shared pointer for the unit that is
-                                        // being rearranged.
+  unit_handle_t                        m_toRearrange;
+                                        // Handle of the unit that is being
+                                        // rearranged.
 
   recover_t                            m_recovery;
                                         // Forced recovery information.
 
-  unsigned int                         m_expansions[k_BOARD_SIZE];
-                                        // Mobile range expansion bitfield.
-                                        // Used to record which indices are in
-                                        // the mobile range expansion for which
-                                        // players.
-
-  PosnSet                              m_escapeRoutes;
+  Bitboard                             m_expansions[k_NUM_PLAYERS];
+                                        // Squares in the mobile range
+                                        // expansion of each colour, indexed
+                                        // by colour.
+
+  Bitboard                             m_expanders;
+                                        // Squares holding a unit with a
+                                        // mobile range expansion effect.
+                                        // Kept in sync with 'm_board'.
+
+  bool                                 m_expandersMoved;
+                                        // 'true' if a unit with a mobile
+                                        // range expansion effect was added
+                                        // to, or removed from, a tower since
+                                        // the expansions were last updated.
+
+  Bitboard                             m_attacks[UnitArena::k_CAPACITY];
+                                        // Squares attacked by each unit,
+                                        // indexed by handle.  Kept in sync
+                                        // with 'm_board' and 'm_expansions'
+                                        // (see 'updateAttacks()').
+
+  Bitboard                             m_attacked[k_NUM_PLAYERS];
+                                        // Squares attacked by any unit of
+                                        // each colour, indexed by colour.
+                                        // Kept in sync with 'm_attacks'.
+
+  Bitboard                             m_changed;
+                                        // Squares whose towers, or mobile
+                                        // range expansion, changed since the
+                                        // attack maps were last updated.
+
+  mutable Bitboard                     m_escapeRoutes;
                                         // If the current player is in check,
                                         // contains the set of points that the
                                         // commander can move to in order to
                                         // escape check.
 
-  PosnSet                              m_checkPoints;
+  mutable Bitboard                     m_checkPoints;
                                         // If the current player is in check,
                                         // contains the set of points that a
                                         // non-commander units can be moved to
                                         // or dropped upon to get the commander
                                         // to escape check.
 
+  mutable Bitboard                     m_pinned;
+                                        // Squares of the units of the
+                                        // current player that may expose
+                                        // the commander by leaving (see
+                                        // 'pinned()'); computed with the
+                                        // evasions if the player is in
+                                        // check.
+
+  bool                                 m_lazyCheckmate;
+                                        // 'true' if the evasions from check
+                                        // are computed on demand.
+
+  mutable bool                         m_evasionsPending;
+                                        // 'true' if the current player is in
+                                        // check, but their escape routes,
+                                        // pins, and available check points
+                                        // are not yet computed; only the
+                                        // check points of the units giving
+                                        // check are in 'm_checkPoints'.
+
 private:
   // PRIVATE ACCESSORS
   Player& next(void);
@@ -221,44 +383,227 @@ private:
   Player& current(void);
     // Returns a reference to the 'Player' whose turn it is currently.
 
-  PosnSet commanderEscapeRoutes(const Unit& com,
-                                const Posn& commanderPosn) const;
-    // Returns a set of 'Posn' objects that the given Commander, 'com', at the
+  Bitboard commanderEscapeRoutes(const Unit& com,
+                                 const Posn& commanderPosn) const;
+    // Returns the set of squares that the given Commander, 'com', at the
     // given 'Posn', 'commanderPosn', can escape to in order to avoid a
     // checkmate.
 
-  bool isReachableAfterMove(const Posn& posn, const Player& player) const;
+  bool isReachableAfterMove(const Posn&   posn,
+                            const Player& player,
+                            const Unit&   moving) const;
     // Returns 'true' if the acitve units for the given 'player' could reach
-    // the given 'posn' after an opposing unit has moved to the given 'posn',
+    // the given 'posn' after the given opposing 'moving' unit has moved to
+    // the given 'posn', otherwise 'false'.
+
+  bool isBetrayingDuplicate(const Unit& unit, const Tower& tower) const;
+    // Returns 'true' if the given 'unit' moving onto the given 'tower' would
+    // take its top and turn an enemy unit below of the same front identifier
+    // to its team by betrayal, otherwise 'false'.
+
+  bool isTakingCommander(const Posn& target, const Unit& unit) const;
+    // Returns 'true' if the given 'unit', which reaches the given 'target',
+    // could move onto the tower there after the enemy Commander moved onto
+    // it, taking its top if the top is of the colour of the 'unit',
     // otherwise 'false'.
 
+  bool isExposingCommander(const Tower&       tower,
+                           const Unit * const *members,
+                           tier_t              height) const;
+    // Returns 'true' if an enemy unit that reaches the given 'tower', which
+    // holds a Commander, could move onto it were it to hold the given
+    // 'height' 'members', bottom first, otherwise 'false'.  The rules that
+    // depend on the units of the tower, which the enemy unit takes the top
+    // of, or turns by betrayal, are applied to the 'members'.
+
+  bool isAttacking(const Posn& target, const Unit& unit) const;
+    // Returns 'true' if the given 'unit' attacks the given 'target', that is
+    // it could move to 'target' if moves that leave a Commander in check
+    // were allowed, otherwise 'false'.  This looks up the attack map of the
+    // 'unit', then applies the rules that depend on the tower at 'target'.
+
+  bool isAttackedAfter(const Unit& unit, const Posn& posn) const;
+    // Returns 'true' if the Commander of the given 'unit' would be attacked
+    // after the 'unit' is moved to, or strikes from, the given 'posn', which
+    // is one of the check points if the Commander is in check, otherwise
+    // 'false'.  A 'posn' that is the square of the 'unit' is an immobile
+    // strike on the top of its tower.
+
+  bool isAttackedAfterStrike(tier_t tier, const Unit& unit) const;
+    // Returns 'true' if the Commander of the given 'unit' would be attacked
+    // after the 'unit' strikes the enemy unit at the given 'tier' of its
+    // tower, which lowers the units above it, may let a second enemy Bronze
+    // into the file of the Commander, and, for the Commander, puts it next
+    // to the unit beyond, otherwise 'false'.
+
+  Bitboard computeAttacks(const Unit& unit) const;
+    // Returns the set of squares that the given 'unit' could walk to from its
+    // position, considering the units that block its walks, but not the
+    // towers at the end of the walks.
+
+  Bitboard computeAttacks(const Unit& unit, const Bitboard& vacated) const;
+    // Returns the set of squares that the given 'unit' could walk to from its
+    // position if the towers in the given 'vacated' set did not block its
+    // walks, but not the towers at the end of the walks.
+
+  Bitboard computeAttacksAfterLeaving(const Unit& unit,
+                                      const Unit& moving) const;
+    // Returns the set of squares that the given 'unit' could walk to from its
+    // position once the given 'moving' unit left its tower, but not the
+    // towers at the end of the walks.
+
+  Bitboard computeWalks(const Unit& unit, const Bitboard& vacated) const;
+    // Returns the set of squares that the given 'unit' could walk to from its
+    // tier and position if the towers in the given 'vacated' set did not
+    // block its walks, whether or not it is at the top of its tower.
+
   bool isDuplicateInFile(const Unit& unit, const Posn& posn) const;
     // Returns 'true' if there is a Unit of the same colour and identifier as
     // the given 'unit' in the file containing the given 'posn', otherwise
     // 'false'.
 
+  Bitboard threatened(colour_t colour) const;
+    // Returns the set of squares that the units of the given 'colour' on the
+    // board could walk to from their tier on an empty board.
+
+  bool mayBeFoulMate(const Unit&     unit,
+                     const Posn&     target,
+                     const Bitboard& threats) const;
+    // Returns 'false' if dropping or moving the given 'unit' to the given
+    // 'target' cannot put the enemy Commander in check, given the squares,
+    // 'threats', threatened by the unit's team (see 'threatened()'),
+    // otherwise 'true'.
+
+  bool isFoulMate(const Move& move) const;
+    // Returns 'true' if playing the given 'move' would be rejected as a Pawn
+    // or Bronze checkmate, otherwise 'false'.  The move is played on a copy
+    // of the game.
+
+  void generateDrops(const Unit&     unit,
+                     const Bitboard& threats,
+                     MoveList&       moves) const;
+    // Appends to the given 'moves' every legal drop of the given 'unit', with
+    // the given 'threats' of its team (see 'threatened()').
+
+  bool computeEvasions(bool withEscapes) const;
+    // Computes the escape routes, if the given 'withEscapes' is 'true', the
+    // pins, and the check points that the current player can reach, and
+    // returns 'true' if any of them lets the player escape check, otherwise
+    // 'false'.  The behaviour is undefined unless the current player is in
+    // check, and 'm_checkPoints' holds the check points of the units giving
+    // check.
+
+  void resolveEvasions(void) const;
+    // Computes the evasions of the current player from check, and sets
+    // checkmate if there are none, if the evasions are pending.
+
   // PRIVATE MANIPULATORS
   void reset(void);
     // Resets the logic controller, players, units, and game state.  Note that
-    // after this function is called, 'Unit' pointers previously allocated will
-    // be invalid.
+    // after this function is called, 'Unit' pointers previously obtained will
+    // refer to the units of the new game.  This does not allocate memory.
+
+  void rebase(const Logician& original);
+    // Rebinds the unit, tower, and player pointers copied from the given
+    // 'original' so that they refer to the storage of this instance, visiting
+    // every unit in the towers and in the players once.  The behaviour is
+    // undefined unless every other member has been copied from 'original'.
 
   void resetPlayer(Player& player);
     // Resets the given 'player' by clearing its units; creating new ones in
     // the process.
 
-  void captureUnit(SharedUnitPtr& ptr,
-                   Player&        from,
-                   Player&        to,
-                   bool           remove = false);
-    // Captures the unit specified by the given 'ptr', adding it to the
-    // player's, to's, army, and removing it from the player's, from's, army.
-    // If the optionally spcified 'remove' is 'true', also removes it from the
-    // board.
+  void indexTower(const Tower& tower);
+    // Adds the units in the given 'tower' to the occupancy and piece
+    // bitboards, and to the board key, and marks its square as changed for
+    // the next 'updateAttacks()', and 'updateMobileRangeExpansion()' if it
+    // holds a unit with a mobile range expansion effect.
+
+  void unindexTower(const Tower& tower);
+    // Removes the units in the given 'tower' from the occupancy and piece
+    // bitboards, and from the board key.  This must be called before a tower
+    // is changed, and 'indexTower()' after, so that units which were
+    // removed, recoloured, or shifted between tiers do not leave stale
+    // squares behind.
+
+  void captureUnit(Unit *unit, Player& from, Player& to);
+    // Captures the given 'unit', adding it to the player's, to's, army, and
+    // removing it from the player's, from's, army.  Note that this does not
+    // change the board, so a unit that is then put on or taken off the board
+    // must be activated or deactivated in the player's, to's, army.
+
+  void make(const Move& move, undo_t& undo);
+    // Applies the given 'move' to the board, the players' armies, and the
+    // bitboards, and records what is needed to revert it in the given
+    // 'undo'.  Captures, betrayals, and flips are applied as for a turn, but
+    // the game state is not changed.  The behaviour is undefined unless
+    // 'move' can be applied to the board; 'make()' does not check the rules.
+
+  void unmake(const undo_t& undo);
+    // Reverts the move recorded in the given 'undo', which must be the most
+    // recent move applied by 'make()' that has not been reverted.  The board,
+    // the armies, and the bitboards are restored exactly.
+
+  void restoreCaptured(const undo_t& undo,
+                       Tower&        tower,
+                       Player&       from,
+                       Player&       to);
+    // Returns the unit captured by the move recorded in the given 'undo' from
+    // the player's, from's, army to the player's, to's, army, and puts it
+    // back into the given 'tower' at the tier it was captured from.
 
   void updateMobileRangeExpansion(void);
-    // Recomputes and updates the tracking of the mobile range expansions areas
-    // on the board.
+    // Updates the mobile range expansion areas on the board, if a unit with a
+    // mobile range expansion effect was added to, or removed from, a tower
+    // since the last update, and the attack maps of the units that it
+    // affects.
+
+  void updateAttacks(void);
+    // Recomputes the attack maps of the units whose square changed, or whose
+    // walks cross a square that changed, since the last update.  The maps of
+    // the other units still hold, so they are left as they are.
+
+  void moveUnit(const Unit& unit,
+                const Posn& posn,
+                undo_t&     undo,
+                error_t&    error);
+    // Moves the given 'unit' to the given 'posn' as the public 'moveUnit()'
+    // does, and on success records what is needed to revert the board in the
+    // given 'undo'.
+
+  void dropUnit(const Unit& unit,
+                const Posn& posn,
+                undo_t&     undo,
+                error_t&    error);
+    // Drops the given 'unit' to the given 'posn' as the public 'dropUnit()'
+    // does, and on success records what is needed to revert the board in the
+    // given 'undo'.
+
+  void exchangeUnits(effect_t    exchange,
+                     const Unit& a,
+                     const Unit& b,
+                     undo_t&     undo,
+                     error_t&    error);
+    // Invokes the given 'exchange' between the given units, 'a' and 'b', as
+    // the public 'exchangeUnits()' does, and on success records what is
+    // needed to revert the board in the given 'undo'.
+
+  void immobileStrike(const Unit& unit,
+                      tier_t      target,
+                      undo_t&     undo,
+                      error_t&    error);
+    // Performs an immobile strike of the given 'unit' on the given 'target'
+    // tier as the public 'immobileStrike()' does, and on success records what
+    // is needed to revert the board in the given 'undo'.
+
+  void forceRecover(bool recover, undo_t& undo, error_t& error);
+    // Settles the forced recovery as the public 'forceRecover()' does for the
+    // given 'recover', and on success records what is needed to revert the
+    // board in the given 'undo'.
+
+  void playMove(const Move& move, undo_t& undo, error_t& error);
+    // Plays the given 'move' as the public 'playMove()' does, and on success
+    // records what is needed to revert the board in the given 'undo'.
 
   void updateStateAfterTurn(error_t&   error,
                             piece_id_t dropped = GUNGI_PIECE_NONE);
@@ -277,12 +622,61 @@ public:
   explicit Logician(void);
     // Default constructor.
 
+  Logician(const Logician& original);
+    // Creates a copy of the given 'original' game, including the hands, the
+    // recorded positions, and any pending forced recovery or rearrangement.
+    // The players and the recorded positions are allocated.
+
   ~Logician(void);
     // Default destructor.
 
   // ACCESSSORS
-  const std::vector<Tower>& board(void) const;
-    // Returns a pointer to the underlying 'Tower' array.
+  const board_t& board(void) const;
+    // Returns a reference to the underlying 'Tower' array.
+
+  Bitboard occupied(void) const;
+    // Returns the set of squares holding at least one unit.
+
+  Bitboard occupied(colour_t colour) const;
+    // Returns the set of squares holding at least one unit of the given
+    // 'colour' at any tier.
+
+  Bitboard occupied(colour_t colour, tier_t tier) const;
+    // Returns the set of squares holding a unit of the given 'colour' at the
+    // given 'tier'.
+
+  uint64_t key(void) const;
+    // Returns the 64-bit hash of the current position: the units on the
+    // board, the units in each player's hand, and the side to move.  Equal
+    // positions have equal keys.
+
+  Bitboard full(void) const;
+    // Returns the set of squares holding a tower of 'k_MAX_TOWER_SIZE' units.
+
+  Bitboard topped(colour_t colour) const;
+    // Returns the set of squares whose top unit is of the given 'colour'.
+
+  Bitboard pieces(colour_t colour, piece_id_t piece) const;
+    // Returns the set of squares holding a unit of the given 'colour' whose
+    // front identifier is the given 'piece'.
+
+  const Bitboard& attacks(const Unit& unit) const;
+    // Returns the set of squares attacked by the given 'unit': the squares it
+    // could walk to from the top of its tower without being blocked,
+    // regardless of the towers at those squares, and of whether the move
+    // would leave its Commander in check.  The set is empty unless the
+    // 'unit' is at the top of a tower.
+
+  Bitboard attacked(colour_t colour) const;
+    // Returns the set of squares attacked by any unit of the given 'colour'
+    // (see 'attacks()').
+
+  Bitboard pinned(colour_t colour) const;
+    // Returns the squares of the units of the given 'colour' that may expose
+    // their Commander by leaving: the unit at the top of a tower that is the
+    // only one between the Commander and an enemy unit reaching it, or that
+    // covers an enemy unit reaching it.  A unit that can jump is only stopped
+    // by units in the mobile range expansion of the Commander's team.
 
   int winner(void) const;
     // Returns 'BLACK' if black won, 'WHITE' if white won, '-1' if the game is
@@ -315,6 +709,14 @@ public:
     // Returns a constant pointer to the Unit at the given 'tier' in the tower
     // on the board at the given 'posn'.  Note that this may be 'NULL'.
 
+  const Unit *unit(unit_handle_t handle) const;
+    // Returns a constant pointer to the unit with the given 'handle', or
+    // 'NULL' if the handle is 'UnitArena::k_NULL_HANDLE'.
+
+  unit_handle_t handle(const Unit& unit) const;
+    // Returns the handle of the given 'unit'.  The behaviour is undefined
+    // unless the 'unit' belongs to this game.
+
   bool isDraw(void) const;
     // Returns 'true' if the game ended in a draw, otherwise 'false'.  Note
     // that this value is meaningless unless the game has ended.
@@ -361,6 +763,10 @@ public:
     // This is shorthand for 'isPlayersTurn(player) && isInCheckmate()'.  Note
     // that a player can only be in checkmate on their own turn.
 
+  bool isLazyCheckmate(void) const;
+    // Returns 'true' if checkmate is decided on demand, otherwise 'false'
+    // (see 'setLazyCheckmate()').
+
   bool isInverted(const colour_t& colour) const;
     // Returns 'true' if the player specified by the given 'colour' has their
     // movements inverted, otherwise 'false'.
@@ -446,10 +852,12 @@ public:
     // 'GUNGI_ERROR_INVALID_UNIT' if the given 'unit' is in a player's hand,
     // 'GUNGI_ERROR_CHECK' if the move would not move the current player out of
     // check, 'GUNGI_ERROR_FULL_TOWER' if the target tower is full, and the top
-    // unit cannot be usurped, 'GUNGI_ERROR_BRONZE_FILE' if the given 'unit' is
-    // a bronze unit and moving it would move it into a file with another
-    // bronze of the same team, 'GUNGI_ERROR_NO_WALK' if there is no path for
-    // the given 'unit' to reach the given 'target' position,
+    // unit cannot be usurped, 'GUNGI_ERROR_DUPLICATE' if the target tower
+    // already contains a unit of the same team and front identifier as the
+    // given 'unit', 'GUNGI_ERROR_BRONZE_FILE' if the given 'unit' is a bronze
+    // unit and moving it would move it into a file with another bronze of the
+    // same team, 'GUNGI_ERROR_NO_WALK' if there is no path for the given
+    // 'unit' to reach the given 'target' position,
     // 'GUNGI_ERROR_DROPS_ONLY' if it is initial arrangement, or
     // 'GUNGI_ERROR_INVALID_STATE' if moves cannot be performed at this time.
 
@@ -482,16 +890,30 @@ public:
     // to the exchange, 'GUNGI_ERROR_INVALID_EXCHANGE' if the effect is a
     // 'GUNGI_EFFECT_1_3_TIER_EXCHANGE' and it is invalid,
     // 'GUNGI_ERROR_INVALID_SUB' if the effect is a 'GUNGI_EFFECT_SUBSTITUTION'
-    // and it is invalid, 'GUNGI_ERROR_CHECK' if the effect is a
-    // 'GUNGI_EFFECT_SUBSTITUTION' and the unit's team's Commander is in check,
-    // 'GUNGI_ERROR_DROPS_ONLY' if it is still initial arrangement, or
-    // 'GUNGI_ERROR_INVALID_STATE' if exchanges cannot be performed at this
-    // time.
+    // and it is invalid, 'GUNGI_ERROR_CHECK' if the unit's team's Commander
+    // is in check, or a 'GUNGI_EFFECT_1_3_TIER_EXCHANGE' in its tower would
+    // put it in check, 'GUNGI_ERROR_DROPS_ONLY' if it is still initial
+    // arrangement, or 'GUNGI_ERROR_INVALID_STATE' if exchanges cannot be
+    // performed at this time.
+
+  void generateMoves(MoveList& moves) const;
+    // Replaces the contents of the given 'moves' with every legal move for
+    // the player whose turn it is: drops, moves (including captures),
+    // immobile strikes, exchanges, and the choice of a pending forced
+    // recovery.  Units in hand with the same front and back are
+    // interchangeable, so the drops of only one of them are listed.  Each
+    // move is one that 'playMove()' accepts.
 
   // MANIPULATAORS
   void newGame(void);
     // Sets up a new game.  'BLACK' goes first.
 
+  void setLazyCheckmate(bool lazy);
+    // Sets whether checkmate is decided on demand, rather than after every
+    // turn, to the given 'lazy'.  Only whether the current player is in check
+    // is then found after a turn; the evasions are computed by the first
+    // query that needs them.  The mode is kept by 'newGame()' and copies.
+
   void moveUnit(const Posn& from, tier_t tier, const Posn& to, error_t& error);
     // Moves the unit at the given 'tier' in the Tower at the given 'Posn',
     // 'from', to the given 'Posn', 'to'.  Returns an error status code of
@@ -570,7 +992,35 @@ public:
     // otherwise does not.  Returns 'GUNGI_ERROR_NONE' on success, otherwise
     // 'GUNGI_ERROR_INVALID_STATE' if there is no active forced recovery.
 
+  void playMove(const Move& move, error_t& error);
+    // Plays the given 'move' for the player whose turn it is.  Returns
+    // 'GUNGI_ERROR_NONE' to the given output parameter, 'error', on success,
+    // 'GUNGI_ERROR_INVALID_UNIT' if the 'move' does not refer to a unit of
+    // this game, 'GUNGI_ERROR_OUT_OF_RANGE' if an immobile strike targets a
+    // unit outside the striking unit's tower, otherwise the same error codes
+    // as the function that performs that type of move.
+
+  void makeMove(const Move& move, turn_t& turn, error_t& error);
+    // Plays the given 'move' as 'playMove()' does, and records in the given
+    // 'turn' what is needed to take it back with 'unmakeMove()'.  Returns the
+    // same error codes as 'playMove()' to the given 'error'; the game is
+    // unchanged unless it is 'GUNGI_ERROR_NONE'.  This lets a search walk the
+    // tree of moves in one game rather than in a copy per position.
+
+  void unmakeMove(const turn_t& turn);
+    // Takes back the move recorded in the given 'turn', which must be the most
+    // recent move made by 'makeMove()' that has not been taken back.  The
+    // board, the armies, the recorded positions, and the game state are
+    // restored.
+
   // OPERATORS
+  Logician& operator=(const Logician& rhs);
+    // Replaces the state of this game with a copy of the given 'rhs' game,
+    // and returns a reference to this game.  Pointers to units previously
+    // obtained from this game will refer to the units of the copied game.
+    // The storage of this game is reused, so this only allocates if the
+    // recorded positions of 'rhs' outgrow those of this game.
+
   friend std::ostream& operator<<(std::ostream& os, const Logician& logician);
     // Writes the underlying board of the given 'logician' out to the given
     // output stream, 'os'.  This will result in writing out the 9x9 grid with
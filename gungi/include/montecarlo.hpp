@@ -0,0 +1,255 @@
+// montecarlo.hpp                                                     -*-C++-*-
+#pragma once
+//@DESCRIPTION:
+//  This component provides a Monte Carlo tree search of a game: the tree of
+//  moves is grown one position at a time towards the moves that have won the
+//  most random games, or playouts, played from them.  Below the tree, a
+//  playout picks each move at random among those of
+//  'Logician::generateMoves()', so it plays by the same rules as the game,
+//  with no knowledge of Gungi beyond them.
+//
+//  A move in the tree is chosen by the UCT rule: the move with the highest
+//  sum of its share of wins and of a bonus that grows with the visits of its
+//  position and shrinks with its own visits, so that every move is tried and
+//  the promising ones are tried most.  The moves of a position are shuffled
+//  as it is added to the tree, so that the moves tried first are not always
+//  those generated first.  A playout that does not end within
+//  'k_MAX_PLAYOUT_PLIES' is won by the player ahead in
+//  'Engine::evaluate()'.
+//
+//  A search may run on several threads, which share one tree.  A thread that
+//  walks down the tree adds a virtual loss to each move on its way, taken
+//  back once its playout is counted, so that the other threads see the move
+//  as worse meanwhile and walk down other moves.  The statistics of a
+//  position are atomic counters, and a position is added to the tree by the
+//  one thread that claims it, so the threads take no lock.  The tree is
+//  stored in a pool of positions allocated once; once it is full, playouts
+//  go on from the leaves of the tree without growing it.
+//
+//@CLASSES:
+//  'gungi::MonteCarlo': Monte Carlo tree search.
+#include "logician.hpp"
+#include "move.hpp"
+#include "threadpool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace gungi {
+
+class MonteCarlo {
+  // Monte Carlo tree search for the best move in a game.  A 'MonteCarlo'
+  // keeps its tree and buffers between calls, so searching again does not
+  // allocate.  A 'MonteCarlo' runs one search at a time.
+
+public:
+  // STRUCTURES
+  typedef struct limits_t {
+    // Maximum number of playouts, over every thread, or zero for no limit.
+    uint64_t      playouts;
+
+    // Maximum time to search for, in milliseconds, or zero for no limit.
+    unsigned int  milliseconds;
+  } limits_t;
+
+  typedef struct stats_t {
+    // Move from the position searched.
+    Move      move;
+
+    // Number of playouts through the move.
+    uint32_t  visits;
+
+    // Share of those playouts won by the player making the move, with a
+    // draw counting as half a win.
+    double    winRate;
+  } stats_t;
+
+  // STATIC CLASS MEMBERS
+  static const unsigned int k_MAX_PLAYOUT_PLIES = 64;
+    // Maximum number of moves of a playout below the tree.  Random games
+    // seldom end in checkmate, so a longer playout costs more moves for
+    // little more than the noise of its random moves.
+
+  static const unsigned int k_MAX_TREE_DEPTH = 64;
+    // Maximum number of moves walked down the tree before a playout, so that
+    // the moves a worker takes back fit in what it set aside for them.
+
+  static const unsigned int k_DEFAULT_NODES = 1 << 20;
+    // Default number of positions held by the tree.
+
+private:
+  // ENUMERATIONS
+  typedef enum node_state_t {
+    // Enumeration for how far the moves of a position are in the tree.
+    NODE_LEAF,
+    NODE_EXPANDING,
+    NODE_EXPANDED,
+  } node_state_t;
+
+  // STRUCTURES
+  typedef struct node_t {
+    // Number of playouts counted through the position.
+    std::atomic<uint32_t>  visits;
+
+    // Number of threads walking through the position, times
+    // 'k_VIRTUAL_LOSS'; they count as lost playouts until they are counted.
+    std::atomic<uint32_t>  virtualLoss;
+
+    // Playouts won by the player whose move led to the position, counting a
+    // win as two and a draw as one.
+    std::atomic<uint64_t>  wins;
+
+    // Move leading to the position from its parent.
+    Move                   move;
+
+    // Colour of the player making 'move'.
+    uint8_t                colour;
+
+    // Whether the moves of the position are in the tree ('node_state_t').
+    std::atomic<uint8_t>   state;
+
+    // Number of moves of the position.
+    uint16_t               numChildren;
+
+    // Index of the position after the first move; the positions after the
+    // other moves follow it.
+    uint32_t               firstChild;
+  } node_t;
+
+  typedef struct worker_t {
+    // Copy of the game being searched by the worker.
+    Logician                       game;
+
+    // Moves made from the root of the search, to be taken back.
+    std::vector<Logician::turn_t>  turns;
+
+    // Indices of the positions of the tree walked through.
+    std::vector<uint32_t>          path;
+
+    // Moves of the position of the playout.
+    MoveList                       moves;
+
+    // State of the random number generator of the worker.
+    uint64_t                       random;
+
+    // Number of playouts counted by the worker, read by the other workers.
+    std::atomic<uint64_t>          playouts;
+  } worker_t;
+
+  // INSTANCE MEMBERS
+  std::unique_ptr<node_t[]>                m_nodes;
+                                            // Pool of positions of the
+                                            // tree; the first is the root.
+
+  uint32_t                                 m_capacity;
+                                            // Number of positions in the
+                                            // pool.
+
+  std::atomic<uint32_t>                    m_size;
+                                            // Number of positions of the
+                                            // pool in use.
+
+  std::vector<std::unique_ptr<worker_t> >  m_workers;
+                                            // State of each search thread.
+
+  std::unique_ptr<ThreadPool>              m_pool;
+                                            // Threads running the workers,
+                                            // if there is more than one.
+
+  limits_t                                 m_limits;
+                                            // Limits of the current search.
+
+  std::chrono::steady_clock::time_point    m_start;
+                                            // Time the current search
+                                            // started.
+
+  std::atomic<uint64_t>                    m_started;
+                                            // Number of playouts started by
+                                            // the current search.
+
+  std::atomic<bool>                        m_stopped;
+                                            // 'true' if the current search
+                                            // hit a limit.
+
+private:
+  // PRIVATE MANIPULATORS
+  void run(worker_t& worker);
+    // Runs playouts with the given 'worker' until the search is stopped.
+
+  void playout(worker_t& worker);
+    // Walks the given 'worker' down the tree from the root, adds the moves of
+    // the position reached to the tree, plays a random game from it, and
+    // counts the result in every position walked through.
+
+  bool expand(worker_t& worker, node_t& node);
+    // Adds the moves of the game of the given 'worker' to the tree as the
+    // children of the given 'node', in random order.  Returns 'true' on
+    // success, otherwise 'false' if another thread is adding them, or the
+    // pool is full.
+
+  int simulate(worker_t& worker);
+    // Plays random moves in the game of the given 'worker' until it ends, or
+    // 'k_MAX_PLAYOUT_PLIES' are played, and returns the winner, either
+    // 'BLACK' or 'WHITE', otherwise '-1' for a draw.
+
+  uint64_t nextRandom(worker_t& worker);
+    // Returns the next number of the random number generator of the given
+    // 'worker'.
+
+  bool isStopped(void);
+    // Returns 'true' if the search was stopped, otherwise checks the playout
+    // and time limits, and returns 'true' if one was reached, otherwise
+    // 'false'.
+
+  // PRIVATE ACCESSORS
+  uint32_t select(const node_t& node) const;
+    // Returns the index of the child of the given 'node' to walk to, by the
+    // UCT rule.
+
+  // PRIVATE CREATORS
+  MonteCarlo(const MonteCarlo&);
+    // Not implemented.
+
+  MonteCarlo& operator=(const MonteCarlo&);
+    // Not implemented.
+
+public:
+  // CREATORS
+  explicit MonteCarlo(unsigned int numThreads = 1,
+                      unsigned int maxNodes = k_DEFAULT_NODES,
+                      uint64_t     seed = 0);
+    // Creates a search on the given 'numThreads' threads, with a tree of at
+    // most the given 'maxNodes' positions, and random number generators
+    // started from the given 'seed'.  If 'numThreads' is zero, searches on
+    // one thread per hardware thread.  The behaviour is undefined unless
+    // '0 < maxNodes'.
+
+  // MANIPULATORS
+  Move search(const Logician& game, const limits_t& limits);
+    // Searches the given 'game' for the best move of the player whose turn it
+    // is, within the given 'limits', and returns the move played through
+    // most.  Returns a move of type 'Move::MOVE_TYPE_NONE' if the game is
+    // over or there is no legal move.  The 'game' is copied once per thread;
+    // it is not changed.  The behaviour is undefined unless 'limits' has a
+    // limit.
+
+  // ACCESSORS
+  void analysis(std::vector<stats_t>& stats) const;
+    // Loads into the given output parameter, 'stats', the statistics of the
+    // moves of the position of the last search, the move played through most
+    // first.
+
+  uint64_t playouts(void) const;
+    // Returns the number of playouts of the last search, over every thread.
+
+  uint32_t size(void) const;
+    // Returns the number of positions in the tree of the last search.
+
+  unsigned int numThreads(void) const;
+    // Returns the number of threads that the search runs on.
+};
+
+}  // close 'gungi' namespace
@@ -0,0 +1,379 @@
+// move.hpp                                                           -*-C++-*-
+#pragma once
+//@DESCRIPTION:
+//  This component provides a compact description of a single turn in a game:
+//  a drop, a move (which may capture), an immobile strike, an exchange, or the
+//  choice made for a forced recovery.  Units are referred to by their handle
+//  in the game's 'UnitArena' rather than by pointer, so a 'Move' is four
+//  bytes, and remains meaningful in a copy of the game it was created for.
+//
+//  A 'MoveList' is a fixed-capacity list of moves that lives on the stack, so
+//  that listing the moves in a position does not allocate.
+//
+//@CLASSES:
+//  'gungi::Move': value-semantic description of a single turn.
+//  'gungi::MoveList': fixed-capacity list of moves.
+#include "gtypes.hpp"
+#include "posn.hpp"
+#include "unitarena.hpp"
+
+#include <cstdint>
+#include <iostream>
+
+namespace gungi {
+
+                                  // ==========
+                                  // class Move
+                                  // ==========
+
+class Move {
+  // A 'gungi::Move' describes a single turn.  Every move has a moving 'unit';
+  // drops and moves also have a destination square, while immobile strikes
+  // and exchanges have a 'target' unit.
+
+public:
+  // ENUMERATIONS
+  typedef enum move_type_t {
+    // Enumeration for the kinds of turn.
+    MOVE_TYPE_NONE,
+    MOVE_TYPE_DROP,
+    MOVE_TYPE_MOVE,
+    MOVE_TYPE_IMMOBILE_STRIKE,
+    MOVE_TYPE_TIER_EXCHANGE,
+    MOVE_TYPE_SUBSTITUTION,
+    MOVE_TYPE_FORCED_RECOVERY,
+  } move_type_t;
+
+private:
+  // INSTANCE MEMBERS
+  uint8_t        m_type;
+                  // Kind of turn, a 'move_type_t'.
+
+  unit_handle_t  m_unit;
+                  // Handle of the unit making the turn.
+
+  unit_handle_t  m_target;
+                  // Handle of the unit struck or exchanged with, otherwise
+                  // 'UnitArena::k_NULL_HANDLE'.
+
+  uint8_t        m_square;
+                  // Index of the destination square for a drop or a move,
+                  // or whether the unit is recovered for a forced recovery.
+
+private:
+  // PRIVATE CREATORS
+  Move(move_type_t   type,
+       unit_handle_t unit,
+       unit_handle_t target,
+       unsigned int  square);
+    // Creates a move with the given members.
+
+public:
+  // STATIC CLASS METHODS
+  static Move drop(unit_handle_t unit, const Posn& to);
+    // Returns a move that drops the given 'unit' from its player's hand onto
+    // the tower at the given 'to' position.
+
+  static Move move(unit_handle_t unit, const Posn& to);
+    // Returns a move that moves the given 'unit' to the tower at the given
+    // 'to' position, capturing the top of that tower if it is an enemy.
+
+  static Move immobileStrike(unit_handle_t unit, unit_handle_t target);
+    // Returns a move in which the given 'unit' strikes the given 'target' in
+    // its own tower.
+
+  static Move exchange(effect_t      exchange,
+                       unit_handle_t unit,
+                       unit_handle_t target);
+    // Returns a move in which the given 'unit' invokes the given 'exchange'
+    // effect ('GUNGI_EFFECT_SUBSTITUTION' or
+    // 'GUNGI_EFFECT_1_3_TIER_EXCHANGE') with the given 'target'.
+
+  static Move forcedRecovery(unit_handle_t unit, bool recover);
+    // Returns a move that settles the forced recovery of the given 'unit',
+    // recovering it to its player's hand if 'recover' is 'true', otherwise
+    // leaving it on the board.
+
+  static Move decode(uint32_t code);
+    // Returns the move encoded as the given 'code' by 'encode()'.
+
+public:
+  // CREATORS
+  Move(void);
+    // Creates a move of type 'MOVE_TYPE_NONE'.
+
+  // ACCESSORS
+  move_type_t type(void) const;
+    // Returns the kind of this move.
+
+  unit_handle_t unit(void) const;
+    // Returns the handle of the unit making this move.
+
+  unit_handle_t target(void) const;
+    // Returns the handle of the unit struck or exchanged with, otherwise
+    // 'UnitArena::k_NULL_HANDLE'.
+
+  unsigned int square(void) const;
+    // Returns the index of the destination square of a drop or a move.
+
+  Posn to(void) const;
+    // Returns the destination position of a drop or a move.
+
+  bool recover(void) const;
+    // Returns 'true' if this forced recovery recovers its unit, otherwise
+    // 'false'.
+
+  uint32_t encode(void) const;
+    // Returns this move packed into a single word, from which 'decode()'
+    // restores it.
+
+  // OPERATORS
+  bool operator==(const Move& other) const;
+    // Returns 'true' if this move and the given 'other' move are the same,
+    // otherwise 'false'.
+
+  bool operator!=(const Move& other) const;
+    // Returns 'true' if this move and the given 'other' move differ,
+    // otherwise 'false'.
+
+  friend std::ostream& operator<<(std::ostream& os, const Move& move);
+    // Writes the given 'move' out to the given output stream, 'os', and
+    // returns the modified stream.
+};
+
+                                // ==============
+                                // class MoveList
+                                // ==============
+
+class MoveList {
+  // A fixed-capacity list of moves.  The capacity bounds the number of moves
+  // available in any position, so a list can hold every move for a turn.
+
+public:
+  // STATIC CLASS MEMBERS
+  static const unsigned int k_CAPACITY = 2048;
+    // Maximum number of moves held by a list.
+
+private:
+  // INSTANCE MEMBERS
+  Move          m_moves[k_CAPACITY];
+                 // Storage for the moves.
+
+  unsigned int  m_size;
+                 // Number of moves in the list.
+
+public:
+  // CREATORS
+  MoveList(void);
+    // Creates an empty list.
+
+  // MANIPULATORS
+  void add(const Move& move);
+    // Appends the given 'move' to this list.  Raises an assertion if the list
+    // is full.
+
+  void clear(void);
+    // Removes every move from this list.
+
+  void swap(unsigned int i, unsigned int j);
+    // Exchanges the moves at the given indices, 'i' and 'j'.  The behaviour
+    // is undefined unless 'i < size()' and 'j < size()'.
+
+  // ACCESSORS
+  unsigned int size(void) const;
+    // Returns the number of moves in this list.
+
+  bool empty(void) const;
+    // Returns 'true' if this list has no moves, otherwise 'false'.
+
+  const Move *begin(void) const;
+    // Returns a pointer to the first move in this list.
+
+  const Move *end(void) const;
+    // Returns a pointer one past the last move in this list.
+
+  bool contains(const Move& move) const;
+    // Returns 'true' if the given 'move' is in this list, otherwise 'false'.
+
+  // OPERATORS
+  const Move& operator[](unsigned int idx) const;
+    // Returns the move at the given index, 'idx'.  The behaviour is undefined
+    // unless 'idx < size()'.
+};
+
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+// PRIVATE CREATORS
+inline Move::Move(move_type_t   type,
+                  unit_handle_t unit,
+                  unit_handle_t target,
+                  unsigned int  square)
+: m_type(type)
+, m_unit(unit)
+, m_target(target)
+, m_square(static_cast<uint8_t>(square))
+{
+  // DO NOTHING
+}
+
+                                  // ----------
+                                  // class Move
+                                  // ----------
+
+// STATIC CLASS METHODS
+inline Move Move::drop(unit_handle_t unit, const Posn& to) {
+  return Move(MOVE_TYPE_DROP, unit, UnitArena::k_NULL_HANDLE, to.index());
+}
+
+inline Move Move::move(unit_handle_t unit, const Posn& to) {
+  return Move(MOVE_TYPE_MOVE, unit, UnitArena::k_NULL_HANDLE, to.index());
+}
+
+inline Move Move::immobileStrike(unit_handle_t unit, unit_handle_t target) {
+  return Move(MOVE_TYPE_IMMOBILE_STRIKE, unit, target, 0);
+}
+
+inline Move Move::exchange(effect_t      exchange,
+                           unit_handle_t unit,
+                           unit_handle_t target) {
+  GASSERT(exchange == GUNGI_EFFECT_SUBSTITUTION ||
+          exchange == GUNGI_EFFECT_1_3_TIER_EXCHANGE);
+  return Move(exchange == GUNGI_EFFECT_SUBSTITUTION
+                ? MOVE_TYPE_SUBSTITUTION
+                : MOVE_TYPE_TIER_EXCHANGE,
+              unit,
+              target,
+              0);
+}
+
+inline Move Move::forcedRecovery(unit_handle_t unit, bool recover) {
+  return Move(MOVE_TYPE_FORCED_RECOVERY,
+              unit,
+              UnitArena::k_NULL_HANDLE,
+              recover ? 1 : 0);
+}
+
+inline Move Move::decode(uint32_t code) {
+  return Move(static_cast<move_type_t>(code & 0xff),
+              static_cast<unit_handle_t>(code >> 8),
+              static_cast<unit_handle_t>(code >> 16),
+              code >> 24);
+}
+
+// CREATORS
+inline Move::Move(void)
+: m_type(MOVE_TYPE_NONE)
+, m_unit(UnitArena::k_NULL_HANDLE)
+, m_target(UnitArena::k_NULL_HANDLE)
+, m_square(0)
+{
+  // DO NOTHING
+}
+
+// ACCESSORS
+inline Move::move_type_t Move::type(void) const {
+  return static_cast<move_type_t>(m_type);
+}
+
+inline unit_handle_t Move::unit(void) const {
+  return m_unit;
+}
+
+inline unit_handle_t Move::target(void) const {
+  return m_target;
+}
+
+inline unsigned int Move::square(void) const {
+  return m_square;
+}
+
+inline Posn Move::to(void) const {
+  return Posn(m_square % k_BOARD_LENGTH, m_square / k_BOARD_LENGTH);
+}
+
+inline bool Move::recover(void) const {
+  return m_square != 0;
+}
+
+inline uint32_t Move::encode(void) const {
+  return static_cast<uint32_t>(m_type) |
+         static_cast<uint32_t>(m_unit) << 8 |
+         static_cast<uint32_t>(m_target) << 16 |
+         static_cast<uint32_t>(m_square) << 24;
+}
+
+// OPERATORS
+inline bool Move::operator==(const Move& other) const {
+  return m_type == other.m_type &&
+         m_unit == other.m_unit &&
+         m_target == other.m_target &&
+         m_square == other.m_square;
+}
+
+inline bool Move::operator!=(const Move& other) const {
+  return !(*this == other);
+}
+
+                                // --------------
+                                // class MoveList
+                                // --------------
+
+// CREATORS
+inline MoveList::MoveList(void)
+: m_size(0)
+{
+  // DO NOTHING
+}
+
+// MANIPULATORS
+inline void MoveList::add(const Move& move) {
+  GASSERT(m_size < k_CAPACITY);
+  m_moves[m_size++] = move;
+}
+
+inline void MoveList::clear(void) {
+  m_size = 0;
+}
+
+inline void MoveList::swap(unsigned int i, unsigned int j) {
+  GASSERT(i < m_size && j < m_size);
+  const Move move = m_moves[i];
+  m_moves[i] = m_moves[j];
+  m_moves[j] = move;
+}
+
+// ACCESSORS
+inline unsigned int MoveList::size(void) const {
+  return m_size;
+}
+
+inline bool MoveList::empty(void) const {
+  return m_size == 0;
+}
+
+inline const Move *MoveList::begin(void) const {
+  return m_moves;
+}
+
+inline const Move *MoveList::end(void) const {
+  return m_moves + m_size;
+}
+
+inline bool MoveList::contains(const Move& move) const {
+  for (const Move& other : *this) {
+    if (other == move) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// OPERATORS
+inline const Move& MoveList::operator[](unsigned int idx) const {
+  return m_moves[idx];
+}
+
+}  // close 'gungi' namespace
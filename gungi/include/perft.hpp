@@ -0,0 +1,67 @@
+// perft.hpp                                                          -*-C++-*-
+#pragma once
+//@DESCRIPTION:
+//  This component provides performance testing ("perft") of the move
+//  generator: counting the leaf nodes of the tree of legal moves to a fixed
+//  depth.  Node counts pin down the rules, as any change to move generation
+//  or validation that alters the set of legal moves in some position changes
+//  the count of a deep enough tree; the time taken to count them measures the
+//  throughput of move generation.
+//
+//  A "divide" breaks the count down by the moves of the root position, which
+//  narrows a mismatch in counts down to the moves that cause it.  The subtrees
+//  below the root moves are counted in parallel on a 'ThreadPool'.
+//
+//  The tree is walked on a single game per task, making each move and taking
+//  it back with 'Logician::makeMove()' and 'Logician::unmakeMove()', so a
+//  game is only copied once per task.
+//
+//@CLASSES:
+//  'gungi::Perft': namespace for the node counting functions.
+#include "logician.hpp"
+#include "move.hpp"
+#include "threadpool.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace gungi {
+
+class Perft {
+  // Namespace for the node counting functions.
+
+  // PRIVATE CLASS METHODS
+  static uint64_t walk(Logician& game, unsigned int depth);
+    // Returns the number of leaf nodes of the tree of legal moves of the given
+    // 'game' with the given 'depth'.  Every move is taken back before this
+    // returns, so the 'game' is left in the position it was given in.
+
+public:
+  // STRUCTURES
+  typedef struct divide_t {
+    // Move made from the root position.
+    Move      move;
+
+    // Number of leaf nodes below the move.
+    uint64_t  nodes;
+  } divide_t;
+
+public:
+  // STATIC CLASS METHODS
+  static uint64_t count(const Logician& game, unsigned int depth);
+    // Returns the number of leaf nodes of the tree of legal moves of the given
+    // 'game' with the given 'depth'.  A tree of depth zero has one node, the
+    // position itself.
+
+  static uint64_t divide(const Logician&        game,
+                         unsigned int           depth,
+                         ThreadPool&            pool,
+                         std::vector<divide_t>& counts);
+    // Returns the number of leaf nodes of the tree of legal moves of the given
+    // 'game' with the given 'depth', and loads into the given output
+    // parameter, 'counts', the number of leaf nodes below each legal move of
+    // the 'game', in the order they were generated.  The subtrees are counted
+    // on the given 'pool'.  The behaviour is undefined unless 'depth > 0'.
+};
+
+}  // close 'gungi' namespace
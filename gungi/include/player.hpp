@@ -2,7 +2,22 @@
 #pragma once
 //@DESCRIPTION:
 //  This component defines the player class.  A player is represented uniquely
-//  by their colour.
+//  by their colour.  A player does not own its units.
+//
+//  A player keeps its units partitioned into the units on the board (active)
+//  and the units in hand (inactive).  The player cannot see a unit being put
+//  on or taken off the board, so whoever does so must tell the player, with
+//  'activate()' and 'deactivate()'; the partitions are then read without
+//  copying or allocating.  Each unit records its index in the lists of the
+//  player holding it, so it is moved between them, or removed, in constant
+//  time by putting the last unit of a list in its place; the lists are
+//  therefore not kept in any order.
+//
+//  The hand is also kept as a table indexed by the kinds of units in the
+//  starting hand, where a kind is a front and a back, either face up or
+//  flipped.  Units of the same kind are interchangeable in hand, so the
+//  number of units of a kind, and one unit to drop, are found without
+//  looking at the rest of the hand.
 //
 //@CLASSES:
 //  'gungi::Player': class representing a player.
@@ -18,19 +33,66 @@ class Player {
   // people facing off in a game of Gungi, and is defined uniquely by their
   // colour.
 
+public:
+  // STATIC CLASS MEMBERS
+  static const unsigned int k_MAX_UNITS = 2 * k_START_PIECE_COUNT;
+    // Maximum number of units a player can hold; every unit in the game.
+
+  static const unsigned int k_NUM_HAND_KINDS =
+    2 * sizeof(k_START_HAND) / sizeof(k_START_HAND[0]);
+    // Number of kinds of units in hand: each front and back of the starting
+    // hand, face up or flipped.
+
+  static const unsigned int k_MAX_KIND_COUNT = 14;
+    // Maximum number of units of one kind a player can hold; both players'
+    // Pawns with a Bronze back.
+
 private:
   // INSTANCE MEMBERS
   colour_t                  m_colour;
                              // Colour of this player.
 
-  SharedUnitPtr             m_commander;
-                             // Constant ointer to the player's commander.
+  Unit                     *m_commander;
+                             // Pointer to the player's commander.
 
-  SharedUnitPtrVector       m_units;
+  UnitPtrVector             m_units;
                              // Units belonging to this player.  These may be
-                             // in the player's hand or on the board.
+                             // in the player's hand or on the board.  The
+                             // capacity is reserved up front, so adding units
+                             // never allocates.
+
+  UnitPtrVector             m_active;
+                             // Units in 'm_units' that are on the board.
+
+  UnitPtrVector             m_inactive;
+                             // Units in 'm_units' that are in the player's
+                             // hand.
+
+  Unit                     *m_hand[k_NUM_HAND_KINDS][k_MAX_KIND_COUNT];
+                             // Units in 'm_inactive' by kind.  Only the first
+                             // 'm_handCounts[kind]' entries of a kind are set.
+
+  unsigned int              m_handCounts[k_NUM_HAND_KINDS];
+                             // Number of units of each kind in the player's
+                             // hand.
+
+  // PRIVATE MANIPULATORS
+  void addToHand(Unit *unit);
+    // Adds the given 'unit', which is in the player's hand, to the units of
+    // its kind.
+
+  void removeFromHand(Unit *unit);
+    // Removes the given 'unit', which is in the player's hand, from the units
+    // of its kind.
 
 public:
+  // CLASS METHODS
+  static unsigned int handKind(piece_id_t front, piece_id_t back);
+    // Returns the kind of a unit in hand with the given 'front' and 'back',
+    // which is less than 'k_NUM_HAND_KINDS', or 'k_NUM_HAND_KINDS' if no unit
+    // of the starting hand has them, face up or flipped.
+
+
   // CREATORS
   Player(colour_t colour);
     // Default constructor.  Creates an instance of a player with the given
@@ -44,13 +106,8 @@ public:
     // Resets the player instance: clears its units vector.
 
   void addUnit(Unit *unit, error_t& error);
-    // Adds the given 'unit' to this player's unit vector.  Returns
-    // 'GUNGI_ERROR_NONE' to the given output parameter, 'error', on success,
-    // otherwise 'GUNGI_ERROR_DUPLICATE' if the given 'unit' is already in the
-    // the underlying vector.
-
-  void addUnit(SharedUnitPtr& unit, error_t& error);
-    // Adds the given 'unit' to this player's unit vector.  Returns
+    // Adds the given 'unit' to this player's unit vector, and to the active
+    // or inactive units according to whether it is on the board.  Returns
     // 'GUNGI_ERROR_NONE' to the given output parameter, 'error', on success,
     // otherwise 'GUNGI_ERROR_DUPLICATE' if the given 'unit' is already in the
     // the underlying vector.
@@ -61,23 +118,48 @@ public:
     // otherwise 'GUNGI_ERROR_NOT_A_MEMBER' if the given 'unit' is not a unit
     // belonging to this player.
 
+  void activate(Unit *unit, error_t& error);
+    // Moves the given 'unit', which has just been put on the board, from this
+    // player's inactive units to their active units.  Returns
+    // 'GUNGI_ERROR_NONE' to the given output parameter, 'error', on success,
+    // otherwise 'GUNGI_ERROR_NOT_A_MEMBER' if the given 'unit' is not an
+    // inactive unit of this player.
+
+  void deactivate(Unit *unit, error_t& error);
+    // Moves the given 'unit', which has just been taken off the board, from
+    // this player's active units to their inactive units.  Returns
+    // 'GUNGI_ERROR_NONE' to the given output parameter, 'error', on success,
+    // otherwise 'GUNGI_ERROR_NOT_A_MEMBER' if the given 'unit' is not an
+    // active unit of this player.
+
   // ACCESSORS
-  const SharedUnitPtr& commander(void) const;
-    // Returns a constant pointer to the player's commander.
+  const Unit *commander(void) const;
+    // Returns a constant pointer to the player's commander, or 'NULL' if the
+    // player does not have one.
 
   const colour_t& colour(void) const;
     // Returns this player's colour.
 
-  SharedUnitPtrVector activeUnits(void) const;
-    // Returns a vector of the player's active units.
+  const UnitPtrVector& activeUnits(void) const;
+    // Returns a vector of the player's active units, the units on the board.
+
+  const UnitPtrVector& inactiveUnits(void) const;
+    // Returns a vector of the player's inactive units, the units in hand.
+
+  unsigned int handCount(unsigned int kind) const;
+    // Returns the number of units of the given 'kind' in the player's hand,
+    // which is 0 if 'kind' is 'k_NUM_HAND_KINDS'.
 
-  SharedUnitPtrVector inactiveUnits(void) const;
-    // Returns a vector of the player's inactive units.
+  const Unit *handUnit(unsigned int kind) const;
+    // Returns a constant pointer to a unit of the given 'kind' in the
+    // player's hand, or 'NULL' if the player holds none.  It is the unit of
+    // that kind that most recently entered the hand, unless another unit of
+    // that kind has left the hand since.
 
-  SharedUnitPtrVector& units(void);
+  UnitPtrVector& units(void);
     // Returns a vector of the units belonging to this player.
 
-  const SharedUnitPtrVector& units(void) const;
+  const UnitPtrVector& units(void) const;
     // Returns a vector of the units belonging to this player.
 };
 
@@ -0,0 +1,134 @@
+// threadpool.hpp                                                     -*-C++-*-
+#pragma once
+//@DESCRIPTION:
+//  This component provides a fixed-size pool of worker threads that run a
+//  batch of indexed tasks.  Each worker owns a queue of task indices; the
+//  tasks of a batch are dealt out to the queues in turn, a worker takes tasks
+//  from the front of its own queue, and a worker whose queue is empty steals
+//  from the back of the queues of the other workers.  Work stealing keeps
+//  every worker busy when the tasks of a batch vary widely in cost, such as
+//  the subtrees below the moves of a position.
+//
+//@CLASSES:
+//  'gungi::ThreadPool': work-stealing pool of worker threads.
+//
+//@EXAMPLE:
+//  ```
+//  ThreadPool pool(4);
+//  std::vector<uint64_t> results(tasks.size());
+//  pool.run(tasks.size(), [&](unsigned int idx) {
+//    results[idx] = solve(tasks[idx]);
+//  });
+//  ```
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gungi {
+
+class ThreadPool {
+  // Work-stealing pool of worker threads.
+
+public:
+  // TYPE DEFINITIONS
+  typedef std::function<void(unsigned int)> task_t;
+    // Type definition for a task, which is called with the index of the task
+    // within its batch.
+
+private:
+  // STRUCTURES
+  typedef struct queue_t {
+    // Mutex guarding 'tasks'.
+    std::mutex                mutex;
+
+    // Indices of the tasks waiting to be run.
+    std::deque<unsigned int>  tasks;
+  } queue_t;
+
+  // INSTANCE MEMBERS
+  std::vector<std::unique_ptr<queue_t> >  m_queues;
+                                           // Task queue of each worker.
+
+  std::vector<std::thread>                m_workers;
+                                           // Worker threads.
+
+  std::mutex                              m_mutex;
+                                           // Mutex guarding the members
+                                           // below.
+
+  std::condition_variable                 m_started;
+                                           // Signalled when a batch starts,
+                                           // or the pool is stopping.
+
+  std::condition_variable                 m_finished;
+                                           // Signalled when the last task of
+                                           // a batch finishes.
+
+  const task_t                           *m_task;
+                                           // Task of the current batch.
+
+  unsigned int                            m_batch;
+                                           // Number of batches started.
+
+  unsigned int                            m_remaining;
+                                           // Number of tasks of the current
+                                           // batch that have not finished.
+
+  bool                                    m_stopping;
+                                           // 'true' if the workers should
+                                           // exit.
+
+private:
+  // PRIVATE MANIPULATORS
+  bool take(unsigned int worker, unsigned int& idx);
+    // Loads into the given output parameter, 'idx', the index of a task for
+    // the given 'worker' to run, taken from its own queue, or else stolen
+    // from another queue.  Returns 'true' on success, otherwise 'false' if
+    // every queue is empty.
+
+  void work(unsigned int worker);
+    // Runs the given 'worker' until the pool is stopped.
+
+  // PRIVATE CREATORS
+  ThreadPool(const ThreadPool&);
+    // Not implemented.
+
+  ThreadPool& operator=(const ThreadPool&);
+    // Not implemented.
+
+public:
+  // CREATORS
+  explicit ThreadPool(unsigned int numThreads = 0);
+    // Creates a pool with the given 'numThreads' worker threads.  If
+    // 'numThreads' is zero, creates one worker per hardware thread.
+
+  ~ThreadPool(void);
+    // Stops and joins the worker threads.
+
+  // MANIPULATORS
+  void run(unsigned int numTasks, const task_t& task);
+    // Calls the given 'task' once for each index in the range
+    // '[0, numTasks)' on the worker threads, and returns once every call has
+    // returned.  The behaviour is undefined if this is called concurrently,
+    // or from within a task.
+
+  // ACCESSORS
+  unsigned int size(void) const;
+    // Returns the number of worker threads.
+};
+
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+// ACCESSORS
+inline unsigned int ThreadPool::size(void) const {
+  return m_workers.size();
+}
+
+}  // close 'gungi' namespace
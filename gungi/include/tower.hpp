@@ -2,15 +2,25 @@
 #pragma once
 //@DESCRIPTION:
 //  This component provides a definition for a tower in Gungi.  A tower is a
-//  set of units stacked upon one another.
+//  set of units stacked upon one another.  A tower holds at most
+//  'k_MAX_TOWER_SIZE' units, so the units are kept in a fixed inline array
+//  rather than a container, and each unit records its own tier.  A tower does
+//  not own its units: the slots hold the handles of units in a 'UnitArena',
+//  and the arena is passed to every method that has to resolve them.  A tower
+//  therefore holds no pointers, and copying a board copies its members as is.
 //
 //@CLASSES:
 //  'gungi::Tower': class definition for a tower in 'Gungi'.
+//
+//@TYPES:
+//  'gungi::board_t': fixed array of the towers that make up a board.
 #include "gtypes.hpp"
 #include "posn.hpp"
 #include "unit.hpp"
+#include "unitarena.hpp"
 
-#include <vector>
+#include <array>
+#include <cstdint>
 
 namespace gungi {
 
@@ -33,14 +43,18 @@ private:
   Posn                m_posn;
                        // The position of this tower on the board.
 
-  int                 m_bits;
+  unit_handle_t       m_units[k_MAX_HEIGHT];
+                       // Handles of the units in this tower, from the bottom
+                       // tier up.  Only the first 'm_height' entries are
+                       // meaningful.
+
+  uint8_t             m_height;
+                       // Number of units in this tower.
+
+  uint8_t             m_bits;
                        // Bits for keeping track of effects that have been
                        // applied within the tower.
 
-  SharedUnitPtrVector m_units;
-                       // Vector of pointers to the 'Unit' objects in this
-                       // tower.
-
 public:
   // CREATORS
   Tower(void);
@@ -62,38 +76,63 @@ public:
   void markClean(void);
     // Resets all bits in the tower's effect tracking bitfield.
 
-  void add(Unit *unit, error_t& err);
-    // Adds the given 'unit' to this tower.  Returns an error status code of
-    // 'GUNGI_ERROR_NONE' to the given output parameter 'err' if the unit was
-    // added successfully.  Returns an error status code of
-    // 'GUNGI_ERROR_FULL_TOWER' to the given output parameter 'err' if the
+  void add(unit_handle_t unit, UnitArena& arena, error_t& err);
+    // Adds the given 'unit' of the given 'arena' to this tower.  Returns an
+    // error status code of 'GUNGI_ERROR_NONE' to the given output parameter
+    // 'err' if the unit was added successfully.  Returns an error status code
+    // of 'GUNGI_ERROR_FULL_TOWER' to the given output parameter 'err' if the
     // tower is of height 'k_MAX_HEIGHT'.  Returns an error status of
     // 'GUNGI_ERROR_DUPLICATE' to the given output parameter 'err' if the
     // given 'unit' is already a member of the tower.
 
-  void add(SharedUnitPtr& unit, error_t& err);
-    // Adds the given 'unit' to this tower.  Returns an error status code of
+  void insert(tier_t         tier,
+              unit_handle_t  unit,
+              UnitArena&     arena,
+              error_t&       err);
+    // Inserts the given 'unit' of the given 'arena' into this tower at the
+    // given 'tier', moving the units at and above that tier up a tier.  This
+    // is the inverse of 'remove()'.  Returns an error status code of
+    // 'GUNGI_ERROR_NONE' to the given output parameter 'err' on success,
+    // 'GUNGI_ERROR_FULL_TOWER' if the tower is of height 'k_MAX_HEIGHT',
+    // otherwise 'GUNGI_ERROR_OUT_OF_RANGE' if 'tier' is above the top of the
+    // tower.  Note that no duplicate check is performed.
+
+  void remove(unit_handle_t unit, UnitArena& arena, error_t& err);
+    // Removes the given 'unit' of the given 'arena' from this tower, moving
+    // the units above it down a tier.  Returns an error status code of
     // 'GUNGI_ERROR_NONE' to the given output parameter 'err' if the unit was
-    // added successfully.  Returns an error status code of
-    // 'GUNGI_ERROR_FULL_TOWER' to the given output parameter 'err' if the
-    // tower is of height 'k_MAX_HEIGHT'.  Returns an error status of
-    // 'GUNGI_ERROR_DUPLICATE' to the given output parameter 'err' if the
-    // given 'unit' is already a member of the tower.
-
-  void remove(const Unit *unit, error_t& err);
-    // Removes the given 'unit' from this tower.  Returns an error status code
-    // of 'GUNGI_ERROR_NONE' to the given output parameter 'err' if the unit
-    // was removed successfully.  Returns an error status code of
+    // removed successfully.  Returns an error status code of
     // 'GUNGI_ERROR_NOT_A_MEMBER' if the given unit is not a member of this
     // tower.
 
+  void exchange(tier_t a, tier_t b, UnitArena& arena, error_t& err);
+    // Swaps the units at the given tiers, 'a' and 'b', in this tower, whose
+    // members are in the given 'arena'.  Returns an error status code of
+    // 'GUNGI_ERROR_NONE' to the given output parameter 'err' on success,
+    // otherwise 'GUNGI_ERROR_OUT_OF_RANGE' if there is no unit at either
+    // tier.
+
+  unit_handle_t replace(tier_t         tier,
+                        unit_handle_t  unit,
+                        UnitArena&     arena,
+                        error_t&       err);
+    // Replaces the unit at the given 'tier' in this tower with the given
+    // 'unit' of the given 'arena', and returns the handle of the unit that
+    // was replaced.  The replaced unit is cleared of its tower unless it has
+    // already been placed in another tower.  Note that no duplicate check is
+    // performed.  Returns an error status code of 'GUNGI_ERROR_NONE' to the
+    // given output parameter 'err' on success, otherwise
+    // 'GUNGI_ERROR_OUT_OF_RANGE' and 'UnitArena::k_NULL_HANDLE' if there is
+    // no unit at the given 'tier'.
+
   void reset(void);
     // Resets the tower.
 
   // ACCESSORS
-  bool isDuplicate(const Unit *unit) const;
-    // Returns 'true' if the given 'unit' is already a member of this tower as
-    // determined by its colour and front identifier.
+  bool isDuplicate(const Unit *unit, const UnitArena& arena) const;
+    // Returns 'true' if the given 'unit' is already a member of this tower,
+    // whose members are in the given 'arena', as determined by its colour and
+    // front identifier.
 
   bool isDirty(const dirty_bit_t& bit) const;
     // Returns 'true' if the given 'bit' is set in the Tower's underlying
@@ -106,28 +145,27 @@ public:
     // Returns the tier the given unit is on: an unsigned integer between
     // [0, k_MAX_HEIGHT - 1] inclusive.  Returns an error status code of
     // 'GUNGI_ERROR_NONE' to the given output parameter 'err' if the unit
-    // is in the tower, otherwise 'GUNGI_ERROR_NOT_A_MEMBER'.
+    // is in the tower, otherwise 'GUNGI_ERROR_NOT_A_MEMBER'.  This is a
+    // constant time lookup of the tier recorded by the 'unit'.
 
-  Unit *at(tier_t tier, error_t& err);
-    // Returns a constant reference to the unit at the given 'tier' in the
-    // tower.  Returns an error status code of 'GUNGI_ERROR_NONE' to the given
-    // output parameter 'err' if there is a unit at the given tier, otherwise
-    // 'GUNGI_ERROR_OUT_OF_RANGE'.
+  unit_handle_t at(tier_t tier, error_t& err) const;
+    // Returns the handle of the unit at the given 'tier' in the tower.
+    // Returns an error status code of 'GUNGI_ERROR_NONE' to the given output
+    // parameter 'err' if there is a unit at the given tier, otherwise
+    // 'GUNGI_ERROR_OUT_OF_RANGE' and 'UnitArena::k_NULL_HANDLE'.
 
-  const Unit *at(tier_t tier, error_t& err) const;
-    // Returns a constant reference to the unit at the given 'tier' in the
-    // tower.  Returns an error status code of 'GUNGI_ERROR_NONE' to the given
-    // output parameter 'err' if there is a unit at the given tier, otherwise
-    // 'GUNGI_ERROR_OUT_OF_RANGE'.
+  unit_handle_t top(void) const;
+    // Returns the handle of the unit at the top of this tower, or
+    // 'UnitArena::k_NULL_HANDLE' if this tower is empty.
 
   const Posn& posn(void) const;
     // Returns the position of this tower.
-
-  SharedUnitPtrVector& members(void);
-    // Returns a reference to the members of htis tower.
-
-  const SharedUnitPtrVector& members(void) const;
-    // Returns a constant reference to the members of this tower.
 };
 
+// TYPE DEFINITIONS
+typedef std::array<Tower, k_BOARD_LENGTH * k_BOARD_LENGTH> board_t;
+  // Type definition for the towers that make up the board, indexed by the
+  // square index of their position.  The board is held inline, so copying
+  // it is a single copy of its towers.
+
 }  // close 'gungi' namespace
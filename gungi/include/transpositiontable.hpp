@@ -0,0 +1,158 @@
+// transpositiontable.hpp                                             -*-C++-*-
+#pragma once
+//@DESCRIPTION:
+//  This component provides a fixed-size table of search results keyed by the
+//  Zobrist key of a position, shared by every thread of a search.  The table
+//  is allocated once, with a power-of-two number of slots, so a key picks its
+//  slot with a mask.
+//
+//  A slot is two words: the packed result, and the key exclusive-or'ed with
+//  it.  Both are written and read with relaxed atomics and no lock, so two
+//  threads writing a slot at once can leave the words of different results
+//  in it; such a slot no longer matches either key, and is treated as empty
+//  rather than returning a mix of the two results.
+//
+//  The table may be asked to be backed by huge pages, which cuts the misses
+//  of the translation lookaside buffer on a table of many megabytes probed
+//  at random.  Explicit huge pages are used where the system has them
+//  reserved, otherwise the memory is aligned to, and advised for,
+//  transparent huge pages.
+//
+//@CLASSES:
+//  'gungi::TranspositionTable': lock-free table of search results.
+#include "move.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace gungi {
+
+class TranspositionTable {
+  // Lock-free table of search results, shared between threads.
+
+public:
+  // ENUMERATIONS
+  typedef enum bound_t {
+    // Enumeration for how a stored score relates to the true score.
+    BOUND_NONE,
+    BOUND_UPPER,
+    BOUND_LOWER,
+    BOUND_EXACT,
+  } bound_t;
+
+  // STRUCTURES
+  typedef struct entry_t {
+    // Best move found, or a move of type 'Move::MOVE_TYPE_NONE'.
+    Move          move;
+
+    // Score of the position.
+    int           score;
+
+    // Depth of the search that found the score, in plies.
+    unsigned int  depth;
+
+    // Whether the score is exact, or a bound on the true score.
+    bound_t       bound;
+  } entry_t;
+
+  // STATIC CLASS MEMBERS
+  static const int k_MAX_SCORE = (1 << 21) - 1;
+    // Largest magnitude of a score that can be stored.
+
+  static const unsigned int k_MAX_DEPTH = 63;
+    // Largest depth that can be stored.
+
+private:
+  // STRUCTURES
+  typedef struct slot_t {
+    // Key of the position exclusive-or'ed with 'data'.
+    std::atomic<uint64_t>  check;
+
+    // Packed entry and the generation that stored it.
+    std::atomic<uint64_t>  data;
+  } slot_t;
+
+  // INSTANCE MEMBERS
+  slot_t        *m_slots;
+                  // Storage for the slots.
+
+  uint64_t       m_mask;
+                  // Number of slots less one.
+
+  std::size_t    m_bytes;
+                  // Size of the storage, in bytes.
+
+  bool           m_hugePages;
+                  // 'true' if the storage is mapped from explicit huge
+                  // pages.
+
+  unsigned int   m_generation;
+                  // Generation of the current search.
+
+private:
+  // PRIVATE CREATORS
+  TranspositionTable(const TranspositionTable&);
+    // Not implemented.
+
+  TranspositionTable& operator=(const TranspositionTable&);
+    // Not implemented.
+
+public:
+  // CREATORS
+  explicit TranspositionTable(unsigned int megabytes, bool hugePages = false);
+    // Creates an empty table of the largest power-of-two number of slots that
+    // fits in the given number of 'megabytes', and at least one slot.  If
+    // 'hugePages' is 'true', backs the table with huge pages where the
+    // system allows it.
+
+  ~TranspositionTable(void);
+    // Releases the storage of the table.
+
+  // MANIPULATORS
+  void clear(void);
+    // Empties the table.  The behaviour is undefined if the table is used by
+    // another thread meanwhile.
+
+  void newSearch(void);
+    // Marks the results stored from now on as newer than the results stored
+    // before, so that they are kept over them.  The behaviour is undefined if
+    // the table is used by another thread meanwhile.
+
+  void store(uint64_t key, const entry_t& entry);
+    // Stores the given 'entry' as the result for the position with the given
+    // 'key', unless the slot holds a result of the current search that is
+    // deeper.  A stored move of type 'Move::MOVE_TYPE_NONE' keeps the move
+    // already stored for the same 'key'.  The behaviour is undefined unless
+    // '-k_MAX_SCORE <= entry.score <= k_MAX_SCORE', and
+    // 'entry.depth <= k_MAX_DEPTH'.
+
+  // ACCESSORS
+  bool probe(uint64_t key, entry_t& entry) const;
+    // Loads into the given output parameter, 'entry', the result stored for
+    // the position with the given 'key', and returns 'true', otherwise
+    // returns 'false' if there is none.
+
+  uint64_t size(void) const;
+    // Returns the number of slots in the table.
+
+  bool isHugePages(void) const;
+    // Returns 'true' if the table is mapped from explicit huge pages,
+    // otherwise 'false'.
+};
+
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+// ACCESSORS
+inline uint64_t TranspositionTable::size(void) const {
+  return m_mask + 1;
+}
+
+inline bool TranspositionTable::isHugePages(void) const {
+  return m_hugePages;
+}
+
+}  // close 'gungi' namespace
@@ -2,15 +2,20 @@
 #pragma once
 //@DESCRIPTION:
 //  This component provides a definition for a unit in Gungi.  A unit is a
-//  piece on the Gungi board (e.g. 'Commander' or 'Samurai').
+//  piece on the Gungi board (e.g. 'Commander' or 'Samurai').  Units are kept
+//  small, and are trivially copyable, so that a whole army can be stored
+//  contiguously (see 'gungi::UnitArena').
 //
 //@CLASSES:
 //  'gungi::Unit': class definition for a unit in 'Gungi'.
+//
+//@TYPES:
+//  'gungi::UnitPtrVector': vector of non-owning pointers to units.
 #include "builder.hpp"
 #include "gtypes.hpp"
 
+#include <cstdint>
 #include <iostream>
-#include <memory>
 #include <string>
 #include <vector>
 
@@ -23,44 +28,64 @@ class Unit {
   // A 'gungi::Unit' represents a unit or piece in Gungi, defined by both
   // their colour and identifier.
 
+public:
+  // ENUMERATIONS
+  typedef enum slot_t {
+    UNITS_SLOT = 0,
+      // Index in the units of the player holding this unit.
+
+    GROUP_SLOT,
+      // Index in the active, or inactive, units of that player.
+
+    HAND_SLOT,
+      // Index among the units of its kind in the hand of that player.
+
+    NUM_SLOTS
+  } slot_t;
+
 private:
   // INSTANCE MEMBERS
-  const Builder&       m_builder;
-                        // Builder used to construct units and provide access
-                        // to shared resources.
+  Tower const         *m_tower;
+                        // Pointer to the tower this unit belongs to.
 
-  piece_id_t           m_identifier;
-                        // The identifier for this unit.  Specifies which kind
-                        // of unit this is.
+  int8_t               m_identifier;
+                        // The 'piece_id_t' identifier for this unit.
+                        // Specifies which kind of unit this is.
 
-  piece_id_t           m_back;
-                        // The identifier which specifies which unit this unit
-                        // becomes when it is flipped to its backside.
+  int8_t               m_back;
+                        // The 'piece_id_t' identifier which specifies which
+                        // unit this unit becomes when it is flipped to its
+                        // backside.
 
-  colour_t             m_colour;
-                        // The colour of this unit.
+  uint8_t              m_colour;
+                        // The 'colour_t' colour of this unit.
 
-  effect_bitfield_t    m_effectBitField;
+  int8_t               m_tier;
+                        // The tier of this unit within its tower.
+
+  uint16_t             m_effectBitField;
                         // Bitfield which specifies what kind of effects this
                         // unit has.
 
-  effect_bitfield_t    m_immuneBitField;
+  uint16_t             m_immuneBitField;
                         // Bitfield of the effects this unit is immune to.
 
-  const_moveset_ptr_t  m_movesPtr;
-                        // Pointer to a set of moves this unit can make.
-
-  Tower const         *m_tower;
-                        // Pointer to the tower this unit belongs to.
+  uint8_t              m_slots[NUM_SLOTS];
+                        // Indices of this unit in the lists of the player
+                        // holding it, so that it is removed from them
+                        // without a search (see 'gungi::Player').
 
 private:
   // PRIVATE MANIPULATORS
-  void reset(void);
-    // Resets the piece by loading the effects, immunities, and moves for the
-    // piece identified by the 'm_identifier' member.
+  void reset(const Builder& builder);
+    // Resets the piece by loading the effects and immunities for the piece
+    // identified by the 'm_identifier' member from the given 'builder'.
 
 public:
   // CREATORS
+  Unit(void);
+    // Creates an invalid unit.  A subsequent call to 'isValid()' will return
+    // 'false'.
   explicit Unit(piece_id_t      front,
                 piece_id_t      back,
                 colour_t        colour,
@@ -68,7 +93,8 @@ public:
     // Creates an instance of a 'Unit' initializing it to correspond to the
     // unit defined by the given 'front' identifier, with the given 'back'
     // identifier as the back piece with the given 'colour'.  Uses the given
-    // 'builder' to access any shared resources.  Note that if the given
+    // 'builder' to load the unit's effects; the 'builder' need not outlive
+    // the unit.  Note that if the given
     // 'front' piece is an invalid identifier, this instance will be marked
     // invalid, and a subsequent call to 'isValid()' will return 'false'.
 
@@ -77,20 +103,25 @@ public:
 
   // MANIPULATORS
   void flip(error_t& err);
-    // Flips this unit to its back piece, re-populating it using the underlying
-    // builder.  Returns a status of 'GUNGI_ERROR_NONE' in the given output
+    // Flips this unit to its back piece, re-populating it using a default
+    // 'Builder'.  Returns a status of 'GUNGI_ERROR_NONE' in the given output
     // parameter 'err', if the flip succeeds.  Returns a status of
     // 'GUNGI_ERROR_NO_BACK' if the unit does not have a back side.
 
   void setColour(colour_t colour);
     // Sets the colour of this unit to the given 'colour'.
 
-  void setTower(Tower const *towerPtr);
-    // Sets the tower of this unit to the given 'towerPtr' pointer.
+  void setTower(Tower const *towerPtr, tier_t tier = 0);
+    // Sets the tower of this unit to the given 'towerPtr' pointer, and its
+    // tier within that tower to the optionally specified 'tier'.
 
   void clearTower(void);
     // Clears the tower of this unit.
 
+  void setSlot(slot_t slot, unsigned int index);
+    // Sets the index of this unit in the list of the player holding it given
+    // by 'slot' to the given 'index'.
+
   void addEffect(effect_t effect);
     // Adds the given 'effect' to this unit.
 
@@ -111,16 +142,16 @@ public:
     // Returns 'true' if this unit is active, otherwise 'false'.  This is
     // equivalent to 'tower() != NULL'.
 
-  const piece_id_t& id(void) const;
+  piece_id_t id(void) const;
     // Returns the identifier of this unit.
 
-  const piece_id_t& front(void) const;
+  piece_id_t front(void) const;
     // Returns the identifier of the front piece of this unit.
 
-  const piece_id_t& back(void) const;
+  piece_id_t back(void) const;
     // Returns the identifier of the back piece of this unit.
 
-  const colour_t& colour(void) const;
+  colour_t colour(void) const;
     // Returns the colour of this unit.
 
   const_moveset_ptr_t moveset(void) const;
@@ -130,6 +161,15 @@ public:
     // Returns a constant pointer to the tower this unit belongs to.  This
     // value is 'NULL' if this unit is not in a tower.
 
+  tier_t tier(void) const;
+    // Returns the tier of this unit within its tower.  Note that this value
+    // is meaningless if this unit is not in a tower.
+
+  unsigned int slot(slot_t slot) const;
+    // Returns the index of this unit in the list of the player holding it
+    // given by 'slot'.  Note that this value is meaningless unless the unit
+    // is in that list.
+
   effect_bitfield_t effectField(void) const;
     // Returns the bitfield of the effects this unit has.
 
@@ -145,8 +185,7 @@ public:
     // returns the modified stream.
 };
 
-typedef std::shared_ptr<Unit> SharedUnitPtr;
-
-typedef std::vector<SharedUnitPtr> SharedUnitPtrVector;
+typedef std::vector<Unit *> UnitPtrVector;
+  // Vector of non-owning pointers to units.
 
 }  // close 'gungi' namespace
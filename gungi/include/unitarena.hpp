@@ -0,0 +1,155 @@
+// unitarena.hpp                                                      -*-C++-*-
+#pragma once
+//@DESCRIPTION:
+//  This component provides a fixed-capacity arena that owns the units of a
+//  game.  Every unit in a game lives in one contiguous array inside the arena,
+//  and is identified by a small integer handle: its index in that array.
+//  Towers hold the handles of their units, and players hold non-owning
+//  pointers into the arena, so resetting a game neither allocates nor frees
+//  memory.
+//
+//@CLASSES:
+//  'gungi::UnitArena': fixed-capacity storage for the units of a game.
+//
+//@TYPES:
+//  'gungi::unit_handle_t': type definition for a handle to a unit in an arena.
+#include "builder.hpp"
+#include "gtypes.hpp"
+#include "unit.hpp"
+
+#include <cstdint>
+
+namespace gungi {
+
+typedef uint8_t unit_handle_t;
+  // Type definition for a handle to a unit in a 'UnitArena'.
+
+class UnitArena {
+  // A 'gungi::UnitArena' owns the units of a single game.
+
+public:
+  // STATIC CLASS MEMBERS
+  static const unsigned int k_CAPACITY = 2 * k_START_PIECE_COUNT;
+    // Maximum number of units in an arena; both players' starting hands.
+
+  static const unit_handle_t k_NULL_HANDLE = 0xFF;
+    // Handle that does not refer to any unit.
+
+private:
+  // INSTANCE MEMBERS
+  Unit          m_units[k_CAPACITY];
+                 // Storage for the units.  Only the first 'm_size' entries
+                 // are meaningful.
+
+  unsigned int  m_size;
+                 // Number of units created since the last reset.
+
+public:
+  // CREATORS
+  UnitArena(void);
+    // Creates an empty arena.
+
+  ~UnitArena(void);
+    // Default destructor.
+
+  // MANIPULATORS
+  unit_handle_t create(piece_id_t     front,
+                       piece_id_t     back,
+                       colour_t       colour,
+                       const Builder& builder);
+    // Creates a unit with the given 'front', 'back', and 'colour' using the
+    // given 'builder', and returns its handle.  Raises an assertion if the
+    // arena is full.
+
+  void reset(void);
+    // Discards every unit in this arena.  Note that pointers to units
+    // previously created are left dangling into reused storage.
+
+  Unit *get(unit_handle_t handle);
+    // Returns a pointer to the unit with the given 'handle', or 'NULL' if the
+    // 'handle' is 'k_NULL_HANDLE'.
+
+  Unit& operator[](unit_handle_t handle);
+    // Returns a reference to the unit with the given 'handle'.  The behaviour
+    // is undefined unless 'handle < size()'.
+
+  Unit *begin(void);
+    // Returns a pointer to the first unit in this arena.
+
+  Unit *end(void);
+    // Returns a pointer one past the last unit in this arena.
+
+  // ACCESSORS
+  const Unit *get(unit_handle_t handle) const;
+    // Returns a constant pointer to the unit with the given 'handle', or
+    // 'NULL' if the 'handle' is 'k_NULL_HANDLE'.
+
+  const Unit& operator[](unit_handle_t handle) const;
+    // Returns a constant reference to the unit with the given 'handle'.  The
+    // behaviour is undefined unless 'handle < size()'.
+
+  unit_handle_t handle(const Unit *unit) const;
+    // Returns the handle of the given 'unit', or 'k_NULL_HANDLE' if the
+    // 'unit' is 'NULL' or is not owned by this arena.
+
+  unsigned int size(void) const;
+    // Returns the number of units in this arena.
+
+  const Unit *begin(void) const;
+    // Returns a constant pointer to the first unit in this arena.
+
+  const Unit *end(void) const;
+    // Returns a constant pointer one past the last unit in this arena.
+};
+
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+// MANIPULATORS
+inline Unit *UnitArena::get(unit_handle_t handle) {
+  return handle == k_NULL_HANDLE ? NULL : &m_units[handle];
+}
+
+inline Unit& UnitArena::operator[](unit_handle_t handle) {
+  return m_units[handle];
+}
+
+inline Unit *UnitArena::begin(void) {
+  return m_units;
+}
+
+inline Unit *UnitArena::end(void) {
+  return m_units + m_size;
+}
+
+// ACCESSORS
+inline const Unit *UnitArena::get(unit_handle_t handle) const {
+  return handle == k_NULL_HANDLE ? NULL : &m_units[handle];
+}
+
+inline const Unit& UnitArena::operator[](unit_handle_t handle) const {
+  return m_units[handle];
+}
+
+inline unit_handle_t UnitArena::handle(const Unit *unit) const {
+  if (unit < m_units || unit >= m_units + m_size) {
+    return k_NULL_HANDLE;
+  }
+  return static_cast<unit_handle_t>(unit - m_units);
+}
+
+inline unsigned int UnitArena::size(void) const {
+  return m_size;
+}
+
+inline const Unit *UnitArena::begin(void) const {
+  return m_units;
+}
+
+inline const Unit *UnitArena::end(void) const {
+  return m_units + m_size;
+}
+
+}  // close 'gungi' namespace
@@ -5,11 +5,13 @@
 //
 //@CLASSES:
 //  'gungi::NilDeleter': no-op pointer deleter class.
+//  'gungi::Walker': iterator over the squares walked by a moveset.
 //  'gungi::Util': gungi utility class.
 #include "gtypes.hpp"
 #include "posn.hpp"
 #include "unit.hpp"
 
+#include <cstddef>
 #include <string>
 
 namespace gungi {
@@ -40,6 +42,95 @@ public:
 };
 
 
+                                 // ============
+                                 // class Walker
+                                 // ============
+
+class Walker {
+  // Iterator over the squares visited by walking each path of a piece's
+  // moveset at a particular tier.  Each call to 'next()' takes one step along
+  // the current path, moving to the start of the next path once the current
+  // path is exhausted.  The walker reads the flat moveset tables directly, so
+  // walking never allocates.
+
+private:
+  // INSTANCE MEMBERS
+  const move_span_t *m_path;
+    // The next path to walk.
+
+  const move_span_t *m_lastPath;
+    // One past the last path to walk.
+
+  const move_t      *m_step;
+    // The next step of the current path.
+
+  const move_t      *m_lastStep;
+    // One past the last step of the current path.
+
+  unsigned int       m_direction;
+    // Directions remaining for the current step.
+
+  bool               m_unlimited;
+    // Whether the current step is unlimited.
+
+  bool               m_invert;
+    // Whether the walk is top-down.
+
+  bool               m_hasEnd;
+    // Whether unlimited steps stop at 'm_end'.
+
+  Posn               m_start;
+    // Square that every path starts from.
+
+  Posn               m_end;
+    // Square that unlimited steps stop at, if 'm_hasEnd'.
+
+  Posn               m_posn;
+    // Current square of the walk.
+
+public:
+  // CREATORS
+  Walker(piece_id_t  piece,
+         tier_t      tier,
+         const Posn& start,
+         bool        invert = false);
+    // Creates a walker over the moveset of the given 'piece' at the given
+    // 'tier', starting from the given 'start' position.  Unlimited steps stop
+    // at the first square off the board.  The optionally specified 'invert'
+    // parameter determines if the walk is top-down ('true'), otherwise
+    // bottom-up ('false'), defaults to 'false'.
+
+  Walker(piece_id_t  piece,
+         tier_t      tier,
+         const Posn& start,
+         const Posn& end,
+         bool        invert = false);
+    // Creates a walker over the moveset of the given 'piece' at the given
+    // 'tier', starting from the given 'start' position.  Unlimited steps stop
+    // at the given 'end' position, or the first square off the board.  The
+    // optionally specified 'invert' parameter determines if the walk is
+    // top-down ('true'), otherwise bottom-up ('false'), defaults to 'false'.
+
+  // MANIPULATORS
+  bool next(void);
+    // Advances the walk by one square.  Returns 'true' if the walk moved to
+    // another square, otherwise 'false' if every path has been walked.
+
+  // ACCESSORS
+  const Posn& posn(void) const;
+    // Returns the current square of the walk.  Note that the square may be
+    // off the board.
+
+  bool isUnlimited(void) const;
+    // Returns 'true' if the current square was reached by an unlimited step,
+    // otherwise 'false'.
+
+  bool isPathEnd(void) const;
+    // Returns 'true' if the current square is the last square of its path,
+    // otherwise 'false'.
+};
+
+
                                   // ==========
                                   // class Util
                                   // ==========
@@ -49,6 +140,11 @@ class Util {
 
 public:
   // STATIC CLASS MEMBERS
+  static const unsigned int k_MAX_WALK_LENGTH = 1 + k_MAX_PATH_STEPS *
+                                                    k_BOARD_LENGTH;
+    // Maximum number of squares in a walk returned by 'getWalk()', including
+    // the starting square.
+
   static const piece_id_t k_FRONT_PIECES[];
     // Array of identifiers for the front pieces.
 
@@ -88,19 +184,17 @@ public:
   static std::string toUpperCase(const std::string& str);
     // Returns the given string, 'str', as all uppercase letters.
 
-  static SharedUnitPtrVector::iterator find(SharedUnitPtrVector& v,
+  static UnitPtrVector::iterator find(UnitPtrVector& v, const Unit *unit);
+    // Returns an iterator to the pointer for the given 'unit' in the given
+    // vector, 'v' if the unit exists with the vector, otherwise returns
+    // 'v.end()'.
+
+  static UnitPtrVector::const_iterator find(const UnitPtrVector& v,
                                             const Unit          *unit);
-    // Returns an iterator to the shared poitner for the given 'unit' in the
-    // given vector, 'v' if the unit exists with the vector, otherwise
+    // Returns a constant iterator to the pointer for the given 'unit' in the
+    // given vector, 'v' if the unit exists within the vector, otherwise
     // returns 'v.end()'.
 
-  static SharedUnitPtrVector::const_iterator find(
-                                              const SharedUnitPtrVector& v,
-                                              const Unit                *unit);
-    // Returns a constant iterator to the shared pointer for the given 'unit'
-    // in the given vector, 'v' if the unit exists within the vector,
-    // otherwise returns 'v.end()'.
-
   static PosnSet::const_iterator find(const PosnSet& set, const Posn& posn);
     // Returns a constant iterator to the 'Posn' for the given 'posn' in the
     // given 'PosnSet', 'set', if the 'posn' is found, otherwise returns
@@ -125,6 +219,23 @@ public:
     // 'invert' parameter determines if the walk is top-down ('true'),
     // otherwise bottom-up ('false'), defaults to 'false'.
 
+  static unsigned int getWalk(const Unit *unit,
+                              tier_t      tier,
+                              const Posn& start,
+                              const Posn& end,
+                              Posn       *walk,
+                              error_t&    error,
+                              bool        invert = false);
+    // Loads the squares walked from the given 'start' position to the given
+    // 'end' position for the given 'unit' at the given 'tier' into the given
+    // 'walk' buffer, which must hold at least 'k_MAX_WALK_LENGTH' positions,
+    // and returns the number of squares loaded.  Return an error status of
+    // 'GUNGI_ERROR_NONE' in the given output parameter, 'error', if there was
+    // a successfully path found, otherwise 'GUNGI_ERROR_NO_WALK' and returns
+    // zero.  The optionally specified 'invert' parameter determines if the
+    // walk is top-down ('true'), otherwise bottom-up ('false'), defaults to
+    // 'false'.
+
   static PosnSet getWalk(const Unit *unit,
                          tier_t      tier,
                          const Posn& start,
@@ -171,4 +282,107 @@ inline void NilDeleter<T>::operator()(T *ptr) const {
   (void)ptr;
 }
 
+
+                                 // ------------
+                                 // class Walker
+                                 // ------------
+
+// CREATORS
+inline Walker::Walker(piece_id_t  piece,
+                      tier_t      tier,
+                      const Posn& start,
+                      bool        invert)
+: m_path(k_MOVE_PATHS + k_UNIT_MOVES[piece][tier].first)
+, m_lastPath(m_path + k_UNIT_MOVES[piece][tier].count)
+, m_step(NULL)
+, m_lastStep(NULL)
+, m_direction(0)
+, m_unlimited(false)
+, m_invert(invert)
+, m_hasEnd(false)
+, m_start(start)
+, m_end(start)
+, m_posn(start)
+{
+  // DO NOTHING
+}
+
+inline Walker::Walker(piece_id_t  piece,
+                      tier_t      tier,
+                      const Posn& start,
+                      const Posn& end,
+                      bool        invert)
+: m_path(k_MOVE_PATHS + k_UNIT_MOVES[piece][tier].first)
+, m_lastPath(m_path + k_UNIT_MOVES[piece][tier].count)
+, m_step(NULL)
+, m_lastStep(NULL)
+, m_direction(0)
+, m_unlimited(false)
+, m_invert(invert)
+, m_hasEnd(true)
+, m_start(start)
+, m_end(end)
+, m_posn(start)
+{
+  // DO NOTHING
+}
+
+// MANIPULATORS
+inline bool Walker::next(void) {
+  if (!m_direction) {
+    while (m_step == m_lastStep) {
+      // The current path is exhausted, so start the next path.
+      if (m_path == m_lastPath) {
+        return false;
+      }
+
+      m_step = k_MOVE_STEPS + m_path->first;
+      m_lastStep = m_step + m_path->count;
+      m_posn = m_start;
+      m_path++;
+    }
+
+    m_direction = m_step->move_direction;
+    m_unlimited = m_step->move_modifier == GUNGI_MOVE_MOD_UNLIMITED;
+    m_step++;
+  }
+
+  if (m_direction & GUNGI_MOVE_DIR_UP) {
+    m_posn.up(m_invert);
+  }
+
+  if (m_direction & GUNGI_MOVE_DIR_DOWN) {
+    m_posn.down(m_invert);
+  }
+
+  if (m_direction & GUNGI_MOVE_DIR_LEFT) {
+    m_posn.left(m_invert);
+  }
+
+  if (m_direction & GUNGI_MOVE_DIR_RIGHT) {
+    m_posn.right(m_invert);
+  }
+
+  if (!m_unlimited ||
+      !m_posn.isValid() ||
+      (m_hasEnd && m_posn == m_end)) {
+    m_direction = 0;
+  }
+
+  return true;
+}
+
+// ACCESSORS
+inline const Posn& Walker::posn(void) const {
+  return m_posn;
+}
+
+inline bool Walker::isUnlimited(void) const {
+  return m_unlimited;
+}
+
+inline bool Walker::isPathEnd(void) const {
+  return !m_direction && m_step == m_lastStep;
+}
+
 }  // close 'gungi' namespace
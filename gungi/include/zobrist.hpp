@@ -0,0 +1,103 @@
+// zobrist.hpp                                                        -*-C++-*-
+#pragma once
+//@DESCRIPTION:
+//  This component provides the keys used to hash a game position into a
+//  single 64-bit value.  A position is hashed as the exclusive-or of a key for
+//  each unit on the board (by square, tier, colour, front, and back), combined
+//  with a key for the units in each player's hand, and a key for the side to
+//  move.  Keys for the board are combined with exclusive-or so that a key can
+//  be updated incrementally as units are added to and removed from towers.
+//  The units in a hand form a multiset, so their keys are combined by
+//  addition, which allows a hand to hold many identical units.
+//
+//  Keys are not stored in tables; each key is computed by a bijective mixing
+//  function from the packed description of what it stands for, so there is
+//  nothing to initialize, and distinct descriptions never share a key.
+//
+//@CLASSES:
+//  'gungi::Zobrist': position hashing keys.
+#include "gtypes.hpp"
+#include "player.hpp"
+#include "tower.hpp"
+#include "unitarena.hpp"
+
+#include <cstdint>
+
+namespace gungi {
+
+class Zobrist {
+  // Keys for hashing a game position.
+
+private:
+  // PRIVATE CLASS METHODS
+  static uint64_t mix(uint64_t value);
+    // Returns the given 'value' scrambled by a bijective mixing function.
+
+public:
+  // STATIC CLASS METHODS
+  static uint64_t unit(unsigned int square,
+                       tier_t       tier,
+                       colour_t     colour,
+                       piece_id_t   front,
+                       piece_id_t   back);
+    // Returns the key for a unit of the given 'colour', 'front', and 'back'
+    // at the given 'tier' of the tower on the square with index 'square'.
+
+  static uint64_t hand(colour_t colour, piece_id_t front, piece_id_t back);
+    // Returns the key for a unit of the given 'colour', 'front', and 'back'
+    // in its player's hand.
+
+  static uint64_t side(void);
+    // Returns the key for black being the side to move.
+
+  static uint64_t board(const board_t& board, const UnitArena& arena);
+    // Returns the exclusive-or of the keys for every unit on the given
+    // 'board', whose units are in the given 'arena', computed from scratch.
+
+  static uint64_t hand(const Player& player);
+    // Returns the sum of the keys for every unit in the hand of the given
+    // 'player', computed from scratch.
+};
+
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+// PRIVATE CLASS METHODS
+inline uint64_t Zobrist::mix(uint64_t value) {
+  value += 0x9E3779B97F4A7C15ULL;
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+  return value ^ (value >> 31);
+}
+
+// STATIC CLASS METHODS
+inline uint64_t Zobrist::unit(unsigned int square,
+                              tier_t       tier,
+                              colour_t     colour,
+                              piece_id_t   front,
+                              piece_id_t   back) {
+  // Pieces are offset by one so that 'GUNGI_PIECE_NONE' packs as zero.
+  return mix((1ULL << 32) |
+             (static_cast<uint64_t>(square) << 16) |
+             (static_cast<uint64_t>(tier) << 14) |
+             (static_cast<uint64_t>(colour) << 10) |
+             (static_cast<uint64_t>(front + 1) << 5) |
+             static_cast<uint64_t>(back + 1));
+}
+
+inline uint64_t Zobrist::hand(colour_t   colour,
+                              piece_id_t front,
+                              piece_id_t back) {
+  return mix((2ULL << 32) |
+             (static_cast<uint64_t>(colour) << 10) |
+             (static_cast<uint64_t>(front + 1) << 5) |
+             static_cast<uint64_t>(back + 1));
+}
+
+inline uint64_t Zobrist::side(void) {
+  return mix(3ULL << 32);
+}
+
+}  // close 'gungi' namespace
@@ -114,12 +114,12 @@ int gungi_game_get_winner(unsigned int game_id) {
   return controller.winner();
 }
 
-error_t gungi_game_drop_unit(unsigned int game_id,
-                             const char *id,
-                             unsigned int to_col,
-                             unsigned int to_row) {
+gungi::error_t gungi_game_drop_unit(unsigned int game_id,
+                                    const char *id,
+                                    unsigned int to_col,
+                                    unsigned int to_row) {
   Controller& controller = get_controller(game_id);
-  error_t error;
+  gungi::error_t error;
   piece_id_t front;
   piece_id_t back;
   std::string stringId;
@@ -142,14 +142,14 @@ error_t gungi_game_drop_unit(unsigned int game_id,
   return error;
 }
 
-error_t gungi_game_move_unit(unsigned int game_id,
-                             unsigned int from_col,
-                             unsigned int from_row,
-                             tier_t from_tier,
-                             unsigned int to_col,
-                             unsigned int to_row) {
+gungi::error_t gungi_game_move_unit(unsigned int game_id,
+                                    unsigned int from_col,
+                                    unsigned int from_row,
+                                    tier_t from_tier,
+                                    unsigned int to_col,
+                                    unsigned int to_row) {
   Controller& controller = get_controller(game_id);
-  error_t error;
+  gungi::error_t error;
   const Posn from(from_col, from_row);
   const Posn to(to_col, to_row);
 
@@ -158,49 +158,49 @@ error_t gungi_game_move_unit(unsigned int game_id,
   return error;
 }
 
-error_t gungi_game_substitution(unsigned int game_id,
-                                unsigned int from_col,
-                                unsigned int from_row,
-                                tier_t from_tier,
-                                unsigned int to_col,
-                                unsigned int to_row,
-                                tier_t to_tier) {
+gungi::error_t gungi_game_substitution(unsigned int game_id,
+                                       unsigned int from_col,
+                                       unsigned int from_row,
+                                       tier_t from_tier,
+                                       unsigned int to_col,
+                                       unsigned int to_row,
+                                       tier_t to_tier) {
   Controller& controller = get_controller(game_id);
   Posn from(from_col, from_row);
   Posn to(to_col, to_row);
   effect_t effect = GUNGI_EFFECT_SUBSTITUTION;
-  error_t error;
+  gungi::error_t error;
 
   controller.exchangeUnits(effect, from, from_tier, to, to_tier, error);
 
   return error;
 }
 
-error_t gungi_game_exchange(unsigned int game_id,
-                            unsigned int from_col,
-                            unsigned int from_row,
-                            tier_t from_tier,
-                            unsigned int to_col,
-                            unsigned int to_row,
-                            tier_t to_tier) {
+gungi::error_t gungi_game_exchange(unsigned int game_id,
+                                   unsigned int from_col,
+                                   unsigned int from_row,
+                                   tier_t from_tier,
+                                   unsigned int to_col,
+                                   unsigned int to_row,
+                                   tier_t to_tier) {
   Controller& controller = get_controller(game_id);
   Posn from(from_col, from_row);
   Posn to(to_col, to_row);
   effect_t effect = GUNGI_EFFECT_1_3_TIER_EXCHANGE;
-  error_t error;
+  gungi::error_t error;
 
   controller.exchangeUnits(effect, from, from_tier, to, to_tier, error);
 
   return error;
 }
 
-error_t gungi_game_immobile_strike(unsigned int game_id,
-                                   unsigned int from_col,
-                                   unsigned int from_row,
-                                   tier_t from_tier,
-                                   tier_t target_tier) {
+gungi::error_t gungi_game_immobile_strike(unsigned int game_id,
+                                          unsigned int from_col,
+                                          unsigned int from_row,
+                                          tier_t from_tier,
+                                          tier_t target_tier) {
   Controller& controller = get_controller(game_id);
-  error_t error;
+  gungi::error_t error;
   Posn from(from_col, from_row);
 
   controller.immobileStrike(from, from_tier, target_tier, error);
@@ -208,10 +208,10 @@ error_t gungi_game_immobile_strike(unsigned int game_id,
   return error;
 }
 
-error_t gungi_game_force_recover(unsigned int game_id,
-                                 bool recover) {
+gungi::error_t gungi_game_force_recover(unsigned int game_id,
+                                        bool recover) {
   Controller& controller = get_controller(game_id);
-  error_t error;
+  gungi::error_t error;
 
   controller.forceRecover(recover, error);
   return error;
@@ -2,11 +2,19 @@
 #pragma once
 //@PURPOSE: Gungi library header.
 #include "../../include/builder.hpp"
+#include "../../include/engine.hpp"
+#include "../../include/gnarchive.hpp"
 #include "../../include/gndecoder.hpp"
+#include "../../include/gnencoder.hpp"
+#include "../../include/gnreader.hpp"
 #include "../../include/gtypes.hpp"
 #include "../../include/logician.hpp"
+#include "../../include/montecarlo.hpp"
+#include "../../include/move.hpp"
+#include "../../include/perft.hpp"
 #include "../../include/player.hpp"
 #include "../../include/posn.hpp"
+#include "../../include/threadpool.hpp"
 #include "../../include/tower.hpp"
 #include "../../include/unit.hpp"
 #include "../../include/util.hpp"
@@ -62,60 +70,60 @@ int gungi_game_get_winner(unsigned int game_id);
   // is still in progress, or has ended in a draw, then '-1' is returned
   // instead.
 
-error_t gungi_game_drop_unit(unsigned int game_id,
-                             const char *id,
-                             unsigned int to_col,
-                             unsigned int to_row);
+gungi::error_t gungi_game_drop_unit(unsigned int game_id,
+                                    const char *id,
+                                    unsigned int to_col,
+                                    unsigned int to_row);
   // Drops a unit, specified by the given 'id', for the game, specified by the
   // given 'game_id' onto the board position identified by the column 'to_col',
   // and row 'to_row'.
 
-error_t gungi_game_move_unit(unsigned int game_id,
-                             unsigned int from_col,
-                             unsigned int from_row,
-                             tier_t from_tier,
-                             unsigned int to_col,
-                             unsigned int to_row);
+gungi::error_t gungi_game_move_unit(unsigned int game_id,
+                                    unsigned int from_col,
+                                    unsigned int from_row,
+                                    tier_t from_tier,
+                                    unsigned int to_col,
+                                    unsigned int to_row);
   // For the game specified by the given 'game_id', moves a unit from the
   // position identified by the column 'from_col' and row 'from_row' at tier
   // 'from_tier' to the top of the tower at the position identified by the
   // given column 'to_col' and row 'to_row'.
 
-error_t gungi_game_substitution(unsigned int game_id,
-                                unsigned int from_col,
-                                unsigned int from_row,
-                                tier_t from_tier,
-                                unsigned int to_col,
-                                unsigned int to_row,
-                                tier_t to_tier);
+gungi::error_t gungi_game_substitution(unsigned int game_id,
+                                       unsigned int from_col,
+                                       unsigned int from_row,
+                                       tier_t from_tier,
+                                       unsigned int to_col,
+                                       unsigned int to_row,
+                                       tier_t to_tier);
   // For the game specified by the given 'game_id', performs a substitution
   // between the unit at the position identified by the column 'from_col' and
   // row 'from_row' at tier 'from_tier' with the unit at the position
   // identified by the column 'to_col' and row 'to_row' at tier 'to_tier'.
 
-error_t gungi_game_exchange(unsigned int game_id,
-                            unsigned int from_col,
-                            unsigned int from_row,
-                            tier_t from_tier,
-                            unsigned int to_col,
-                            unsigned int to_row,
-                            tier_t to_tier);
+gungi::error_t gungi_game_exchange(unsigned int game_id,
+                                   unsigned int from_col,
+                                   unsigned int from_row,
+                                   tier_t from_tier,
+                                   unsigned int to_col,
+                                   unsigned int to_row,
+                                   tier_t to_tier);
   // For the game specified by the given 'game_id', performs a 1-3 Tier
   // Exchange between the unit at the position identified by the column
   // 'from_col' and row 'from_row' at tier 'from_tier' and the unit at the
   // same position, identified by 'to_col' and 'to_row', but at tier 'to_tier'.
 
-error_t gungi_game_immobile_strike(unsigned int game_id,
-                                   unsigned int from_col,
-                                   unsigned int from_row,
-                                   tier_t from_tier,
-                                   tier_t target_tier);
+gungi::error_t gungi_game_immobile_strike(unsigned int game_id,
+                                          unsigned int from_col,
+                                          unsigned int from_row,
+                                          tier_t from_tier,
+                                          tier_t target_tier);
   // For the game specified by the given 'game_id', performs an immobile strike
   // within a tower at a position identified by the given column 'from_col' and
   // row 'from_row'.  The unit at the specified tier 'from_tier' performs the
   // strike against the unit at the specified tier 'target_tier'.
 
-error_t gungi_game_force_recover(unsigned int game_id, bool recover);
+gungi::error_t gungi_game_force_recover(unsigned int game_id, bool recover);
   // For the game specified by the given 'game_id', sets whether the user will
   // be performing a forced recovery, by setting 'recover' to 'true', or not
   // by setting 'recover' to 'false'.
@@ -0,0 +1,146 @@
+// attacktable.cpp                                                    -*-C++-*-
+#include "attacktable.hpp"
+
+#include "bitboard.hpp"
+#include "gtypes.hpp"
+#include "posn.hpp"
+#include "util.hpp"
+
+namespace gungi {
+
+// PRIVATE CLASS METHODS
+const AttackTable& AttackTable::instance(void) {
+  static const AttackTable s_table;
+  return s_table;
+}
+
+bool AttackTable::isReachable(piece_id_t  piece,
+                              tier_t      tier,
+                              const Posn& start,
+                              const Posn& end,
+                              bool        invert) {
+  Walker walker(piece, tier, start, end, invert);
+  while (walker.next()) {
+    if (walker.isPathEnd() && walker.posn() == end) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+Bitboard AttackTable::expansionOf(effect_t    effect,
+                                  const Posn& posn,
+                                  colour_t    colour) {
+  // Black's territory is the top three ranks, and black moves top-down;
+  // white's territory is the bottom three ranks, and white moves bottom-up.
+  const bool inverted = colour == BLACK;
+  const unsigned int territoryLength = 3;
+
+  Bitboard squares;
+  if (effect == GUNGI_EFFECT_MOBILE_RANGE_EXPANSION_1) {
+    // Fortress mobile range expansion.  Affects the pieces on-top of the unit
+    // and in front of it, extending outside the territory in a straight line.
+    Posn p = posn;
+    while (p.isValid()) {
+      squares.set(p);
+      p.up(inverted);
+    }
+    return squares;
+  }
+
+  // Catapult mobile range expansion.  Affects the pieces on top of the unit
+  // and within the territory.  The shape formed is a diamond: 1-3-5-3-1
+  // centered around the current unit.
+  const int upAmounts[] = { 2, 1, 0, -1, -2 };
+  const int leftAmounts[] = { 0, 1, 2, 1, 0 };
+  const int rightAmounts[] = { 0, 2, 4, 2, 0 };
+  for (unsigned int i = 0; i < sizeof(upAmounts) / sizeof(int); i++) {
+    Posn p = posn;
+    for (int up = upAmounts[i]; up != 0; up += up < 0 ? 1 : -1) {
+      if (up < 0) {
+        p.down(inverted);
+      } else {
+        p.up(inverted);
+      }
+    }
+
+    const bool inTerritory = inverted
+      ? p.row() >= k_BOARD_LENGTH - territoryLength
+      : p.row() < territoryLength;
+    if (!p.isValid() || !inTerritory) {
+      continue;
+    }
+
+    for (int left = leftAmounts[i]; left > 0; left--) {
+      p.left(inverted);
+    }
+
+    for (int right = rightAmounts[i]; right >= 0; right--) {
+      if (p.isValid()) {
+        squares.set(p);
+      }
+      p.right(inverted);
+    }
+  }
+
+  return squares;
+}
+
+// PRIVATE CREATORS
+AttackTable::AttackTable(void)
+: m_reach()
+, m_between()
+, m_lines()
+, m_expansion()
+{
+  for (unsigned int from = 0; from < k_NUM_SQUARES; from++) {
+    const Posn start(from % k_BOARD_LENGTH, from / k_BOARD_LENGTH);
+
+    for (unsigned int to = 0; to < k_NUM_SQUARES; to++) {
+      const Posn end(to % k_BOARD_LENGTH, to / k_BOARD_LENGTH);
+
+      for (const Posn& posn : Util::crossed(start, end)) {
+        m_between[from][to].set(posn);
+      }
+
+      for (unsigned int piece = 0; piece < GUNGI_NUM_PIECES; piece++) {
+        for (tier_t tier = 0; tier < k_MAX_TOWER_SIZE; tier++) {
+          for (unsigned int inverted = 0; inverted < 2; inverted++) {
+            if (isReachable(static_cast<piece_id_t>(piece),
+                            tier,
+                            start,
+                            end,
+                            inverted)) {
+              m_reach[piece][tier][from][inverted].set(to);
+            }
+          }
+        }
+      }
+    }
+
+    // The lines need every square reachable from 'from', so they are built
+    // once the reach from 'from' is complete.
+    for (unsigned int piece = 0; piece < GUNGI_NUM_PIECES; piece++) {
+      for (tier_t tier = 0; tier < k_MAX_TOWER_SIZE; tier++) {
+        for (unsigned int inverted = 0; inverted < 2; inverted++) {
+          Bitboard& lines = m_lines[piece][tier][from][inverted];
+          Bitboard targets = m_reach[piece][tier][from][inverted];
+          while (targets.any()) {
+            lines |= m_between[from][targets.pop()];
+          }
+        }
+      }
+    }
+
+    const colour_t colours[] = { WHITE, BLACK };
+    for (unsigned int i = 0; i < 2; i++) {
+      m_expansion[0][from][i] =
+        expansionOf(GUNGI_EFFECT_MOBILE_RANGE_EXPANSION_1, start, colours[i]);
+      m_expansion[1][from][i] =
+        expansionOf(GUNGI_EFFECT_MOBILE_RANGE_EXPANSION_2, start, colours[i]);
+    }
+  }
+}
+
+}  // close 'gungi' namespace
@@ -0,0 +1,66 @@
+// bitboard.cpp                                                       -*-C++-*-
+#include "bitboard.hpp"
+
+#include "gtypes.hpp"
+#include "posn.hpp"
+
+#include <iostream>
+
+namespace gungi {
+
+// STATIC CLASS METHODS
+Bitboard Bitboard::file(unsigned int col) {
+  GASSERT(col < k_BOARD_LENGTH);
+
+  Bitboard board;
+  for (unsigned int row = 0; row < k_BOARD_LENGTH; row++) {
+    board.set(Posn(col, row));
+  }
+  return board;
+}
+
+Bitboard Bitboard::rank(unsigned int row) {
+  GASSERT(row < k_BOARD_LENGTH);
+
+  Bitboard board;
+  for (unsigned int col = 0; col < k_BOARD_LENGTH; col++) {
+    board.set(Posn(col, row));
+  }
+  return board;
+}
+
+Bitboard Bitboard::fromPosns(const PosnSet& posns) {
+  Bitboard board;
+  for (const Posn& posn : posns) {
+    if (posn.isValid()) {
+      board.set(posn);
+    }
+  }
+  return board;
+}
+
+// ACCESSORS
+PosnSet Bitboard::toPosns(void) const {
+  PosnSet posns;
+  posns.reserve(count());
+
+  Bitboard squares = *this;
+  while (squares.any()) {
+    const unsigned int idx = squares.pop();
+    posns.push_back(Posn(idx % k_BOARD_LENGTH, idx / k_BOARD_LENGTH));
+  }
+  return posns;
+}
+
+// OPERATORS
+std::ostream& operator<<(std::ostream& os, const Bitboard& board) {
+  for (int row = k_BOARD_LENGTH - 1; row >= 0; row--) {
+    for (unsigned int col = 0; col < k_BOARD_LENGTH; col++) {
+      os << (board.test(Posn(col, row)) ? '1' : '.');
+    }
+    os << std::endl;
+  }
+  return os;
+}
+
+}  // close 'gungi' namespace
@@ -0,0 +1,474 @@
+// engine.cpp                                                         -*-C++-*-
+#include "engine.hpp"
+
+#include "bitboard.hpp"
+#include "gtypes.hpp"
+#include "logician.hpp"
+#include "move.hpp"
+#include "player.hpp"
+#include "threadpool.hpp"
+#include "tower.hpp"
+#include "transpositiontable.hpp"
+#include "unit.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace gungi {
+
+namespace {
+
+const int k_PIECE_VALUES[GUNGI_NUM_PIECES] = {
+  // Value of a unit by its front, indexed by 'piece_id_t'.  A Pawn is worth
+  // a hundred; the other values follow the reach of each piece's moves.
+  100,   // Pawn
+  350,   // Bow
+  450,   // Prodigy
+  500,   // Hidden Dragon
+  300,   // Fortress
+  300,   // Catapult
+  350,   // Spy
+  400,   // Samurai
+  450,   // Captain
+  0,     // Commander
+  150,   // Bronze
+  300,   // Silver
+  350,   // Gold
+  300,   // Arrow
+  600,   // Phoenix
+  700,   // Dragon King
+  350,   // Lance
+  450,   // Clandestinite
+  400,   // Pike
+  400,   // Pistol
+};
+
+const int k_ATTACK_VALUE = 4;
+  // Value of each square attacked by a player's units.
+
+const int k_INFINITE_SCORE = Engine::k_MATE_SCORE + 1;
+  // Score outside of the range of any position.
+
+const int k_MATE_BOUND = Engine::k_MATE_SCORE - Engine::k_MAX_PLY;
+  // Least score of a checkmate found within the search.
+
+const int k_PV_ORDER = 1 << 30;
+  // Order of the move of the last principal variation, ahead of any other.
+
+const int k_HASH_ORDER = 1 << 29;
+  // Order of the best move stored in the transposition table, ahead of any
+  // capture.
+
+const int k_CAPTURE_ORDER = 1 << 20;
+  // Order of a capture, ahead of any move that does not capture.
+
+const uint64_t k_CLOCK_INTERVAL = 1024;
+  // Number of positions visited between reads of the clock.
+
+int toTable(int score, unsigned int ply) {
+  // Returns the given 'score' of a position at the given 'ply' as it is
+  // stored in the transposition table: a checkmate is counted from the
+  // position, rather than from the root, as the position may be reached at
+  // another ply.
+  if (score >= k_MATE_BOUND) {
+    return score + static_cast<int>(ply);
+  } else if (score <= -k_MATE_BOUND) {
+    return score - static_cast<int>(ply);
+  }
+  return score;
+}
+
+int fromTable(int score, unsigned int ply) {
+  // Returns the given 'score' stored in the transposition table as the score
+  // of a position at the given 'ply'.
+  if (score >= k_MATE_BOUND) {
+    return score - static_cast<int>(ply);
+  } else if (score <= -k_MATE_BOUND) {
+    return score + static_cast<int>(ply);
+  }
+  return score;
+}
+
+}  // close unnamed namespace
+
+// STATIC CLASS METHODS
+int Engine::evaluate(const Logician& game) {
+  const colour_t colour = game.isPlayersTurn(BLACK) ? BLACK : WHITE;
+  const colour_t enemy = colour == BLACK ? WHITE : BLACK;
+  const Player& own = colour == BLACK ? game.black() : game.white();
+  const Player& other = colour == BLACK ? game.white() : game.black();
+
+  int score = 0;
+  for (const Unit *unit : own.units()) {
+    score += value(unit->front());
+  }
+
+  for (const Unit *unit : other.units()) {
+    score -= value(unit->front());
+  }
+
+  // The attack maps are kept up to date by the game, so mobility is a count.
+  score += k_ATTACK_VALUE * static_cast<int>(game.attacked(colour).count());
+  score -= k_ATTACK_VALUE * static_cast<int>(game.attacked(enemy).count());
+  return score;
+}
+
+int Engine::value(piece_id_t piece) {
+  GASSERT(piece >= 0 && piece < GUNGI_NUM_PIECES);
+  return k_PIECE_VALUES[piece];
+}
+
+// PRIVATE MANIPULATORS
+void Engine::iterate(worker_t& worker, unsigned int idx) {
+  const unsigned int maxDepth = m_limits.depth && m_limits.depth < k_MAX_PLY
+                              ? m_limits.depth
+                              : k_MAX_PLY;
+
+  // Every other helper starts a ply deeper, so that the helpers do not all
+  // search the same depth at the same time.
+  const unsigned int first = idx % 2 == 1 && maxDepth > 1 ? 2 : 1;
+  for (unsigned int depth = first; depth <= maxDepth; depth++) {
+    const int score = negamax(worker,
+                              depth,
+                              0,
+                              -k_INFINITE_SCORE,
+                              k_INFINITE_SCORE);
+    if (m_stopped.load(std::memory_order_relaxed)) {
+      // The iteration did not complete, so its line may not be the best one;
+      // the line of the previous iteration stands.
+      break;
+    }
+
+    worker.line.assign(worker.pv[0], worker.pv[0] + worker.pvLength[0]);
+    worker.score = score;
+    worker.depth = depth;
+
+    if (score >= k_MATE_SCORE - static_cast<int>(depth) ||
+        score <= -k_MATE_SCORE + static_cast<int>(depth)) {
+      // The game ends within the depth searched whatever the players do, so
+      // a deeper search finds the same line.
+      break;
+    }
+  }
+
+  if (idx == 0) {
+    // The line of the main thread is the result, so the helpers stop with
+    // it.
+    m_stopped.store(true, std::memory_order_relaxed);
+  }
+}
+
+int Engine::negamax(worker_t&    worker,
+                    unsigned int depth,
+                    unsigned int ply,
+                    int          alpha,
+                    int          beta) {
+  worker.pvLength[ply] = ply;
+  worker.nodes.store(worker.nodes.load(std::memory_order_relaxed) + 1,
+                     std::memory_order_relaxed);
+  if (isStopped(worker)) {
+    return 0;
+  }
+
+  Logician& game = worker.game;
+  if (game.isOver()) {
+    // Only the player whose turn it is can be in checkmate.
+    return game.isDraw() ? 0 : -(k_MATE_SCORE - static_cast<int>(ply));
+  }
+
+  if (depth == 0 || ply == k_MAX_PLY) {
+    return evaluate(game);
+  }
+
+  // A pending forced recovery or rearrangement is not part of the key, so
+  // such a position is neither looked up nor stored.
+  const bool hashed = !game.isForcedRecovery() &&
+                      !game.isForcedRearrangement();
+  const uint64_t key = game.key();
+  TranspositionTable::entry_t entry;
+  Move hashMove;
+  if (hashed && m_table.probe(key, entry)) {
+    hashMove = entry.move;
+
+    // The root is always searched, so that it has a line.
+    const int score = fromTable(entry.score, ply);
+    if (ply > 0 &&
+        entry.depth >= depth &&
+        (entry.bound == TranspositionTable::BOUND_EXACT ||
+         (entry.bound == TranspositionTable::BOUND_LOWER && score >= beta) ||
+         (entry.bound == TranspositionTable::BOUND_UPPER && score <= alpha))) {
+      return score;
+    }
+  }
+
+  ply_t& current = worker.plies[ply];
+  game.generateMoves(current.moves);
+  if (current.moves.empty()) {
+    return 0;
+  }
+
+  orderMoves(worker, ply, hashMove);
+
+  const colour_t colour = game.isPlayersTurn(BLACK) ? BLACK : WHITE;
+  const int originalAlpha = alpha;
+  int best = -k_INFINITE_SCORE;
+  Move bestMove;
+  error_t error;
+  for (unsigned int i = 0; i < current.moves.size(); i++) {
+    const Move move = nextMove(worker, ply, i);
+
+    Logician::turn_t turn;
+    game.makeMove(move, turn, error);
+    GASSERT(error == GUNGI_ERROR_NONE);
+
+    // The player settling a forced recovery moves again, so the score of the
+    // position after it is already from their point of view.
+    const int score = game.isPlayersTurn(colour)
+                    ? negamax(worker, depth - 1, ply + 1, alpha, beta)
+                    : -negamax(worker, depth - 1, ply + 1, -beta, -alpha);
+
+    game.unmakeMove(turn);
+    if (m_stopped.load(std::memory_order_relaxed)) {
+      return 0;
+    }
+
+    if (score > best) {
+      best = score;
+      bestMove = move;
+    }
+
+    if (score > alpha) {
+      // The move is the best so far, so the line through it is the best line
+      // from this ply.
+      alpha = score;
+      worker.pv[ply][ply] = move;
+      for (unsigned int j = ply + 1; j < worker.pvLength[ply + 1]; j++) {
+        worker.pv[ply][j] = worker.pv[ply + 1][j];
+      }
+
+      worker.pvLength[ply] = worker.pvLength[ply + 1];
+    }
+
+    if (alpha >= beta) {
+      break;
+    }
+  }
+
+  if (hashed) {
+    // No move raised alpha when every move failed low, so none is known to be
+    // best, and the move already stored is kept.
+    entry.bound = best >= beta
+                ? TranspositionTable::BOUND_LOWER
+                : best > originalAlpha
+                ? TranspositionTable::BOUND_EXACT
+                : TranspositionTable::BOUND_UPPER;
+    entry.move = entry.bound == TranspositionTable::BOUND_UPPER
+               ? Move()
+               : bestMove;
+    entry.score = toTable(best, ply);
+    entry.depth = depth;
+    m_table.store(key, entry);
+  }
+
+  return best;
+}
+
+void Engine::orderMoves(worker_t&    worker,
+                        unsigned int ply,
+                        const Move&  hashMove) {
+  ply_t& current = worker.plies[ply];
+  const Logician& game = worker.game;
+  const board_t& board = game.board();
+
+  for (unsigned int i = 0; i < current.moves.size(); i++) {
+    const Move& move = current.moves[i];
+    int order = 0;
+    if (ply < worker.line.size() && move == worker.line[ply]) {
+      order = k_PV_ORDER;
+    } else if (move == hashMove) {
+      order = k_HASH_ORDER;
+    } else if (move.type() == Move::MOVE_TYPE_MOVE ||
+               move.type() == Move::MOVE_TYPE_IMMOBILE_STRIKE) {
+      // Captures of the most valuable units by the least valuable units come
+      // first.
+      const Unit *unit = game.unit(move.unit());
+      const Unit *target = move.type() == Move::MOVE_TYPE_MOVE
+                         ? game.unit(board[move.square()].top())
+                         : game.unit(move.target());
+      if (target && target->colour() != unit->colour()) {
+        order = k_CAPTURE_ORDER
+              + 16 * value(target->front())
+              - value(unit->front()) / 16;
+      }
+    }
+
+    current.scores[i] = order;
+  }
+}
+
+const Move& Engine::nextMove(worker_t&    worker,
+                             unsigned int ply,
+                             unsigned int idx) {
+  ply_t& current = worker.plies[ply];
+
+  unsigned int best = idx;
+  for (unsigned int i = idx + 1; i < current.moves.size(); i++) {
+    if (current.scores[i] > current.scores[best]) {
+      best = i;
+    }
+  }
+
+  if (best != idx) {
+    // The moves before 'idx' have been searched, so the best of the rest is
+    // swapped in after them, along with its score.
+    current.moves.swap(idx, best);
+    const int score = current.scores[idx];
+    current.scores[idx] = current.scores[best];
+    current.scores[best] = score;
+  }
+
+  return current.moves[idx];
+}
+
+bool Engine::isStopped(worker_t& worker) {
+  if (m_stopped.load(std::memory_order_relaxed)) {
+    return true;
+  } else if (&worker != m_workers[0].get()) {
+    // Only the main thread keeps track of the limits.
+    return false;
+  }
+
+  // The nodes of every thread are only added up once in a while, unless the
+  // main thread is the only one.
+  const uint64_t nodes = worker.nodes.load(std::memory_order_relaxed);
+  const bool interval = nodes % k_CLOCK_INTERVAL == 0;
+  bool stop = false;
+  if (m_limits.nodes &&
+      (m_workers.size() == 1 || interval) &&
+      this->nodes() > m_limits.nodes) {
+    stop = true;
+  } else if (m_limits.milliseconds && interval) {
+    const std::chrono::milliseconds elapsed =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - m_start);
+    stop = elapsed.count() >= m_limits.milliseconds;
+  }
+
+  if (stop) {
+    m_stopped.store(true, std::memory_order_relaxed);
+  }
+  return stop;
+}
+
+// CREATORS
+Engine::Engine(unsigned int numThreads,
+               unsigned int megabytes,
+               bool         hugePages)
+: m_workers()
+, m_pool()
+, m_table(megabytes, hugePages)
+, m_limits()
+, m_start()
+, m_stopped(false)
+{
+  if (numThreads == 0) {
+    numThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  for (unsigned int idx = 0; idx < numThreads; idx++) {
+    std::unique_ptr<worker_t> worker(new worker_t());
+    worker->plies.resize(k_MAX_PLY);
+    worker->line.reserve(k_MAX_PLY);
+    worker->score = 0;
+    worker->depth = 0;
+    worker->nodes.store(0);
+    m_workers.push_back(std::move(worker));
+  }
+
+  if (numThreads > 1) {
+    m_pool.reset(new ThreadPool(numThreads));
+  }
+}
+
+// MANIPULATORS
+void Engine::clear(void) {
+  m_table.clear();
+}
+
+Move Engine::search(const Logician& game, const limits_t& limits) {
+  m_limits = limits;
+  m_start = std::chrono::steady_clock::now();
+  m_stopped.store(false);
+  m_table.newSearch();
+
+  for (const std::unique_ptr<worker_t>& worker : m_workers) {
+    // Assignment reuses the storage of the worker's game.
+    worker->game = game;
+    worker->line.clear();
+    worker->score = 0;
+    worker->depth = 0;
+    worker->nodes.store(0);
+  }
+
+  if (game.isOver()) {
+    return Move();
+  }
+
+  MoveList moves;
+  game.generateMoves(moves);
+  if (moves.empty()) {
+    return Move();
+  }
+
+  if (m_pool) {
+    m_pool->run(m_workers.size(), [this](unsigned int idx) {
+      iterate(*m_workers[idx], idx);
+    });
+  } else {
+    iterate(*m_workers[0], 0);
+  }
+
+  worker_t& main = *m_workers[0];
+  if (main.line.empty()) {
+    // Not even the first iteration completed, so any legal move will do.
+    main.line.push_back(moves[0]);
+  }
+
+  return main.line[0];
+}
+
+// ACCESSORS
+int Engine::score(void) const {
+  return m_workers[0]->score;
+}
+
+unsigned int Engine::depth(void) const {
+  return m_workers[0]->depth;
+}
+
+uint64_t Engine::nodes(void) const {
+  uint64_t nodes = 0;
+  for (const std::unique_ptr<worker_t>& worker : m_workers) {
+    nodes += worker->nodes.load(std::memory_order_relaxed);
+  }
+  return nodes;
+}
+
+unsigned int Engine::numThreads(void) const {
+  return m_workers.size();
+}
+
+const TranspositionTable& Engine::table(void) const {
+  return m_table;
+}
+
+const std::vector<Move>& Engine::principalVariation(void) const {
+  return m_workers[0]->line;
+}
+
+}  // close 'gungi' namespace
@@ -0,0 +1,712 @@
+// gnarchive.cpp                                                      -*-C++-*-
+#include "gnarchive.hpp"
+
+#include "gndecoder.hpp"
+#include "gnencoder.hpp"
+#include "gnreader.hpp"
+#include "gtypes.hpp"
+#include "logician.hpp"
+#include "move.hpp"
+#include "posn.hpp"
+#include "tower.hpp"
+#include "unit.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace gungi {
+
+namespace {
+
+const unsigned int k_NUM_SQUARES = 81;
+  // Number of squares of the board.
+
+inline uint32_t load32(const uint8_t *bytes) {
+  // Returns the little-endian number of four bytes at the given 'bytes'.
+  return static_cast<uint32_t>(bytes[0]) |
+         static_cast<uint32_t>(bytes[1]) << 8 |
+         static_cast<uint32_t>(bytes[2]) << 16 |
+         static_cast<uint32_t>(bytes[3]) << 24;
+}
+
+inline uint64_t load64(const uint8_t *bytes) {
+  // Returns the little-endian number of eight bytes at the given 'bytes'.
+  return static_cast<uint64_t>(load32(bytes)) |
+         static_cast<uint64_t>(load32(bytes + 4)) << 32;
+}
+
+inline void store32(uint8_t *bytes, uint32_t value) {
+  // Stores the given 'value' as four little-endian bytes at the given
+  // 'bytes'.
+  bytes[0] = static_cast<uint8_t>(value);
+  bytes[1] = static_cast<uint8_t>(value >> 8);
+  bytes[2] = static_cast<uint8_t>(value >> 16);
+  bytes[3] = static_cast<uint8_t>(value >> 24);
+}
+
+inline void store64(uint8_t *bytes, uint64_t value) {
+  // Stores the given 'value' as eight little-endian bytes at the given
+  // 'bytes'.
+  store32(bytes, static_cast<uint32_t>(value));
+  store32(bytes + 4, static_cast<uint32_t>(value >> 32));
+}
+
+inline bool hasIdentifiers(uint8_t type) {
+  // Returns 'true' if a move of the given 'type' keeps the identifiers of its
+  // unit when packed, otherwise 'false'.
+  return type == GNDecoder::TOKEN_DROP ||
+         type == GNDecoder::TOKEN_RECOVER ||
+         type == GNDecoder::TOKEN_RECOVER_TO_OPPONENT ||
+         type == GNDecoder::TOKEN_NO_RECOVER;
+}
+
+bool packPiece(char identifier, bool front, uint32_t& piece) {
+  // Loads into the given output parameter, 'piece', the piece of the given
+  // Gungi Notation 'identifier' plus one, or zero for no piece.  Returns
+  // 'true' on success, otherwise 'false' if the 'identifier' is unknown, or
+  // is no piece for the given 'front' of a unit.
+  const char id[2] = { identifier, '\0' };
+  const piece_id_t value = gn_identifier_to_piece(id);
+  if (value == GUNGI_PIECE_NONE) {
+    piece = 0;
+    return !front && identifier == '-';
+  }
+
+  piece = static_cast<uint32_t>(value) + 1;
+  return true;
+}
+
+bool writeOut(int fd, const uint8_t *bytes, size_t length) {
+  // Writes the given 'length' bytes starting at the given 'bytes' out to the
+  // given file descriptor, 'fd'.  Returns 'true' on success, otherwise
+  // 'false'.
+  while (length > 0) {
+    const ssize_t written = ::write(fd, bytes, length);
+    if (written < 0 && errno == EINTR) {
+      continue;
+    } else if (written <= 0) {
+      return false;
+    }
+
+    bytes += written;
+    length -= written;
+  }
+  return true;
+}
+
+}  // close unnamed namespace
+
+                               // ===============
+                               // class GNArchive
+                               // ===============
+
+// STATIC CLASS MEMBERS
+const size_t GNArchive::k_PLY_SIZE;
+const size_t GNArchive::k_MAGIC_SIZE;
+const size_t GNArchive::k_GAME_SIZE;
+const size_t GNArchive::k_FOOTER_SIZE;
+const char GNArchive::k_MAGIC[k_MAGIC_SIZE + 1] = "GNARCHIV";
+
+// PRIVATE MANIPULATORS
+bool GNArchive::index(void) {
+  // Every offset is checked against the length of the archive, so that a
+  // malformed archive is not read past its end.
+  if (m_length < k_MAGIC_SIZE + k_FOOTER_SIZE ||
+      std::memcmp(m_data, k_MAGIC, k_MAGIC_SIZE) != 0 ||
+      std::memcmp(m_data + m_length - k_MAGIC_SIZE,
+                  k_MAGIC,
+                  k_MAGIC_SIZE) != 0) {
+    return false;
+  }
+
+  const uint64_t footer = m_length - k_FOOTER_SIZE;
+  const uint8_t *ch = m_data + footer;
+  const uint64_t gamesOffset = load64(ch);
+  const uint64_t stringsOffset = load64(ch + 8);
+  const uint32_t numGames = load32(ch + 16);
+  const uint32_t numStrings = load32(ch + 20);
+
+  const uint64_t charactersOffset =
+    stringsOffset + (static_cast<uint64_t>(numStrings) + 1) * 8;
+  if (gamesOffset < k_MAGIC_SIZE ||
+      gamesOffset > footer ||
+      stringsOffset > footer ||
+      stringsOffset < gamesOffset ||
+      (stringsOffset - gamesOffset) % k_GAME_SIZE != 0 ||
+      (stringsOffset - gamesOffset) / k_GAME_SIZE != numGames ||
+      charactersOffset > footer) {
+    return false;
+  }
+
+  m_games = m_data + gamesOffset;
+  m_strings = m_data + stringsOffset;
+  m_characters = m_data + charactersOffset;
+  m_numGames = numGames;
+  m_numStrings = numStrings;
+
+  // The strings end where the footer starts.
+  return load64(m_strings + numStrings * 8) == footer - charactersOffset;
+}
+
+// PRIVATE ACCESSORS
+const uint8_t *GNArchive::game(size_t game) const {
+  return m_games + game * k_GAME_SIZE;
+}
+
+bool GNArchive::string(uint32_t id, std::string& value) const {
+  if (id >= m_numStrings) {
+    return false;
+  }
+
+  const uint64_t begin = load64(m_strings + id * 8);
+  const uint64_t end = load64(m_strings + (id + 1) * 8);
+  const uint64_t length = load64(m_strings + m_numStrings * 8);
+  if (begin > end || end > length) {
+    return false;
+  }
+
+  value.assign(reinterpret_cast<const char *>(m_characters) + begin,
+               end - begin);
+  return true;
+}
+
+bool GNArchive::play(size_t                           game,
+                     unsigned int                     numPlies,
+                     Controller&                      controller,
+                     unsigned int&                    plies,
+                     std::vector<GNDecoder::token_t> *tokens,
+                     std::vector<colour_t>           *colours) const {
+  plies = 0;
+  if (game >= m_numGames) {
+    return false;
+  }
+
+  const unsigned int count = this->numPlies(game);
+  if (numPlies > count) {
+    numPlies = count;
+  }
+
+  const uint8_t *bytes = m_data + load64(this->game(game));
+  for (; plies < numPlies; plies++, bytes += k_PLY_SIZE) {
+    GNDecoder::token_t token;
+    if (!unpackMove(bytes, token)) {
+      return false;
+    }
+
+    if (!hasIdentifiers(token.type)) {
+      // The move is made by the unit at the square and tier it is from.
+      error_t error;
+      const Posn posn(token.col, token.row);
+      const Unit *unit =
+        controller.unit(controller.board()[posn.index()].at(token.tier,
+                                                            error));
+      if (!unit) {
+        return false;
+      }
+
+      token.front = *piece_to_gn_identifier(unit->front());
+      token.back = *piece_to_gn_identifier(unit->back());
+    }
+
+    const colour_t colour = controller.isPlayersTurn(BLACK) ? BLACK : WHITE;
+    if (!GNDecoder::applyMove(token, controller)) {
+      return false;
+    }
+
+    if (tokens) {
+      tokens->push_back(token);
+      colours->push_back(colour);
+    }
+  }
+
+  return true;
+}
+
+// CREATORS
+GNArchive::GNArchive(void)
+: m_data(NULL)
+, m_length(0)
+, m_map(NULL)
+, m_games(NULL)
+, m_strings(NULL)
+, m_characters(NULL)
+, m_numGames(0)
+, m_numStrings(0)
+{
+  // DO NOTHING
+}
+
+GNArchive::~GNArchive(void) {
+  close();
+}
+
+// MANIPULATORS
+bool GNArchive::open(const std::string& path) {
+  close();
+
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+    // An empty file cannot be mapped, and is not an archive.
+    ::close(fd);
+    return false;
+  }
+
+  const size_t length = static_cast<size_t>(st.st_size);
+  void *map = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (map == MAP_FAILED) {
+    return false;
+  }
+
+  m_map = map;
+  m_data = static_cast<const uint8_t *>(map);
+  m_length = length;
+  if (!index()) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+bool GNArchive::open(const char *data, size_t length) {
+  close();
+
+  m_data = reinterpret_cast<const uint8_t *>(data);
+  m_length = length;
+  if (!index()) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+void GNArchive::close(void) {
+  if (m_map) {
+    munmap(m_map, m_length);
+  }
+
+  m_data = NULL;
+  m_length = 0;
+  m_map = NULL;
+  m_games = NULL;
+  m_strings = NULL;
+  m_characters = NULL;
+  m_numGames = 0;
+  m_numStrings = 0;
+}
+
+// ACCESSORS
+size_t GNArchive::numGames(void) const {
+  return m_numGames;
+}
+
+unsigned int GNArchive::numPlies(size_t game) const {
+  if (game >= m_numGames) {
+    return 0;
+  }
+
+  // A game whose moves are not between the magic string and the table of
+  // games is malformed, and has none.
+  const uint8_t *entry = this->game(game);
+  const uint64_t offset = load64(entry);
+  const uint64_t numPlies = load32(entry + 8);
+  const uint64_t end = m_games - m_data;
+  if (offset < k_MAGIC_SIZE ||
+      offset > end ||
+      numPlies > (end - offset) / k_PLY_SIZE) {
+    return 0;
+  }
+  return static_cast<unsigned int>(numPlies);
+}
+
+bool GNArchive::metadata(size_t game, GNMetadata& md) const {
+  md.clear();
+  if (game >= m_numGames) {
+    return false;
+  }
+
+  const uint8_t *ids = this->game(game) + 12;
+  std::string value;
+  if (!string(load32(ids), value)) {
+    return false;
+  }
+  md.setEvent(value);
+
+  if (!string(load32(ids + 4), value) ||
+      (!value.empty() && !md.setDate(value))) {
+    return false;
+  }
+
+  if (!string(load32(ids + 8), value)) {
+    return false;
+  }
+  md.setLocation(value);
+
+  if (!string(load32(ids + 12), value)) {
+    return false;
+  }
+  md.setWhite(value);
+
+  if (!string(load32(ids + 16), value)) {
+    return false;
+  }
+  md.setBlack(value);
+  return true;
+}
+
+bool GNArchive::move(size_t              game,
+                     unsigned int        ply,
+                     GNDecoder::token_t& token) const {
+  if (ply >= numPlies(game)) {
+    return false;
+  }
+
+  const uint8_t *bytes = m_data + load64(this->game(game)) + ply * k_PLY_SIZE;
+  return unpackMove(bytes, token);
+}
+
+bool GNArchive::replay(size_t        game,
+                       unsigned int  numPlies,
+                       Controller&   controller,
+                       unsigned int& plies) const {
+  return play(game, numPlies, controller, plies, NULL, NULL);
+}
+
+bool GNArchive::write(size_t game, GNEncoder& encoder) const {
+  // The result in the header is only known once every move is played, so
+  // the moves are kept as they are played, and written after the header.
+  GNMetadata md;
+  Controller controller;
+  std::vector<GNDecoder::token_t> tokens;
+  std::vector<colour_t> colours;
+  unsigned int plies;
+  if (!metadata(game, md) ||
+      !play(game, numPlies(game), controller, plies, &tokens, &colours) ||
+      plies != numPlies(game)) {
+    return false;
+  }
+
+  if (!encoder.writeHeader(md, controller)) {
+    return false;
+  }
+
+  for (size_t idx = 0; idx < tokens.size(); idx++) {
+    if (!encoder.writeMove(tokens[idx], colours[idx])) {
+      return false;
+    }
+  }
+
+  return encoder.endGame();
+}
+
+size_t GNArchive::size(void) const {
+  return m_length;
+}
+
+// STATIC CLASS MEMBERS
+bool GNArchive::packMove(const GNDecoder::token_t& token, uint8_t *bytes) {
+  // The move is packed into 24 bits: its kind in bits 0 to 3, its square in
+  // bits 4 to 10, and its tier in bits 11 and 12.  The bits from 13 hold the
+  // identifiers of a drop or forced recovery, five bits each, the tier of an
+  // immobile strike or 1-3 tier exchange, or the square and tier moved to of
+  // the other moves.
+  if (token.type == GNDecoder::TOKEN_NONE ||
+      token.type > GNDecoder::TOKEN_TIER_EXCHANGE ||
+      token.col > 8 || token.row > 8 || token.tier >= k_MAX_TOWER_SIZE) {
+    return false;
+  }
+
+  uint32_t value = token.type |
+                   (token.row * 9u + token.col) << 4 |
+                   static_cast<uint32_t>(token.tier) << 11;
+  if (hasIdentifiers(token.type)) {
+    uint32_t front;
+    uint32_t back;
+    if (!packPiece(token.front, true, front) ||
+        !packPiece(token.back, false, back)) {
+      return false;
+    }
+    value |= front << 13 | back << 18;
+  } else if (token.type == GNDecoder::TOKEN_IMMOBILE_STRIKE ||
+             token.type == GNDecoder::TOKEN_TIER_EXCHANGE) {
+    if (token.toTier >= k_MAX_TOWER_SIZE) {
+      return false;
+    }
+    value |= static_cast<uint32_t>(token.toTier) << 13;
+  } else {
+    if (token.toCol > 8 || token.toRow > 8 ||
+        token.toTier >= k_MAX_TOWER_SIZE) {
+      return false;
+    }
+    value |= (token.toRow * 9u + token.toCol) << 13 |
+             static_cast<uint32_t>(token.toTier) << 20;
+  }
+
+  bytes[0] = static_cast<uint8_t>(value);
+  bytes[1] = static_cast<uint8_t>(value >> 8);
+  bytes[2] = static_cast<uint8_t>(value >> 16);
+  return true;
+}
+
+bool GNArchive::unpackMove(const uint8_t *bytes, GNDecoder::token_t& token) {
+  const uint32_t value = static_cast<uint32_t>(bytes[0]) |
+                         static_cast<uint32_t>(bytes[1]) << 8 |
+                         static_cast<uint32_t>(bytes[2]) << 16;
+  const uint32_t square = value >> 4 & 0x7F;
+  token.type = static_cast<uint8_t>(value & 0xF);
+  token.front = '\0';
+  token.back = '\0';
+  token.col = static_cast<uint8_t>(square % 9);
+  token.row = static_cast<uint8_t>(square / 9);
+  token.tier = static_cast<uint8_t>(value >> 11 & 0x3);
+  token.toCol = 0;
+  token.toRow = 0;
+  token.toTier = 0;
+
+  if (token.type == GNDecoder::TOKEN_NONE ||
+      token.type > GNDecoder::TOKEN_TIER_EXCHANGE ||
+      square >= k_NUM_SQUARES ||
+      token.tier >= k_MAX_TOWER_SIZE) {
+    return false;
+  }
+
+  if (hasIdentifiers(token.type)) {
+    const uint32_t front = value >> 13 & 0x1F;
+    const uint32_t back = value >> 18 & 0x1F;
+    if (front == 0 || front > GUNGI_NUM_PIECES ||
+        back > GUNGI_NUM_PIECES || value >> 23 != 0) {
+      return false;
+    }
+
+    token.front =
+      *piece_to_gn_identifier(static_cast<piece_id_t>(front - 1));
+    token.back = back == 0 ? '-' :
+      *piece_to_gn_identifier(static_cast<piece_id_t>(back - 1));
+  } else if (token.type == GNDecoder::TOKEN_IMMOBILE_STRIKE ||
+             token.type == GNDecoder::TOKEN_TIER_EXCHANGE) {
+    token.toTier = static_cast<uint8_t>(value >> 13 & 0x3);
+    if (token.toTier >= k_MAX_TOWER_SIZE || value >> 15 != 0) {
+      return false;
+    }
+  } else {
+    const uint32_t toSquare = value >> 13 & 0x7F;
+    token.toCol = static_cast<uint8_t>(toSquare % 9);
+    token.toRow = static_cast<uint8_t>(toSquare / 9);
+    token.toTier = static_cast<uint8_t>(value >> 20 & 0x3);
+    if (toSquare >= k_NUM_SQUARES ||
+        token.toTier >= k_MAX_TOWER_SIZE ||
+        value >> 22 != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+                            // =====================
+                            // class GNArchiveWriter
+                            // =====================
+
+// PRIVATE MANIPULATORS
+bool GNArchiveWriter::write(const void *bytes, size_t length) {
+  if (m_failed) {
+    return false;
+  }
+
+  const uint8_t *ch = static_cast<const uint8_t *>(bytes);
+  m_offset += length;
+  while (length > 0) {
+    if (m_length == k_BUFFER_SIZE && !flush()) {
+      return false;
+    }
+
+    const size_t count = std::min(length, k_BUFFER_SIZE - m_length);
+    std::memcpy(m_buffer.get() + m_length, ch, count);
+    m_length += count;
+    ch += count;
+    length -= count;
+  }
+  return true;
+}
+
+bool GNArchiveWriter::flush(void) {
+  if (m_failed) {
+    return false;
+  }
+
+  if (!writeOut(m_fd, m_buffer.get(), m_length)) {
+    m_failed = true;
+    return false;
+  }
+
+  m_length = 0;
+  return true;
+}
+
+uint32_t GNArchiveWriter::intern(const std::string& value) {
+  std::unordered_map<std::string, uint32_t>::const_iterator it =
+                                                     m_stringIds.find(value);
+  if (it != m_stringIds.end()) {
+    return it->second;
+  }
+
+  const uint32_t id = static_cast<uint32_t>(m_strings.size());
+  m_stringIds.insert(std::make_pair(value, id));
+  m_strings.push_back(value);
+  return id;
+}
+
+// CREATORS
+GNArchiveWriter::GNArchiveWriter(int fd)
+: m_buffer(new uint8_t[k_BUFFER_SIZE])
+, m_length(0)
+, m_offset(0)
+, m_fd(fd)
+, m_failed(false)
+, m_finished(false)
+, m_games()
+, m_strings()
+, m_stringIds()
+, m_tokens()
+, m_plies()
+{
+  write(GNArchive::k_MAGIC, GNArchive::k_MAGIC_SIZE);
+}
+
+GNArchiveWriter::~GNArchiveWriter(void) {
+  finish();
+}
+
+// MANIPULATORS
+bool GNArchiveWriter::addGame(const GNMetadata&                      md,
+                              const std::vector<GNDecoder::token_t>& tokens) {
+  if (m_failed || m_finished || tokens.size() > UINT32_MAX) {
+    return false;
+  }
+
+  // Every move is packed before any is written, so that a game with a
+  // malformed move is not added.
+  m_plies.resize(tokens.size() * GNArchive::k_PLY_SIZE);
+  for (size_t idx = 0; idx < tokens.size(); idx++) {
+    if (!GNArchive::packMove(tokens[idx],
+                             &m_plies[idx * GNArchive::k_PLY_SIZE])) {
+      return false;
+    }
+  }
+
+  const uint64_t offset = m_offset;
+  if (!m_plies.empty()) {
+    write(&m_plies[0], m_plies.size());
+  }
+
+  uint8_t entry[GNArchive::k_GAME_SIZE];
+  store64(entry, offset);
+  store32(entry + 8, static_cast<uint32_t>(tokens.size()));
+  store32(entry + 12, intern(md.event()));
+  store32(entry + 16, intern(md.date()));
+  store32(entry + 20, intern(md.location()));
+  store32(entry + 24, intern(md.white()));
+  store32(entry + 28, intern(md.black()));
+  m_games.insert(m_games.end(), entry, entry + GNArchive::k_GAME_SIZE);
+  return !m_failed;
+}
+
+bool GNArchiveWriter::addGame(const GNMetadata&        md,
+                              const std::vector<Move>& moves) {
+  Controller controller;
+  m_tokens.clear();
+  for (const Move& move : moves) {
+    GNDecoder::token_t token;
+    if (!GNEncoder::tokenize(controller, move, token)) {
+      return false;
+    }
+
+    error_t error = GUNGI_ERROR_NONE;
+    controller.playMove(move, error);
+    if (error != GUNGI_ERROR_NONE) {
+      return false;
+    }
+    m_tokens.push_back(token);
+  }
+
+  return addGame(md, m_tokens);
+}
+
+bool GNArchiveWriter::addGame(const GNReader::game_t& game) {
+  Controller controller;
+  unsigned int plies;
+  if (!game.valid || !GNReader::replay(game, controller, plies, m_tokens)) {
+    return false;
+  }
+
+  return addGame(game.metadata, m_tokens);
+}
+
+bool GNArchiveWriter::finish(void) {
+  if (m_finished) {
+    return !m_failed;
+  }
+  m_finished = true;
+
+  const uint64_t gamesOffset = m_offset;
+  if (!m_games.empty()) {
+    write(&m_games[0], m_games.size());
+  }
+
+  // The offsets of the strings, then their characters.
+  const uint64_t stringsOffset = m_offset;
+  uint64_t stringOffset = 0;
+  uint8_t bytes[8];
+  for (const std::string& value : m_strings) {
+    store64(bytes, stringOffset);
+    write(bytes, 8);
+    stringOffset += value.size();
+  }
+  store64(bytes, stringOffset);
+  write(bytes, 8);
+
+  for (const std::string& value : m_strings) {
+    write(value.data(), value.size());
+  }
+
+  uint8_t footer[GNArchive::k_FOOTER_SIZE];
+  store64(footer, gamesOffset);
+  store64(footer + 8, stringsOffset);
+  store32(footer + 16, static_cast<uint32_t>(numGames()));
+  store32(footer + 20, static_cast<uint32_t>(m_strings.size()));
+  std::memcpy(footer + 24, GNArchive::k_MAGIC, GNArchive::k_MAGIC_SIZE);
+  write(footer, GNArchive::k_FOOTER_SIZE);
+
+  return flush();
+}
+
+// ACCESSORS
+size_t GNArchiveWriter::numGames(void) const {
+  return m_games.size() / GNArchive::k_GAME_SIZE;
+}
+
+uint64_t GNArchiveWriter::size(void) const {
+  return m_offset;
+}
+
+bool GNArchiveWriter::good(void) const {
+  return !m_failed;
+}
+
+}  // close 'gungi' namespace
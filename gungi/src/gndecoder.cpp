@@ -7,6 +7,8 @@
 #include "tower.hpp"
 #include "util.hpp"
 
+#include <cctype>
+#include <cstddef>
 #include <cstdio>
 #include <iostream>
 #include <sstream>
@@ -16,6 +18,15 @@
 
 namespace gungi {
 
+namespace {
+
+inline bool isDigit(char ch) {
+  // Returns 'true' if the given 'ch' is a decimal digit, otherwise 'false'.
+  return static_cast<unsigned char>(ch - '0') <= 9;
+}
+
+}  // close unnamed namespace
+
                                // ================
                                // class GNMetadata
                                // ================
@@ -97,15 +108,36 @@ void GNMetadata::setEvent(const std::string& event) {
 }
 
 bool GNMetadata::setDate(const std::string& date) {
-  unsigned int year, month, day;
-  if (sscanf(date.c_str(), "%u.%u.%u", &year, &month, &day)) {
-    if (month > 12 || day > 31) {
+  // The fields are read by hand, as 'sscanf()' costs more than the rest of a
+  // header when reading many games.
+  unsigned int fields[3] = { 0, 0, 0 };
+  size_t idx = 0;
+  for (unsigned int field = 0; field < 3; field++) {
+    if (field > 0) {
+      if (idx == date.size() || date[idx] != '.') {
+        return false;
+      }
+      idx++;
+    }
+
+    const size_t start = idx;
+    for (; idx < date.size() && date[idx] >= '0' && date[idx] <= '9'; idx++) {
+      fields[field] = fields[field] * 10 + (date[idx] - '0');
+    }
+
+    if (idx == start) {
       return false;
     }
-    m_date = date;
-    return true;
   }
-  return false;
+
+  const unsigned int month = fields[1];
+  const unsigned int day = fields[2];
+  if (month > 12 || day > 31) {
+    return false;
+  }
+
+  m_date = date;
+  return true;
 }
 
 void GNMetadata::setLocation(const std::string& location) {
@@ -120,6 +152,14 @@ void GNMetadata::setBlack(const std::string& name) {
   m_black = name;
 }
 
+void GNMetadata::clear(void) {
+  m_event.clear();
+  m_date.clear();
+  m_location.clear();
+  m_white.clear();
+  m_black.clear();
+}
+
 
                                 // ===============
                                 // class GNDecoder
@@ -218,312 +258,6 @@ bool GNDecoder::decodeHeader(std::stringstream& ss, GNMetadata& md) {
   return true;
 }
 
-bool GNDecoder::decodeMove(std::string move, Controller& controller) {
-  char front[2] = { 0 };
-  char back[2] = { 0 };
-  unsigned int row1, row2, col1, col2, tier1, tier2;
-  colour_t colour = controller.isPlayersTurn(BLACK) ? BLACK : WHITE;
-  const std::vector<Tower>& towers = controller.board();
-  error_t error = GUNGI_ERROR_NONE;
-
-  if (sscanf(move.c_str(),
-             "%c%c<%u-%u-%u>%u-%u-%u",
-             front,
-             back,
-             &col1,
-             &row1,
-             &tier1,
-             &col2,
-             &row2,
-             &tier2) == 8) {
-    // Move.
-    Posn from(col1, row1);
-    Posn to(col2, row2);
-    if (!to.isValid() || !from.isValid()) {
-      return false;
-    } else if (towers[to.index()].height() != tier2 &&
-               towers[to.index()].height() != tier2 + 1) {
-      // Not moving into the top of the tower, so invalidate this parameter, as
-      // it is not actually passed to the '.moveUnit()' call.
-      return false;
-    }
-
-    piece_id_t frontPiece = gn_identifier_to_piece(front);
-    piece_id_t backPiece = gn_identifier_to_piece(back);
-    const Unit *unit = towers[from.index()].at(tier1, error);
-    if (!unit ||
-        unit->front() != frontPiece ||
-        unit->back() != backPiece ||
-        unit->colour() != colour) {
-      // Have to validate the unit is the correct one as well, since this is
-      // not checked by the controller call.
-      return false;
-    }
-
-    controller.moveUnit(from, tier1, to, error);
-  } else if (sscanf(move.c_str(),
-                    "%c%c*%u-%u-%u",
-                    front,
-                    back,
-                    &col1,
-                    &row1,
-                    &tier1) == 5) {
-    // Drop.
-    Posn to(col1, row1);
-    if (to.isValid() && towers[to.index()].height() != tier1) {
-      // Not moving into the top of the tower, so invalidate this parameter, as
-      // it is not actually passed to the '.dropUnit()' call.
-      return false;
-    }
-
-    piece_id_t frontPiece = gn_identifier_to_piece(front);
-    piece_id_t backPiece = gn_identifier_to_piece(back);
-    controller.dropUnit(frontPiece, backPiece, to, error);
-  } else if (sscanf(move.c_str(),
-                    "%c%c<%u-%u-%ux%u-%u-%u",
-                    front,
-                    back,
-                    &col1,
-                    &row1,
-                    &tier1,
-                    &col2,
-                    &row2,
-                    &tier2) == 8) {
-    // Mobile strike.
-    Posn from(col1, row1);
-    Posn to(col2, row2);
-    if (!to.isValid() || !from.isValid()) {
-      return false;
-    } else if (towers[to.index()].height() != tier2 + 1) {
-      // Not moving into the top of the tower, so invalidate this parameter, as
-      // it is not actually passed to the '.moveUnit()' call.
-      return false;
-    }
-
-    piece_id_t frontPiece = gn_identifier_to_piece(front);
-    piece_id_t backPiece = gn_identifier_to_piece(back);
-    const Unit *unit = towers[from.index()].at(tier1, error);
-    if (!unit ||
-        unit->front() != frontPiece ||
-        unit->back() != backPiece ||
-        unit->colour() != colour) {
-      // Have to validate the unit is the correct one as well, since this is
-      // not checked by the controller call.
-      return false;
-    }
-
-    controller.moveUnit(from, tier1, to, error);
-  } else if (sscanf(move.c_str(),
-                    "%c%c<%u-%u-%ux%u",
-                    front,
-                    back,
-                    &col1,
-                    &row1,
-                    &tier1,
-                    &tier2) == 6) {
-    // Immobile strike.
-    Posn posn(col1, row1);
-    piece_id_t frontPiece = gn_identifier_to_piece(front);
-    piece_id_t backPiece = gn_identifier_to_piece(back);
-    const Unit *unit = towers[posn.index()].at(tier1, error);
-    if (!unit ||
-        unit->front() != frontPiece ||
-        unit->back() != backPiece ||
-        unit->colour() != colour) {
-      // Have to validate the unit is the correct one that the movetext
-      // specifies, since those parameters are not passed to the controller
-      // call.
-      return false;
-    }
-
-    controller.immobileStrike(posn, tier1, tier2, error);
-  } else if (sscanf(move.c_str(),
-                    "%c%c+%u-%u-%u",
-                    front,
-                    back,
-                    &col1,
-                    &row1,
-                    &tier1) == 5) {
-    // Forced recovery to self.
-    Posn posn(col1, row1);
-    piece_id_t frontPiece = gn_identifier_to_piece(front);
-    piece_id_t backPiece = gn_identifier_to_piece(back);
-    const Unit *unit = controller.forcedRearrangeUnit();
-    if (!unit || !unit->tower()) {
-      // No forced rearrangement.
-      return false;
-    }
-
-    if (unit->front() != frontPiece ||
-        unit->back() != backPiece ||
-        unit->colour() == colour) {
-      // Invalid unit being force recovered.
-      return false;
-    }
-
-    const Tower *tower = unit->tower();
-    if (tower->posn() != posn) {
-      // Not the correct tower.
-      return false;
-    }
-
-    const Unit *towerUnit = tower->at(tier1, error);
-    if (towerUnit && unit != towerUnit) {
-      // Not the unit at the given tier.
-      return false;
-    }
-
-    controller.forceRecover(true /* recover */, error);
-  } else if (sscanf(move.c_str(),
-                    "%c%c^%u-%u-%u",
-                    front,
-                    back,
-                    &col1,
-                    &row1,
-                    &tier1) == 5) {
-    // Forced recovery to the opponent.
-    Posn posn(col1, row1);
-    piece_id_t frontPiece = gn_identifier_to_piece(front);
-    piece_id_t backPiece = gn_identifier_to_piece(back);
-    const Unit *unit = controller.forcedRearrangeUnit();
-    if (!unit || !unit->tower()) {
-      // No forced rearrangement.
-      return false;
-    }
-
-    if (unit->front() != frontPiece ||
-        unit->back() != backPiece ||
-        unit->colour() == colour) {
-      // Invalid unit being force recovered.
-      return false;
-    }
-
-    const Tower *tower = unit->tower();
-    if (tower->posn() != posn) {
-      // Not the correct tower.
-      return false;
-    }
-
-    const Unit *towerUnit = tower->at(tier1, error);
-    if (towerUnit && unit != towerUnit) {
-      // Not the unit at the given tier.
-      return false;
-    }
-
-    controller.forceRecover(true /* recover */, error);
-  } else if (sscanf(move.c_str(),
-                    "%c%c=%u-%u-%u",
-                    front,
-                    back,
-                    &col1,
-                    &row1,
-                    &tier1) == 5) {
-    // No forced recovery.
-    Posn posn(col1, row1);
-    piece_id_t frontPiece = gn_identifier_to_piece(front);
-    piece_id_t backPiece = gn_identifier_to_piece(back);
-    const Unit *unit = controller.forcedRearrangeUnit();
-    if (!unit || !unit->tower()) {
-      // No forced rearrangement.
-      return false;
-    }
-
-    if (unit->front() != frontPiece ||
-        unit->back() != backPiece ||
-        unit->colour() == colour) {
-      // Invalid unit being force recovered.
-      return false;
-    }
-
-    const Tower *tower = unit->tower();
-    if (tower->posn() != posn) {
-      // Not the correct tower.
-      return false;
-    }
-
-    const Unit *towerUnit = tower->at(tier1, error);
-    if (towerUnit && unit != towerUnit) {
-      // Not the unit at the given tier.
-      return false;
-    }
-
-    controller.forceRecover(false /* no recover */, error);
-  } else if (sscanf(move.c_str(),
-                    "%c%c<%u-%u-%u&%u-%u-%u",
-                    front,
-                    back,
-                    &col1,
-                    &row1,
-                    &tier1,
-                    &col2,
-                    &row2,
-                    &tier2) == 8) {
-    // Substitution.
-    Posn from(col1, row1);
-    Posn to(col2, row2);
-    if (!from.isValid()) {
-      return false;
-    }
-
-    piece_id_t frontPiece = gn_identifier_to_piece(front);
-    piece_id_t backPiece = gn_identifier_to_piece(back);
-    const Unit *unit = towers[from.index()].at(tier1, error);
-    if (!unit ||
-        unit->front() != frontPiece ||
-        unit->back() != backPiece ||
-        unit->colour() != colour) {
-      // Have to validate the unit is the correct one as well, since this is
-      // not checked by the controller call.
-      return false;
-    }
-
-    controller.exchangeUnits(GUNGI_EFFECT_SUBSTITUTION,
-                             from,
-                             tier1,
-                             to,
-                             tier2,
-                             error);
-  } else if (sscanf(move.c_str(),
-                    "%c%c<%u-%u-%u&%u",
-                    front,
-                    back,
-                    &col1,
-                    &row1,
-                    &tier1,
-                    &tier2) == 6) {
-    // 1-3 Tier Exchange.
-    Posn from(col1, row1);
-    Posn to(col2, row2);
-    if (!from.isValid()) {
-      return false;
-    }
-
-    piece_id_t frontPiece = gn_identifier_to_piece(front);
-    piece_id_t backPiece = gn_identifier_to_piece(back);
-    const Unit *unit = towers[from.index()].at(tier1, error);
-    if (!unit ||
-        unit->front() != frontPiece ||
-        unit->back() != backPiece ||
-        unit->colour() != colour) {
-      // Have to validate the unit is the correct one as well, since this is
-      // not checked by the controller call.
-      return false;
-    }
-
-    controller.exchangeUnits(GUNGI_EFFECT_1_3_TIER_EXCHANGE,
-                             from,
-                             tier1,
-                             to,
-                             tier2,
-                             error);
-  } else {
-    // Unknown move string or empty.
-    return (move.find_first_not_of(" \t\n\r") == std::string::npos);
-  }
-
-  return (error == GUNGI_ERROR_NONE);
-}
-
 bool GNDecoder::decodeMovetext(std::stringstream& ss, Controller& controller) {
   unsigned int moveCount = 1;
 
@@ -608,6 +342,215 @@ bool GNDecoder::decodeMovetext(std::stringstream& ss, Controller& controller) {
 }
 
 // STATIC CLASS MEMBERS
+bool GNDecoder::parseMove(const char *move, size_t length, token_t& token) {
+  // Every token is one of 'UU?c-r-t', 'UU<c-r-t?t', or 'UU<c-r-t?c-r-t',
+  // where 'UU' is the unit and '?' a separator, so its length tells its
+  // shape, and each character is checked at its offset.
+  if (length != 8 && length != 10 && length != 14) {
+    return false;
+  }
+
+  bool valid = isDigit(move[3]) & (move[4] == '-') &
+               isDigit(move[5]) & (move[6] == '-') &
+               isDigit(move[7]);
+
+  token.front = move[0];
+  token.back = move[1];
+  token.col = move[3] - '0';
+  token.row = move[5] - '0';
+  token.tier = move[7] - '0';
+  token.toCol = 0;
+  token.toRow = 0;
+  token.toTier = 0;
+
+  const char separator = length == 8 ? move[2] : move[8];
+  if (length == 8) {
+    token.type = separator == '*' ? TOKEN_DROP
+               : separator == '+' ? TOKEN_RECOVER
+               : separator == '^' ? TOKEN_RECOVER_TO_OPPONENT
+               : separator == '=' ? TOKEN_NO_RECOVER
+               : TOKEN_NONE;
+  } else if (length == 10) {
+    valid &= (move[2] == '<') & isDigit(move[9]);
+    token.toTier = move[9] - '0';
+    token.type = separator == 'x' ? TOKEN_IMMOBILE_STRIKE
+               : separator == '&' ? TOKEN_TIER_EXCHANGE
+               : TOKEN_NONE;
+  } else {
+    valid &= (move[2] == '<') &
+             isDigit(move[9]) & (move[10] == '-') &
+             isDigit(move[11]) & (move[12] == '-') &
+             isDigit(move[13]);
+    token.toCol = move[9] - '0';
+    token.toRow = move[11] - '0';
+    token.toTier = move[13] - '0';
+    token.type = separator == '>' ? TOKEN_MOVE
+               : separator == 'x' ? TOKEN_MOBILE_STRIKE
+               : separator == '&' ? TOKEN_SUBSTITUTION
+               : TOKEN_NONE;
+  }
+
+  return valid && token.type != TOKEN_NONE;
+}
+
+bool GNDecoder::applyMove(const token_t& token, Controller& controller) {
+  const char front[2] = { token.front, '\0' };
+  const char back[2] = { token.back, '\0' };
+  const piece_id_t frontPiece = gn_identifier_to_piece(front);
+  const piece_id_t backPiece = gn_identifier_to_piece(back);
+  const colour_t colour = controller.isPlayersTurn(BLACK) ? BLACK : WHITE;
+  const board_t& towers = controller.board();
+  const Posn from(token.col, token.row);
+  const Posn to(token.toCol, token.toRow);
+  const tier_t tier = token.tier;
+  const tier_t toTier = token.toTier;
+  error_t error = GUNGI_ERROR_NONE;
+
+  if (!from.isValid()) {
+    return false;
+  }
+
+  switch (token.type) {
+    case TOKEN_DROP: {
+      if (towers[from.index()].height() != token.tier) {
+        // Not moving into the top of the tower, so invalidate this
+        // parameter, as it is not actually passed to the '.dropUnit()' call.
+        return false;
+      }
+
+      controller.dropUnit(frontPiece, backPiece, from, error);
+      return error == GUNGI_ERROR_NONE;
+    }
+
+    case TOKEN_RECOVER:
+    case TOKEN_RECOVER_TO_OPPONENT:
+    case TOKEN_NO_RECOVER: {
+      const Unit *unit = controller.forcedRecoveryUnit();
+      if (!unit || !unit->tower()) {
+        // No forced recovery.
+        return false;
+      }
+
+      // The turn does not pass until the recovery is settled, so the unit
+      // belongs to the player whose turn it is.
+      if (unit->front() != frontPiece ||
+          unit->back() != backPiece ||
+          unit->colour() != colour) {
+        // Invalid unit being force recovered.
+        return false;
+      }
+
+      const Tower *tower = unit->tower();
+      if (tower->posn() != from) {
+        // Not the correct tower.
+        return false;
+      }
+
+      const Unit *towerUnit = controller.unit(tower->at(tier, error));
+      if (towerUnit && unit != towerUnit) {
+        // Not the unit at the given tier.
+        return false;
+      }
+
+      controller.forceRecover(token.type != TOKEN_NO_RECOVER, error);
+      return error == GUNGI_ERROR_NONE;
+    }
+
+    default: {
+      break;
+    }
+  }
+
+  // The other moves are made by a unit on the board.  Have to validate the
+  // unit is the one that the movetext specifies, since this is not checked
+  // by the controller call.
+  const Unit *unit = controller.unit(towers[from.index()].at(tier, error));
+  if (!unit ||
+      unit->front() != frontPiece ||
+      unit->back() != backPiece ||
+      unit->colour() != colour) {
+    return false;
+  }
+
+  switch (token.type) {
+    case TOKEN_MOVE:
+    case TOKEN_MOBILE_STRIKE: {
+      // Moving anywhere but into the top of the tower invalidates the target
+      // tier, as it is not actually passed to the '.moveUnit()' call.  A
+      // strike has to land on a unit.
+      if (!to.isValid()) {
+        return false;
+      }
+
+      const unsigned int height = towers[to.index()].height();
+      if (height != token.toTier + 1u &&
+          (token.type != TOKEN_MOVE || height != token.toTier)) {
+        return false;
+      }
+
+      controller.moveUnit(from, tier, to, error);
+      break;
+    }
+
+    case TOKEN_IMMOBILE_STRIKE: {
+      controller.immobileStrike(from, tier, toTier, error);
+      break;
+    }
+
+    case TOKEN_SUBSTITUTION: {
+      if (!to.isValid()) {
+        return false;
+      }
+
+      controller.exchangeUnits(GUNGI_EFFECT_SUBSTITUTION,
+                               from,
+                               tier,
+                               to,
+                               toTier,
+                               error);
+      break;
+    }
+
+    case TOKEN_TIER_EXCHANGE: {
+      // The exchange is between two units of the same tower.
+      controller.exchangeUnits(GUNGI_EFFECT_1_3_TIER_EXCHANGE,
+                               from,
+                               tier,
+                               from,
+                               toTier,
+                               error);
+      break;
+    }
+
+    default: {
+      return false;
+    }
+  }
+
+  return (error == GUNGI_ERROR_NONE);
+}
+
+bool GNDecoder::decodeMove(const char  *move,
+                           size_t       length,
+                           Controller&  controller) {
+  token_t token;
+  if (!parseMove(move, length, token)) {
+    // Unknown move string or empty.
+    for (size_t idx = 0; idx < length; idx++) {
+      if (!std::isspace(static_cast<unsigned char>(move[idx]))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  return applyMove(token, controller);
+}
+
+bool GNDecoder::decodeMove(const std::string& move, Controller& controller) {
+  return decodeMove(move.data(), move.size(), controller);
+}
+
 bool GNDecoder::decode(const std::string& gn, GNMetadata& md, Controller& controller) {
   std::stringstream ss(gn);
   if (!decodeHeader(ss, md)) {
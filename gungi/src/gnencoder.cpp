@@ -0,0 +1,455 @@
+// gnencoder.cpp                                                      -*-C++-*-
+#include "gnencoder.hpp"
+
+#include "gndecoder.hpp"
+#include "gtypes.hpp"
+#include "logician.hpp"
+#include "move.hpp"
+#include "posn.hpp"
+#include "tower.hpp"
+#include "unit.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace gungi {
+
+namespace {
+
+inline char *writePosn(char *ch, unsigned int col, unsigned int row) {
+  // Writes the given 'col' and 'row' as 'col-row-' to the given 'ch', and
+  // returns the character after them.
+  ch[0] = static_cast<char>('0' + col);
+  ch[1] = '-';
+  ch[2] = static_cast<char>('0' + row);
+  ch[3] = '-';
+  return ch + 4;
+}
+
+}  // close unnamed namespace
+
+                                // ===============
+                                // class GNEncoder
+                                // ===============
+
+// PRIVATE MANIPULATORS
+bool GNEncoder::reserve(size_t length) {
+  if (m_failed) {
+    return false;
+  } else if (m_length + length <= m_capacity) {
+    return true;
+  } else if (m_fd < 0 || !flush()) {
+    m_failed = true;
+    return false;
+  }
+  return true;
+}
+
+bool GNEncoder::write(const char *text, size_t length) {
+  if (length > m_capacity && m_fd >= 0) {
+    // Too long to buffer, such as a long header value, so it is written out
+    // after the text before it.
+    return flush() && writeOut(text, length);
+  }
+
+  if (!reserve(length)) {
+    return false;
+  }
+
+  std::memcpy(m_buffer + m_length, text, length);
+  m_length += length;
+  return true;
+}
+
+bool GNEncoder::writeOut(const char *text, size_t length) {
+  while (length > 0) {
+    const ssize_t written = ::write(m_fd, text, length);
+    if (written < 0 && errno == EINTR) {
+      continue;
+    } else if (written <= 0) {
+      m_failed = true;
+      return false;
+    }
+
+    text += written;
+    length -= written;
+    m_flushed += written;
+  }
+  return true;
+}
+
+bool GNEncoder::writeTag(const char        *name,
+                         size_t             length,
+                         const std::string& value) {
+  if (value.empty()) {
+    // An empty date is malformed to the decoder, so empty tags are left out.
+    return !m_failed;
+  }
+
+  return write("[", 1) &&
+         write(name, length) &&
+         write(" \"", 2) &&
+         write(value.data(), value.size()) &&
+         write("\"]\n", 3);
+}
+
+// CREATORS
+GNEncoder::GNEncoder(char *buffer, size_t capacity)
+: m_storage()
+, m_buffer(buffer)
+, m_capacity(capacity)
+, m_length(0)
+, m_flushed(0)
+, m_fd(-1)
+, m_failed(false)
+, m_started(false)
+, m_moveCount(0)
+, m_numMoves(0)
+, m_column(0)
+, m_plies()
+{
+  // DO NOTHING
+}
+
+GNEncoder::GNEncoder(int fd)
+: m_storage(new char[k_BUFFER_SIZE])
+, m_buffer(m_storage.get())
+, m_capacity(k_BUFFER_SIZE)
+, m_length(0)
+, m_flushed(0)
+, m_fd(fd)
+, m_failed(false)
+, m_started(false)
+, m_moveCount(0)
+, m_numMoves(0)
+, m_column(0)
+, m_plies()
+{
+  // DO NOTHING
+}
+
+GNEncoder::~GNEncoder(void) {
+  flush();
+}
+
+// MANIPULATORS
+bool GNEncoder::writeHeader(const GNMetadata& md,
+                            const Controller& controller) {
+  if (m_started) {
+    // End the movetext of the game before, and leave a blank line after it.
+    if (!endGame() || !write("\n", 1)) {
+      return false;
+    }
+  }
+
+  m_started = true;
+  m_moveCount = 0;
+  m_numMoves = 0;
+  m_column = 0;
+
+  const char *result = !controller.isOver() ? "*"
+                     : controller.isDraw() ? "1/2 - 1/2"
+                     : controller.isInCheckmate(BLACK) ? "1 - 0"
+                     : "0 - 1";
+
+  return writeTag("Event", 5, md.event()) &&
+         writeTag("Date", 4, md.date()) &&
+         writeTag("Location", 8, md.location()) &&
+         writeTag("White", 5, md.white()) &&
+         writeTag("Black", 5, md.black()) &&
+         write("[Result \"", 9) &&
+         write(result, std::strlen(result)) &&
+         write("\"]\n", 3);
+}
+
+bool GNEncoder::writeMove(const GNDecoder::token_t& token, colour_t colour) {
+  char move[k_MAX_MOVE_LENGTH];
+  const size_t length = encodeMove(token, move);
+  if (length == 0) {
+    return false;
+  }
+
+  // The move is written with the move indicator before it, if any, and the
+  // space or newline before them, in one piece, so that an indicator is
+  // never wrapped apart from its move.
+  char text[k_MAX_MOVE_LENGTH + 16];
+  char *ch = text + 1;
+
+  if (m_numMoves == 0 || m_numMoves == 2) {
+    char digits[10];
+    unsigned int numDigits = 0;
+    unsigned int count = ++m_moveCount;
+    do {
+      digits[numDigits++] = static_cast<char>('0' + count % 10);
+      count /= 10;
+    } while (count > 0);
+
+    while (numDigits > 0) {
+      *ch++ = digits[--numDigits];
+    }
+
+    *ch++ = '.';
+    if (colour != BLACK) {
+      *ch++ = '.';
+      *ch++ = '.';
+    }
+    *ch++ = ' ';
+    m_numMoves = 0;
+  }
+
+  std::memcpy(ch, move, length);
+  ch += length;
+  m_numMoves++;
+
+  const char *start = text + 1;
+  const unsigned int width = static_cast<unsigned int>(ch - start);
+  if (m_column > 0) {
+    if (m_column + 1 + width > k_LINE_WIDTH) {
+      text[0] = '\n';
+      m_column = 0;
+    } else {
+      text[0] = ' ';
+      m_column++;
+    }
+    start = text;
+  }
+
+  m_column += width;
+  return write(start, ch - start);
+}
+
+bool GNEncoder::writeMove(const Controller& controller, const Move& move) {
+  GNDecoder::token_t token;
+  if (!tokenize(controller, move, token)) {
+    return false;
+  }
+  return writeMove(token, controller.isPlayersTurn(BLACK) ? BLACK : WHITE);
+}
+
+bool GNEncoder::writeGame(const GNMetadata&        md,
+                          const std::vector<Move>& moves) {
+  // The result in the header is only known once every move is played, so
+  // the moves are turned into tokens as they are played, and written after
+  // the header.
+  Controller controller;
+  m_plies.clear();
+  for (const Move& move : moves) {
+    ply_t ply;
+    if (!tokenize(controller, move, ply.token)) {
+      return false;
+    }
+
+    ply.colour = controller.isPlayersTurn(BLACK) ? BLACK : WHITE;
+    error_t error = GUNGI_ERROR_NONE;
+    controller.playMove(move, error);
+    if (error != GUNGI_ERROR_NONE) {
+      return false;
+    }
+    m_plies.push_back(ply);
+  }
+
+  if (!writeHeader(md, controller)) {
+    return false;
+  }
+
+  for (const ply_t& ply : m_plies) {
+    if (!writeMove(ply.token, static_cast<colour_t>(ply.colour))) {
+      return false;
+    }
+  }
+
+  return endGame();
+}
+
+bool GNEncoder::endGame(void) {
+  if (m_column == 0) {
+    return !m_failed;
+  }
+
+  m_column = 0;
+  return write("\n", 1);
+}
+
+bool GNEncoder::flush(void) {
+  if (m_fd < 0 || m_failed) {
+    return !m_failed;
+  }
+
+  // The text not written out on failure is dropped, so that 'size()' counts
+  // only the text written.
+  const bool written = writeOut(m_buffer, m_length);
+  m_length = 0;
+  return written;
+}
+
+// ACCESSORS
+size_t GNEncoder::size(void) const {
+  return m_flushed + m_length;
+}
+
+bool GNEncoder::good(void) const {
+  return !m_failed;
+}
+
+// STATIC CLASS MEMBERS
+size_t GNEncoder::encodeMove(const GNDecoder::token_t& token, char *move) {
+  if (token.col > 9 || token.row > 9 || token.tier > 9 ||
+      token.toCol > 9 || token.toRow > 9 || token.toTier > 9) {
+    return 0;
+  }
+
+  char separator;
+  switch (token.type) {
+    case GNDecoder::TOKEN_DROP:                separator = '*'; break;
+    case GNDecoder::TOKEN_RECOVER:             separator = '+'; break;
+    case GNDecoder::TOKEN_RECOVER_TO_OPPONENT: separator = '^'; break;
+    case GNDecoder::TOKEN_NO_RECOVER:          separator = '='; break;
+    case GNDecoder::TOKEN_MOVE:                separator = '>'; break;
+    case GNDecoder::TOKEN_MOBILE_STRIKE:
+    case GNDecoder::TOKEN_IMMOBILE_STRIKE:     separator = 'x'; break;
+    case GNDecoder::TOKEN_SUBSTITUTION:
+    case GNDecoder::TOKEN_TIER_EXCHANGE:       separator = '&'; break;
+    default: {
+      return 0;
+    }
+  }
+
+  char *ch = move;
+  *ch++ = token.front;
+  *ch++ = token.back;
+
+  switch (token.type) {
+    case GNDecoder::TOKEN_DROP:
+    case GNDecoder::TOKEN_RECOVER:
+    case GNDecoder::TOKEN_RECOVER_TO_OPPONENT:
+    case GNDecoder::TOKEN_NO_RECOVER: {
+      // 'UU?c-r-t'
+      *ch++ = separator;
+      ch = writePosn(ch, token.col, token.row);
+      *ch++ = static_cast<char>('0' + token.tier);
+      break;
+    }
+
+    case GNDecoder::TOKEN_IMMOBILE_STRIKE:
+    case GNDecoder::TOKEN_TIER_EXCHANGE: {
+      // 'UU<c-r-t?t'
+      *ch++ = '<';
+      ch = writePosn(ch, token.col, token.row);
+      *ch++ = static_cast<char>('0' + token.tier);
+      *ch++ = separator;
+      *ch++ = static_cast<char>('0' + token.toTier);
+      break;
+    }
+
+    default: {
+      // 'UU<c-r-t?c-r-t'
+      *ch++ = '<';
+      ch = writePosn(ch, token.col, token.row);
+      *ch++ = static_cast<char>('0' + token.tier);
+      *ch++ = separator;
+      ch = writePosn(ch, token.toCol, token.toRow);
+      *ch++ = static_cast<char>('0' + token.toTier);
+      break;
+    }
+  }
+
+  return ch - move;
+}
+
+bool GNEncoder::tokenize(const Controller&   controller,
+                         const Move&         move,
+                         GNDecoder::token_t& token) {
+  const Unit *unit = controller.unit(move.unit());
+  if (!unit) {
+    return false;
+  }
+
+  token.front = piece_to_gn_identifier(unit->front())[0];
+  token.back = piece_to_gn_identifier(unit->back())[0];
+  token.toCol = 0;
+  token.toRow = 0;
+  token.toTier = 0;
+
+  const board_t& towers = controller.board();
+  if (move.type() == Move::MOVE_TYPE_DROP) {
+    const Posn to = move.to();
+    token.type = GNDecoder::TOKEN_DROP;
+    token.col = static_cast<uint8_t>(to.col());
+    token.row = static_cast<uint8_t>(to.row());
+    token.tier = static_cast<uint8_t>(towers[to.index()].height());
+    return true;
+  }
+
+  // The other moves are made by a unit on the board.
+  const Tower *tower = unit->tower();
+  if (!tower) {
+    return false;
+  }
+
+  token.col = static_cast<uint8_t>(tower->posn().col());
+  token.row = static_cast<uint8_t>(tower->posn().row());
+  token.tier = static_cast<uint8_t>(unit->tier());
+
+  const Unit *target = controller.unit(move.target());
+  switch (move.type()) {
+    case Move::MOVE_TYPE_MOVE: {
+      // A unit moving onto an enemy captures it, and takes its tier.
+      const Posn to = move.to();
+      const Tower& toTower = towers[to.index()];
+      const Unit *top = controller.unit(toTower.top());
+      const bool capture = top && top->colour() != unit->colour();
+      token.type = capture ? GNDecoder::TOKEN_MOBILE_STRIKE
+                           : GNDecoder::TOKEN_MOVE;
+      token.toCol = static_cast<uint8_t>(to.col());
+      token.toRow = static_cast<uint8_t>(to.row());
+      token.toTier = static_cast<uint8_t>(toTower.height() - capture);
+      return true;
+    }
+
+    case Move::MOVE_TYPE_IMMOBILE_STRIKE:
+    case Move::MOVE_TYPE_TIER_EXCHANGE: {
+      if (!target || target->tower() != tower) {
+        return false;
+      }
+
+      token.type = move.type() == Move::MOVE_TYPE_IMMOBILE_STRIKE ?
+                   GNDecoder::TOKEN_IMMOBILE_STRIKE :
+                   GNDecoder::TOKEN_TIER_EXCHANGE;
+      token.toTier = static_cast<uint8_t>(target->tier());
+      return true;
+    }
+
+    case Move::MOVE_TYPE_SUBSTITUTION: {
+      if (!target || !target->tower()) {
+        return false;
+      }
+
+      token.type = GNDecoder::TOKEN_SUBSTITUTION;
+      token.toCol = static_cast<uint8_t>(target->tower()->posn().col());
+      token.toRow = static_cast<uint8_t>(target->tower()->posn().row());
+      token.toTier = static_cast<uint8_t>(target->tier());
+      return true;
+    }
+
+    case Move::MOVE_TYPE_FORCED_RECOVERY: {
+      // A unit is recovered to its own player's hand unless it captured on
+      // the move that forced its recovery.
+      token.type = !move.recover() ? GNDecoder::TOKEN_NO_RECOVER
+                 : controller.forcedRecoveryColour() == unit->colour() ?
+                   GNDecoder::TOKEN_RECOVER :
+                   GNDecoder::TOKEN_RECOVER_TO_OPPONENT;
+      return true;
+    }
+
+    default: {
+      return false;
+    }
+  }
+}
+
+}  // close 'gungi' namespace
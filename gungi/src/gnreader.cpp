@@ -0,0 +1,450 @@
+// gnreader.cpp                                                       -*-C++-*-
+#include "gnreader.hpp"
+
+#include "gndecoder.hpp"
+#include "gtypes.hpp"
+#include "logician.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace gungi {
+
+namespace {
+
+inline bool isSpace(char ch) {
+  // Returns 'true' if the given 'ch' is whitespace, otherwise 'false'.
+  return ch == ' ' || (ch >= '\t' && ch <= '\r');
+}
+
+inline const char *skipSpace(const char *ch, const char *end) {
+  // Returns the first character from the given 'ch' up to the given 'end'
+  // that is not whitespace, otherwise 'end'.
+  while (ch != end && isSpace(*ch)) {
+    ++ch;
+  }
+  return ch;
+}
+
+inline const char *skipToken(const char *ch, const char *end) {
+  // Returns the first character from the given 'ch' up to the given 'end'
+  // that is whitespace, otherwise 'end'.
+  while (ch != end && !isSpace(*ch)) {
+    ++ch;
+  }
+  return ch;
+}
+
+inline const char *find(const char *ch, const char *end, char value) {
+  // Returns the first character from the given 'ch' up to the given 'end'
+  // that is the given 'value', otherwise 'NULL'.
+  return static_cast<const char *>(std::memchr(ch, value, end - ch));
+}
+
+const char *skipComment(const char *ch, const char *end) {
+  // Returns the character after the comment starting at the given 'ch', or
+  // the given 'end' if the comment runs to it.  Returns 'NULL' if the comment
+  // is an inline comment that does not end.
+  const char *close = find(ch, end, *ch == '(' ? ')' : '\n');
+  if (!close) {
+    return *ch == '(' ? NULL : end;
+  }
+  return close + 1;
+}
+
+bool isName(const char *name, const char *end, const char *expected) {
+  // Returns 'true' if the name from the given 'name' up to the given 'end' is
+  // the given lowercase 'expected' name, in any case, otherwise 'false'.
+  for (; name != end; ++name, ++expected) {
+    char ch = *name;
+    if (ch >= 'A' && ch <= 'Z') {
+      ch += 'a' - 'A';
+    }
+
+    if (ch != *expected) {
+      return false;
+    }
+  }
+  return *expected == '\0';
+}
+
+const char *decodeTag(const char  *ch,
+                      const char  *end,
+                      GNMetadata&  md,
+                      std::string& value) {
+  // Decodes the header tag starting at the given 'ch', and ending before the
+  // given 'end', into the given 'md', using the given 'value' to hold the
+  // value of the tag.  Returns the character after the tag on success,
+  // otherwise 'NULL'.
+  const char *name = skipSpace(ch + 1, end);
+  const char *nameEnd = skipToken(name, end);
+  ch = skipSpace(nameEnd, end);
+  if (name == nameEnd || ch == end || *ch != '"') {
+    return NULL;
+  }
+
+  const char *quote = find(++ch, end, '"');
+  if (!quote) {
+    return NULL;
+  }
+
+  value.assign(ch, quote);
+  ch = skipSpace(quote + 1, end);
+  if (ch == end || *ch != ']') {
+    return NULL;
+  }
+
+  if (isName(name, nameEnd, "event")) {
+    md.setEvent(value);
+  } else if (isName(name, nameEnd, "date")) {
+    if (!md.setDate(value)) {
+      return NULL;
+    }
+  } else if (isName(name, nameEnd, "location")) {
+    md.setLocation(value);
+  } else if (isName(name, nameEnd, "white")) {
+    md.setWhite(value);
+  } else if (isName(name, nameEnd, "black")) {
+    md.setBlack(value);
+  } else if (!isName(name, nameEnd, "result")) {
+    // Unknown name.  The result does not bear on the metadata, so it is
+    // ignored.
+    return NULL;
+  }
+
+  return ch + 1;
+}
+
+const char *decodeHeader(const char  *ch,
+                         const char  *end,
+                         GNMetadata&  md,
+                         std::string& value,
+                         bool&        valid) {
+  // Decodes the header starting at the given 'ch', and ending before the
+  // given 'end', into the given 'md', using the given 'value' to hold the
+  // value of a tag.  Loads into the given output parameter, 'valid', 'true'
+  // if the header was decoded, otherwise 'false'.  Returns the start of the
+  // movetext following the header.
+  md.clear();
+  valid = true;
+
+  for (ch = skipSpace(ch, end); ch != end; ch = skipSpace(ch, end)) {
+    if (*ch == '#' || *ch == '(') {
+      ch = skipComment(ch, end);
+      if (!ch) {
+        valid = false;
+        return end;
+      }
+    } else if (*ch != '[') {
+      break;
+    } else if (valid) {
+      const char *next = decodeTag(ch, end, md, value);
+      if (!next) {
+        // The rest of the header is skipped, a line at a time, so that its
+        // tags do not start another game.
+        valid = false;
+        next = find(ch, end, '\n');
+        ch = next ? next + 1 : end;
+      } else {
+        ch = next;
+      }
+    } else {
+      const char *next = find(ch, end, '\n');
+      ch = next ? next + 1 : end;
+    }
+  }
+
+  return ch;
+}
+
+bool isLineStart(const char *ch, const char *begin) {
+  // Returns 'true' if only whitespace comes between the given 'ch' and the
+  // start of its line, looking back no further than the given 'begin',
+  // otherwise 'false'.
+  for (; ch != begin && isSpace(ch[-1]); --ch) {
+    if (ch[-1] == '\n') {
+      return true;
+    }
+  }
+  return false;
+}
+
+const char *findGame(const char *begin, const char *end) {
+  // Returns the start of the header of the game after the movetext starting
+  // at the given 'begin', otherwise the given 'end' if there is none.
+  //
+  // A '[' starts a header only at the start of a line, and outside of an
+  // inline comment, which may span lines.  A '#' starts a single line
+  // comment only at the start of a line.  Each of these characters is rare in
+  // movetext, so the text is searched for the next of them rather than for
+  // the end of each line.  The search for a '(' or '#' stops at the next
+  // '[', so the text searched is still in the cache.
+  const char *ch = begin;
+  const char *bracket = NULL;
+  const char *paren = NULL;
+  const char *hash = NULL;
+  while (ch != end) {
+    if (!bracket || bracket < ch) {
+      bracket = find(ch, end, '[');
+      bracket = bracket ? bracket : end;
+      paren = NULL;
+      hash = NULL;
+    }
+
+    if (!paren || paren < ch) {
+      paren = find(ch, bracket, '(');
+      paren = paren ? paren : bracket;
+    }
+
+    if (!hash || hash < ch) {
+      hash = find(ch, bracket, '#');
+      hash = hash ? hash : bracket;
+    }
+
+    if (hash < paren && hash < bracket) {
+      ch = isLineStart(hash, begin) ? find(hash, end, '\n') : hash + 1;
+    } else if (paren < bracket) {
+      ch = skipComment(paren, end);
+    } else if (bracket == end || isLineStart(bracket, begin)) {
+      return bracket;
+    } else {
+      ch = bracket + 1;
+    }
+
+    if (!ch) {
+      return end;
+    }
+  }
+
+  return end;
+}
+
+const char *trim(const char *begin, const char *end) {
+  // Returns the end of the text from the given 'begin' up to the given 'end'
+  // without its trailing whitespace.
+  while (end != begin && isSpace(end[-1])) {
+    --end;
+  }
+  return end;
+}
+
+bool replayMovetext(const GNReader::slice_t&         movetext,
+                    Controller&                      controller,
+                    unsigned int&                    plies,
+                    std::vector<GNDecoder::token_t> *tokens) {
+  // Decodes the moves of the given 'movetext' and plays them on the given
+  // 'controller', appending them to the given 'tokens', unless it is 'NULL'.
+  // Loads into the given output parameter, 'plies', the number of moves
+  // played.  Returns 'true' if every move was played, otherwise 'false'.
+  const char *ch = movetext.data;
+  const char *end = ch + movetext.length;
+  unsigned int moveCount = 1;
+  plies = 0;
+
+  while (true) {
+    // Skip the comments before the move indicator.
+    ch = skipSpace(ch, end);
+    while (ch != end && (*ch == '#' || *ch == '(')) {
+      ch = skipComment(ch, end);
+      ch = ch ? skipSpace(ch, end) : end;
+    }
+
+    if (ch == end) {
+      break;
+    }
+
+    // Decode the move indicator, a number followed by one period if it is
+    // black's turn, otherwise three.
+    unsigned int count = 0;
+    const char *digits = ch;
+    for (; ch != end && *ch >= '0' && *ch <= '9'; ++ch) {
+      count = count * 10 + (*ch - '0');
+    }
+
+    const char *periods = skipSpace(ch, end);
+    ch = skipToken(periods, end);
+    const size_t numPeriods = ch - periods;
+    if (ch == digits ||
+        count != moveCount++ ||
+        (numPeriods != 1 && numPeriods != 3) ||
+        std::memcmp(periods, "...", numPeriods) != 0 ||
+        !controller.isPlayersTurn(numPeriods == 1 ? BLACK : WHITE)) {
+      return false;
+    }
+
+    // Decode the move, and the move after it, unless another move indicator
+    // or the end of the movetext comes first.
+    for (unsigned int idx = 0; idx < 2; idx++) {
+      ch = skipSpace(ch, end);
+      if (idx > 0) {
+        while (ch != end && (*ch == '#' || *ch == '(')) {
+          ch = skipComment(ch, end);
+          ch = ch ? skipSpace(ch, end) : end;
+        }
+
+        if (ch == end || (*ch >= '1' && *ch <= '9')) {
+          break;
+        }
+      } else if (ch == end) {
+        return false;
+      }
+
+      const char *move = ch;
+      ch = skipToken(ch, end);
+
+      GNDecoder::token_t token;
+      if (!GNDecoder::parseMove(move, ch - move, token) ||
+          !GNDecoder::applyMove(token, controller)) {
+        return false;
+      }
+
+      if (tokens) {
+        tokens->push_back(token);
+      }
+      plies++;
+    }
+  }
+
+  return true;
+}
+
+}  // close unnamed namespace
+
+                                // ==============
+                                // class GNReader
+                                // ==============
+
+// CREATORS
+GNReader::GNReader(void)
+: m_data(NULL)
+, m_length(0)
+, m_map(NULL)
+{
+  // DO NOTHING
+}
+
+GNReader::GNReader(const char *data, size_t length)
+: m_data(data)
+, m_length(length)
+, m_map(NULL)
+{
+  // DO NOTHING
+}
+
+GNReader::~GNReader(void) {
+  close();
+}
+
+// MANIPULATORS
+bool GNReader::open(const std::string& path) {
+  close();
+
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+    ::close(fd);
+    return false;
+  } else if (st.st_size == 0) {
+    // An empty file cannot be mapped, and has no games.
+    ::close(fd);
+    return true;
+  }
+
+  const size_t length = static_cast<size_t>(st.st_size);
+  void *map = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (map == MAP_FAILED) {
+    return false;
+  }
+
+#ifdef MADV_SEQUENTIAL
+  // The games are read from the start to the end of the file, so the kernel
+  // can read ahead of them.
+  madvise(map, length, MADV_SEQUENTIAL);
+#endif
+
+  m_map = map;
+  m_data = static_cast<const char *>(map);
+  m_length = length;
+  return true;
+}
+
+void GNReader::close(void) {
+  if (m_map) {
+    munmap(m_map, m_length);
+  }
+
+  m_data = NULL;
+  m_length = 0;
+  m_map = NULL;
+}
+
+// ACCESSORS
+size_t GNReader::read(const callback_t& callback) const {
+  if (!m_data) {
+    return 0;
+  }
+
+  // The game and the storage of its strings are reused from one game to the
+  // next.
+  game_t game;
+  std::string value;
+  size_t count = 0;
+
+  const char *end = m_data + m_length;
+  const char *ch = skipSpace(m_data, end);
+  while (ch != end) {
+    const char *movetext = decodeHeader(ch,
+                                        end,
+                                        game.metadata,
+                                        value,
+                                        game.valid);
+    const char *next = findGame(movetext, end);
+
+    game.text.data = ch;
+    game.text.length = trim(ch, next) - ch;
+    game.movetext.data = movetext;
+    game.movetext.length = trim(movetext, next) - movetext;
+    game.offset = ch - m_data;
+    count++;
+
+    if (!callback(game)) {
+      break;
+    }
+    ch = next;
+  }
+
+  return count;
+}
+
+size_t GNReader::size(void) const {
+  return m_length;
+}
+
+// STATIC CLASS MEMBERS
+bool GNReader::replay(const game_t& game,
+                      Controller&   controller,
+                      unsigned int& plies) {
+  return replayMovetext(game.movetext, controller, plies, NULL);
+}
+
+bool GNReader::replay(const game_t&                    game,
+                      Controller&                      controller,
+                      unsigned int&                    plies,
+                      std::vector<GNDecoder::token_t>& tokens) {
+  tokens.clear();
+  return replayMovetext(game.movetext, controller, plies, &tokens);
+}
+
+}  // close 'gungi' namespace
@@ -4,6 +4,7 @@
 #include "util.hpp"
 
 #include <cassert>
+#include <cctype>
 #include <cstdarg>
 #include <cstdio>
 #include <cstring>
@@ -109,14 +110,14 @@ const effect_bitfield_t k_UNIT_EFFECT[GUNGI_NUM_PIECES] = {
   [GUNGI_PIECE_GOLD]          = GUNGI_EFFECT_NONE,
   [GUNGI_PIECE_ARROW]         = GUNGI_EFFECT_NONE,
   [GUNGI_PIECE_PHOENIX]       = GUNGI_EFFECT_NONE,
+  [GUNGI_PIECE_DRAGON_KING]   = GUNGI_EFFECT_NONE,
   [GUNGI_PIECE_LANCE]         = GUNGI_EFFECT_FORCED_REARRANGEMENT |
                                 GUNGI_EFFECT_FORCED_RECOVERY,
   [GUNGI_PIECE_CLANDESTINITE] = GUNGI_EFFECT_LAND_LINK |
                                 GUNGI_EFFECT_FRONT_DROP_ONLY |
                                 GUNGI_EFFECT_JUMP,
   [GUNGI_PIECE_PIKE]          = GUNGI_EFFECT_NONE,
-  [GUNGI_PIECE_PISTOL]        = GUNGI_EFFECT_NONE,
-  [GUNGI_PIECE_DRAGON_KING]   = GUNGI_EFFECT_NONE
+  [GUNGI_PIECE_PISTOL]        = GUNGI_EFFECT_NONE
 };
 
 const effect_bitfield_t k_UNIT_IMMUNITY[GUNGI_NUM_PIECES] = {
@@ -140,982 +141,714 @@ const effect_bitfield_t k_UNIT_IMMUNITY[GUNGI_NUM_PIECES] = {
   [GUNGI_PIECE_ARROW]         = GUNGI_EFFECT_NONE,
   [GUNGI_PIECE_PHOENIX]       = GUNGI_EFFECT_MOBILE_RANGE_EXPANSION_1 |
                                 GUNGI_EFFECT_MOBILE_RANGE_EXPANSION_2,
+  [GUNGI_PIECE_DRAGON_KING]   = GUNGI_EFFECT_MOBILE_RANGE_EXPANSION_1 |
+                                GUNGI_EFFECT_MOBILE_RANGE_EXPANSION_2,
   [GUNGI_PIECE_LANCE]         = GUNGI_EFFECT_NONE,
   [GUNGI_PIECE_CLANDESTINITE] = GUNGI_EFFECT_NONE,
   [GUNGI_PIECE_PIKE]          = GUNGI_EFFECT_NONE,
-  [GUNGI_PIECE_PISTOL]        = GUNGI_EFFECT_NONE,
-  [GUNGI_PIECE_DRAGON_KING]   = GUNGI_EFFECT_MOBILE_RANGE_EXPANSION_1 |
-                                GUNGI_EFFECT_MOBILE_RANGE_EXPANSION_2
+  [GUNGI_PIECE_PISTOL]        = GUNGI_EFFECT_NONE
 };
 
-const moveset_t k_UNIT_MOVES[GUNGI_NUM_PIECES] = {
-  [GUNGI_PIECE_PAWN] = {
-    [0] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [1] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [2] = {
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    }
-  },
-  [GUNGI_PIECE_BOW] = {
-    [0] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [1] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [2] = {
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      }
-    }
-  },
-  [GUNGI_PIECE_PRODIGY] = {
-    [0] = {
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_UNLIMITED }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_UNLIMITED }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_UNLIMITED }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_UNLIMITED }
-      }
-    },
-    [1] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [2] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      }
-    }
-  },
-  [GUNGI_PIECE_HIDDEN_DRAGON] = {
-    [0] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_UNLIMITED }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_UNLIMITED }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_UNLIMITED }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_UNLIMITED }
-      }
-    },
-    [1] = {
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [2] = {
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    }
-  },
-  [GUNGI_PIECE_FORTRESS] = {
-    [0] = {
-    },
-    [1] = {
-    },
-    [2] = {
-    }
-  },
-  [GUNGI_PIECE_CATAPULT] = {
-    [0] = {
-    },
-    [1] = {
-    },
-    [2] = {
-    }
-  },
-  [GUNGI_PIECE_SPY] = {
-    [0] = {
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [1] = {
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [2] = {
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    }
-  },
-  [GUNGI_PIECE_SAMURAI] = {
-    [0] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [1] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [2] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      }
-    }
-  },
-  [GUNGI_PIECE_CAPTAIN] = {
-    [0] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [1] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [2] = {
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE } 
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      }
-    }
-  },
-  [GUNGI_PIECE_COMMANDER] = {
-    [0] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [1] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [2] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    }
-  },
-  [GUNGI_PIECE_BRONZE] = {
-    [0] = {
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [1] = {
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [2] = {
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    }
-  },
-  [GUNGI_PIECE_SILVER] = {
-    [0] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [1] = {
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [2] = {
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    }
-  },
-  [GUNGI_PIECE_GOLD] = {
-    [0] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [1] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [2] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    }
-  },
-  [GUNGI_PIECE_ARROW] = {
-    [0] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [1] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [2] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    }
-  },
-  [GUNGI_PIECE_PHOENIX] = {
-    [0] = {
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_UNLIMITED }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_UNLIMITED }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_UNLIMITED }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_UNLIMITED }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [1] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [2] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      }
-    }
-  },
-  [GUNGI_PIECE_LANCE] = {
-    [0] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_UNLIMITED }
-      }
-    },
-    [1] = {
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [2] = {
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      }
-    }
-  },
-  [GUNGI_PIECE_CLANDESTINITE] = {
-    [0] = {
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [1] = {
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [2] = {
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    }
-  },
-  [GUNGI_PIECE_PIKE] = {
-    [0] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE },
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [1] = {
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [2] = {
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    }
-  },
-  [GUNGI_PIECE_PISTOL] = {
-    [0] = {
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [1] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [2] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_NONE }
-      }
-    }
-  },
-  [GUNGI_PIECE_DRAGON_KING] = {
-    [0] = {
-      {
-        { GUNGI_MOVE_DIR_UP, GUNGI_MOVE_MOD_UNLIMITED }
-      },
-      {
-        { GUNGI_MOVE_DIR_LEFT, GUNGI_MOVE_MOD_UNLIMITED }
-      },
-      {
-        { GUNGI_MOVE_DIR_RIGHT, GUNGI_MOVE_MOD_UNLIMITED }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN, GUNGI_MOVE_MOD_UNLIMITED }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [1] = {
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    },
-    [2] = {
-      {
-        { GUNGI_MOVE_DIR_UP_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_UP_RIGHT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_LEFT, GUNGI_MOVE_MOD_NONE }
-      },
-      {
-        { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE }
-      }
-    }
-  },
+// The movesets are stored as flat tables so that they are constant
+// initialized, and walking them never allocates.  Each tier of a piece's
+// moveset in 'k_UNIT_MOVES' is a span of 'k_MOVE_PATHS', and each path is a
+// span of 'k_MOVE_STEPS'.  Offsets into each table are noted alongside its
+// entries.
+constexpr move_t k_MOVE_STEPS[k_NUM_MOVE_STEPS] = {
+  // Pawn, tier 1.
+  /*   0 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  // Pawn, tier 2.
+  /*   1 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /*   2 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /*   3 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /*   4 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /*   5 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  // Pawn, tier 3.
+  /*   6 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /*   7 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /*   8 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /*   9 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /*  10 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /*  11 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  // Bow, tier 1.
+  /*  12 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /*  13 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /*  14 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /*  15 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /*  16 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /*  17 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  // Bow, tier 2.
+  /*  18 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /*  19 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  /*  20 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /*  21 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /*  22 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /*  23 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  // Bow, tier 3.
+  /*  24 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /*  25 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /*  26 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /*  27 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /*  28 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /*  29 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /*  30 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /*  31 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /*  32 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  /*  33 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  // Prodigy, tier 1.
+  /*  34 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_UNLIMITED },
+  /*  35 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_UNLIMITED },
+  /*  36 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_UNLIMITED },
+  /*  37 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_UNLIMITED },
+  // Prodigy, tier 2.
+  /*  38 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /*  39 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /*  40 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /*  41 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  // Prodigy, tier 3.
+  /*  42 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /*  43 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /*  44 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /*  45 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  // Hidden Dragon, tier 1.
+  /*  46 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_UNLIMITED },
+  /*  47 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_UNLIMITED },
+  /*  48 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_UNLIMITED },
+  /*  49 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_UNLIMITED },
+  // Hidden Dragon, tier 2.
+  /*  50 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /*  51 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /*  52 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  /*  53 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  // Hidden Dragon, tier 3.
+  /*  54 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /*  55 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /*  56 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  /*  57 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  // Spy, tier 1.
+  /*  58 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /*  59 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /*  60 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /*  61 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  // Spy, tier 2.
+  /*  62 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /*  63 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /*  64 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /*  65 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /*  66 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /*  67 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  // Spy, tier 3.
+  /*  68 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /*  69 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /*  70 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /*  71 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /*  72 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /*  73 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  // Samurai, tier 1.
+  /*  74 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /*  75 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /*  76 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /*  77 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /*  78 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  // Samurai, tier 2.
+  /*  79 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /*  80 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /*  81 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /*  82 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /*  83 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /*  84 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /*  85 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  /*  86 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  // Samurai, tier 3.
+  /*  87 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /*  88 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /*  89 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /*  90 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /*  91 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /*  92 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /*  93 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  /*  94 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  // Captain, tier 1.
+  /*  95 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /*  96 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /*  97 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /*  98 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  /*  99 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  // Captain, tier 2.
+  /* 100 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 101 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 102 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /* 103 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  /* 104 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  /* 105 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  // Captain, tier 3.
+  /* 106 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 107 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /* 108 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /* 109 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /* 110 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 111 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 112 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /* 113 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /* 114 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /* 115 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /* 116 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  /* 117 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  // Commander, tier 1.
+  /* 118 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 119 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /* 120 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /* 121 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  /* 122 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /* 123 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 124 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  /* 125 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  // Commander, tier 2.
+  /* 126 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 127 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /* 128 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /* 129 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  /* 130 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /* 131 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 132 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  /* 133 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  // Commander, tier 3.
+  /* 134 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 135 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /* 136 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /* 137 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  /* 138 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /* 139 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 140 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  /* 141 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  // Bronze, tier 1.
+  /* 142 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /* 143 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  // Bronze, tier 2.
+  /* 144 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /* 145 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  // Bronze, tier 3.
+  /* 146 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /* 147 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  // Silver, tier 1.
+  /* 148 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 149 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /* 150 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  /* 151 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  // Silver, tier 2.
+  /* 152 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 153 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /* 154 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  /* 155 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  // Silver, tier 3.
+  /* 156 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 157 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /* 158 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  /* 159 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  // Gold, tier 1.
+  /* 160 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 161 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /* 162 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  /* 163 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /* 164 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 165 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  // Gold, tier 2.
+  /* 166 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 167 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /* 168 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  /* 169 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /* 170 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 171 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  // Gold, tier 3.
+  /* 172 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 173 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /* 174 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  /* 175 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /* 176 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 177 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  // Arrow, tier 1.
+  /* 178 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 179 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  /* 180 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  /* 181 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  // Arrow, tier 2.
+  /* 182 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 183 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  /* 184 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  /* 185 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  /* 186 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  /* 187 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  // Arrow, tier 3.
+  /* 188 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 189 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  /* 190 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  /* 191 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  /* 192 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  /* 193 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  /* 194 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  /* 195 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  // Phoenix, tier 1.
+  /* 196 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_UNLIMITED },
+  /* 197 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_UNLIMITED },
+  /* 198 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_UNLIMITED },
+  /* 199 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_UNLIMITED },
+  /* 200 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 201 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /* 202 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /* 203 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  // Phoenix, tier 2.
+  /* 204 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 205 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /* 206 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /* 207 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  // Phoenix, tier 3.
+  /* 208 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 209 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /* 210 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /* 211 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  // Dragon King, tier 1.
+  /* 212 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_UNLIMITED },
+  /* 213 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_UNLIMITED },
+  /* 214 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_UNLIMITED },
+  /* 215 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_UNLIMITED },
+  /* 216 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 217 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /* 218 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  /* 219 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  // Dragon King, tier 2.
+  /* 220 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 221 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /* 222 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  /* 223 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  // Dragon King, tier 3.
+  /* 224 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 225 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /* 226 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  /* 227 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  // Lance, tier 1.
+  /* 228 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_UNLIMITED },
+  // Lance, tier 2.
+  /* 229 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 230 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /* 231 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  /* 232 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  // Lance, tier 3.
+  /* 233 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 234 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /* 235 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  /* 236 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  // Clandestinite, tier 1.
+  /* 237 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 238 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 239 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /* 240 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 241 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  // Clandestinite, tier 2.
+  /* 242 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 243 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 244 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /* 245 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 246 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /* 247 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 248 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  // Clandestinite, tier 3.
+  /* 249 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 250 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 251 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /* 252 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 253 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /* 254 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 255 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  /* 256 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  /* 257 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  /* 258 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  /* 259 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  /* 260 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  /* 261 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  /* 262 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  /* 263 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  // Pike, tier 1.
+  /* 264 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 265 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 266 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 267 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /* 268 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /* 269 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  // Pike, tier 2.
+  /* 270 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 271 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /* 272 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  /* 273 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  // Pike, tier 3.
+  /* 274 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 275 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /* 276 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  /* 277 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  // Pistol, tier 1.
+  /* 278 */ { GUNGI_MOVE_DIR_UP_RIGHT,   GUNGI_MOVE_MOD_NONE },
+  /* 279 */ { GUNGI_MOVE_DIR_UP_LEFT,    GUNGI_MOVE_MOD_NONE },
+  /* 280 */ { GUNGI_MOVE_DIR_DOWN_LEFT,  GUNGI_MOVE_MOD_NONE },
+  /* 281 */ { GUNGI_MOVE_DIR_DOWN_RIGHT, GUNGI_MOVE_MOD_NONE },
+  // Pistol, tier 2.
+  /* 282 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 283 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /* 284 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /* 285 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE },
+  // Pistol, tier 3.
+  /* 286 */ { GUNGI_MOVE_DIR_UP,         GUNGI_MOVE_MOD_NONE },
+  /* 287 */ { GUNGI_MOVE_DIR_LEFT,       GUNGI_MOVE_MOD_NONE },
+  /* 288 */ { GUNGI_MOVE_DIR_RIGHT,      GUNGI_MOVE_MOD_NONE },
+  /* 289 */ { GUNGI_MOVE_DIR_DOWN,       GUNGI_MOVE_MOD_NONE }
+};
+
+constexpr move_span_t k_MOVE_PATHS[k_NUM_MOVE_PATHS] = {
+  // Pawn, tier 1.
+  /*   0 */ {   0, 1 },
+  // Pawn, tier 2.
+  /*   1 */ {   1, 1 },
+  /*   2 */ {   2, 2 },
+  /*   3 */ {   4, 2 },
+  // Pawn, tier 3.
+  /*   4 */ {   6, 1 },
+  /*   5 */ {   7, 1 },
+  /*   6 */ {   8, 2 },
+  /*   7 */ {  10, 2 },
+  // Bow, tier 1.
+  /*   8 */ {  12, 2 },
+  /*   9 */ {  14, 2 },
+  /*  10 */ {  16, 2 },
+  // Bow, tier 2.
+  /*  11 */ {  18, 1 },
+  /*  12 */ {  19, 1 },
+  /*  13 */ {  20, 2 },
+  /*  14 */ {  22, 2 },
+  // Bow, tier 3.
+  /*  15 */ {  24, 2 },
+  /*  16 */ {  26, 2 },
+  /*  17 */ {  28, 2 },
+  /*  18 */ {  30, 2 },
+  /*  19 */ {  32, 2 },
+  // Prodigy, tier 1.
+  /*  20 */ {  34, 1 },
+  /*  21 */ {  35, 1 },
+  /*  22 */ {  36, 1 },
+  /*  23 */ {  37, 1 },
+  // Prodigy, tier 2.
+  /*  24 */ {  38, 1 },
+  /*  25 */ {  39, 1 },
+  /*  26 */ {  40, 1 },
+  /*  27 */ {  41, 1 },
+  // Prodigy, tier 3.
+  /*  28 */ {  42, 1 },
+  /*  29 */ {  43, 1 },
+  /*  30 */ {  44, 1 },
+  /*  31 */ {  45, 1 },
+  // Hidden Dragon, tier 1.
+  /*  32 */ {  46, 1 },
+  /*  33 */ {  47, 1 },
+  /*  34 */ {  48, 1 },
+  /*  35 */ {  49, 1 },
+  // Hidden Dragon, tier 2.
+  /*  36 */ {  50, 1 },
+  /*  37 */ {  51, 1 },
+  /*  38 */ {  52, 1 },
+  /*  39 */ {  53, 1 },
+  // Hidden Dragon, tier 3.
+  /*  40 */ {  54, 1 },
+  /*  41 */ {  55, 1 },
+  /*  42 */ {  56, 1 },
+  /*  43 */ {  57, 1 },
+  // Spy, tier 1.
+  /*  44 */ {  58, 2 },
+  /*  45 */ {  60, 2 },
+  // Spy, tier 2.
+  /*  46 */ {  62, 2 },
+  /*  47 */ {  64, 2 },
+  /*  48 */ {  66, 1 },
+  /*  49 */ {  67, 1 },
+  // Spy, tier 3.
+  /*  50 */ {  68, 2 },
+  /*  51 */ {  70, 2 },
+  /*  52 */ {  72, 1 },
+  /*  53 */ {  73, 1 },
+  // Samurai, tier 1.
+  /*  54 */ {  74, 1 },
+  /*  55 */ {  75, 1 },
+  /*  56 */ {  76, 1 },
+  /*  57 */ {  77, 1 },
+  /*  58 */ {  78, 1 },
+  // Samurai, tier 2.
+  /*  59 */ {  79, 2 },
+  /*  60 */ {  81, 1 },
+  /*  61 */ {  82, 1 },
+  /*  62 */ {  83, 1 },
+  /*  63 */ {  84, 1 },
+  /*  64 */ {  85, 2 },
+  // Samurai, tier 3.
+  /*  65 */ {  87, 2 },
+  /*  66 */ {  89, 1 },
+  /*  67 */ {  90, 1 },
+  /*  68 */ {  91, 1 },
+  /*  69 */ {  92, 1 },
+  /*  70 */ {  93, 2 },
+  // Captain, tier 1.
+  /*  71 */ {  95, 1 },
+  /*  72 */ {  96, 1 },
+  /*  73 */ {  97, 1 },
+  /*  74 */ {  98, 1 },
+  /*  75 */ {  99, 1 },
+  // Captain, tier 2.
+  /*  76 */ { 100, 1 },
+  /*  77 */ { 101, 1 },
+  /*  78 */ { 102, 1 },
+  /*  79 */ { 103, 1 },
+  /*  80 */ { 104, 1 },
+  /*  81 */ { 105, 1 },
+  // Captain, tier 3.
+  /*  82 */ { 106, 1 },
+  /*  83 */ { 107, 1 },
+  /*  84 */ { 108, 2 },
+  /*  85 */ { 110, 2 },
+  /*  86 */ { 112, 2 },
+  /*  87 */ { 114, 2 },
+  /*  88 */ { 116, 1 },
+  /*  89 */ { 117, 1 },
+  // Commander, tier 1.
+  /*  90 */ { 118, 1 },
+  /*  91 */ { 119, 1 },
+  /*  92 */ { 120, 1 },
+  /*  93 */ { 121, 1 },
+  /*  94 */ { 122, 1 },
+  /*  95 */ { 123, 1 },
+  /*  96 */ { 124, 1 },
+  /*  97 */ { 125, 1 },
+  // Commander, tier 2.
+  /*  98 */ { 126, 1 },
+  /*  99 */ { 127, 1 },
+  /* 100 */ { 128, 1 },
+  /* 101 */ { 129, 1 },
+  /* 102 */ { 130, 1 },
+  /* 103 */ { 131, 1 },
+  /* 104 */ { 132, 1 },
+  /* 105 */ { 133, 1 },
+  // Commander, tier 3.
+  /* 106 */ { 134, 1 },
+  /* 107 */ { 135, 1 },
+  /* 108 */ { 136, 1 },
+  /* 109 */ { 137, 1 },
+  /* 110 */ { 138, 1 },
+  /* 111 */ { 139, 1 },
+  /* 112 */ { 140, 1 },
+  /* 113 */ { 141, 1 },
+  // Bronze, tier 1.
+  /* 114 */ { 142, 1 },
+  /* 115 */ { 143, 1 },
+  // Bronze, tier 2.
+  /* 116 */ { 144, 1 },
+  /* 117 */ { 145, 1 },
+  // Bronze, tier 3.
+  /* 118 */ { 146, 1 },
+  /* 119 */ { 147, 1 },
+  // Silver, tier 1.
+  /* 120 */ { 148, 1 },
+  /* 121 */ { 149, 1 },
+  /* 122 */ { 150, 1 },
+  /* 123 */ { 151, 1 },
+  // Silver, tier 2.
+  /* 124 */ { 152, 1 },
+  /* 125 */ { 153, 1 },
+  /* 126 */ { 154, 1 },
+  /* 127 */ { 155, 1 },
+  // Silver, tier 3.
+  /* 128 */ { 156, 1 },
+  /* 129 */ { 157, 1 },
+  /* 130 */ { 158, 1 },
+  /* 131 */ { 159, 1 },
+  // Gold, tier 1.
+  /* 132 */ { 160, 1 },
+  /* 133 */ { 161, 1 },
+  /* 134 */ { 162, 1 },
+  /* 135 */ { 163, 1 },
+  /* 136 */ { 164, 1 },
+  /* 137 */ { 165, 1 },
+  // Gold, tier 2.
+  /* 138 */ { 166, 1 },
+  /* 139 */ { 167, 1 },
+  /* 140 */ { 168, 1 },
+  /* 141 */ { 169, 1 },
+  /* 142 */ { 170, 1 },
+  /* 143 */ { 171, 1 },
+  // Gold, tier 3.
+  /* 144 */ { 172, 1 },
+  /* 145 */ { 173, 1 },
+  /* 146 */ { 174, 1 },
+  /* 147 */ { 175, 1 },
+  /* 148 */ { 176, 1 },
+  /* 149 */ { 177, 1 },
+  // Arrow, tier 1.
+  /* 150 */ { 178, 1 },
+  /* 151 */ { 179, 1 },
+  /* 152 */ { 180, 1 },
+  /* 153 */ { 181, 1 },
+  // Arrow, tier 2.
+  /* 154 */ { 182, 1 },
+  /* 155 */ { 183, 1 },
+  /* 156 */ { 184, 2 },
+  /* 157 */ { 186, 2 },
+  // Arrow, tier 3.
+  /* 158 */ { 188, 1 },
+  /* 159 */ { 189, 1 },
+  /* 160 */ { 190, 1 },
+  /* 161 */ { 191, 1 },
+  /* 162 */ { 192, 2 },
+  /* 163 */ { 194, 2 },
+  // Phoenix, tier 1.
+  /* 164 */ { 196, 1 },
+  /* 165 */ { 197, 1 },
+  /* 166 */ { 198, 1 },
+  /* 167 */ { 199, 1 },
+  /* 168 */ { 200, 1 },
+  /* 169 */ { 201, 1 },
+  /* 170 */ { 202, 1 },
+  /* 171 */ { 203, 1 },
+  // Phoenix, tier 2.
+  /* 172 */ { 204, 1 },
+  /* 173 */ { 205, 1 },
+  /* 174 */ { 206, 1 },
+  /* 175 */ { 207, 1 },
+  // Phoenix, tier 3.
+  /* 176 */ { 208, 1 },
+  /* 177 */ { 209, 1 },
+  /* 178 */ { 210, 1 },
+  /* 179 */ { 211, 1 },
+  // Dragon King, tier 1.
+  /* 180 */ { 212, 1 },
+  /* 181 */ { 213, 1 },
+  /* 182 */ { 214, 1 },
+  /* 183 */ { 215, 1 },
+  /* 184 */ { 216, 1 },
+  /* 185 */ { 217, 1 },
+  /* 186 */ { 218, 1 },
+  /* 187 */ { 219, 1 },
+  // Dragon King, tier 2.
+  /* 188 */ { 220, 1 },
+  /* 189 */ { 221, 1 },
+  /* 190 */ { 222, 1 },
+  /* 191 */ { 223, 1 },
+  // Dragon King, tier 3.
+  /* 192 */ { 224, 1 },
+  /* 193 */ { 225, 1 },
+  /* 194 */ { 226, 1 },
+  /* 195 */ { 227, 1 },
+  // Lance, tier 1.
+  /* 196 */ { 228, 1 },
+  // Lance, tier 2.
+  /* 197 */ { 229, 1 },
+  /* 198 */ { 230, 1 },
+  /* 199 */ { 231, 1 },
+  /* 200 */ { 232, 1 },
+  // Lance, tier 3.
+  /* 201 */ { 233, 1 },
+  /* 202 */ { 234, 1 },
+  /* 203 */ { 235, 1 },
+  /* 204 */ { 236, 1 },
+  // Clandestinite, tier 1.
+  /* 205 */ { 237, 2 },
+  /* 206 */ { 239, 2 },
+  /* 207 */ { 241, 1 },
+  // Clandestinite, tier 2.
+  /* 208 */ { 242, 2 },
+  /* 209 */ { 244, 2 },
+  /* 210 */ { 246, 1 },
+  /* 211 */ { 247, 1 },
+  /* 212 */ { 248, 1 },
+  // Clandestinite, tier 3.
+  /* 213 */ { 249, 2 },
+  /* 214 */ { 251, 2 },
+  /* 215 */ { 253, 1 },
+  /* 216 */ { 254, 1 },
+  /* 217 */ { 255, 1 },
+  /* 218 */ { 256, 2 },
+  /* 219 */ { 258, 2 },
+  /* 220 */ { 260, 2 },
+  /* 221 */ { 262, 2 },
+  // Pike, tier 1.
+  /* 222 */ { 264, 2 },
+  /* 223 */ { 266, 1 },
+  /* 224 */ { 267, 1 },
+  /* 225 */ { 268, 1 },
+  /* 226 */ { 269, 1 },
+  // Pike, tier 2.
+  /* 227 */ { 270, 1 },
+  /* 228 */ { 271, 1 },
+  /* 229 */ { 272, 1 },
+  /* 230 */ { 273, 1 },
+  // Pike, tier 3.
+  /* 231 */ { 274, 1 },
+  /* 232 */ { 275, 1 },
+  /* 233 */ { 276, 1 },
+  /* 234 */ { 277, 1 },
+  // Pistol, tier 1.
+  /* 235 */ { 278, 1 },
+  /* 236 */ { 279, 1 },
+  /* 237 */ { 280, 1 },
+  /* 238 */ { 281, 1 },
+  // Pistol, tier 2.
+  /* 239 */ { 282, 1 },
+  /* 240 */ { 283, 1 },
+  /* 241 */ { 284, 1 },
+  /* 242 */ { 285, 1 },
+  // Pistol, tier 3.
+  /* 243 */ { 286, 1 },
+  /* 244 */ { 287, 1 },
+  /* 245 */ { 288, 1 },
+  /* 246 */ { 289, 1 }
+};
+
+constexpr moveset_t k_UNIT_MOVES[GUNGI_NUM_PIECES] = {
+  [GUNGI_PIECE_PAWN]          = { {   0,  1 }, {   1,  3 }, {   4,  4 } },
+  [GUNGI_PIECE_BOW]           = { {   8,  3 }, {  11,  4 }, {  15,  5 } },
+  [GUNGI_PIECE_PRODIGY]       = { {  20,  4 }, {  24,  4 }, {  28,  4 } },
+  [GUNGI_PIECE_HIDDEN_DRAGON] = { {  32,  4 }, {  36,  4 }, {  40,  4 } },
+  [GUNGI_PIECE_FORTRESS]      = { {  44,  0 }, {  44,  0 }, {  44,  0 } },
+  [GUNGI_PIECE_CATAPULT]      = { {  44,  0 }, {  44,  0 }, {  44,  0 } },
+  [GUNGI_PIECE_SPY]           = { {  44,  2 }, {  46,  4 }, {  50,  4 } },
+  [GUNGI_PIECE_SAMURAI]       = { {  54,  5 }, {  59,  6 }, {  65,  6 } },
+  [GUNGI_PIECE_CAPTAIN]       = { {  71,  5 }, {  76,  6 }, {  82,  8 } },
+  [GUNGI_PIECE_COMMANDER]     = { {  90,  8 }, {  98,  8 }, { 106,  8 } },
+  [GUNGI_PIECE_BRONZE]        = { { 114,  2 }, { 116,  2 }, { 118,  2 } },
+  [GUNGI_PIECE_SILVER]        = { { 120,  4 }, { 124,  4 }, { 128,  4 } },
+  [GUNGI_PIECE_GOLD]          = { { 132,  6 }, { 138,  6 }, { 144,  6 } },
+  [GUNGI_PIECE_ARROW]         = { { 150,  4 }, { 154,  4 }, { 158,  6 } },
+  [GUNGI_PIECE_PHOENIX]       = { { 164,  8 }, { 172,  4 }, { 176,  4 } },
+  [GUNGI_PIECE_DRAGON_KING]   = { { 180,  8 }, { 188,  4 }, { 192,  4 } },
+  [GUNGI_PIECE_LANCE]         = { { 196,  1 }, { 197,  4 }, { 201,  4 } },
+  [GUNGI_PIECE_CLANDESTINITE] = { { 205,  3 }, { 208,  5 }, { 213,  9 } },
+  [GUNGI_PIECE_PIKE]          = { { 222,  5 }, { 227,  4 }, { 231,  4 } },
+  [GUNGI_PIECE_PISTOL]        = { { 235,  4 }, { 239,  4 }, { 243,  4 } }
 };
 
 static const char *s_GN_IDENTIFIERS[] = {
-  [GUNGI_PIECE_ARROW]         = "A",
+  [GUNGI_PIECE_PAWN]          = "P",
   [GUNGI_PIECE_BOW]           = "B",
-  [GUNGI_PIECE_BRONZE]        = "Z",
-  [GUNGI_PIECE_CAPTAIN]       = "C",
+  [GUNGI_PIECE_PRODIGY]       = "R",
+  [GUNGI_PIECE_HIDDEN_DRAGON] = "H",
+  [GUNGI_PIECE_FORTRESS]      = "F",
   [GUNGI_PIECE_CATAPULT]      = "T",
-  [GUNGI_PIECE_CLANDESTINITE] = "N",
+  [GUNGI_PIECE_SPY]           = "Y",
+  [GUNGI_PIECE_SAMURAI]       = "S",
+  [GUNGI_PIECE_CAPTAIN]       = "C",
   [GUNGI_PIECE_COMMANDER]     = "O",
-  [GUNGI_PIECE_DRAGON_KING]   = "K",
-  [GUNGI_PIECE_FORTRESS]      = "F",
+  [GUNGI_PIECE_BRONZE]        = "Z",
+  [GUNGI_PIECE_SILVER]        = "V",
   [GUNGI_PIECE_GOLD]          = "G",
-  [GUNGI_PIECE_HIDDEN_DRAGON] = "H",
-  [GUNGI_PIECE_LANCE]         = "L",
-  [GUNGI_PIECE_PAWN]          = "P",
+  [GUNGI_PIECE_ARROW]         = "A",
   [GUNGI_PIECE_PHOENIX]       = "X",
+  [GUNGI_PIECE_DRAGON_KING]   = "K",
+  [GUNGI_PIECE_LANCE]         = "L",
+  [GUNGI_PIECE_CLANDESTINITE] = "N",
   [GUNGI_PIECE_PIKE]          = "E",
-  [GUNGI_PIECE_PISTOL]        = "I",
-  [GUNGI_PIECE_PRODIGY]       = "R",
-  [GUNGI_PIECE_SAMURAI]       = "S",
-  [GUNGI_PIECE_SILVER]        = "V",
-  [GUNGI_PIECE_SPY]           = "Y"
+  [GUNGI_PIECE_PISTOL]        = "I"
 };
 
 
@@ -1141,13 +874,17 @@ const char *piece_to_gn_identifier(piece_id_t piece) {
 }
 
 piece_id_t gn_identifier_to_piece(const char *id) {
-  std::string strId(id);
-  strId = Util::toUpperCase(strId);
+  // Every identifier is one character, so the given 'id' is compared without
+  // building strings, as this is called twice for every move decoded.
+  if (id[0] == '\0' || id[1] != '\0') {
+    return GUNGI_PIECE_NONE;
+  }
 
+  const char ch =
+    static_cast<char>(std::toupper(static_cast<unsigned char>(id[0])));
   for (int i = GUNGI_PIECE_NONE + 1; i < GUNGI_NUM_PIECES; i++) {
     piece_id_t piece = static_cast<piece_id_t>(i);
-    std::string pieceId(piece_to_gn_identifier(piece));
-    if (strId == pieceId) {
+    if (ch == s_GN_IDENTIFIERS[piece][0]) {
       return piece;
     }
   }
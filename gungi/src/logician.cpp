@@ -1,6 +1,8 @@
 // logician.cpp                                                       -*-C++-*-
 #include "logician.hpp"
 
+#include "attacktable.hpp"
+#include "bitboard.hpp"
 #include "builder.hpp"
 #include "gtypes.hpp"
 #include "player.hpp"
@@ -8,11 +10,13 @@
 #include "tower.hpp"
 #include "unit.hpp"
 #include "util.hpp"
+#include "zobrist.hpp"
 
 #include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <string>
@@ -21,45 +25,12 @@
 
 namespace {
 
-static bool hasTower(std::shared_ptr<gungi::Unit>& unit);
-  // Returns 'true' if the given 'unit' is in a tower, otherwise 'false'.
+static unsigned int colourIndex(gungi::colour_t colour);
+  // Returns the index of the given 'colour' within the per-player bitboard
+  // arrays.
 
-static gungi::PosnSet intersect(const gungi::PosnSet& a,
-                                const gungi::PosnSet& b);
-  // Computes the set intersection between the constant 'gungi::PosnSet'
-  // references, 'a' and 'b', and returns the result.
-
-static gungi::PosnSet difference(const gungi::PosnSet& a,
-                                 const gungi::PosnSet& b);
-  // Computes the set difference between the constant 'gungi::PosnSet'
-  // references 'a' and 'b', and returns the result.
-
-template <class InputIt, class UnaryPredicate>
-unsigned int any_of_count(InputIt first, InputIt last, UnaryPredicate p) {
-  unsigned int count = 0;
-  while (first != last) {
-    count += p(*first) ? 1 : 0;
-    first++;
-  }
-  return count;
-}
-
-bool hasTower(std::shared_ptr<gungi::Unit>& unit) {
-  return unit->tower() != NULL;
-}
-
-gungi::PosnSet intersect(const gungi::PosnSet& a, const gungi::PosnSet& b) {
-  gungi::PosnSet temp;
-  temp.reserve(a.size());
-  std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), temp.begin());
-  return temp;
-}
-
-gungi::PosnSet difference(const gungi::PosnSet& a, const gungi::PosnSet& b) {
-  gungi::PosnSet temp;
-  temp.reserve(a.size());
-  std::set_difference(a.begin(), a.end(), b.begin(), b.end(), temp.begin());
-  return temp;
+unsigned int colourIndex(gungi::colour_t colour) {
+  return colour == gungi::WHITE ? 0 : 1;
 }
 
 }  // close 'unnamed' namespace
@@ -72,8 +43,7 @@ namespace gungi {
 
 // CREATORS
 BoardRecorder::BoardRecorder(void)
-: m_boardSize(Logician::k_BOARD_SIZE)
-, m_positions()
+: m_keys()
 {
   // DO NOTHING
 }
@@ -83,64 +53,33 @@ BoardRecorder::~BoardRecorder(void) {
 }
 
 // ACCESSORS
-const BoardRecorder::position_t *BoardRecorder::position(const std::vector<Tower>& board) const {
-  for (const position_t& position : m_positions) {
-    bool isBoardEqual = false;
-    for (unsigned int i = 0; i < m_boardSize; i++) {
-      const Tower& tower = board[i];
-      const std::vector<piece_id_t>& pieces = position.board[i];
-
-      if (tower.height() != pieces.size()) {
-        // Early exit, since their sizes aren't equal.
-        isBoardEqual = false;
-        break;
-      }
-
-      for (unsigned int y = 0; y < tower.height(); y++) {
-        if (tower.members()[i]->front() != pieces[i]) {
-          // Eqarly exit, since the sides are not equal.
-          isBoardEqual = false;
-          break;
-        }
-      }
-
-      if (!isBoardEqual) {
-        break;
-      }
-    }
+unsigned int BoardRecorder::repetitions(uint64_t key) const {
+  return std::count(m_keys.begin(), m_keys.end(), key);
+}
 
-    if (isBoardEqual) {
-      return &position;
-    }
-  }
-  return NULL;
+unsigned int BoardRecorder::count(void) const {
+  return m_keys.size();
 }
 
 // MANIPULATORS
 void BoardRecorder::reset(void) {
-  m_positions.clear();
-}
-
-unsigned int BoardRecorder::record(const std::vector<Tower>& board) {
-  position_t *pos = const_cast<position_t *>(position(board));
-  if (!pos) {
-    m_positions.resize(m_positions.size() + 1);
-    pos = &m_positions.back();
-    pos->board.resize(m_boardSize);
-    pos->repetitions = 0;
-    for (unsigned int i = 0; i < m_boardSize; i++) {
-      for (const SharedUnitPtr& ptr : board[i].members()) {
-        pos->board[i].push_back(ptr->front());
-      }
-    }
-  }
-  return pos->repetitions++;
+  m_keys.clear();
+}
+
+unsigned int BoardRecorder::record(uint64_t key) {
+  const unsigned int repeated = repetitions(key);
+  m_keys.push_back(key);
+  return repeated;
+}
+
+void BoardRecorder::truncate(unsigned int count) {
+  GASSERT(count <= m_keys.size());
+  m_keys.resize(count);
 }
 
 // OPERATORS
-unsigned int operator<<(BoardRecorder&            recorder,
-                        const std::vector<Tower>& board) {
-  return recorder.record(board);
+unsigned int operator<<(BoardRecorder& recorder, uint64_t key) {
+  return recorder.record(key);
 }
 
 
@@ -150,25 +89,31 @@ unsigned int operator<<(BoardRecorder&            recorder,
 
 // PRIVATE ACCESSORS
 Player& Logician::next(void) {
-  if (state() & GAME_STATE_TURN_WHITE) {
+  if (m_gameState & GAME_STATE_TURN_WHITE) {
     return m_black;
   }
   return m_white;
 }
 
 Player& Logician::current(void) {
-  if (state() & GAME_STATE_TURN_WHITE) {
+  if (m_gameState & GAME_STATE_TURN_WHITE) {
     return m_white;
   }
   return m_black;
 }
 
-PosnSet Logician::commanderEscapeRoutes(const Unit& com,
-                                        const Posn& commanderPosn) const {
+Bitboard Logician::commanderEscapeRoutes(const Unit& com,
+                                         const Posn& commanderPosn) const {
   GASSERT(com.front() == GUNGI_PIECE_COMMANDER);
 
+  if (com.tower() && m_arena.get(com.tower()->top()) != &com) {
+    // A Commander that units were moved on top of can neither move nor be
+    // substituted.
+    return Bitboard();
+  }
+
   error_t error;
-  PosnSet escapes = (PosnSet) {
+  const PosnSet neighbours = (PosnSet) {
     Posn(commanderPosn.col() + 1, commanderPosn.row()),
     Posn(commanderPosn.col() - 1, commanderPosn.row()),
     Posn(commanderPosn.col(), commanderPosn.row() + 1),
@@ -179,17 +124,11 @@ PosnSet Logician::commanderEscapeRoutes(const Unit& com,
     Posn(commanderPosn.col() - 1, commanderPosn.row() - 1),
   };
 
-  for (PosnSet::iterator it = escapes.begin(); it != escapes.end();) {
-    if (!it->isValid() || m_board[it->index()].height() == k_MAX_TOWER_SIZE) {
-      escapes.erase(it);
-    } else {
-      it++;
-    }
-  }
+  // The commander cannot escape off the board, or onto a full tower.
+  Bitboard escapes = Bitboard::fromPosns(neighbours) - full();
 
   const Player& player = com.colour() == BLACK ? black() : white();
-  for (const SharedUnitPtr& sharedUnitPtr : player.units()) {
-    const Unit *unit = sharedUnitPtr.get();
+  for (const Unit *unit : player.units()) {
     if (unit->effectField() & GUNGI_EFFECT_SUBSTITUTION) {
       // This effect allows to swap with a Commander to the left, right, front,
       // or back of the current unit if the commander is in check, and the unit
@@ -212,7 +151,7 @@ PosnSet Logician::commanderEscapeRoutes(const Unit& com,
       case GUNGI_MOVE_DIR_LEFT:
       case GUNGI_MOVE_DIR_RIGHT:
       case GUNGI_MOVE_DIR_DOWN:
-        escapes.push_back(posn);
+        escapes.set(posn);
         break;
       default:
         break;
@@ -224,55 +163,678 @@ PosnSet Logician::commanderEscapeRoutes(const Unit& com,
 }
 
 bool Logician::isReachableAfterMove(const Posn&   posn,
-                                    const Player& player) const {
+                                    const Player& player,
+                                    const Unit&   moving) const {
   error_t error;
-  for (const SharedUnitPtr& sharedUnitPtr : player.activeUnits()) {
-    const Unit *unit = sharedUnitPtr.get();
-    Tower const *tower = unit->tower();
-    if (tower->posn() == posn) {
-      tier_t tier = tower->tier(unit, error);
-      GASSERT(error == GUNGI_ERROR_NONE);
+  const Tower& tower = m_board[posn.index()];
+  if (tower.height() >= 2) {
+    // A unit moving to the tower takes the unit at its top, so the unit of
+    // the player right below it, if any, can strike it.
+    const Unit *top = m_arena.get(tower.top());
+    const Unit *below = m_arena.get(tower.at(tower.height() - 2, error));
+    if (top->colour() == player.colour() &&
+        below->colour() == player.colour()) {
+      return true;
+    }
+  }
 
-      if (tier != tower->height() - 1) {
-        continue;
-      }
+  // Leaving its tower, the moving unit may only open the walks that cross
+  // it.
+  const Tower *origin = moving.tower();
+  const unsigned int to = posn.index();
+  for (const Unit *unit : player.activeUnits()) {
+    const unsigned int start = unit->tower()->posn().index();
+    if (start == to) {
+      continue;
+    }
 
-      const Unit *topUnit = tower->at(tier + 1, error);
-      if (!topUnit || topUnit->colour() != unit->colour()) {
-        continue;
-      }
+    const bool reaches =
+      attacks(*unit).test(to) ||
+      (origin &&
+       AttackTable::between(start, to).test(origin->posn().index()) &&
+       computeAttacksAfterLeaving(*unit, moving).test(to));
+    if (reaches && isTakingCommander(posn, *unit)) {
+      return true;
+    }
+  }
+
+  // The unit of the player right below the moving unit, if any, is
+  // uncovered once it leaves.
+  if (!origin || origin->height() < 2) {
+    return false;
+  }
+
+  const Unit *uncovered = m_arena.get(origin->at(origin->height() - 2, error));
+  return uncovered->colour() == player.colour() &&
+         computeWalks(*uncovered, Bitboard()).test(posn) &&
+         isTakingCommander(posn, *uncovered);
+}
 
+bool Logician::isTakingCommander(const Posn& target, const Unit& unit) const {
+  // The Commander takes the top of the tower if it is an enemy, so the rules
+  // that depend on the tower are applied to the tower without it.
+  const Tower& tower = m_board[target.index()];
+  const Unit *top = m_arena.get(tower.top());
+  const bool taken = top && top->colour() == unit.colour();
+  const tier_t height = tower.height() - (taken ? 1 : 0);
+
+  error_t error;
+  for (tier_t tier = 0; tier < height; tier++) {
+    const Unit *member = m_arena.get(tower.at(tier, error));
+    if (member->front() == unit.front() && member->colour() == unit.colour()) {
+      return false;
+    }
+  }
+
+  if (unit.front() != GUNGI_PIECE_BRONZE) {
+    return true;
+  }
+
+  Bitboard bronzes = pieces(unit.colour(), GUNGI_PIECE_BRONZE)
+                   & Bitboard::file(target.col());
+  if (taken && top->front() == GUNGI_PIECE_BRONZE) {
+    bronzes.reset(target.index());
+  }
+  return bronzes.none();
+}
+
+bool Logician::isExposingCommander(const Tower&       tower,
+                                   const Unit * const *members,
+                                   tier_t              height) const {
+  GASSERT(height > 0);
+
+  const colour_t colour = members[height - 1]->colour();
+  const Player& enemy = colour == BLACK ? white() : black();
+  const Posn& posn = tower.posn();
+  const unsigned int idx = posn.index();
+  for (const Unit *unit : enemy.activeUnits()) {
+    if (!m_attacks[m_arena.handle(unit)].test(idx) ||
+        (unit->front() == GUNGI_PIECE_BRONZE &&
+         isDuplicateInFile(*unit, posn))) {
+      continue;
+    }
+
+    // The top is taken, and the units below it join the team of 'unit' if
+    // it betrays, so neither may duplicate it.
+    const bool betrays = unit->effectField() & GUNGI_EFFECT_BETRAYAL;
+    bool duplicate = false;
+    for (tier_t tier = 0; !duplicate && tier < height - 1; tier++) {
+      const Unit *member = members[tier];
+      duplicate = member->front() == unit->front() &&
+                  (betrays || member->colour() == unit->colour());
+    }
+
+    if (!duplicate) {
       return true;
+    }
+  }
+
+  return false;
+}
+
+bool Logician::isAttacking(const Posn& target, const Unit& unit) const {
+  if (isInitialArrangement() ||
+      isForcedRearrangeForPlayer(unit.colour()) ||
+      isForcedRecoveryForPlayer(unit.colour()) ||
+      isOver()) {
+    // No unit can move, so no unit attacks.
+    return false;
+  } else if (!m_attacks[m_arena.handle(&unit)].test(target)) {
+    return false;
+  }
+
+  // The attack map does not consider the tower at the target, which can
+  // still rule the move out.
+  const Tower& tower = m_board[target.index()];
+  const Unit *top = m_arena.get(tower.top());
+  if (top &&
+      top->colour() == unit.colour() &&
+      tower.height() == k_MAX_TOWER_SIZE) {
+    return false;
+  } else if (tower.isDuplicate(&unit, m_arena) ||
+             isBetrayingDuplicate(unit, tower)) {
+    return false;
+  }
+
+  return unit.front() != GUNGI_PIECE_BRONZE ||
+         !isDuplicateInFile(unit, target);
+}
+
+bool Logician::isBetrayingDuplicate(const Unit&  unit,
+                                    const Tower& tower) const {
+  if (!(unit.effectField() & GUNGI_EFFECT_BETRAYAL)) {
+    return false;
+  }
+
+  const Unit *top = m_arena.get(tower.top());
+  if (!top || top->colour() == unit.colour()) {
+    // Nothing betrays its team.
+    return false;
+  }
+
+  // The top is taken, and the enemy units below it join the unit's team.
+  error_t error;
+  const tier_t below = tower.height() - 1;
+  for (tier_t tier = 0; tier < below; tier++) {
+    const Unit *member = m_arena.get(tower.at(tier, error));
+    if (member->colour() != unit.colour() && member->front() == unit.front()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Logician::isAttackedAfter(const Unit& unit, const Posn& posn) const {
+  const unsigned int to = posn.index();
+  const Tower& tower = m_board[to];
+  const Unit *top = m_arena.get(tower.top());
+  const bool drop = !unit.tower();
+  const bool strike = unit.tower() == &tower;
+  const bool takes = !drop && top && top->colour() != unit.colour();
+  const bool leaves = !drop && !strike && m_pinned.test(unit.tower()->posn());
+  if (!leaves && !takes) {
+    // The unit neither leaves a pinned tower, nor takes a unit.
+    return false;
+  }
+
+  const Player& player = unit.colour() == BLACK ? black() : white();
+  const Player& enemy = unit.colour() == BLACK ? white() : black();
+  const Posn& commanderPosn = player.commander()->tower()->posn();
+  const unsigned int target = commanderPosn.index();
+
+  const Bitboard file = Bitboard::file(commanderPosn.col());
+  Bitboard bronzes = pieces(enemy.colour(), GUNGI_PIECE_BRONZE);
+  if (!leaves && !(bronzes & file).test(to)) {
+    // The unit stops every check at a check point, and neither uncovers a
+    // walk to the Commander, nor lets a second enemy Bronze into its file.
+    return false;
+  }
+
+  if (isInitialArrangement() ||
+      isForcedRearrangeForPlayer(enemy) ||
+      isForcedRecoveryForPlayer(enemy) ||
+      isOver()) {
+    // No enemy unit can move, so no enemy unit attacks.
+    return false;
+  }
+
+  // Build the squares that block the enemy units after the move: the unit
+  // lands on 'posn', and, if it leaves its tower, uncovers the unit below it.
+  error_t error;
+  Bitboard occupied = this->occupied();
+  Bitboard shields = topped(unit.colour());
+  occupied.set(to);
+  shields.set(to);
+
+  const Unit *uncovered = NULL;
+  if (!drop && !strike) {
+    const Tower& from = *unit.tower();
+    const unsigned int idx = from.posn().index();
+    if (from.height() == 1) {
+      occupied.reset(idx);
+      shields.reset(idx);
     } else {
-      PosnSet walk;
-      bool validWalk = isValidMove(posn, *unit, walk, error);
-      if (validWalk) {
-        return true;
+      uncovered = m_arena.get(from.at(from.height() - 2, error));
+      if (uncovered->colour() != unit.colour()) {
+        shields.reset(idx);
       }
     }
   }
+
+  if (takes &&
+      (top->front() == GUNGI_PIECE_BRONZE ||
+       (!strike && (unit.effectField() & GUNGI_EFFECT_BETRAYAL)))) {
+    // The enemy Bronze at 'posn' is taken, or betrays its team.
+    bronzes.reset(to);
+  }
+
+  const bool inverted = isInverted(enemy.colour());
+  const Bitboard jumpBarriers = shields
+                              & m_expansions[colourIndex(unit.colour())];
+  const Tower& commanderTower = m_board[target];
+  for (const Unit *enemyUnit : enemy.activeUnits()) {
+    const Tower *enemyTower = enemyUnit->tower();
+    const unsigned int idx = enemyTower->posn().index();
+    if (idx == to ||
+        (enemyUnit != m_arena.get(enemyTower->top()) &&
+         enemyUnit != uncovered)) {
+      // Units at 'posn' are taken or covered, and units below the top of a
+      // tower cannot move.
+      continue;
+    }
+
+    // A tower holds one unit of each front identifier per team, so a taken
+    // top of the tower of the Commander is the only duplicate of its kind.
+    if (!AttackTable::reach(enemyUnit->front(),
+                            enemyUnit->tier(),
+                            idx,
+                            inverted).test(target) ||
+        (commanderTower.isDuplicate(enemyUnit, m_arena) &&
+         !(takes && to == target && top->front() == enemyUnit->front())) ||
+        (enemyUnit->front() == GUNGI_PIECE_BRONZE && (bronzes & file).any())) {
+      continue;
+    }
+
+    const Bitboard& barriers = enemyUnit->effectField() & GUNGI_EFFECT_JUMP
+      ? jumpBarriers
+      : occupied;
+    if ((AttackTable::between(idx, target) & barriers).none()) {
+      return true;
+    }
+  }
+
   return false;
 }
 
+bool Logician::isAttackedAfterStrike(tier_t tier, const Unit& unit) const {
+  const Tower& tower = *unit.tower();
+  const tier_t height = tower.height();
+  error_t error;
+  if (unit.front() == GUNGI_PIECE_COMMANDER) {
+    // The Commander takes the place of the unit it strikes, next to the unit
+    // beyond it, which can strike the Commander if it is an enemy.
+    const tier_t beyond = 2 * tier - unit.tier();
+    const Unit *next = beyond >= 0 && beyond < height
+                     ? m_arena.get(tower.at(beyond, error))
+                     : NULL;
+    if (next && next->colour() != unit.colour()) {
+      return true;
+    }
+  }
+
+  const Player& player = unit.colour() == BLACK ? black() : white();
+  const Player& enemy = unit.colour() == BLACK ? white() : black();
+  const Tower& commanderTower = *player.commander()->tower();
+  const Posn& commanderPosn = commanderTower.posn();
+  const unsigned int target = commanderPosn.index();
+  const unsigned int idx = tower.posn().index();
+
+  const Unit *struck = m_arena.get(tower.at(tier, error));
+  GASSERT(error == GUNGI_ERROR_NONE);
+  if (struck->front() == GUNGI_PIECE_BRONZE &&
+      tower.posn().col() == commanderPosn.col()) {
+    // Taking the enemy Bronze in the file of the Commander may let another
+    // enemy Bronze into the file.
+    Bitboard bronzes = pieces(enemy.colour(), GUNGI_PIECE_BRONZE);
+    bronzes.reset(idx);
+    if ((bronzes & Bitboard::file(commanderPosn.col())).none()) {
+      for (const Unit *bronze : enemy.activeUnits()) {
+        if (bronze != struck &&
+            bronze->front() == GUNGI_PIECE_BRONZE &&
+            attacks(*bronze).test(target) &&
+            (&commanderTower == &tower ||
+             (!commanderTower.isDuplicate(bronze, m_arena) &&
+              !isBetrayingDuplicate(*bronze, commanderTower)))) {
+          return true;
+        }
+      }
+    }
+  }
+
+  const Unit *top = m_arena.get(tower.top());
+  if (tier == height - 1 || top->colour() == unit.colour()) {
+    // The strike takes the top, or the top is of the player, so no enemy
+    // unit walks differently after it.
+    return false;
+  }
+
+  // The enemy unit at the top is lowered by a tier, which changes its walks.
+  if (!AttackTable::reach(top->front(),
+                          top->tier() - 1,
+                          idx,
+                          isInverted(top->colour())).test(target) ||
+      commanderTower.isDuplicate(top, m_arena) ||
+      (top->front() == GUNGI_PIECE_BRONZE &&
+       isDuplicateInFile(*top, commanderPosn))) {
+    return false;
+  }
+
+  Bitboard barriers = occupied();
+  if (top->effectField() & GUNGI_EFFECT_JUMP) {
+    barriers = topped(unit.colour())
+             & m_expansions[colourIndex(unit.colour())];
+  }
+  return (AttackTable::between(idx, target) & barriers).none();
+}
+
+Bitboard Logician::computeAttacks(const Unit& unit) const {
+  return computeAttacks(unit, Bitboard());
+}
+
+Bitboard Logician::computeAttacks(const Unit&     unit,
+                                  const Bitboard& vacated) const {
+  const Tower *tower = unit.tower();
+  if (!tower || unit.tier() != tower->height() - 1) {
+    // Only the unit at the top of a tower can move.
+    return Bitboard();
+  }
+
+  return computeWalks(unit, vacated);
+}
+
+Bitboard Logician::computeAttacksAfterLeaving(const Unit& unit,
+                                              const Unit& moving) const {
+  if (!moving.tower()) {
+    // A dropped unit leaves no tower.
+    return attacks(unit);
+  }
+
+  const Tower& tower = *moving.tower();
+  const unsigned int idx = tower.posn().index();
+
+  // The tower stops blocking walks once it is empty, and jumps once its new
+  // top is of the colour of 'unit'.
+  error_t error;
+  Bitboard vacated;
+  if (tower.height() == 1) {
+    vacated.set(idx);
+  } else if (unit.effectField() & GUNGI_EFFECT_JUMP) {
+    const Unit *below = m_arena.get(tower.at(tower.height() - 2, error));
+    if (below->colour() == unit.colour()) {
+      vacated.set(idx);
+    }
+  }
+
+  const Tower *start = unit.tower();
+  if (vacated.none() ||
+      (AttackTable::lines(unit.front(),
+                          unit.tier(),
+                          start->posn().index(),
+                          isInverted(unit.colour())) & vacated).none()) {
+    // The unit does not walk across the tower.
+    return attacks(unit);
+  }
+
+  return computeAttacks(unit, vacated);
+}
+
+Bitboard Logician::computeWalks(const Unit&     unit,
+                                const Bitboard& vacated) const {
+  const unsigned int start = unit.tower()->posn().index();
+  const bool inverted = isInverted(unit.colour());
+  const colour_t enemyColour = unit.colour() == WHITE ? BLACK : WHITE;
+
+  // A walk is blocked by any unit it crosses, unless the unit can jump, in
+  // which case it is only blocked by enemy units in the enemy's mobile range
+  // expansion.
+  Bitboard barriers = occupied();
+  if (unit.effectField() & GUNGI_EFFECT_JUMP) {
+    barriers = topped(enemyColour) & m_expansions[colourIndex(enemyColour)];
+  }
+
+  barriers -= vacated;
+
+  Bitboard attacks;
+  Bitboard targets = AttackTable::reach(unit.front(),
+                                        unit.tier(),
+                                        start,
+                                        inverted);
+  while (targets.any()) {
+    const unsigned int idx = targets.pop();
+    if ((AttackTable::between(start, idx) & barriers).none()) {
+      attacks.set(idx);
+    }
+  }
+
+  return attacks;
+}
+
 bool Logician::isDuplicateInFile(const Unit& unit, const Posn& posn) const {
-  char col = posn.col();
-  for (unsigned int i = 0; i < k_BOARD_LENGTH; i++) {
-    const Posn p(col, i);
-    const Tower& tower = m_board[p.index()];
-    for (const SharedUnitPtr& sharedUnitPtr : tower.members()) {
-      if (sharedUnitPtr->colour() == unit.colour() &&
-          sharedUnitPtr->front() == unit.front()) {
-        return true;
+  return (pieces(unit.colour(), unit.front()) & Bitboard::file(posn.col())).any();
+}
+
+Bitboard Logician::threatened(colour_t colour) const {
+  const Player& player = colour == BLACK ? black() : white();
+  const bool inverted = isInverted(player);
+
+  Bitboard threats;
+  for (const Unit *unit : player.units()) {
+    if (unit->tower()) {
+      threats |= AttackTable::reach(unit->front(),
+                                    unit->tier(),
+                                    unit->tower()->posn().index(),
+                                    inverted);
+    }
+  }
+  return threats;
+}
+
+bool Logician::isFoulMate(const Move& move) const {
+  Logician fork(*this);
+  error_t error;
+  fork.playMove(move, error);
+  return error == GUNGI_ERROR_PAWN_CHECKMATE ||
+         error == GUNGI_ERROR_BRONZE_CHECKMATE;
+}
+
+bool Logician::mayBeFoulMate(const Unit&     unit,
+                             const Posn&     target,
+                             const Bitboard& threats) const {
+  const Player& enemy = unit.colour() == BLACK ? white() : black();
+  const Tower *enemyTower = enemy.commander()->tower();
+  if (!enemyTower) {
+    // Check is not computed until both Commanders have been placed.
+    return false;
+  }
+
+  // Checkmate needs check, and after the turn only a unit that could reach
+  // the enemy Commander on an empty board can give check: one already on the
+  // board, or the given 'unit' from any tier it could take at the 'target'.
+  const Tower& tower = m_board[target.index()];
+  Bitboard reach = threats;
+  for (tier_t tier = tower.height() > 0 ? tower.height() - 1 : 0;
+       tier <= tower.height() && tier < k_MAX_TOWER_SIZE;
+       tier++) {
+    reach |= AttackTable::reach(unit.front(),
+                                tier,
+                                target.index(),
+                                isInverted(unit.colour()));
+  }
+
+  return reach.test(enemyTower->posn());
+}
+
+void Logician::generateDrops(const Unit&     unit,
+                             const Bitboard& threats,
+                             MoveList&       moves) const {
+  const unit_handle_t handle = m_arena.handle(&unit);
+
+  // Dropping a Pawn or a Bronze to checkmate is foul play, which is only
+  // detected after the drop is made.
+  const bool foul = unit.front() == GUNGI_PIECE_PAWN ||
+                    unit.front() == GUNGI_PIECE_BRONZE;
+
+  error_t error;
+  for (unsigned int idx = 0; idx < Bitboard::k_NUM_SQUARES; idx++) {
+    const Posn& posn = m_board[idx].posn();
+    if (!isValidDrop(posn, unit, error)) {
+      continue;
+    }
+
+    const Move move = Move::drop(handle, posn);
+    if (foul && mayBeFoulMate(unit, posn, threats) && isFoulMate(move)) {
+      continue;
+    }
+
+    moves.add(move);
+  }
+}
+
+bool Logician::computeEvasions(bool withEscapes) const {
+  // The check gates of the validations below are for the moves of the
+  // current player, so they are lifted while the evasions are computed.
+  const game_state_t originalState = m_gameState;
+  m_gameState &= ~GAME_STATE_CHECK;
+
+  const bool blackToMove = m_gameState & GAME_STATE_TURN_BLACK;
+  const Player& currentPlayer = blackToMove ? m_black : m_white;
+  const Player& nextPlayer = blackToMove ? m_white : m_black;
+  const Unit *commander = currentPlayer.commander();
+  GASSERT(commander && commander->tower());
+
+  const Posn& target = commander->tower()->posn();
+
+  // Compute if there are any units that could exchange positions with the
+  // commander.  If there are such units, then they could be used to escape
+  // from check, so they must be verified as well.
+  m_escapeRoutes.clear();
+  if (withEscapes) {
+    m_escapeRoutes = commanderEscapeRoutes(*commander, target);
+  }
+
+  // For each unit in the next player's army, check if that unit can hit any
+  // of the positions that the commander can escape to.  Only the routes in
+  // its attack map, or at its own tower, are affected.
+  error_t error;
+  for (const Unit *unit : nextPlayer.activeUnits()) {
+    if (m_escapeRoutes.none()) {
+      break;
+    }
+
+    Tower const *tower = unit->tower();
+    const Posn& start(tower->posn());
+
+    // The commander no longer blocks the walks of the unit once it moves.
+    const Bitboard reach = computeAttacksAfterLeaving(*unit, *commander);
+
+    Bitboard remaining = m_escapeRoutes
+                       & (reach | Bitboard::square(start.index()));
+    while (remaining.any()) {
+      const unsigned int idx = remaining.pop();
+      const Posn& escape = m_board[idx].posn();
+      if (escape == start) {
+        // This escape route goes to the tower containing this unit.
+        int tier = tower->tier(unit, error);
+        GASSERT(error == GUNGI_ERROR_NONE);
+        if (tier == tower->height() - 1) {
+          // If this unit is the highest in the tower, we have to check if it
+          // is the same team as the commander.  If so, this escape route is
+          // not valid.
+          if (commander->colour() == unit->colour()) {
+            m_escapeRoutes.reset(idx);
+          }
+        } else if (tier == tower->height() - 2) {
+          // If this unit is not the highest in the tower, we have to check if
+          // the unit above this one in the tower is the same team as the
+          // current unit.  If so, the commander would take that unit's spot,
+          // meaning this unit can now perform an immobile strike, so this
+          // escape route is invalid.
+          const Unit *above = m_arena.get(tower->at(tier + 1, error));
+          if (above && above->colour() == unit->colour()) {
+            m_escapeRoutes.reset(idx);
+          }
+        }
+      } else if (reach.test(idx) && isTakingCommander(escape, *unit)) {
+        // The unit can hit this escape route, so it is not a valid escape
+        // route as the current player will still be in check.
+        m_escapeRoutes.reset(idx);
       }
     }
   }
-  return false;
+
+  // The enemy unit right below the commander, if any, is uncovered once the
+  // commander moves.
+  const Tower& commanderTower = *commander->tower();
+  if (m_escapeRoutes.any() && commanderTower.height() >= 2) {
+    const Unit *uncovered =
+      m_arena.get(commanderTower.at(commanderTower.height() - 2, error));
+    if (uncovered->colour() != commander->colour()) {
+      Bitboard remaining = m_escapeRoutes
+                         & computeWalks(*uncovered, Bitboard());
+      while (remaining.any()) {
+        const unsigned int idx = remaining.pop();
+        if (isTakingCommander(m_board[idx].posn(), *uncovered)) {
+          m_escapeRoutes.reset(idx);
+        }
+      }
+    }
+  }
+
+  m_pinned = pinned(currentPlayer.colour());
+
+  // For each non-commander unit on the current player's team, check if the
+  // unit can move to, strike at, or be dropped on a check point without
+  // leaving the commander in check.
+  const Bitboard checkPoints = m_checkPoints;
+  Bitboard availableCheckPoints;
+  for (const Unit *unit : currentPlayer.activeUnits()) {
+    if (unit == commander) {
+      // The commander escapes check on its own (see 'm_escapeRoutes').
+      continue;
+    }
+
+    Bitboard remaining = (checkPoints - availableCheckPoints)
+                       & attacks(*unit);
+    while (remaining.any()) {
+      const unsigned int idx = remaining.pop();
+      const Posn& posn = m_board[idx].posn();
+      if (isAttacking(posn, *unit) && !isAttackedAfter(*unit, posn)) {
+        availableCheckPoints.set(idx);
+      }
+    }
+  }
+
+  // A unit right below an enemy unit at a check point can strike it.
+  Bitboard remaining = (checkPoints - availableCheckPoints)
+                     & topped(nextPlayer.colour());
+  while (remaining.any()) {
+    const unsigned int idx = remaining.pop();
+    const Tower& tower = m_board[idx];
+    if (tower.height() < 2) {
+      continue;
+    }
+
+    const tier_t tier = tower.height() - 1;
+    const Unit *below = m_arena.get(tower.at(tier - 1, error));
+    if (below->colour() == currentPlayer.colour() &&
+        isValidImmobileStrike(tier, *below, error) &&
+        !isAttackedAfter(*below, tower.posn())) {
+      availableCheckPoints.set(idx);
+    }
+  }
+
+  // Units in hand of the same kind can be dropped on the same squares, so
+  // only one unit of each kind is tried.  A drop never uncovers a unit, so
+  // a valid drop on a check point always stops the check.
+  for (unsigned int kind = 0; kind < Player::k_NUM_HAND_KINDS; kind++) {
+    const Unit *unit = currentPlayer.handUnit(kind);
+    if (!unit) {
+      continue;
+    }
+
+    Bitboard remaining = checkPoints - availableCheckPoints;
+    while (remaining.any()) {
+      const unsigned int idx = remaining.pop();
+      if (isValidDrop(m_board[idx].posn(), *unit, error)) {
+        availableCheckPoints.set(idx);
+      }
+    }
+  }
+
+  // Reduce the set of check points to the ones that the current player can
+  // actually hit with their units.
+  m_checkPoints = availableCheckPoints;
+  m_gameState = originalState;
+  return m_checkPoints.any() || m_escapeRoutes.any();
+}
+
+void Logician::resolveEvasions(void) const {
+  if (!m_evasionsPending) {
+    return;
+  }
+
+  // Cleared first, as the validations used to find the evasions query the
+  // game state.
+  m_evasionsPending = false;
+  if (!computeEvasions(true)) {
+    m_gameState |= GAME_STATE_CHECKMATE;
+  }
 }
 
 // PRIVATE MANIPULATORS
 void Logician::reset(void) {
-  // Clear all the units that have been allocated thus far.
-  m_units.clear();
+  // Release all the units created thus far; the arena storage is reused.
+  m_arena.reset();
 
   // Reset each player.
   resetPlayer(m_black);
@@ -285,14 +847,79 @@ void Logician::reset(void) {
     }
   }
 
+  // Clear the bitboards, as the board is now empty.
+  for (unsigned int i = 0; i < k_NUM_PLAYERS; i++) {
+    for (unsigned int tier = 0; tier < k_MAX_TOWER_SIZE; tier++) {
+      m_occupancy[i][tier].clear();
+    }
+
+    for (unsigned int piece = 0; piece < GUNGI_NUM_PIECES; piece++) {
+      m_pieces[i][piece].clear();
+    }
+  }
+
+  // Every unit starts in its player's hand.
+  m_boardKey = 0;
+  m_handKey = Zobrist::hand(m_black) + Zobrist::hand(m_white);
+
   m_gameState = GAME_STATE_TURN_BLACK | GAME_STATE_INITIAL_ARRANGEMENT;
   m_boardRecorder.reset();
-  m_toRearrange.reset();
-  m_recovery.unit.reset();
-  memset(&m_recovery, 0, sizeof(m_recovery));
-  memset(m_expansions, 0, k_BOARD_SIZE * sizeof(unsigned int));
+  m_toRearrange = UnitArena::k_NULL_HANDLE;
+  m_recovery.unit = UnitArena::k_NULL_HANDLE;
+  m_recovery.player = NULL;
+  m_recovery.tower = NULL;
+  for (unsigned int i = 0; i < k_NUM_PLAYERS; i++) {
+    m_expansions[i].clear();
+  }
+
+  m_expanders.clear();
+  m_expandersMoved = false;
+
+  // No unit is on the board, so no unit attacks.
+  for (unsigned int i = 0; i < UnitArena::k_CAPACITY; i++) {
+    m_attacks[i].clear();
+  }
+
+  for (unsigned int i = 0; i < k_NUM_PLAYERS; i++) {
+    m_attacked[i].clear();
+  }
+
+  m_changed.clear();
   m_escapeRoutes.clear();
   m_checkPoints.clear();
+  m_pinned.clear();
+  m_evasionsPending = false;
+}
+
+void Logician::rebase(const Logician& original) {
+  error_t error;
+
+  // The towers hold handles, which are the same in both arenas, so only the
+  // units copied with the arena have to be pointed back at this board.
+  for (const Tower& tower : m_board) {
+    for (tier_t tier = 0; tier < tower.height(); tier++) {
+      m_arena[tower.at(tier, error)].setTower(&tower, tier);
+    }
+  }
+
+  Player *players[] = { &m_black, &m_white };
+  const Player *originals[] = { &original.m_black, &original.m_white };
+  for (unsigned int i = 0; i < k_NUM_PLAYERS; i++) {
+    players[i]->reset();
+    for (const Unit *unit : originals[i]->units()) {
+      players[i]->addUnit(&m_arena[original.m_arena.handle(unit)], error);
+      GASSERT(error == GUNGI_ERROR_NONE);
+    }
+  }
+
+  if (m_recovery.player) {
+    m_recovery.player = (original.m_recovery.player == &original.m_black) ?
+      &m_black : &m_white;
+  }
+
+  if (m_recovery.tower) {
+    m_recovery.tower = &m_board[m_recovery.tower->posn().index()];
+  }
 }
 
 void Logician::resetPlayer(Player& player) {
@@ -313,14 +940,14 @@ void Logician::resetPlayer(Player& player) {
     unsigned int count = static_cast<unsigned int>(k_START_HAND[i][2]);
 
     while (count --> 0) {
-      Unit *unit = new Unit(front, back, player.colour(), m_builder);
-      std::shared_ptr<Unit> ptr(unit);
+      unit_handle_t handle = m_arena.create(front,
+                                            back,
+                                            player.colour(),
+                                            m_builder);
 
-      player.addUnit(ptr, error);
+      player.addUnit(&m_arena[handle], error);
       GASSERT(error == GUNGI_ERROR_NONE);
 
-      m_units.push_back(ptr);
-
       hand_size++;
     }
   }
@@ -329,93 +956,452 @@ void Logician::resetPlayer(Player& player) {
   GASSERT(hand_size == k_START_PIECE_COUNT);
 }
 
-void Logician::captureUnit(SharedUnitPtr& ptr, Player& from, Player& to, bool remove) {
+void Logician::indexTower(const Tower& tower) {
+  const unsigned int idx = tower.posn().index();
+  m_changed.set(idx);
+
   error_t error;
-  from.removeUnit(ptr.get(), error);
+  for (tier_t tier = 0; tier < tower.height(); tier++) {
+    const Unit *unit = m_arena.get(tower.at(tier, error));
+    const unsigned int colour = colourIndex(unit->colour());
+    m_occupancy[colour][tier].set(idx);
+    m_pieces[colour][unit->front()].set(idx);
+    if (unit->effectField() & k_MOBILE_RANGE_EXPANSION) {
+      m_expanders.set(idx);
+      m_expandersMoved = true;
+    }
+
+    m_boardKey ^= Zobrist::unit(idx,
+                                tier,
+                                unit->colour(),
+                                unit->front(),
+                                unit->back());
+  }
+}
+
+void Logician::unindexTower(const Tower& tower) {
+  const unsigned int idx = tower.posn().index();
+  error_t error;
+  for (tier_t tier = 0; tier < tower.height(); tier++) {
+    const Unit *unit = m_arena.get(tower.at(tier, error));
+    const unsigned int colour = colourIndex(unit->colour());
+    m_occupancy[colour][tier].reset(idx);
+    m_pieces[colour][unit->front()].reset(idx);
+    if (unit->effectField() & k_MOBILE_RANGE_EXPANSION) {
+      m_expanders.reset(idx);
+      m_expandersMoved = true;
+    }
+
+    m_boardKey ^= Zobrist::unit(idx,
+                                tier,
+                                unit->colour(),
+                                unit->front(),
+                                unit->back());
+  }
+}
+
+void Logician::captureUnit(Unit *unit, Player& from, Player& to) {
+  error_t error;
+  from.removeUnit(unit, error);
   GASSERT(error == GUNGI_ERROR_NONE);
 
-  to.addUnit(ptr, error);
+  to.addUnit(unit, error);
   GASSERT(error == GUNGI_ERROR_NONE);
+}
+
+void Logician::make(const Move& move, undo_t& undo) {
+  error_t error;
+  Unit *unit = &m_arena[move.unit()];
+  Player& own = unit->colour() == BLACK ? m_black : m_white;
+  Player& enemy = unit->colour() == BLACK ? m_white : m_black;
 
-  if (remove) {
-    GASSERT(ptr->tower());
+  undo.move = move;
+  undo.captured = UnitArena::k_NULL_HANDLE;
+  undo.flipped = false;
+  undo.numBetrayed = 0;
 
-    Tower& tower = m_board[ptr->tower()->posn().index()];
-    tower.remove(ptr.get(), error);
+  switch (move.type()) {
+  case Move::MOVE_TYPE_DROP: {
+    Tower& tower = m_board[move.square()];
+    unindexTower(tower);
+
+    tower.add(move.unit(), m_arena, error);
     GASSERT(error == GUNGI_ERROR_NONE);
 
-    ptr->flip(error);
+    own.activate(unit, error);
     GASSERT(error == GUNGI_ERROR_NONE);
+
+    indexTower(tower);
+
+    m_handKey -= Zobrist::hand(unit->colour(), unit->front(), unit->back());
+    break;
   }
+  case Move::MOVE_TYPE_MOVE: {
+    GASSERT(unit->tower());
+    Tower& from = m_board[unit->tower()->posn().index()];
+    Tower& to = m_board[move.square()];
+    GASSERT(&from != &to);
+
+    undo.from = static_cast<uint8_t>(from.posn().index());
+    undo.fromTier = static_cast<uint8_t>(unit->tier());
+
+    unindexTower(from);
+    unindexTower(to);
+
+    Unit *top = m_arena.get(to.top());
+    if (top && top->colour() != unit->colour()) {
+      // Capture the unit at the top of the tower.
+      undo.captured = to.top();
+      undo.capturedTier = static_cast<uint8_t>(to.height() - 1);
+      undo.flipped = top->back() != GUNGI_PIECE_NONE;
+
+      captureUnit(top, enemy, own);
+      to.remove(undo.captured, m_arena, error);
+      GASSERT(error == GUNGI_ERROR_NONE);
+
+      // The unit is flipped before it enters the hand, so that it is kept
+      // with the units of its new kind.
+      if (undo.flipped) {
+        top->flip(error);
+      }
+
+      own.deactivate(top, error);
+      GASSERT(error == GUNGI_ERROR_NONE);
+
+      m_handKey += Zobrist::hand(top->colour(), top->front(), top->back());
+
+      if (unit->effectField() & GUNGI_EFFECT_BETRAYAL) {
+        // Units below in the tower betray their team and align with the
+        // moving unit's player.
+        for (tier_t t = 0; t < to.height(); t++) {
+          const unit_handle_t handle = to.at(t, error);
+          Unit *betrayer = &m_arena[handle];
+          if (betrayer->colour() != unit->colour()) {
+            captureUnit(betrayer, enemy, own);
+            undo.betrayed[undo.numBetrayed++] = handle;
+          }
+        }
+      }
+    }
+
+    from.remove(move.unit(), m_arena, error);
+    GASSERT(error == GUNGI_ERROR_NONE);
+
+    to.add(move.unit(), m_arena, error);
+    GASSERT(error == GUNGI_ERROR_NONE);
+
+    indexTower(from);
+    indexTower(to);
+    break;
+  }
+  case Move::MOVE_TYPE_IMMOBILE_STRIKE: {
+    GASSERT(unit->tower());
+    Tower& tower = m_board[unit->tower()->posn().index()];
+    Unit *target = &m_arena[move.target()];
+
+    undo.captured = move.target();
+    undo.capturedTier = static_cast<uint8_t>(tower.tier(target, error));
+    GASSERT(error == GUNGI_ERROR_NONE);
+    undo.flipped = target->back() != GUNGI_PIECE_NONE;
+
+    unindexTower(tower);
+
+    captureUnit(target, enemy, own);
+    tower.remove(move.target(), m_arena, error);
+    GASSERT(error == GUNGI_ERROR_NONE);
+
+    if (undo.flipped) {
+      target->flip(error);
+    }
+
+    own.deactivate(target, error);
+    GASSERT(error == GUNGI_ERROR_NONE);
+
+    m_handKey += Zobrist::hand(target->colour(),
+                               target->front(),
+                               target->back());
+
+    indexTower(tower);
+    break;
+  }
+  case Move::MOVE_TYPE_SUBSTITUTION: {
+    // Both units are at the top of their respective towers, so they simply
+    // trade places.  This is its own inverse.
+    Tower& unitTower = m_board[unit->tower()->posn().index()];
+    Tower& targetTower =
+      m_board[m_arena[move.target()].tower()->posn().index()];
+    unindexTower(unitTower);
+    unindexTower(targetTower);
+
+    const unit_handle_t replaced = unitTower.replace(unitTower.height() - 1,
+                                                     targetTower.top(),
+                                                     m_arena,
+                                                     error);
+    GASSERT(error == GUNGI_ERROR_NONE);
+
+    targetTower.replace(targetTower.height() - 1, replaced, m_arena, error);
+    GASSERT(error == GUNGI_ERROR_NONE);
+
+    indexTower(unitTower);
+    indexTower(targetTower);
+    break;
+  }
+  case Move::MOVE_TYPE_TIER_EXCHANGE: {
+    // The units at the first and third tiers trade places.  This is its own
+    // inverse.
+    Tower& tower = m_board[unit->tower()->posn().index()];
+    unindexTower(tower);
+
+    tower.exchange(0, tower.height() - 1, m_arena, error);
+    GASSERT(error == GUNGI_ERROR_NONE);
+
+    indexTower(tower);
+    break;
+  }
+  case Move::MOVE_TYPE_FORCED_RECOVERY: {
+    if (!move.recover()) {
+      // The unit stays where it is.
+      break;
+    }
+
+    // The unit is taken off the board into the hand of the player it is
+    // recovered to, which is the enemy if the unit captured on its move.
+    GASSERT(unit->tower() && m_recovery.player);
+    Tower& tower = m_board[unit->tower()->posn().index()];
+    Player& to = *m_recovery.player;
+
+    undo.from = static_cast<uint8_t>(tower.posn().index());
+    undo.fromTier = static_cast<uint8_t>(unit->tier());
+    if (&to != &own) {
+      undo.captured = move.unit();
+    }
+
+    unindexTower(tower);
+
+    captureUnit(unit, own, to);
+    tower.remove(move.unit(), m_arena, error);
+    GASSERT(error == GUNGI_ERROR_NONE);
+
+    to.deactivate(unit, error);
+    GASSERT(error == GUNGI_ERROR_NONE);
+
+    indexTower(tower);
+
+    m_handKey += Zobrist::hand(unit->colour(), unit->front(), unit->back());
+    break;
+  }
+  default:
+    GASSERT(false);
+    break;
+  }
+
+  updateAttacks();
 }
 
-void Logician::updateMobileRangeExpansion(void) {
-  // Zero out the current expansions.
-  memset(m_expansions, 0, sizeof(unsigned int) * k_BOARD_SIZE);
+void Logician::unmake(const undo_t& undo) {
+  error_t error;
+  const Move& move = undo.move;
+  Unit *unit = &m_arena[move.unit()];
+  Player& own = unit->colour() == BLACK ? m_black : m_white;
+  Player& enemy = unit->colour() == BLACK ? m_white : m_black;
 
-  for (const SharedUnitPtr& sharedUnitPtr : m_units) {
-    if (!sharedUnitPtr->tower()) {
-      continue;
-    } else if (!(sharedUnitPtr->effectField() & k_MOBILE_RANGE_EXPANSION)) {
-      continue;
+  switch (move.type()) {
+  case Move::MOVE_TYPE_DROP: {
+    Tower& tower = m_board[move.square()];
+    unindexTower(tower);
+
+    tower.remove(move.unit(), m_arena, error);
+    GASSERT(error == GUNGI_ERROR_NONE);
+
+    own.deactivate(unit, error);
+    GASSERT(error == GUNGI_ERROR_NONE);
+
+    indexTower(tower);
+
+    m_handKey += Zobrist::hand(unit->colour(), unit->front(), unit->back());
+    break;
+  }
+  case Move::MOVE_TYPE_MOVE: {
+    Tower& from = m_board[undo.from];
+    Tower& to = m_board[move.square()];
+    unindexTower(from);
+    unindexTower(to);
+
+    to.remove(move.unit(), m_arena, error);
+    GASSERT(error == GUNGI_ERROR_NONE);
+
+    from.insert(undo.fromTier, move.unit(), m_arena, error);
+    GASSERT(error == GUNGI_ERROR_NONE);
+
+    for (unsigned int i = undo.numBetrayed; i-- > 0;) {
+      captureUnit(&m_arena[undo.betrayed[i]], own, enemy);
+    }
+
+    if (undo.captured != UnitArena::k_NULL_HANDLE) {
+      restoreCaptured(undo, to, own, enemy);
     }
 
-    colour_t colour = sharedUnitPtr->colour();
-    effect_bitfield_t effects = sharedUnitPtr->effectField();
-    Posn posn = sharedUnitPtr->tower()->posn();
-    bool inverted = isInverted(colour);
+    indexTower(from);
+    indexTower(to);
+    break;
+  }
+  case Move::MOVE_TYPE_IMMOBILE_STRIKE: {
+    Tower& tower = m_board[unit->tower()->posn().index()];
+    unindexTower(tower);
+
+    restoreCaptured(undo, tower, own, enemy);
+
+    indexTower(tower);
+    break;
+  }
+  case Move::MOVE_TYPE_SUBSTITUTION:
+  case Move::MOVE_TYPE_TIER_EXCHANGE: {
+    undo_t redo;
+    make(move, redo);
+    break;
+  }
+  case Move::MOVE_TYPE_FORCED_RECOVERY: {
+    if (!move.recover()) {
+      break;
+    }
+
+    // The unit is in the hand it was recovered to, so 'own' is the player
+    // holding it, and it goes back to the enemy if it changed hands.
+    Tower& tower = m_board[undo.from];
+    Player& to = undo.captured != UnitArena::k_NULL_HANDLE ? enemy : own;
+    unindexTower(tower);
+
+    m_handKey -= Zobrist::hand(unit->colour(), unit->front(), unit->back());
+
+    captureUnit(unit, own, to);
+    tower.insert(undo.fromTier, move.unit(), m_arena, error);
+    GASSERT(error == GUNGI_ERROR_NONE);
+
+    to.activate(unit, error);
+    GASSERT(error == GUNGI_ERROR_NONE);
+
+    indexTower(tower);
+    break;
+  }
+  default:
+    GASSERT(false);
+    break;
+  }
+
+  updateAttacks();
+}
+
+void Logician::restoreCaptured(const undo_t& undo,
+                               Tower&        tower,
+                               Player&       from,
+                               Player&       to) {
+  error_t error;
+  Unit *captured = &m_arena[undo.captured];
+  m_handKey -= Zobrist::hand(captured->colour(),
+                             captured->front(),
+                             captured->back());
+
+  // The unit leaves the hand it was captured into as the kind it was there,
+  // and is flipped back before it rejoins its owner.
+  from.removeUnit(captured, error);
+  GASSERT(error == GUNGI_ERROR_NONE);
+
+  if (undo.flipped) {
+    captured->flip(error);
+    GASSERT(error == GUNGI_ERROR_NONE);
+  }
+
+  to.addUnit(captured, error);
+  GASSERT(error == GUNGI_ERROR_NONE);
+
+  tower.insert(undo.capturedTier, undo.captured, m_arena, error);
+  GASSERT(error == GUNGI_ERROR_NONE);
+
+  to.activate(captured, error);
+  GASSERT(error == GUNGI_ERROR_NONE);
+}
+
+void Logician::updateMobileRangeExpansion(void) {
+  if (!m_expandersMoved) {
+    // Only a Fortress or a Catapult entering, leaving, or moving on the board
+    // changes the expansions.
+    return;
+  }
+
+  const Bitboard previous[k_NUM_PLAYERS] = { m_expansions[0], m_expansions[1] };
+  for (unsigned int i = 0; i < k_NUM_PLAYERS; i++) {
+    m_expansions[i].clear();
+  }
+
+  error_t error;
+  Bitboard expanders = m_expanders;
+  while (expanders.any()) {
+    const unsigned int idx = expanders.pop();
+    const Tower& tower = m_board[idx];
+    for (tier_t tier = 0; tier < tower.height(); tier++) {
+      const Unit *unit = m_arena.get(tower.at(tier, error));
+      const effect_bitfield_t effects = unit->effectField();
+      Bitboard& expansion = m_expansions[colourIndex(unit->colour())];
+      if (effects & GUNGI_EFFECT_MOBILE_RANGE_EXPANSION_1) {
+        expansion |= AttackTable::expansion(
+                                         GUNGI_EFFECT_MOBILE_RANGE_EXPANSION_1,
+                                         idx,
+                                         unit->colour());
+      }
 
-    if (effects & GUNGI_EFFECT_MOBILE_RANGE_EXPANSION_1) {
-      // Fortress mobile range expansion.  Affects the pieces on-top of the
-      // unit and in front of it, extending outside the territory in a straight
-      // line.
-      while (posn.isValid()) {
-        m_expansions[posn.index()] |= colour;
-        posn.up(inverted);
+      if (effects & GUNGI_EFFECT_MOBILE_RANGE_EXPANSION_2) {
+        expansion |= AttackTable::expansion(
+                                         GUNGI_EFFECT_MOBILE_RANGE_EXPANSION_2,
+                                         idx,
+                                         unit->colour());
       }
     }
+  }
 
-    if (effects & GUNGI_EFFECT_MOBILE_RANGE_EXPANSION_2) {
-      // Catapult mobile range expansion.  Affects the pieces on top of the
-      // unit and within the territory.  The shape formed is a diamond:
-      // 1-3-5-3-5 centered around the current unit.
-      std::vector<int> upAmounts = { 2, 1, 0, -1, -2 };
-      std::vector<int> leftAmounts = { 0, 1, 2, 1, 0 };
-      std::vector<int> rightAmounts = { 0, 2, 4, 2, 0 };
-      for (unsigned int i = 0; i < upAmounts.size(); i++) {
-        int up = upAmounts[i];
-        Posn p = posn;
-        while (up != 0) {
-          if (up < 0) {
-            p.down(inverted);
-            up += 1;
-          } else {
-            p.up(inverted);
-            up -= 1;
-          }
-        }
+  m_expandersMoved = false;
 
-        if (!p.isValid() || !isInTerritory(p, colour)) {
-          continue;
-        }
+  // An expansion changes which enemy units a jumping unit can cross, so the
+  // units crossing a square whose expansion changed have to be updated.
+  for (unsigned int i = 0; i < k_NUM_PLAYERS; i++) {
+    m_changed |= previous[i] ^ m_expansions[i];
+  }
 
-        int left = leftAmounts[i];
-        while (left > 0) {
-          p.left(inverted);
-          left--;
-        }
+  updateAttacks();
+}
 
-        int right = rightAmounts[i];
-        while (right >= 0) {
-          if (p.isValid()) {
-            m_expansions[p.index()] |= colour;
-          }
-          p.right(inverted);
-          right--;
-        }  // end while
-      }  // end for
-    }  // end if
+void Logician::updateAttacks(void) {
+  if (m_changed.none()) {
+    return;
+  }
+
+  for (unsigned int i = 0; i < k_NUM_PLAYERS; i++) {
+    m_attacked[i].clear();
   }
+
+  for (const Unit& unit : m_arena) {
+    Bitboard& attacks = m_attacks[m_arena.handle(&unit)];
+    const Tower *tower = unit.tower();
+    if (!tower) {
+      attacks.clear();
+      continue;
+    }
+
+    // The attacks of a unit depend only on its own tower, and on the squares
+    // that its walks cross, so a unit whose walks cross no changed square
+    // keeps its attacks.
+    const unsigned int idx = tower->posn().index();
+    if (m_changed.test(idx) ||
+        (m_changed & AttackTable::lines(unit.front(),
+                                        unit.tier(),
+                                        idx,
+                                        isInverted(unit.colour()))).any()) {
+      attacks = computeAttacks(unit);
+    }
+
+    m_attacked[colourIndex(unit.colour())] |= attacks;
+  }
+
+  m_changed.clear();
 }
 
 void Logician::updateStateAfterTurn(error_t& error, piece_id_t dropped) {
@@ -434,15 +1420,20 @@ void Logician::updateStateAfterTurn(error_t& error, piece_id_t dropped) {
   const game_state_t originalState = state();
 
   // Set state to indicate that it is the next player's turn by flipping the
-  // state turn colour bits.
+  // state turn colour bits.  Check is recomputed for the next player below.
   m_gameState ^= GAME_STATE_TURN_BLACK | GAME_STATE_TURN_WHITE;
+  m_gameState &= ~GAME_STATE_CHECK;
 
   // Compute if we are exiting the 'Initial Arrangement'.  The 'Initial
   // Arrangement' is over when both players have placed all of their units.
   // This phase only happens once per game.
   unsigned int initialPlaced = 0;
   if (isInitialArrangement()) {
-    initialPlaced = any_of_count(m_units.begin(), m_units.end(), hasTower);
+    for (unsigned int i = 0; i < k_NUM_PLAYERS; i++) {
+      for (tier_t tier = 0; tier < k_MAX_TOWER_SIZE; tier++) {
+        initialPlaced += m_occupancy[i][tier].count();
+      }
+    }
     if (initialPlaced == k_PIECE_COUNT) {
       // All units have been placed, so the initial arrangement is over.
       m_gameState ^= GAME_STATE_INITIAL_ARRANGEMENT;
@@ -459,8 +1450,8 @@ void Logician::updateStateAfterTurn(error_t& error, piece_id_t dropped) {
   bool inCheck = false;
   Player& nextPlayer = next();
   Player& currentPlayer = current();
-  const SharedUnitPtr& commander = currentPlayer.commander();
-  GASSERT(commander.get());
+  const Unit *commander = currentPlayer.commander();
+  GASSERT(commander);
 
   Tower const *commanderTower = commander->tower();
   if (commanderTower == NULL) {
@@ -471,8 +1462,10 @@ void Logician::updateStateAfterTurn(error_t& error, piece_id_t dropped) {
     error = GUNGI_ERROR_NONE;
 
     m_gameState |= GAME_STATE_INITIAL_ARRANGEMENT;
-    m_checkPoints = PosnSet();
-    m_escapeRoutes = PosnSet();
+    m_checkPoints.clear();
+    m_escapeRoutes.clear();
+    m_pinned.clear();
+    m_evasionsPending = false;
 
     return;
   }
@@ -480,83 +1473,58 @@ void Logician::updateStateAfterTurn(error_t& error, piece_id_t dropped) {
   // Keeps track of the position of the current player's commander.
   const Posn& target = commanderTower->posn();
 
-  // Compute if there are any units that could exchange positions with the
-  // commander.  If there are such units, then they could be used to escape
-  // from check, so they must be verified as well.
-  PosnSet escapes;
-  if (initialPlaced == 0) {
-    // Only out of initial arrangment are escapes considered.
-    escapes = commanderEscapeRoutes(*commander.get(), target);
-  }
-
   // This position set is used to record the intersection of the positions
   // needed for each unit that can attack the current's player commander on the
   // next turn; this is the minimal sized set of points such that if the
   // current player can move another unit to any of the given positions then
   // they can escape check.
-  PosnSet checkPoints;
+  Bitboard checkPoints;
 
   // For each unit in the next player's army, check if that unit can hit the
-  // commander or any of the positions that the commander can escape to.  If it
-  // can directly attack the commander on the next turn, then the commander is
-  // in check.
-  for (const SharedUnitPtr& sharedUnitPtr : nextPlayer.activeUnits()) {
-    const Unit *unit = sharedUnitPtr.get();
-    Tower const *tower = unit->tower();
-
-    // This is the start position from where the unit will conduct its attack.
-    const Posn& start(tower->posn());
-
-    // Keep track of the walk that the unit does to reach the commander, if
-    // there is such a walk.
-    PosnSet walk;
-    bool validWalk = isValidMove(target, *unit, walk, error);
-    walk.pop_back();
-
-    // The current unit may not able to directly attack the commander, but we
-    // still need to verify if it can attack the commander's escape routes.
-    for (PosnSet::iterator it = escapes.begin(); it != escapes.end();) {
-      PosnSet escapeWalk;
-      if (*it == start) {
-        // This escape route goes to the tower containing this unit.
-        int tier = tower->tier(unit, error);
-        GASSERT(error == GUNGI_ERROR_NONE);
-        if (tier == tower->height() - 1) {
-          // If this unit is the highest in the tower, we have to check if it
-          // is the same team as the commander.  If so, this escape route is
-          // not valid.
-          if (commander->colour() == unit->colour()) {
-            escapes.erase(it);
-            continue;
-          }
-        } else if (tier == tower->height() - 2) {
-          // If this unit is not the highest in the tower, we have to check if
-          // the unit above this one in the tower is the same team as the
-          // current unit.  If so, the commander would take that unit's spot,
-          // meaning this unit can now perform an immobile strike, so this
-          // escape route is invalid.
-          const Unit *above = tower->at(tier + 1, error);
-          if (above && above->colour() == unit->colour()) {
-            escapes.erase(it);
-            continue;
-          }
-        }
-      } else if (isValidMove(*it, *unit, escapeWalk, error)) {
-        // The unit can hit this escape route, so it is not a valid escape
-        // route as the current player will still be in check.
-        escapes.erase(it);
-        continue;
-      }
-      it++;
+  // commander.  If it can directly attack the commander on the next turn,
+  // then the commander is in check.
+  for (const Unit *unit : nextPlayer.activeUnits()) {
+    if (!isAttacking(target, *unit)) {
+      continue;
     }
 
-    if (!validWalk) {
+    // Current player is in check as there exists a means for the current unit
+    // to attack the current player's commander.  The check is stopped by
+    // taking or covering the unit, or by putting a unit between it and the
+    // commander; a unit that can jump is only stopped by a unit in the current
+    // player's mobile range expansion.
+    const Posn& start(unit->tower()->posn());
+    Bitboard blocks = AttackTable::between(start.index(), target.index());
+    if (unit->effectField() & GUNGI_EFFECT_JUMP) {
+      blocks &= m_expansions[colourIndex(currentPlayer.colour())];
+    }
+    blocks.set(start);
+
+    checkPoints = inCheck ? checkPoints & blocks : blocks;
+    inCheck = true;
+  }
+
+  // An enemy unit right above or below the Commander in its tower can strike
+  // it.  Taking the enemy unit stops the check if it is at the top of the
+  // tower, and the Commander leaving the tower stops any such check.
+  const tier_t height = commanderTower->height();
+  for (tier_t t = commander->tier() - 1; t <= commander->tier() + 1; t += 2) {
+    if (t < 0 || t >= height) {
       continue;
     }
 
-    // Current player is in check as there exists a means for the current unit
-    // to attack the current player's commander.
-    checkPoints = inCheck ? intersect(checkPoints, walk) : walk;
+    const Unit *striker = m_arena.get(commanderTower->at(t, error));
+    GASSERT(error == GUNGI_ERROR_NONE);
+    if (striker->colour() != nextPlayer.colour()) {
+      continue;
+    }
+
+    Bitboard blocks;
+    if (t == height - 1) {
+      blocks.set(target);
+    }
+
+    checkPoints = inCheck ? checkPoints & blocks : blocks;
     inCheck = true;
   }
 
@@ -566,127 +1534,61 @@ void Logician::updateStateAfterTurn(error_t& error, piece_id_t dropped) {
     m_gameState ^= GAME_STATE_INITIAL_ARRANGEMENT;
   }
 
-  if (checkPoints.size() > 0) {
-    // For each non-commander unit on the current player's team, check if the
-    // unit can move to or be placed in a checkpoint without leaving the
-    // commander in check.
-    PosnSet availableCheckPoints;
-    for (SharedUnitPtr& sharedUnitPtr : currentPlayer.units()) {
-      Unit *unit = sharedUnitPtr.get();
-      for (const Posn& posn : checkPoints) {
-        if (unit->tower()) {
-          if (isInitialArrangement()) {
-            // Cannot move.
-            continue;
-          }
-
-          // If the unit has a tower, then this is either a move or an attack;
-          // in either case, try moving the unit to the new tower, and see
-          // whether the commander is still in a position where it is in check.
-          Unit *removed = NULL;
-          Tower& unitTower = m_board[unit->tower()->posn().index()];
-          Tower& targetTower = m_board[posn.index()];
-          if (targetTower.height() == k_MAX_TOWER_SIZE) {
-            removed = targetTower.at(k_MAX_TOWER_SIZE - 1, error);
-            GASSERT(error == GUNGI_ERROR_NONE);
-
-            targetTower.remove(removed, error);
-            GASSERT(error == GUNGI_ERROR_NONE);
-          }
-
-          // Remove the current unit from it current tower and add it to the
-          // tower that it is transitioning into.
-          unitTower.remove(unit, error);
-          GASSERT(error == GUNGI_ERROR_NONE);
-
-          targetTower.add(unit, error);
-          GASSERT(error == GUNGI_ERROR_NONE);
-
-          // Check whether the commander is still in check after the move has
-          // been made, by checking if there are any valid attacks on the
-          // commander after the move.
-          bool stillInCheck = false;
-          for (const SharedUnitPtr& enemySharedUnitPtr : nextPlayer.units()) {
-            const Unit *enemyUnit = enemySharedUnitPtr.get();
-            PosnSet walk;
-            if (enemyUnit->tower() &&
-                isValidMove(target,
-                            *enemyUnit,
-                            walk,
-                            error)) {
-              stillInCheck = true;
-              break;
-            }
-          }
-
-          if (!stillInCheck) {
-            availableCheckPoints.push_back(posn);
-          }
-
-          // Undo the tower removal for the current unit.
-          targetTower.remove(unit, error);
-          GASSERT(error == GUNGI_ERROR_NONE);
-
-          unitTower.add(unit, error);
-          GASSERT(error == GUNGI_ERROR_NONE);
+  // The evasions are kept with the state, so a foul play has to restore
+  // those of the original state.
+  const Bitboard originalEscapeRoutes = m_escapeRoutes;
+  const Bitboard originalCheckPoints = m_checkPoints;
+  const Bitboard originalPinned = m_pinned;
 
-          // Undo removal if it was done.
-          if (removed) {
-            targetTower.add(unit, error);
-            GASSERT(error == GUNGI_ERROR_NONE);
-          }
-        } else if (isValidDrop(posn, *unit, error)) {
-          // Unit doesn't have a tower, so this is a drop-check.
-          availableCheckPoints.push_back(posn);
-        }
-      }
-
-      // Remove the 'availableCheckPoints' from the 'checkPoints' set to reduce
-      // the number of points needed to check on subsequent iterations.
-      checkPoints = difference(checkPoints, availableCheckPoints);
-    }
-
-    // Reduce the set of 'checkPoints' to the ones that the current player can
-    // actually hit with their units.
-    checkPoints = availableCheckPoints;
-  }
+  m_escapeRoutes.clear();
+  m_checkPoints = checkPoints;
+  m_pinned.clear();
+  m_evasionsPending = false;
 
-  // There are no points at which a drop or move can be made, nor any escapes
-  // that the commander can take to avoid still being in check on the next
-  // player's turn, so it is checkmate.
   if (inCheck) {
-    m_gameState ^= GAME_STATE_CHECK;
-
-    if (checkPoints.size() == 0 && escapes.size() == 0) {
-      if (dropped == GUNGI_PIECE_PAWN) {
-        // Cannot achieve checkmate with a pawn drop as it is considered foul
-        // play.
-        m_gameState = originalState;
-        error = GUNGI_ERROR_PAWN_CHECKMATE;
-        return;
-      } else if (dropped == GUNGI_PIECE_BRONZE) {
-        // Cannot achieve checkmate with a bronze drop as it is considered foul
-        // play.
+    m_gameState |= GAME_STATE_CHECK;
+
+    if (m_lazyCheckmate &&
+        initialPlaced == 0 &&
+        dropped != GUNGI_PIECE_PAWN &&
+        dropped != GUNGI_PIECE_BRONZE) {
+      // Checkmate is decided by the first query that needs it.  Only out of
+      // initial arrangement, as the escape routes depend on the turn in
+      // which it ended.
+      m_evasionsPending = true;
+    } else if (!computeEvasions(initialPlaced == 0)) {
+      // There are no points at which a drop or move can be made, nor any
+      // escapes that the commander can take to avoid still being in check on
+      // the next player's turn, so it is checkmate.
+      if (dropped == GUNGI_PIECE_PAWN || dropped == GUNGI_PIECE_BRONZE) {
+        // Cannot achieve checkmate with a pawn or bronze drop as it is
+        // considered foul play.
         m_gameState = originalState;
-        error = GUNGI_ERROR_BRONZE_CHECKMATE;
+        m_escapeRoutes = originalEscapeRoutes;
+        m_checkPoints = originalCheckPoints;
+        m_pinned = originalPinned;
+        error = dropped == GUNGI_PIECE_PAWN
+              ? GUNGI_ERROR_PAWN_CHECKMATE
+              : GUNGI_ERROR_BRONZE_CHECKMATE;
         return;
       }
 
-      m_gameState ^= GAME_STATE_CHECKMATE;
+      m_gameState |= GAME_STATE_CHECKMATE;
     }
+  } else {
+    // Out of check, a unit must still not uncover an attack on the
+    // commander when it leaves its tower.
+    m_pinned = pinned(currentPlayer.colour());
   }
 
   // Check for repetitions here.  If there are max repetitions reached, the
   // game is over, but only if checkmate was not achieved.
-  unsigned int repetitions = m_boardRecorder << m_board;
-  if (!(m_gameState & GAME_STATE_CHECKMATE) &&
-      repetitions == k_MAX_POSITION_REPETITIONS) {
+  unsigned int repetitions = m_boardRecorder << key();
+  if (repetitions == k_MAX_POSITION_REPETITIONS && !isInCheckmate()) {
     m_gameState ^= GAME_STATE_DRAW;
   }
 
   error = GUNGI_ERROR_NONE;
-  m_escapeRoutes = escapes;
-  m_checkPoints = checkPoints;
 }
 
 // CREATORS
@@ -694,29 +1596,174 @@ Logician::Logician(void)
 : m_builder()
 , m_black(BLACK)
 , m_white(WHITE)
-, m_units()
-, m_board(k_BOARD_SIZE)
+, m_arena()
+, m_board()
+, m_occupancy()
+, m_pieces()
+, m_boardKey(0)
+, m_handKey(0)
 , m_boardRecorder()
 , m_gameState(Logician::GAME_STATE_INITIAL_ARRANGEMENT)
-, m_toRearrange()
+, m_toRearrange(UnitArena::k_NULL_HANDLE)
 , m_recovery()
-, m_expansions {
-}
+, m_expansions()
+, m_expanders()
+, m_expandersMoved(false)
+, m_attacks()
+, m_attacked()
+, m_changed()
 , m_escapeRoutes()
 , m_checkPoints()
+, m_pinned()
+, m_lazyCheckmate(false)
+, m_evasionsPending(false)
 {
   reset();
 }
 
+Logician::Logician(const Logician& original)
+: m_builder()
+, m_black(original.m_black)
+, m_white(original.m_white)
+, m_arena(original.m_arena)
+, m_board(original.m_board)
+, m_occupancy()
+, m_pieces()
+, m_boardKey(original.m_boardKey)
+, m_handKey(original.m_handKey)
+, m_boardRecorder(original.m_boardRecorder)
+, m_gameState(original.m_gameState)
+, m_toRearrange(original.m_toRearrange)
+, m_recovery(original.m_recovery)
+, m_expansions()
+, m_expanders(original.m_expanders)
+, m_expandersMoved(original.m_expandersMoved)
+, m_attacks()
+, m_attacked()
+, m_changed(original.m_changed)
+, m_escapeRoutes(original.m_escapeRoutes)
+, m_checkPoints(original.m_checkPoints)
+, m_pinned(original.m_pinned)
+, m_lazyCheckmate(original.m_lazyCheckmate)
+, m_evasionsPending(original.m_evasionsPending)
+{
+  // The members above are copied by their own copy constructors; the
+  // fixed-size tables below are copied whole.
+  memcpy(m_occupancy, original.m_occupancy, sizeof(m_occupancy));
+  memcpy(m_pieces, original.m_pieces, sizeof(m_pieces));
+  memcpy(m_expansions, original.m_expansions, sizeof(m_expansions));
+
+  // Units have the same handles in the copy, so their attacks carry over.
+  memcpy(m_attacks, original.m_attacks, sizeof(m_attacks));
+  memcpy(m_attacked, original.m_attacked, sizeof(m_attacked));
+
+  // The pointers copied with the containers still refer to 'original'.
+  rebase(original);
+}
+
 Logician::~Logician(void) {
   // DO NOTHING
 }
 
 // ACCESSORS
-const std::vector<Tower>& Logician::board(void) const {
+const board_t& Logician::board(void) const {
   return m_board;
 }
 
+Bitboard Logician::occupied(void) const {
+  return m_occupancy[0][0] | m_occupancy[1][0];
+}
+
+Bitboard Logician::occupied(colour_t colour) const {
+  const unsigned int i = colourIndex(colour);
+  return m_occupancy[i][0] | m_occupancy[i][1] | m_occupancy[i][2];
+}
+
+Bitboard Logician::occupied(colour_t colour, tier_t tier) const {
+  GASSERT(tier >= 0 && tier < k_MAX_TOWER_SIZE);
+  return m_occupancy[colourIndex(colour)][tier];
+}
+
+uint64_t Logician::key(void) const {
+  const bool blackToMove = m_gameState & GAME_STATE_TURN_BLACK;
+  return m_boardKey ^ m_handKey ^ (blackToMove ? Zobrist::side() : 0);
+}
+
+Bitboard Logician::full(void) const {
+  return m_occupancy[0][k_MAX_TOWER_SIZE - 1] |
+         m_occupancy[1][k_MAX_TOWER_SIZE - 1];
+}
+
+Bitboard Logician::topped(colour_t colour) const {
+  // A unit is at the top of its tower if the tier above it is empty.
+  const unsigned int i = colourIndex(colour);
+  Bitboard topped = m_occupancy[i][k_MAX_TOWER_SIZE - 1];
+  for (tier_t tier = 0; tier < k_MAX_TOWER_SIZE - 1; tier++) {
+    const Bitboard above = m_occupancy[0][tier + 1] | m_occupancy[1][tier + 1];
+    topped |= m_occupancy[i][tier] & ~above;
+  }
+  return topped;
+}
+
+Bitboard Logician::pieces(colour_t colour, piece_id_t piece) const {
+  GASSERT(Util::isValidPiece(piece));
+  return m_pieces[colourIndex(colour)][piece];
+}
+
+const Bitboard& Logician::attacks(const Unit& unit) const {
+  return m_attacks[m_arena.handle(&unit)];
+}
+
+Bitboard Logician::attacked(colour_t colour) const {
+  return m_attacked[colourIndex(colour)];
+}
+
+Bitboard Logician::pinned(colour_t colour) const {
+  const Player& player = colour == BLACK ? black() : white();
+  const Player& enemy = colour == BLACK ? white() : black();
+  const Unit *commander = player.commander();
+  if (!commander || !commander->tower()) {
+    return Bitboard();
+  }
+
+  const unsigned int target = commander->tower()->posn().index();
+  const bool inverted = isInverted(enemy.colour());
+  const Bitboard own = topped(colour);
+  const Bitboard shields = own & m_expansions[colourIndex(colour)];
+
+  error_t error;
+  Bitboard pins;
+  for (const Unit *unit : enemy.activeUnits()) {
+    const Tower *tower = unit->tower();
+    const unsigned int idx = tower->posn().index();
+    if (!AttackTable::reach(unit->front(),
+                            unit->tier(),
+                            idx,
+                            inverted).test(target)) {
+      continue;
+    }
+
+    if (unit != m_arena.get(tower->top())) {
+      // The enemy unit moves again once the unit covering it leaves.
+      const Unit *above = m_arena.get(tower->at(unit->tier() + 1, error));
+      if (above == m_arena.get(tower->top()) && above->colour() == colour) {
+        pins.set(idx);
+      }
+      continue;
+    }
+
+    const Bitboard barriers = unit->effectField() & GUNGI_EFFECT_JUMP
+      ? shields
+      : occupied();
+    const Bitboard blocking = AttackTable::between(idx, target) & barriers;
+    if (blocking.count() == 1) {
+      pins |= blocking & own;
+    }
+  }
+
+  return pins;
+}
+
 int Logician::winner(void) const {
   if (!isOver() || isDraw()) {
     return -1;
@@ -738,15 +1785,16 @@ const Player& Logician::white(void) const {
 }
 
 const Logician::game_state_t& Logician::state(void) const {
+  resolveEvasions();
   return m_gameState;
 }
 
 const Unit *Logician::forcedRearrangeUnit(void) const {
-  return m_toRearrange.get();
+  return m_arena.get(m_toRearrange);
 }
 
 const Unit *Logician::forcedRecoveryUnit(void) const {
-  return m_recovery.unit.get();
+  return m_arena.get(m_recovery.unit);
 }
 
 const int Logician::forcedRecoveryColour(void) const {
@@ -761,11 +1809,19 @@ const Unit *Logician::unitAtPosn(const Posn& posn, tier_t tier) const {
   GASSERT(posn.isValid() && tier < k_MAX_TOWER_SIZE);
   const Tower& tower = m_board[posn.index()];
   error_t error;
-  return tower.at(tier, error);
+  return m_arena.get(tower.at(tier, error));
+}
+
+const Unit *Logician::unit(unit_handle_t handle) const {
+  return m_arena.get(handle);
+}
+
+unit_handle_t Logician::handle(const Unit& unit) const {
+  return m_arena.handle(&unit);
 }
 
 bool Logician::isDraw(void) const {
-  return state() & GAME_STATE_DRAW;
+  return m_gameState & GAME_STATE_DRAW;
 }
 
 bool Logician::isOver(void) const {
@@ -773,29 +1829,29 @@ bool Logician::isOver(void) const {
 }
 
 bool Logician::isPlayersTurn(const colour_t& colour) const {
-  if (state() & GAME_STATE_TURN_WHITE) {
+  if (m_gameState & GAME_STATE_TURN_WHITE) {
     return (colour == WHITE);
-  } else if (state() & GAME_STATE_TURN_BLACK) {
+  } else if (m_gameState & GAME_STATE_TURN_BLACK) {
     return (colour == BLACK);
   }
   return false;
 }
 
 bool Logician::isPlayersTurn(const Player& player) const {
-  if (state() & GAME_STATE_TURN_WHITE) {
+  if (m_gameState & GAME_STATE_TURN_WHITE) {
     return (&player == &(white()));
-  } else if (state() & GAME_STATE_TURN_BLACK) {
+  } else if (m_gameState & GAME_STATE_TURN_BLACK) {
     return (&player == &(black()));
   }
   return false;
 }
 
 bool Logician::isInitialArrangement(void) const {
-  return state() & GAME_STATE_INITIAL_ARRANGEMENT;
+  return m_gameState & GAME_STATE_INITIAL_ARRANGEMENT;
 }
 
 bool Logician::isInCheck(void) const {
-  return state() & GAME_STATE_CHECK;
+  return m_gameState & GAME_STATE_CHECK;
 }
 
 bool Logician::isInCheck(const colour_t& colour) const {
@@ -820,9 +1876,13 @@ bool Logician::isInCheckmate(const Player& player) const {
   return isPlayersTurn(player) && isInCheckmate();
 }
 
+bool Logician::isLazyCheckmate(void) const {
+  return m_lazyCheckmate;
+}
+
 bool Logician::isInMobileRangeExpansion(const Posn& posn,
                                         colour_t    colour) const {
-  return m_expansions[posn.index()] & colour;
+  return m_expansions[colourIndex(colour)].test(posn);
 }
 
 bool Logician::isInverted(const colour_t& colour) const {
@@ -848,7 +1908,7 @@ bool Logician::isInTerritory(const Posn& posn, const Player& player) const {
 }
 
 bool Logician::isForcedRearrangement(void) const {
-  return (m_toRearrange.get() != NULL);
+  return (m_toRearrange != UnitArena::k_NULL_HANDLE);
 }
 
 bool Logician::isForcedRearrangeForPlayer(const colour_t& colour) const {
@@ -860,7 +1920,7 @@ bool Logician::isForcedRearrangeForPlayer(const Player& player) const {
 }
 
 bool Logician::isForcedRecovery(void) const {
-  return (m_recovery.unit.get() != NULL);
+  return (m_recovery.unit != UnitArena::k_NULL_HANDLE);
 }
 
 bool Logician::isForcedRecoveryForPlayer(const colour_t& colour) const {
@@ -890,20 +1950,13 @@ bool Logician::isValidDrop(const Posn& posn,
   }
 
   const Player& player = unit.colour() == BLACK ? black() : white();
-  if (isInCheck(player.colour())) {
+  if (isInCheck(player.colour()) && !m_checkPoints.test(posn)) {
     // If it is the turn of the unit's player, and that player is in check,
-    // then check if the drop point is a valid point to stop the check.
-    if (Util::find(m_checkPoints, posn) != m_checkPoints.end()) {
-      // If the drop point is not in the check points set, then the drop
-      // point is invalid as the player will still be in check on the next
-      // player's turn.
-      error = GUNGI_ERROR_CHECK;
-      return false;
-    }
-
-    // This is a move that moves that player out of check, so it is valid.
-    error = GUNGI_ERROR_NONE;
-    return true;
+    // then the drop point must be a point that stops the check, otherwise
+    // the player will still be in check on the next player's turn.  The drop
+    // must still follow the rules below.
+    error = GUNGI_ERROR_CHECK;
+    return false;
   }
 
   const bool initialArrangement = isInitialArrangement();
@@ -915,7 +1968,26 @@ bool Logician::isValidDrop(const Posn& posn,
     return false;
   }
 
-  if (rearrange && &unit != m_toRearrange.get()) {
+  if (initialArrangement && unit.front() == GUNGI_PIECE_COMMANDER) {
+    // The enemy moves right after the last unit of the Initial Arrangement
+    // is placed, so if it is the Commander, it cannot be placed where the
+    // enemy would take it.
+    unsigned int placed = 0;
+    for (unsigned int i = 0; i < k_NUM_PLAYERS; i++) {
+      for (tier_t tier = 0; tier < k_MAX_TOWER_SIZE; tier++) {
+        placed += m_occupancy[i][tier].count();
+      }
+    }
+
+    const Player& enemy = unit.colour() == BLACK ? white() : black();
+    if (placed == k_PIECE_COUNT - 1 &&
+        isReachableAfterMove(posn, enemy, unit)) {
+      error = GUNGI_ERROR_CHECK;
+      return false;
+    }
+  }
+
+  if (rearrange && m_arena.handle(&unit) != m_toRearrange) {
     // There is a unit waiting to be forced rearrange, and it is not the same
     // as the given 'unit'.
     error = GUNGI_ERROR_INVALID_UNIT;
@@ -924,7 +1996,7 @@ bool Logician::isValidDrop(const Posn& posn,
 
   const unsigned int idx = posn.index();
   const Tower &tower = m_board[idx];
-  if (tower.height() == k_MAX_TOWER_SIZE) {
+  if (full().test(idx)) {
     error = GUNGI_ERROR_FULL_TOWER;
     return false;
   }
@@ -944,7 +2016,7 @@ bool Logician::isValidDrop(const Posn& posn,
     return true;
   }
 
-  const Unit *topTowerUnit = tower.at(tower.height() - 1, error);
+  const Unit *topTowerUnit = m_arena.get(tower.at(tower.height() - 1, error));
   GASSERT(error == GUNGI_ERROR_NONE);
   if (!initialArrangement &&
       (!(topTowerUnit->effectField() & GUNGI_EFFECT_LAND_LINK) ||
@@ -977,7 +2049,7 @@ bool Logician::isValidDrop(const Posn& posn,
 
   // Verify that there are no units of the same team and type as the unit being
   // added in the current tower.
-  if (tower.isDuplicate(&unit)) {
+  if (tower.isDuplicate(&unit, m_arena)) {
     error = GUNGI_ERROR_DUPLICATE;
     return false;
   }
@@ -1013,25 +2085,25 @@ bool Logician::isValidMove(const Posn& target,
   const Player& player = unit.colour() == BLACK ? black() : white();
   if (isInCheck(player)) {
     // If it is the turn of the unit's player, and that player is in check,
-    // then check if the move point is a valid point to stop the check.
-    if (Util::find(m_checkPoints, target) != m_checkPoints.end()) {
-      // If the move point is not in the check points set, then the move
-      // point is invalid as the player will still be in check on the next
-      // player's turn.
+    // then the Commander must move to one of its escape routes, and any other
+    // unit must move to a point that stops the check.  Otherwise the player
+    // will still be in check on the next player's turn.  The move must still
+    // follow the rules below.
+    const Bitboard& evasions = unit.front() == GUNGI_PIECE_COMMANDER
+      ? m_escapeRoutes
+      : m_checkPoints;
+    if (!evasions.test(target)) {
       error = GUNGI_ERROR_CHECK;
       return false;
     }
-
-    // This is a move that moves that player out of check, so it is valid.
-    error = GUNGI_ERROR_NONE;
-    return true;
   }
 
   // Reference to the tower that the unit wants to move into.
   const Tower& targetTower = m_board[target.index()];
   const unsigned int targetHeight = targetTower.height();
   if (targetHeight > 0) {
-    const Unit *topTowerUnit = targetTower.at(targetHeight - 1, error);
+    const Unit *topTowerUnit =
+      m_arena.get(targetTower.at(targetHeight - 1, error));
     GASSERT(error == GUNGI_ERROR_NONE);
 
     if (topTowerUnit->colour() == unit.colour() &&
@@ -1045,6 +2117,16 @@ bool Logician::isValidMove(const Posn& target,
     }
   }
 
+  if (targetTower.isDuplicate(&unit, m_arena) ||
+      isBetrayingDuplicate(unit, targetTower)) {
+    // Cannot move into a tower that already holds a unit of the same team
+    // and front identifier, or one that would join the team by betrayal.  A
+    // captured top unit is never of the same team, so it does not affect
+    // this.
+    error = GUNGI_ERROR_DUPLICATE;
+    return false;
+  }
+
   if (unit.front() == GUNGI_PIECE_BRONZE && isDuplicateInFile(unit, target)) {
     // Cannot move a Bronze unit into the same file as another Brozne of the
     // same team.
@@ -1063,51 +2145,83 @@ bool Logician::isValidMove(const Posn& target,
     return false;
   }
 
+  // Leaving the tower of the Commander changes the top that an enemy unit
+  // reaching the tower takes, and so the units that betray their team.
+  bool exposes = false;
+  if (isPlayersTurn(player) &&
+      unit.front() != GUNGI_PIECE_COMMANDER &&
+      player.commander()->tower() == unit.tower()) {
+    const Unit *members[k_MAX_TOWER_SIZE];
+    for (tier_t t = 0; t < tier; t++) {
+      members[t] = m_arena.get(unit.tower()->at(t, error));
+    }
+    exposes = isExposingCommander(*unit.tower(), members, tier);
+  }
+
   // Have to keep track whether the movements are inverted, as the directions
   // are different depending on the player.
   const bool inverted = isInverted(player);
   colour_t enemyColour = player.colour() == WHITE ? BLACK : WHITE;
 
   for (tier_t t = tier; t < tier + 1 && t <= k_MAX_TOWER_SIZE - 1; t++) {
-    walk = Util::getWalk(&unit, t, start, target, error, inverted);
+    // The attack table rules out unreachable targets without walking the
+    // moveset; the walk itself is only built for a reachable target.
+    walk.clear();
+    if (AttackTable::reach(unit.front(), t, start.index(), inverted)
+                                                       .test(target.index())) {
+      Posn squares[Util::k_MAX_WALK_LENGTH];
+      const unsigned int length = Util::getWalk(&unit,
+                                                t,
+                                                start,
+                                                target,
+                                                squares,
+                                                error,
+                                                inverted);
+      GASSERT(error == GUNGI_ERROR_NONE);
+      walk.assign(squares, squares + length);
 
-    if (error == GUNGI_ERROR_NONE) {
-      // If the walk is valid, have to check that for the points crossed by the
-      // walk that if any of the towers at those positions are an enemy tower
-      // in the enemy's mobile range expansion, as we cannot jump over them.
-      PosnSet crossed = Util::crossed(start, target);
+      // Have to check that for the points crossed by the walk that if any of
+      // the towers at those positions are an enemy tower in the enemy's
+      // mobile range expansion, as we cannot jump over them.
+      const Bitboard blockers = AttackTable::between(start.index(),
+                                                     target.index())
+                              & occupied();
 
       // Keep track of whether the walk is valid.
       bool valid = true;
 
-      if (crossed.size() > 0) {
-        for (const Posn& posn : crossed) {
-          const Tower& tower = m_board[posn.index()];
-          if (tower.height() == 0) {
-            continue;
-          } else if (unit.effectField() & GUNGI_EFFECT_JUMP) {
-            // Can jump over other units, but not enemy units that are in the
-            // enemy's mobile range expansion effect.
-            if (tower.members().back()->colour() == enemyColour) {
-              if (isInMobileRangeExpansion(posn, enemyColour)) {
-                // Can't jump over this.
-                valid = false;
-                break;
-              }
+      if (blockers.any()) {
+        if (unit.effectField() & GUNGI_EFFECT_JUMP) {
+          // Can jump over other units, but not enemy units that are in the
+          // enemy's mobile range expansion effect.
+          const Bitboard enemySquares = blockers & topped(enemyColour);
+          for (unsigned int idx = 0;
+               valid && idx < Bitboard::k_NUM_SQUARES;
+               idx++) {
+            if (enemySquares.test(idx) &&
+                isInMobileRangeExpansion(m_board[idx].posn(), enemyColour)) {
+              // Can't jump over this.
+              valid = false;
             }
-          } else {
-            valid = false;
-            break;
           }
+        } else {
+          valid = false;
         }
       }
 
       if (valid) {
-        if (unit.front() == GUNGI_PIECE_COMMANDER) {
+        if (isPlayersTurn(player) &&
+            unit.front() != GUNGI_PIECE_COMMANDER &&
+            (exposes || isAttackedAfter(unit, target))) {
+          // Leaving exposes the Commander, whether or not the unit stops a
+          // check.
+          error = GUNGI_ERROR_CHECK;
+          return false;
+        } else if (unit.front() == GUNGI_PIECE_COMMANDER) {
           // If the moving unit is a Commander, additionally have to check
           // that the move would not put the Commander into check.
           const Player& enemy = enemyColour == WHITE ? white() : black();
-          if (isReachableAfterMove(target, enemy)) {
+          if (isReachableAfterMove(target, enemy, unit)) {
             error = GUNGI_ERROR_CHECK;
             return false;
           }
@@ -1161,7 +2275,7 @@ bool Logician::isValidImmobileStrike(tier_t      tier,
     return false;
   }
 
-  const Unit *target = unit.tower()->at(tier, error);
+  const Unit *target = m_arena.get(unit.tower()->at(tier, error));
   if (!target) {
     error = GUNGI_ERROR_OUT_OF_RANGE;
     return false;
@@ -1182,11 +2296,19 @@ bool Logician::isValidImmobileStrike(tier_t      tier,
   }
 
   if (isInCheck(unit.colour()) &&
-      (Util::find(m_checkPoints, unit.tower()->posn()) == m_checkPoints.end() ||
-       tier != unit.tower()->height() - 1)) {
+      (!m_checkPoints.test(unit.tower()->posn()) ||
+       tier != unit.tower()->height() - 1 ||
+       isAttackedAfter(unit, unit.tower()->posn()))) {
     // For an immobile strike to move the current player out of check, ti must
-    // be the case that it exists within our check points list, and the unit
-    // being attacked sits at the highest tier in the tower.
+    // be the case that it exists within our check points list, the unit
+    // being attacked sits at the highest tier in the tower, and taking it
+    // does not expose the commander to another unit.
+    error = GUNGI_ERROR_CHECK;
+    return false;
+  } else if (isPlayersTurn(unit.colour()) &&
+             isAttackedAfterStrike(tier, unit)) {
+    // Striking below an enemy unit lowers it, which may open a walk to the
+    // Commander.
     error = GUNGI_ERROR_CHECK;
     return false;
   }
@@ -1257,6 +2379,22 @@ bool Logician::isValidExchange(const effect_t& exchange,
       return false;
     }
 
+    const Player& player = unit.colour() == BLACK ? black() : white();
+    if (isPlayersTurn(player) && player.commander()->tower() == tower) {
+      // The exchange changes the top that an enemy unit reaching the tower
+      // of the Commander takes, and so the units that betray their team.
+      const tier_t height = tower->height();
+      const Unit *members[k_MAX_TOWER_SIZE];
+      for (tier_t t = 0; t < height; t++) {
+        members[t] = m_arena.get(tower->at(t, error));
+      }
+      std::swap(members[unitTier], members[targetTier]);
+      if (isExposingCommander(*tower, members, height)) {
+        error = GUNGI_ERROR_CHECK;
+        return false;
+      }
+    }
+
     error = GUNGI_ERROR_NONE;
     return true;
   } else if (exchange == GUNGI_EFFECT_SUBSTITUTION && unit.effectField() & exchange) {
@@ -1275,12 +2413,28 @@ bool Logician::isValidExchange(const effect_t& exchange,
       return false;
     }
 
-    // Since the moves have been precomputed, we simply need to confirm that
-    // the unit is at the highest tier in its tower, and that the unit's
-    // position is in the escapes list.
+    // The units trade the tops of their towers, so a Commander that units
+    // were moved on top of cannot be substituted.
+    if (target.tower() && m_arena.get(target.tower()->top()) != &target) {
+      error = GUNGI_ERROR_INVALID_SUB;
+      return false;
+    }
+
+    // The Commander takes the place of the unit, so an enemy unit right below
+    // the unit could strike it.
     tier_t tier = unit.tower()->tier(&unit, error);
     GASSERT(error == GUNGI_ERROR_NONE);
-    if (Util::find(m_escapeRoutes, unit.tower()->posn()) != m_escapeRoutes.end() &&
+    if (tier > 0 &&
+        m_arena[unit.tower()->at(tier - 1, error)].colour() != unit.colour()) {
+      error = GUNGI_ERROR_CHECK;
+      return false;
+    }
+
+    // Since the moves have been precomputed, we simply need to confirm that
+    // the unit is at the highest tier in its tower, and that the unit's
+    // position is in the escapes list, once the escapes are computed.
+    resolveEvasions();
+    if (m_escapeRoutes.test(unit.tower()->posn()) &&
         tier == unit.tower()->height() - 1) {
         error = GUNGI_ERROR_NONE;
         return true;
@@ -1294,17 +2448,135 @@ bool Logician::isValidExchange(const effect_t& exchange,
   return false;
 }
 
+void Logician::generateMoves(MoveList& moves) const {
+  moves.clear();
+
+  if (isForcedRecovery()) {
+    // The player who triggered the forced recovery must decide whether the
+    // unit is recovered before anything else can happen.
+    moves.add(Move::forcedRecovery(m_recovery.unit, true));
+    moves.add(Move::forcedRecovery(m_recovery.unit, false));
+    return;
+  } else if (isOver()) {
+    return;
+  }
+
+  const Player& player = isPlayersTurn(BLACK) ? black() : white();
+  const Bitboard threats = threatened(player.colour());
+  if (isForcedRearrangeForPlayer(player)) {
+    // Only the rearranged unit can be dropped.
+    generateDrops(m_arena[m_toRearrange], threats, moves);
+    return;
+  }
+
+  // Units in hand of the same kind lead to the same positions, so only the
+  // drops of one of them are generated.
+  for (unsigned int kind = 0; kind < Player::k_NUM_HAND_KINDS; kind++) {
+    const Unit *member = player.handUnit(kind);
+    if (member) {
+      generateDrops(*member, threats, moves);
+    }
+  }
+
+  if (isInitialArrangement()) {
+    return;
+  }
+
+  const bool inverted = isInverted(player);
+  PosnSet walk;
+  error_t error;
+  for (const Unit *member : player.units()) {
+    const Tower *tower = member->tower();
+    if (!tower) {
+      continue;
+    }
+
+    const unit_handle_t handle = m_arena.handle(member);
+    const Posn& start = tower->posn();
+    const tier_t tier = tower->tier(member, error);
+    GASSERT(error == GUNGI_ERROR_NONE);
+
+    if (tier == tower->height() - 1) {
+      // Only the top unit of a tower can move.  The attack table gives the
+      // squares its moveset reaches; the rest of the rules are left to
+      // 'isValidMove()'.
+      Bitboard targets = AttackTable::reach(member->front(),
+                                            tier,
+                                            start.index(),
+                                            inverted);
+      while (targets.any()) {
+        const Posn& target = m_board[targets.pop()].posn();
+        if (!isValidMove(target, *member, walk, error)) {
+          continue;
+        }
+
+        // Moving a Bronze to checkmate is foul play, which is only detected
+        // after the move is made.
+        const Move move = Move::move(handle, target);
+        if (member->front() == GUNGI_PIECE_BRONZE &&
+            mayBeFoulMate(*member, target, threats) &&
+            isFoulMate(move)) {
+          continue;
+        }
+
+        moves.add(move);
+      }
+    }
+
+    for (tier_t t = 0; t < tower->height(); t++) {
+      if (t != tier && isValidImmobileStrike(t, *member, error)) {
+        moves.add(Move::immobileStrike(handle, tower->at(t, error)));
+      }
+    }
+
+    if (member->effectField() & GUNGI_EFFECT_1_3_TIER_EXCHANGE) {
+      // A tier exchange is made with a unit of the same tower.
+      for (tier_t t = 0; t < tower->height(); t++) {
+        const Unit *target = m_arena.get(tower->at(t, error));
+        if (target != member &&
+            isValidExchange(GUNGI_EFFECT_1_3_TIER_EXCHANGE,
+                            *member,
+                            *target,
+                            error)) {
+          moves.add(Move::exchange(GUNGI_EFFECT_1_3_TIER_EXCHANGE,
+                                   handle,
+                                   m_arena.handle(target)));
+        }
+      }
+    }
+
+    if (member->effectField() & GUNGI_EFFECT_SUBSTITUTION) {
+      // A substitution is made with the player's own Commander.
+      const Unit *commander = player.commander();
+      if (isValidExchange(GUNGI_EFFECT_SUBSTITUTION,
+                          *member,
+                          *commander,
+                          error)) {
+        moves.add(Move::exchange(GUNGI_EFFECT_SUBSTITUTION,
+                                 handle,
+                                 m_arena.handle(commander)));
+      }
+    }
+  }
+}
+
 // MANIPULATORS
 void Logician::newGame(void) {
   reset();
 }
 
+void Logician::setLazyCheckmate(bool lazy) {
+  // Evasions left pending are computed before the mode changes.
+  resolveEvasions();
+  m_lazyCheckmate = lazy;
+}
+
 void Logician::moveUnit(const Posn& from,
                         tier_t      tier,
                         const Posn& to,
                         error_t&    error) {
   Tower& tower = m_board[from.index()];
-  Unit *unit = tower.at(tier, error);
+  Unit *unit = m_arena.get(tower.at(tier, error));
   if (error != GUNGI_ERROR_NONE) {
     return;
   }
@@ -1313,6 +2585,14 @@ void Logician::moveUnit(const Posn& from,
 }
 
 void Logician::moveUnit(const Unit& unit, const Posn& posn, error_t& error) {
+  undo_t undo;
+  moveUnit(unit, posn, undo, error);
+}
+
+void Logician::moveUnit(const Unit& unit,
+                        const Posn& posn,
+                        undo_t&     undo,
+                        error_t&    error) {
   if (!isPlayersTurn(unit.colour())) {
     error = GUNGI_ERROR_NOT_TURN;
     return;
@@ -1323,64 +2603,32 @@ void Logician::moveUnit(const Unit& unit, const Posn& posn, error_t& error) {
     return;
   }
 
-  SharedUnitPtrVector::iterator it = Util::find(m_units, &unit);
-  GASSERT(it != m_units.end());
+  const unit_handle_t handle = m_arena.handle(&unit);
+  GASSERT(handle != UnitArena::k_NULL_HANDLE);
 
-  Tower& tower = m_board[posn.index()];
-  SharedUnitPtr& unitPtr = *it;
-
-  SharedUnitPtrVector capturedUnits;
-  SharedUnitPtrVector betrayedUnits;
-
-  if (tower.height() > 0 && tower.members().back()->colour() != unit.colour()) {
-    // Capture the unit at the top of the tower.
-    SharedUnitPtrVector::iterator it = Util::find(m_units,
-                                                  tower.members().back().get());
-    captureUnit(*it, next(), current(), true);
-    capturedUnits.push_back(*it);
-
-    if (unit.effectField() & GUNGI_EFFECT_BETRAYAL) {
-      // Units below in the tower betray their team and align with the current
-      // player.
-      for (SharedUnitPtr& sharedUnitPtr : tower.members()) {
-        if (sharedUnitPtr->colour() != unit.colour()) {
-          captureUnit(sharedUnitPtr, next(), current());
-          betrayedUnits.push_back(sharedUnitPtr);
-        }
-      }
-    }
-  }
+  make(Move::move(handle, posn), undo);
 
+  // The unit must be recovered if it cannot move from the tier it has landed
+  // on, nor from the tier above it when it is in a mobile range expansion.
   if (unit.effectField() & GUNGI_EFFECT_FORCED_RECOVERY) {
     tier_t tier = unit.tower()->tier(&unit, error);
     GASSERT(error == GUNGI_ERROR_NONE);
 
-    const Posn& unitPosn = unit.tower()->posn();
-    if (!Util::anyWalk(&unit, tier, unitPosn, isInverted(unit.colour()))) {
-      m_recovery.unit = unitPtr;
-      m_recovery.player = capturedUnits.size() ? &next() : &current();
-      m_recovery.tower = &tower;
+    const bool inverted = isInverted(unit.colour());
+    bool recover = !Util::anyWalk(&unit, tier, posn, inverted);
+    if (recover && isInMobileRangeExpansion(posn, unit.colour()) &&
+        tier < k_MAX_TOWER_SIZE - 1) {
+      recover = !Util::anyWalk(&unit, tier + 1, posn, inverted);
     }
 
-    if (isInMobileRangeExpansion(unitPosn, unit.colour()) &&
-        tier < k_MAX_TOWER_SIZE - 1 &&
-        !Util::anyWalk(&unit, tier + 1, unitPosn, isInverted(unit.colour()))) {
-      m_recovery.unit = unitPtr;
-      m_recovery.player = capturedUnits.size() ? &next() : &current();
-      m_recovery.tower = &tower;
+    if (recover) {
+      const bool captured = undo.captured != UnitArena::k_NULL_HANDLE;
+      m_recovery.unit = handle;
+      m_recovery.player = captured ? &next() : &current();
+      m_recovery.tower = &m_board[posn.index()];
     }
   }
 
-  // Move unit into the tower, but first remove from current tower.
-  GASSERT(unit.tower());
-  Tower& unitTower = m_board[unit.tower()->posn().index()];
-  unitTower.remove(unitPtr.get(), error);
-  GASSERT(error == GUNGI_ERROR_NONE);
-
-  // Add the unit to its new tower.
-  tower.add(unitPtr, error);
-  GASSERT(error == GUNGI_ERROR_NONE);
-
   if (unit.front() == GUNGI_PIECE_BRONZE) {
     // This is a special case in which a Bronze moves.  A Bronze cannot move
     // into a position in which it would put the opposing player into check.
@@ -1394,25 +2642,10 @@ void Logician::moveUnit(const Unit& unit, const Posn& posn, error_t& error) {
       return;
     }
 
-    error_t tempError;
-
-    // Undo the captures and betrayals.
-    for (SharedUnitPtr& sharedUnitPtr : capturedUnits) {
-      captureUnit(sharedUnitPtr, current(), next());
-      tower.add(sharedUnitPtr, tempError);
-      GASSERT(tempError == GUNGI_ERROR_NONE);
-    }
-
-    for (SharedUnitPtr& sharedUnitPtr : betrayedUnits) {
-      captureUnit(sharedUnitPtr, current(), next());
-    }
-
-    // Undo the move of the Bronze unit.
-    tower.remove(unitPtr.get(), tempError);
-    GASSERT(tempError == GUNGI_ERROR_NONE);
-
-    unitTower.add(unitPtr, tempError);
-    GASSERT(tempError == GUNGI_ERROR_NONE);
+    // Undo the move of the Bronze unit, along with its captures and
+    // betrayals, and the expansions computed for the position after it.
+    unmake(undo);
+    updateMobileRangeExpansion();
   } else {
     updateStateAfterTurn(error);
     GASSERT(error == GUNGI_ERROR_NONE);
@@ -1423,15 +2656,7 @@ void Logician::dropUnit(piece_id_t  front,
                         piece_id_t  back,
                         const Posn& to,
                         error_t&    error) {
-  Player& p = current();
-  Unit *unit = NULL;
-  for (SharedUnitPtr& ptr : p.units()) {
-    if (ptr->front() == front && ptr->back() == back && !ptr->tower()) {
-      unit = ptr.get();
-      break;
-    }
-  }
-
+  const Unit *unit = current().handUnit(Player::handKind(front, back));
   if (unit) {
     dropUnit(*unit, to, error);
   } else {
@@ -1440,6 +2665,14 @@ void Logician::dropUnit(piece_id_t  front,
 }
 
 void Logician::dropUnit(const Unit& unit, const Posn& posn, error_t& error) {
+  undo_t undo;
+  dropUnit(unit, posn, undo, error);
+}
+
+void Logician::dropUnit(const Unit& unit,
+                        const Posn& posn,
+                        undo_t&     undo,
+                        error_t&    error) {
   if (!isPlayersTurn(unit.colour())) {
     error = GUNGI_ERROR_NOT_TURN;
     return;
@@ -1449,22 +2682,18 @@ void Logician::dropUnit(const Unit& unit, const Posn& posn, error_t& error) {
     return;
   }
 
-  Tower& tower = m_board[posn.index()];
-  SharedUnitPtrVector::iterator it = Util::find(m_units, &unit);
-  GASSERT(it != m_units.end());
+  const unit_handle_t handle = m_arena.handle(&unit);
+  GASSERT(handle != UnitArena::k_NULL_HANDLE);
 
-  tower.add(*it, error);
-  GASSERT(error == GUNGI_ERROR_NONE);
+  make(Move::drop(handle, posn), undo);
 
-  m_toRearrange.reset();
+  m_toRearrange = UnitArena::k_NULL_HANDLE;
   updateStateAfterTurn(error, unit.front());
 
   if (error != GUNGI_ERROR_NONE) {
     // Foul play created by a drop that yielded a checkmate, so undo the drop,
     // and return.
-    error_t tempError;
-    tower.remove(it->get(), tempError);
-    GASSERT(tempError == GUNGI_ERROR_NONE);
+    unmake(undo);
   }
 }
 
@@ -1475,13 +2704,13 @@ void Logician::exchangeUnits(effect_t    effect,
                              tier_t      toTier,
                              error_t&    error) {
   Tower& fromTower = m_board[from.index()];
-  Unit *a = fromTower.at(fromTier, error);
+  Unit *a = m_arena.get(fromTower.at(fromTier, error));
   if (error != GUNGI_ERROR_NONE) {
     return;
   }
 
   Tower& toTower = m_board[to.index()];
-  Unit *b = toTower.at(toTier, error);
+  Unit *b = m_arena.get(toTower.at(toTier, error));
   if (error != GUNGI_ERROR_NONE) {
     return;
   }
@@ -1493,6 +2722,15 @@ void Logician::exchangeUnits(effect_t    exchange,
                              const Unit& a,
                              const Unit& b,
                              error_t&    error) {
+  undo_t undo;
+  exchangeUnits(exchange, a, b, undo, error);
+}
+
+void Logician::exchangeUnits(effect_t    exchange,
+                             const Unit& a,
+                             const Unit& b,
+                             undo_t&     undo,
+                             error_t&    error) {
   if (!isPlayersTurn(a.colour())) {
     error = GUNGI_ERROR_NOT_TURN;
     return;
@@ -1502,20 +2740,7 @@ void Logician::exchangeUnits(effect_t    exchange,
     return;
   }
 
-  Tower& unitTower = m_board[a.tower()->posn().index()];
-  if (exchange == GUNGI_EFFECT_SUBSTITUTION) {
-    Tower& targetTower = m_board[b.tower()->posn().index()];
-    SharedUnitPtr& unit = unitTower.members().back();
-    SharedUnitPtr& target = targetTower.members().back();
-    unit.swap(target);
-    unit->setTower(&targetTower);
-    target->setTower(&unitTower);
-  } else if (exchange == GUNGI_EFFECT_1_3_TIER_EXCHANGE) {
-    SharedUnitPtrVector& members = unitTower.members();
-    members.back().swap(members.front());
-  } else {
-    GASSERT(false);
-  }
+  make(Move::exchange(exchange, m_arena.handle(&a), m_arena.handle(&b)), undo);
 
   updateStateAfterTurn(error);
   GASSERT(error == GUNGI_ERROR_NONE);
@@ -1526,7 +2751,7 @@ void Logician::immobileStrike(const Posn& posn,
                               tier_t      target,
                               error_t&    error) {
   Tower& tower = m_board[posn.index()];
-  Unit *unit = tower.at(tier, error);
+  Unit *unit = m_arena.get(tower.at(tier, error));
   if (error != GUNGI_ERROR_NONE) {
     return;
   }
@@ -1537,6 +2762,14 @@ void Logician::immobileStrike(const Posn& posn,
 void Logician::immobileStrike(const Unit& unit,
                               tier_t      target,
                               error_t&    error) {
+  undo_t undo;
+  immobileStrike(unit, target, undo, error);
+}
+
+void Logician::immobileStrike(const Unit& unit,
+                              tier_t      target,
+                              undo_t&     undo,
+                              error_t&    error) {
   if (!isPlayersTurn(unit.colour())) {
     error = GUNGI_ERROR_NOT_TURN;
     return;
@@ -1546,49 +2779,162 @@ void Logician::immobileStrike(const Unit& unit,
     return;
   }
 
-  Tower& tower = m_board[unit.tower()->posn().index()];
-  Unit *enemy = tower.at(target, error);
+  const Unit *enemy = m_arena.get(unit.tower()->at(target, error));
   GASSERT(error == GUNGI_ERROR_NONE);
 
-  SharedUnitPtrVector::iterator it = Util::find(m_units, &unit);
-  captureUnit(*it, next(), current(), true);
+  make(Move::immobileStrike(m_arena.handle(&unit), m_arena.handle(enemy)),
+       undo);
 
   updateStateAfterTurn(error);
   GASSERT(error == GUNGI_ERROR_NONE);
 }
 
 void Logician::forceRecover(bool recover, error_t& error) {
+  undo_t undo;
+  forceRecover(recover, undo, error);
+}
+
+void Logician::forceRecover(bool recover, undo_t& undo, error_t& error) {
   if (!isForcedRecovery()) {
     error = GUNGI_ERROR_INVALID_STATE;
     return;
   }
 
-  if (recover) {
-    // Always remove from the current player.  It will be added back in the
-    // event the current player is recovering and it was not after a capture.
-    Player& player = current();
-    player.removeUnit(m_recovery.unit.get(), error);
-    GASSERT(error == GUNGI_ERROR_NONE);
+  // The unit is always removed from the current player; it is added back in
+  // the event the current player is recovering and it was not after a
+  // capture.
+  make(Move::forcedRecovery(m_recovery.unit, recover), undo);
 
-    m_recovery.player->addUnit(m_recovery.unit.get(), error);
-    GASSERT(error == GUNGI_ERROR_NONE);
+  m_recovery.unit = UnitArena::k_NULL_HANDLE;
+  m_recovery.player = NULL;
+  m_recovery.tower = NULL;
 
-    // Remove the unit from the board.
-    Tower& tower = m_board[m_recovery.unit->tower()->posn().index()];
-    tower.remove(m_recovery.unit.get(), error);
-    GASSERT(error == GUNGI_ERROR_NONE);
+  updateStateAfterTurn(error);
+  GASSERT(error == GUNGI_ERROR_NONE);
+}
+
+void Logician::playMove(const Move& move, error_t& error) {
+  undo_t undo;
+  playMove(move, undo, error);
+}
+
+void Logician::playMove(const Move& move, undo_t& undo, error_t& error) {
+  const Unit *unit = m_arena.get(move.unit());
+  const Unit *target = m_arena.get(move.target());
+  if (!unit) {
+    error = GUNGI_ERROR_INVALID_UNIT;
+    return;
+  }
+
+  switch (move.type()) {
+  case Move::MOVE_TYPE_DROP:
+    dropUnit(*unit, move.to(), undo, error);
+    break;
+  case Move::MOVE_TYPE_MOVE:
+    moveUnit(*unit, move.to(), undo, error);
+    break;
+  case Move::MOVE_TYPE_IMMOBILE_STRIKE:
+    if (!target || !unit->tower() || target->tower() != unit->tower()) {
+      error = GUNGI_ERROR_OUT_OF_RANGE;
+      return;
+    }
+    immobileStrike(*unit, unit->tower()->tier(target, error), undo, error);
+    break;
+  case Move::MOVE_TYPE_TIER_EXCHANGE:
+  case Move::MOVE_TYPE_SUBSTITUTION:
+    if (!target) {
+      error = GUNGI_ERROR_INVALID_UNIT;
+      return;
+    }
+    exchangeUnits(move.type() == Move::MOVE_TYPE_SUBSTITUTION
+                    ? GUNGI_EFFECT_SUBSTITUTION
+                    : GUNGI_EFFECT_1_3_TIER_EXCHANGE,
+                  *unit,
+                  *target,
+                  undo,
+                  error);
+    break;
+  case Move::MOVE_TYPE_FORCED_RECOVERY:
+    if (move.unit() != m_recovery.unit) {
+      error = GUNGI_ERROR_INVALID_STATE;
+      return;
+    }
+    forceRecover(move.recover(), undo, error);
+    break;
+  default:
+    error = GUNGI_ERROR_INVALID_UNIT;
+    break;
   }
+}
 
-  m_recovery.unit.reset();
-  memset(&m_recovery, 0, sizeof(m_recovery));
+void Logician::makeMove(const Move& move, turn_t& turn, error_t& error) {
+  turn.state = m_gameState;
+  turn.toRearrange = m_toRearrange;
+  turn.recovery = m_recovery;
+  turn.escapeRoutes = m_escapeRoutes;
+  turn.checkPoints = m_checkPoints;
+  turn.pinned = m_pinned;
+  turn.evasionsPending = m_evasionsPending;
+  turn.recorded = m_boardRecorder.count();
 
-  updateStateAfterTurn(error);
-  GASSERT(error == GUNGI_ERROR_NONE);
+  playMove(move, turn.undo, error);
+}
+
+void Logician::unmakeMove(const turn_t& turn) {
+  // The position after the move was recorded at the end of the turn.
+  m_boardRecorder.truncate(turn.recorded);
+
+  unmake(turn.undo);
+  updateMobileRangeExpansion();
+
+  m_gameState = turn.state;
+  m_toRearrange = turn.toRearrange;
+  m_recovery = turn.recovery;
+  m_escapeRoutes = turn.escapeRoutes;
+  m_checkPoints = turn.checkPoints;
+  m_pinned = turn.pinned;
+  m_evasionsPending = turn.evasionsPending;
 }
 
 // OPERATORS
+Logician& Logician::operator=(const Logician& rhs) {
+  if (this == &rhs) {
+    return *this;
+  }
+
+  // Assignment reuses the storage of this game, so restoring a saved game
+  // does not allocate once the vectors have grown to size.
+  m_black = rhs.m_black;
+  m_white = rhs.m_white;
+  m_arena = rhs.m_arena;
+  m_board = rhs.m_board;
+  memcpy(m_occupancy, rhs.m_occupancy, sizeof(m_occupancy));
+  memcpy(m_pieces, rhs.m_pieces, sizeof(m_pieces));
+  m_boardKey = rhs.m_boardKey;
+  m_handKey = rhs.m_handKey;
+  m_boardRecorder = rhs.m_boardRecorder;
+  m_gameState = rhs.m_gameState;
+  m_toRearrange = rhs.m_toRearrange;
+  m_recovery = rhs.m_recovery;
+  memcpy(m_expansions, rhs.m_expansions, sizeof(m_expansions));
+  m_expanders = rhs.m_expanders;
+  m_expandersMoved = rhs.m_expandersMoved;
+  memcpy(m_attacks, rhs.m_attacks, sizeof(m_attacks));
+  memcpy(m_attacked, rhs.m_attacked, sizeof(m_attacked));
+  m_changed = rhs.m_changed;
+  m_escapeRoutes = rhs.m_escapeRoutes;
+  m_checkPoints = rhs.m_checkPoints;
+  m_pinned = rhs.m_pinned;
+  m_lazyCheckmate = rhs.m_lazyCheckmate;
+  m_evasionsPending = rhs.m_evasionsPending;
+
+  // The pointers copied with the containers still refer to 'rhs'.
+  rebase(rhs);
+  return *this;
+}
+
 std::ostream& operator<<(std::ostream& os, const Logician& logician) {
-  const std::vector<Tower>& towers = logician.board();
+  const board_t& towers = logician.board();
   error_t error;
   const unsigned int len = k_BOARD_LENGTH * 6 + 1;
 
@@ -1617,7 +2963,7 @@ std::ostream& operator<<(std::ostream& os, const Logician& logician) {
         // given column an row.
         const Posn posn(col, row);
         const Tower& tower = towers[posn.index()];
-        const Unit *unit = tower.at(tier, error);
+        const Unit *unit = logician.unit(tower.at(tier, error));
         if (!unit) {
           // No unit, so fill the space.
           os << std::string(4, ' ');
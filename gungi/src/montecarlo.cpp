@@ -0,0 +1,373 @@
+// montecarlo.cpp                                                     -*-C++-*-
+#include "montecarlo.hpp"
+
+#include "engine.hpp"
+#include "gtypes.hpp"
+#include "logician.hpp"
+#include "move.hpp"
+#include "threadpool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace gungi {
+
+namespace {
+
+const double k_EXPLORATION = 1.4;
+  // Weight of the exploration bonus of the UCT rule against the share of
+  // wins.
+
+const uint32_t k_VIRTUAL_LOSS = 1;
+  // Number of lost playouts added to a position by each thread walking
+  // through it.
+
+}  // close unnamed namespace
+
+// PRIVATE MANIPULATORS
+void MonteCarlo::run(worker_t& worker) {
+  while (!isStopped()) {
+    playout(worker);
+    worker.playouts.store(worker.playouts.load(std::memory_order_relaxed) + 1,
+                          std::memory_order_relaxed);
+  }
+}
+
+void MonteCarlo::playout(worker_t& worker) {
+  Logician& game = worker.game;
+  error_t error;
+
+  // Walk down the tree, adding the moves of the first position reached that
+  // was visited before, and stopping at 'k_MAX_TREE_DEPTH' moves.
+  uint32_t idx = 0;
+  worker.path.clear();
+  worker.path.push_back(idx);
+  m_nodes[idx].virtualLoss.fetch_add(k_VIRTUAL_LOSS,
+                                     std::memory_order_relaxed);
+  while (!game.isOver() && worker.turns.size() < k_MAX_TREE_DEPTH) {
+    node_t& node = m_nodes[idx];
+    if (node.state.load(std::memory_order_acquire) != NODE_EXPANDED &&
+        ((idx != 0 && node.visits.load(std::memory_order_relaxed) == 0) ||
+         !expand(worker, node))) {
+      break;
+    } else if (node.numChildren == 0) {
+      break;
+    }
+
+    idx = select(node);
+    worker.path.push_back(idx);
+    m_nodes[idx].virtualLoss.fetch_add(k_VIRTUAL_LOSS,
+                                       std::memory_order_relaxed);
+
+    Logician::turn_t turn;
+    game.makeMove(m_nodes[idx].move, turn, error);
+    GASSERT(error == GUNGI_ERROR_NONE);
+    worker.turns.push_back(turn);
+  }
+
+  const int winner = simulate(worker);
+
+  // Take back every move, the last one first.
+  while (!worker.turns.empty()) {
+    game.unmakeMove(worker.turns.back());
+    worker.turns.pop_back();
+  }
+
+  for (const uint32_t visited : worker.path) {
+    node_t& node = m_nodes[visited];
+    const uint64_t wins = winner == -1
+                        ? 1
+                        : winner == node.colour
+                        ? 2
+                        : 0;
+    node.wins.fetch_add(wins, std::memory_order_relaxed);
+    node.visits.fetch_add(1, std::memory_order_relaxed);
+    node.virtualLoss.fetch_sub(k_VIRTUAL_LOSS, std::memory_order_relaxed);
+  }
+}
+
+bool MonteCarlo::expand(worker_t& worker, node_t& node) {
+  uint8_t state = NODE_LEAF;
+  if (!node.state.compare_exchange_strong(state,
+                                          NODE_EXPANDING,
+                                          std::memory_order_acquire)) {
+    // Another thread is adding the moves, or has added them.
+    return state == NODE_EXPANDED;
+  } else if (m_size.load(std::memory_order_relaxed) >= m_capacity) {
+    node.state.store(NODE_LEAF, std::memory_order_relaxed);
+    return false;
+  }
+
+  Logician& game = worker.game;
+  MoveList& moves = worker.moves;
+  game.generateMoves(moves);
+
+  const uint32_t count = moves.size();
+  const uint32_t first = m_size.fetch_add(count, std::memory_order_relaxed);
+  if (first + count > m_capacity) {
+    // The pool is full; the positions claimed past its end are never used.
+    node.state.store(NODE_LEAF, std::memory_order_relaxed);
+    return false;
+  }
+
+  // The moves tried first are those first in the tree, so they are shuffled.
+  for (uint32_t i = count; i > 1; i--) {
+    moves.swap(i - 1, nextRandom(worker) % i);
+  }
+
+  const uint8_t colour = game.isPlayersTurn(BLACK) ? BLACK : WHITE;
+  for (uint32_t i = 0; i < count; i++) {
+    node_t& child = m_nodes[first + i];
+    child.visits.store(0, std::memory_order_relaxed);
+    child.virtualLoss.store(0, std::memory_order_relaxed);
+    child.wins.store(0, std::memory_order_relaxed);
+    child.move = moves[i];
+    child.colour = colour;
+    child.state.store(NODE_LEAF, std::memory_order_relaxed);
+    child.numChildren = 0;
+    child.firstChild = 0;
+  }
+
+  node.firstChild = first;
+  node.numChildren = static_cast<uint16_t>(count);
+
+  // Publishes the children to the threads that see the position expanded.
+  node.state.store(NODE_EXPANDED, std::memory_order_release);
+  return true;
+}
+
+int MonteCarlo::simulate(worker_t& worker) {
+  Logician& game = worker.game;
+  MoveList& moves = worker.moves;
+  error_t error;
+  for (unsigned int ply = 0; ply < k_MAX_PLAYOUT_PLIES; ply++) {
+    if (game.isOver()) {
+      return game.isDraw() ? -1 : game.winner();
+    }
+
+    game.generateMoves(moves);
+    if (moves.empty()) {
+      return -1;
+    }
+
+    Logician::turn_t turn;
+    game.makeMove(moves[nextRandom(worker) % moves.size()], turn, error);
+    GASSERT(error == GUNGI_ERROR_NONE);
+    worker.turns.push_back(turn);
+  }
+
+  if (game.isOver()) {
+    return game.isDraw() ? -1 : game.winner();
+  }
+
+  // The playout is cut short, so it goes to the player ahead.
+  const int score = Engine::evaluate(game);
+  const int colour = game.isPlayersTurn(BLACK) ? BLACK : WHITE;
+  const int enemy = colour == BLACK ? WHITE : BLACK;
+  return score > 0 ? colour : score < 0 ? enemy : -1;
+}
+
+uint32_t MonteCarlo::select(const node_t& node) const {
+  const double parentVisits =
+    node.visits.load(std::memory_order_relaxed) +
+    node.virtualLoss.load(std::memory_order_relaxed);
+  const double logVisits = std::log(std::max(1.0, parentVisits));
+
+  uint32_t best = node.firstChild;
+  double bestValue = -1.0;
+  for (uint32_t idx = node.firstChild;
+       idx < node.firstChild + node.numChildren;
+       idx++) {
+    const node_t& child = m_nodes[idx];
+    const uint32_t visits =
+      child.visits.load(std::memory_order_relaxed) +
+      child.virtualLoss.load(std::memory_order_relaxed);
+    if (visits == 0) {
+      // A move never tried comes before any other.
+      return idx;
+    }
+
+    const double value =
+      child.wins.load(std::memory_order_relaxed) / (2.0 * visits) +
+      k_EXPLORATION * std::sqrt(logVisits / visits);
+    if (value > bestValue) {
+      bestValue = value;
+      best = idx;
+    }
+  }
+
+  return best;
+}
+
+uint64_t MonteCarlo::nextRandom(worker_t& worker) {
+  // Xorshift64*, which is fast and good enough to pick moves.
+  uint64_t x = worker.random;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  worker.random = x;
+  return (x * 0x2545F4914F6CDD1DULL) >> 16;
+}
+
+bool MonteCarlo::isStopped(void) {
+  if (m_stopped.load(std::memory_order_relaxed)) {
+    return true;
+  }
+
+  bool stop = false;
+  if (m_limits.playouts &&
+      m_started.fetch_add(1, std::memory_order_relaxed) >= m_limits.playouts) {
+    stop = true;
+  } else if (m_limits.milliseconds) {
+    const std::chrono::milliseconds elapsed =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - m_start);
+    stop = elapsed.count() >= m_limits.milliseconds;
+  }
+
+  if (stop) {
+    m_stopped.store(true, std::memory_order_relaxed);
+  }
+  return stop;
+}
+
+// CREATORS
+MonteCarlo::MonteCarlo(unsigned int numThreads,
+                       unsigned int maxNodes,
+                       uint64_t     seed)
+: m_nodes()
+, m_capacity(0)
+, m_size(0)
+, m_workers()
+, m_pool()
+, m_limits()
+, m_start()
+, m_started(0)
+, m_stopped(false)
+{
+  GASSERT(maxNodes > 0);
+
+  // The moves of the root always fit, so that a search has moves to pick.
+  m_capacity = std::max(maxNodes, 1 + MoveList::k_CAPACITY);
+  m_nodes.reset(new node_t[m_capacity]);
+
+  if (numThreads == 0) {
+    numThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  for (unsigned int idx = 0; idx < numThreads; idx++) {
+    std::unique_ptr<worker_t> worker(new worker_t());
+    worker->turns.reserve(k_MAX_TREE_DEPTH + k_MAX_PLAYOUT_PLIES);
+    worker->path.reserve(k_MAX_TREE_DEPTH + 1);
+    worker->random = ((seed + idx + 1) * 0x9E3779B97F4A7C15ULL) | 1;
+    worker->playouts.store(0);
+    m_workers.push_back(std::move(worker));
+  }
+
+  if (numThreads > 1) {
+    m_pool.reset(new ThreadPool(numThreads));
+  }
+}
+
+// MANIPULATORS
+Move MonteCarlo::search(const Logician& game, const limits_t& limits) {
+  GASSERT(limits.playouts || limits.milliseconds);
+
+  m_limits = limits;
+  m_start = std::chrono::steady_clock::now();
+  m_started.store(0);
+  m_stopped.store(false);
+
+  node_t& root = m_nodes[0];
+  root.visits.store(0);
+  root.virtualLoss.store(0);
+  root.wins.store(0);
+  root.move = Move();
+  root.colour = 0;
+  root.state.store(NODE_LEAF);
+  root.numChildren = 0;
+  root.firstChild = 0;
+  m_size.store(1);
+
+  for (const std::unique_ptr<worker_t>& worker : m_workers) {
+    // Assignment reuses the storage of the worker's game.
+    worker->game = game;
+    worker->playouts.store(0);
+  }
+
+  if (game.isOver()) {
+    return Move();
+  }
+
+  MoveList moves;
+  game.generateMoves(moves);
+  if (moves.empty()) {
+    return Move();
+  }
+
+  if (m_pool) {
+    m_pool->run(m_workers.size(), [this](unsigned int idx) {
+      run(*m_workers[idx]);
+    });
+  } else {
+    run(*m_workers[0]);
+  }
+
+  std::vector<stats_t> stats;
+  analysis(stats);
+  return stats.empty() ? moves[0] : stats[0].move;
+}
+
+// ACCESSORS
+void MonteCarlo::analysis(std::vector<stats_t>& stats) const {
+  stats.clear();
+
+  const node_t& root = m_nodes[0];
+  if (root.state.load(std::memory_order_acquire) != NODE_EXPANDED) {
+    return;
+  }
+
+  for (uint32_t idx = root.firstChild;
+       idx < root.firstChild + root.numChildren;
+       idx++) {
+    const node_t& child = m_nodes[idx];
+    stats_t entry;
+    entry.move = child.move;
+    entry.visits = child.visits.load(std::memory_order_relaxed);
+    entry.winRate = entry.visits
+                  ? child.wins.load(std::memory_order_relaxed)
+                    / (2.0 * entry.visits)
+                  : 0.0;
+    stats.push_back(entry);
+  }
+
+  std::stable_sort(stats.begin(),
+                   stats.end(),
+                   [](const stats_t& lhs, const stats_t& rhs) {
+                     return lhs.visits > rhs.visits;
+                   });
+}
+
+uint64_t MonteCarlo::playouts(void) const {
+  uint64_t playouts = 0;
+  for (const std::unique_ptr<worker_t>& worker : m_workers) {
+    playouts += worker->playouts.load(std::memory_order_relaxed);
+  }
+  return playouts;
+}
+
+uint32_t MonteCarlo::size(void) const {
+  return std::min(m_size.load(std::memory_order_relaxed), m_capacity);
+}
+
+unsigned int MonteCarlo::numThreads(void) const {
+  return m_workers.size();
+}
+
+}  // close 'gungi' namespace
@@ -0,0 +1,52 @@
+// move.cpp                                                           -*-C++-*-
+#include "move.hpp"
+
+#include "gtypes.hpp"
+#include "posn.hpp"
+
+#include <iostream>
+
+namespace gungi {
+
+namespace {
+
+const char *const k_MOVE_TYPE_NAMES[] = {
+  "None",
+  "Drop",
+  "Move",
+  "ImmobileStrike",
+  "TierExchange",
+  "Substitution",
+  "ForcedRecovery",
+};
+
+}  // close 'unnamed' namespace
+
+// OPERATORS
+std::ostream& operator<<(std::ostream& os, const Move& move) {
+  os
+    << "Move("
+    << k_MOVE_TYPE_NAMES[move.type()]
+    << ", unit="
+    << static_cast<unsigned int>(move.unit());
+
+  switch (move.type()) {
+  case Move::MOVE_TYPE_DROP:
+  case Move::MOVE_TYPE_MOVE:
+    os << ", to=" << move.to();
+    break;
+  case Move::MOVE_TYPE_FORCED_RECOVERY:
+    os << ", recover=" << (move.recover() ? "true" : "false");
+    break;
+  case Move::MOVE_TYPE_NONE:
+    break;
+  default:
+    os << ", target=" << static_cast<unsigned int>(move.target());
+    break;
+  }
+
+  os << ")";
+  return os;
+}
+
+}  // close 'gungi' namespace
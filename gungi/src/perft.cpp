@@ -0,0 +1,77 @@
+// perft.cpp                                                          -*-C++-*-
+#include "perft.hpp"
+
+#include "gtypes.hpp"
+#include "logician.hpp"
+#include "move.hpp"
+#include "threadpool.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace gungi {
+
+// PRIVATE CLASS METHODS
+uint64_t Perft::walk(Logician& game, unsigned int depth) {
+  if (depth == 0) {
+    return 1;
+  }
+
+  MoveList moves;
+  game.generateMoves(moves);
+  if (depth == 1) {
+    // Every generated move is legal, so the leaves need not be played.
+    return moves.size();
+  }
+
+  uint64_t nodes = 0;
+  error_t error;
+  Logician::turn_t turn;
+  for (const Move& move : moves) {
+    game.makeMove(move, turn, error);
+    GASSERT(error == GUNGI_ERROR_NONE);
+    nodes += walk(game, depth - 1);
+    game.unmakeMove(turn);
+  }
+
+  return nodes;
+}
+
+// STATIC CLASS METHODS
+uint64_t Perft::count(const Logician& game, unsigned int depth) {
+  Logician walked(game);
+  return walk(walked, depth);
+}
+
+uint64_t Perft::divide(const Logician&        game,
+                       unsigned int           depth,
+                       ThreadPool&            pool,
+                       std::vector<divide_t>& counts) {
+  GASSERT(depth > 0);
+
+  MoveList moves;
+  game.generateMoves(moves);
+
+  counts.assign(moves.size(), divide_t());
+  pool.run(moves.size(), [&](unsigned int idx) {
+    // Each task walks its subtree on its own copy of the game, so the tasks
+    // share nothing but the root position, which is only read.
+    error_t error;
+    Logician child(game);
+    Logician::turn_t turn;
+    child.makeMove(moves[idx], turn, error);
+    GASSERT(error == GUNGI_ERROR_NONE);
+
+    counts[idx].move = moves[idx];
+    counts[idx].nodes = walk(child, depth - 1);
+  });
+
+  uint64_t nodes = 0;
+  for (const divide_t& entry : counts) {
+    nodes += entry.nodes;
+  }
+
+  return nodes;
+}
+
+}  // close 'gungi' namespace
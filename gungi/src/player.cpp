@@ -3,7 +3,6 @@
 
 #include "gtypes.hpp"
 #include "unit.hpp"
-#include "util.hpp"
 
 #include <algorithm>
 #include <cstdlib>
@@ -11,13 +10,103 @@
 
 namespace gungi {
 
+namespace {
+
+class HandKinds {
+  // Table from the front and back of a unit to its kind in hand.  Backs are
+  // offset by one so that 'GUNGI_PIECE_NONE' has a slot.
+
+private:
+  // INSTANCE MEMBERS
+  unsigned int m_kinds[GUNGI_NUM_PIECES][GUNGI_NUM_PIECES + 1];
+    // Kind of each front and back.
+
+public:
+  // CREATORS
+  HandKinds(void);
+    // Creates the table from the starting hand.
+
+  // ACCESSORS
+  unsigned int kind(piece_id_t front, piece_id_t back) const;
+    // Returns the kind of a unit with the given 'front' and 'back'.
+};
+
+HandKinds::HandKinds(void) {
+  const unsigned int size = Player::k_NUM_HAND_KINDS / 2;
+  for (unsigned int front = 0; front < GUNGI_NUM_PIECES; front++) {
+    for (unsigned int back = 0; back <= GUNGI_NUM_PIECES; back++) {
+      m_kinds[front][back] = Player::k_NUM_HAND_KINDS;
+    }
+  }
+
+  for (unsigned int i = 0; i < size; i++) {
+    const int front = k_START_HAND[i][0];
+    const int back = k_START_HAND[i][1];
+    m_kinds[front][back + 1] = i;
+    if (back != GUNGI_PIECE_NONE) {
+      // A captured unit is flipped over into its new owner's hand.
+      m_kinds[back][front + 1] = size + i;
+    }
+  }
+}
+
+unsigned int HandKinds::kind(piece_id_t front, piece_id_t back) const {
+  if (front < 0 || front >= GUNGI_NUM_PIECES ||
+      back < GUNGI_PIECE_NONE || back >= GUNGI_NUM_PIECES) {
+    return Player::k_NUM_HAND_KINDS;
+  }
+
+  return m_kinds[front][back + 1];
+}
+
+bool isMember(const UnitPtrVector& units,
+              Unit::slot_t         slot,
+              const Unit          *unit) {
+  // Returns 'true' if the given 'unit' is in the given 'units', which it
+  // records the index of in the given 'slot', otherwise 'false'.
+  const unsigned int index = unit->slot(slot);
+  return index < units.size() && units[index] == unit;
+}
+
+void append(UnitPtrVector& units, Unit::slot_t slot, Unit *unit) {
+  // Appends the given 'unit' to the given 'units', recording its index in
+  // the given 'slot'.
+  unit->setSlot(slot, units.size());
+  units.push_back(unit);
+}
+
+void removeMember(UnitPtrVector& units, Unit::slot_t slot, Unit *unit) {
+  // Removes the given 'unit', which is a member, from the given 'units',
+  // whose indices are recorded in the given 'slot'.  The last unit takes the
+  // place of the removed one, so no other unit is moved.
+  Unit *last = units.back();
+  const unsigned int index = unit->slot(slot);
+  units[index] = last;
+  last->setSlot(slot, index);
+  units.pop_back();
+}
+
+}  // close unnamed namespace
+
+// CLASS METHODS
+unsigned int Player::handKind(piece_id_t front, piece_id_t back) {
+  static const HandKinds s_kinds;
+  return s_kinds.kind(front, back);
+}
+
 // CREATORS
 Player::Player(colour_t colour)
 : m_colour(colour)
+, m_commander(NULL)
 , m_units()
-, m_commander(nullptr)
+, m_active()
+, m_inactive()
+, m_hand()
+, m_handCounts()
 {
-  // DO NOTHING
+  m_units.reserve(k_MAX_UNITS);
+  m_active.reserve(k_MAX_UNITS);
+  m_inactive.reserve(k_MAX_UNITS);
 }
 
 Player::~Player(void) {
@@ -27,24 +116,20 @@ Player::~Player(void) {
 // MANIPULATORS
 void Player::reset(void) {
   m_units.clear();
-  m_commander = nullptr;
+  m_active.clear();
+  m_inactive.clear();
+  std::fill(m_handCounts, m_handCounts + k_NUM_HAND_KINDS, 0);
+  m_commander = NULL;
 }
 
 void Player::addUnit(Unit *unit, error_t& error) {
   GASSERT(unit);
 
-  SharedUnitPtr ptr(unit, NilDeleter<Unit>());
-  addUnit(ptr, error);
-}
-
-void Player::addUnit(SharedUnitPtr& unit, error_t& error) {
-  GASSERT(unit.get());
-
-  if (Util::find(m_units, unit.get()) != m_units.end()) {
+  if (isMember(m_units, Unit::UNITS_SLOT, unit)) {
     error = GUNGI_ERROR_DUPLICATE;
   } else {
     if (unit->front() == GUNGI_PIECE_COMMANDER) {
-      GASSERT(m_commander == nullptr);
+      GASSERT(m_commander == NULL);
       m_commander = unit;
     }
 
@@ -52,29 +137,99 @@ void Player::addUnit(SharedUnitPtr& unit, error_t& error) {
 
     error = GUNGI_ERROR_NONE;
 
-    m_units.push_back(unit);
+    append(m_units, Unit::UNITS_SLOT, unit);
+    if (unit->isActive()) {
+      append(m_active, Unit::GROUP_SLOT, unit);
+    } else {
+      append(m_inactive, Unit::GROUP_SLOT, unit);
+      addToHand(unit);
+    }
   }
 }
 
 void Player::removeUnit(Unit *unit, error_t& error) {
   GASSERT(unit);
 
-  SharedUnitPtrVector::const_iterator it = Util::find(m_units, unit);
-  if (it != m_units.end()) {
+  if (isMember(m_units, Unit::UNITS_SLOT, unit)) {
     error = GUNGI_ERROR_NONE;
 
-    if ((*it)->front() == GUNGI_PIECE_COMMANDER) {
-      m_commander.reset();
+    if (unit == m_commander) {
+      m_commander = NULL;
     }
 
-    m_units.erase(it);
+    removeMember(m_units, Unit::UNITS_SLOT, unit);
+
+    // The unit may have been put on or taken off the board without telling
+    // this player, so it is looked for in both partitions.
+    if (isMember(m_active, Unit::GROUP_SLOT, unit)) {
+      removeMember(m_active, Unit::GROUP_SLOT, unit);
+    } else {
+      removeMember(m_inactive, Unit::GROUP_SLOT, unit);
+      removeFromHand(unit);
+    }
   } else {
     error = GUNGI_ERROR_NOT_A_MEMBER;
   }
 }
 
+void Player::activate(Unit *unit, error_t& error) {
+  GASSERT(unit);
+
+  if (!isMember(m_inactive, Unit::GROUP_SLOT, unit)) {
+    error = GUNGI_ERROR_NOT_A_MEMBER;
+    return;
+  }
+
+  removeMember(m_inactive, Unit::GROUP_SLOT, unit);
+  removeFromHand(unit);
+  append(m_active, Unit::GROUP_SLOT, unit);
+  error = GUNGI_ERROR_NONE;
+}
+
+void Player::deactivate(Unit *unit, error_t& error) {
+  GASSERT(unit);
+
+  if (!isMember(m_active, Unit::GROUP_SLOT, unit)) {
+    error = GUNGI_ERROR_NOT_A_MEMBER;
+    return;
+  }
+
+  removeMember(m_active, Unit::GROUP_SLOT, unit);
+  append(m_inactive, Unit::GROUP_SLOT, unit);
+  addToHand(unit);
+  error = GUNGI_ERROR_NONE;
+}
+
+// PRIVATE MANIPULATORS
+void Player::addToHand(Unit *unit) {
+  const unsigned int kind = handKind(unit->front(), unit->back());
+  if (kind == k_NUM_HAND_KINDS) {
+    // Not a unit of a starting hand; it is only kept in 'm_inactive'.
+    return;
+  }
+
+  GASSERT(m_handCounts[kind] < k_MAX_KIND_COUNT);
+  unit->setSlot(Unit::HAND_SLOT, m_handCounts[kind]);
+  m_hand[kind][m_handCounts[kind]++] = unit;
+}
+
+void Player::removeFromHand(Unit *unit) {
+  const unsigned int kind = handKind(unit->front(), unit->back());
+  if (kind == k_NUM_HAND_KINDS) {
+    return;
+  }
+
+  // The last unit of the kind takes the place of the removed one.
+  Unit **units = m_hand[kind];
+  const unsigned int index = unit->slot(Unit::HAND_SLOT);
+  GASSERT(index < m_handCounts[kind] && units[index] == unit);
+  Unit *last = units[--m_handCounts[kind]];
+  units[index] = last;
+  last->setSlot(Unit::HAND_SLOT, index);
+}
+
 // ACCESSORS
-const SharedUnitPtr& Player::commander(void) const {
+const Unit *Player::commander(void) const {
   return m_commander;
 }
 
@@ -82,31 +237,28 @@ const colour_t& Player::colour(void) const {
   return m_colour;
 }
 
-SharedUnitPtrVector Player::activeUnits(void) const {
-  SharedUnitPtrVector v;
-  for (const SharedUnitPtr& ptr : m_units) {
-    if (ptr->isActive()) {
-      v.push_back(ptr);
-    }
-  }
-  return v;
+const UnitPtrVector& Player::activeUnits(void) const {
+  return m_active;
 }
 
-SharedUnitPtrVector Player::inactiveUnits(void) const {
-  SharedUnitPtrVector v;
-  for (const SharedUnitPtr& ptr : m_units) {
-    if (!ptr->isActive()) {
-      v.push_back(ptr);
-    }
-  }
-  return v;
+const UnitPtrVector& Player::inactiveUnits(void) const {
+  return m_inactive;
+}
+
+unsigned int Player::handCount(unsigned int kind) const {
+  return kind < k_NUM_HAND_KINDS ? m_handCounts[kind] : 0;
+}
+
+const Unit *Player::handUnit(unsigned int kind) const {
+  const unsigned int count = handCount(kind);
+  return count > 0 ? m_hand[kind][count - 1] : NULL;
 }
 
-SharedUnitPtrVector& Player::units(void) {
+UnitPtrVector& Player::units(void) {
   return m_units;
 }
 
-const SharedUnitPtrVector& Player::units(void) const {
+const UnitPtrVector& Player::units(void) const {
   return m_units;
 }
 
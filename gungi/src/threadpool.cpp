@@ -0,0 +1,139 @@
+// threadpool.cpp                                                     -*-C++-*-
+#include "threadpool.hpp"
+
+#include "gtypes.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gungi {
+
+// PRIVATE MANIPULATORS
+bool ThreadPool::take(unsigned int worker, unsigned int& idx) {
+  const unsigned int numQueues = m_queues.size();
+  for (unsigned int offset = 0; offset < numQueues; offset++) {
+    // Take the oldest task from our own queue, but steal the newest task from
+    // another queue, so that the owner and the thief work from opposite ends.
+    queue_t& queue = *m_queues[(worker + offset) % numQueues];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+      continue;
+    }
+
+    if (offset == 0) {
+      idx = queue.tasks.front();
+      queue.tasks.pop_front();
+    } else {
+      idx = queue.tasks.back();
+      queue.tasks.pop_back();
+    }
+    return true;
+  }
+
+  return false;
+}
+
+void ThreadPool::work(unsigned int worker) {
+  unsigned int batch = 0;
+  while (true) {
+    unsigned int idx;
+    while (take(worker, idx)) {
+      // Tasks are queued only after the batch's task is published, so the
+      // task read here is the one the index belongs to.
+      const task_t *task;
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        task = m_task;
+      }
+
+      (*task)(idx);
+
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (--m_remaining == 0) {
+        m_finished.notify_all();
+      }
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_started.wait(lock, [&] { return m_stopping || m_batch != batch; });
+    if (m_stopping) {
+      return;
+    }
+    batch = m_batch;
+  }
+}
+
+// CREATORS
+ThreadPool::ThreadPool(unsigned int numThreads)
+: m_queues()
+, m_workers()
+, m_mutex()
+, m_started()
+, m_finished()
+, m_task(NULL)
+, m_batch(0)
+, m_remaining(0)
+, m_stopping(false)
+{
+  if (numThreads == 0) {
+    numThreads = std::thread::hardware_concurrency();
+  }
+
+  if (numThreads == 0) {
+    // The number of hardware threads is not computable.
+    numThreads = 1;
+  }
+
+  for (unsigned int i = 0; i < numThreads; i++) {
+    m_queues.emplace_back(new queue_t());
+  }
+
+  for (unsigned int i = 0; i < numThreads; i++) {
+    m_workers.emplace_back(&ThreadPool::work, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool(void) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_started.notify_all();
+
+  for (std::thread& worker : m_workers) {
+    worker.join();
+  }
+}
+
+// MANIPULATORS
+void ThreadPool::run(unsigned int numTasks, const task_t& task) {
+  if (numTasks == 0) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    GASSERT(m_remaining == 0);
+    m_task = &task;
+    m_remaining = numTasks;
+    m_batch++;
+  }
+
+  for (unsigned int idx = 0; idx < numTasks; idx++) {
+    queue_t& queue = *m_queues[idx % m_queues.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(idx);
+  }
+  m_started.notify_all();
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_finished.wait(lock, [&] { return m_remaining == 0; });
+  m_task = NULL;
+}
+
+}  // close 'gungi' namespace
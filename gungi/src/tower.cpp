@@ -4,13 +4,11 @@
 #include "gtypes.hpp"
 #include "posn.hpp"
 #include "unit.hpp"
+#include "unitarena.hpp"
 #include "util.hpp"
 
-#include <algorithm>
-#include <iterator>
-#include <memory>
+#include <cstdint>
 #include <utility>
-#include <vector>
 
 namespace gungi {
 
@@ -18,6 +16,7 @@ namespace gungi {
 Tower::Tower(void)
 : m_posn(0, 0)
 , m_units()
+, m_height(0)
 , m_bits(0)
 {
   // DO NOTHING
@@ -26,6 +25,7 @@ Tower::Tower(void)
 Tower::Tower(const Posn& posn)
 : m_posn(posn)
 , m_units()
+, m_height(0)
 , m_bits(0)
 {
   // DO NOTHING
@@ -50,52 +50,114 @@ void Tower::markClean(void) {
   m_bits = 0;
 }
 
-void Tower::add(Unit *unit, error_t& err) {
-  GASSERT(unit);
-
-  SharedUnitPtr ptr(unit, NilDeleter<Unit>());
-  add(ptr, err);
-}
+void Tower::add(unit_handle_t unit, UnitArena& arena, error_t& err) {
+  GASSERT(unit != UnitArena::k_NULL_HANDLE);
 
-void Tower::add(SharedUnitPtr& unit, error_t& err) {
   if (height() == k_MAX_HEIGHT) {
     err = GUNGI_ERROR_FULL_TOWER;
-  } else if (isDuplicate(unit.get())) {
+  } else if (isDuplicate(&arena[unit], arena)) {
     err = GUNGI_ERROR_DUPLICATE;
   } else {
-    m_units.push_back(unit);
+    m_units[m_height] = unit;
 
-    unit->setTower(this);
+    arena[unit].setTower(this, m_height);
+
+    m_height++;
 
     err = GUNGI_ERROR_NONE;
   }
 }
 
-void Tower::remove(const Unit *unit, error_t& err) {
-  GASSERT(unit);
+void Tower::insert(tier_t         tier,
+                   unit_handle_t  unit,
+                   UnitArena&     arena,
+                   error_t&       err) {
+  GASSERT(unit != UnitArena::k_NULL_HANDLE);
 
-  SharedUnitPtrVector::const_iterator it = Util::find(m_units, unit);
-  if (it == m_units.end()) {
-    err = GUNGI_ERROR_NOT_A_MEMBER;
-  } else {
-    (*it)->clearTower();
+  if (height() == k_MAX_HEIGHT) {
+    err = GUNGI_ERROR_FULL_TOWER;
+    return;
+  } else if (tier < 0 || tier > static_cast<tier_t>(height())) {
+    err = GUNGI_ERROR_OUT_OF_RANGE;
+    return;
+  }
+
+  // Shift the units at and above the tier up a tier.
+  for (tier_t t = m_height; t > tier; t--) {
+    m_units[t] = m_units[t - 1];
+    arena[m_units[t]].setTower(this, t);
+  }
 
-    m_units.erase(it);
+  m_units[tier] = unit;
+  arena[unit].setTower(this, tier);
 
-    err = GUNGI_ERROR_NONE;
+  m_height++;
+
+  err = GUNGI_ERROR_NONE;
+}
+
+void Tower::remove(unit_handle_t unit, UnitArena& arena, error_t& err) {
+  GASSERT(unit != UnitArena::k_NULL_HANDLE);
+
+  tier_t t = tier(&arena[unit], err);
+  if (err != GUNGI_ERROR_NONE) {
+    return;
+  }
+
+  arena[unit].clearTower();
+
+  // Shift the units above the removed unit down a tier.
+  for (m_height--; t < m_height; t++) {
+    m_units[t] = m_units[t + 1];
+    arena[m_units[t]].setTower(this, t);
+  }
+}
+
+void Tower::exchange(tier_t a, tier_t b, UnitArena& arena, error_t& err) {
+  if (a < 0 || a >= height() || b < 0 || b >= height()) {
+    err = GUNGI_ERROR_OUT_OF_RANGE;
+    return;
+  }
+
+  std::swap(m_units[a], m_units[b]);
+  arena[m_units[a]].setTower(this, a);
+  arena[m_units[b]].setTower(this, b);
+
+  err = GUNGI_ERROR_NONE;
+}
+
+unit_handle_t Tower::replace(tier_t         tier,
+                             unit_handle_t  unit,
+                             UnitArena&     arena,
+                             error_t&       err) {
+  GASSERT(unit != UnitArena::k_NULL_HANDLE);
+
+  const unit_handle_t replaced = at(tier, err);
+  if (err != GUNGI_ERROR_NONE) {
+    return UnitArena::k_NULL_HANDLE;
   }
+
+  if (arena[replaced].tower() == this) {
+    arena[replaced].clearTower();
+  }
+
+  m_units[tier] = unit;
+  arena[unit].setTower(this, tier);
+
+  return replaced;
 }
 
 void Tower::reset(void) {
-  m_units.clear();
+  m_height = 0;
   markClean();
 }
 
 // ACCESSORS
-bool Tower::isDuplicate(const Unit *unit) const {
+bool Tower::isDuplicate(const Unit *unit, const UnitArena& arena) const {
   GASSERT(unit);
-  for (const SharedUnitPtr& ptr : m_units) {
-    if (ptr->front() == unit->front() && ptr->colour() == unit->colour()) {
+  for (tier_t tier = 0; tier < m_height; tier++) {
+    const Unit& member = arena[m_units[tier]];
+    if (member.front() == unit->front() && member.colour() == unit->colour()) {
       return true;
     }
   }
@@ -107,48 +169,40 @@ bool Tower::isDirty(const Tower::dirty_bit_t& bit) const {
 }
 
 unsigned int Tower::height(void) const {
-  return m_units.size();
+  return m_height;
 }
 
 tier_t Tower::tier(const Unit *unit, error_t& err) const {
   GASSERT(unit);
 
-  SharedUnitPtrVector::const_iterator it = Util::find(m_units, unit);
-  tier_t tier = std::distance(m_units.begin(), it);
-  if (tier >= height()) {
+  // The slots hold handles, so membership is decided by the tower and tier
+  // the unit records, which are kept in step with the slots.
+  tier_t tier = unit->tier();
+  if (unit->tower() != this || tier >= height()) {
     err = GUNGI_ERROR_NOT_A_MEMBER;
-  } else {
-    err = GUNGI_ERROR_NONE;
+    return height();
   }
 
+  err = GUNGI_ERROR_NONE;
   return tier;
 }
 
-Unit *Tower::at(tier_t tier, error_t& err) {
-  return const_cast<Unit *>(
-    static_cast<const Tower *>(this)->at(tier, err));
-}
-
-const Unit *Tower::at(tier_t tier, error_t& err) const {
-  if (tier >= height()) {
+unit_handle_t Tower::at(tier_t tier, error_t& err) const {
+  if (tier < 0 || tier >= height()) {
     err = GUNGI_ERROR_OUT_OF_RANGE;
-    return NULL;
+    return UnitArena::k_NULL_HANDLE;
   }
 
   err = GUNGI_ERROR_NONE;
-  return m_units.at(tier).get();
+  return m_units[tier];
 }
 
-const Posn& Tower::posn(void) const {
-  return m_posn;
-}
-
-SharedUnitPtrVector& Tower::members(void) {
-  return m_units;
+unit_handle_t Tower::top(void) const {
+  return m_height ? m_units[m_height - 1] : UnitArena::k_NULL_HANDLE;
 }
 
-const SharedUnitPtrVector& Tower::members(void) const {
-  return m_units;
+const Posn& Tower::posn(void) const {
+  return m_posn;
 }
 
 }  // close 'gungi' namespace
@@ -0,0 +1,169 @@
+// transpositiontable.cpp                                             -*-C++-*-
+#include "transpositiontable.hpp"
+
+#include "gtypes.hpp"
+#include "move.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include <sys/mman.h>
+
+namespace gungi {
+
+namespace {
+
+const std::size_t k_HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+  // Size of a huge page, to which the storage is aligned.
+
+const unsigned int k_SCORE_SHIFT = 32;
+const unsigned int k_DEPTH_SHIFT = 54;
+const unsigned int k_BOUND_SHIFT = 60;
+const unsigned int k_GENERATION_SHIFT = 62;
+  // Positions of the fields of a packed entry: the encoded move takes the
+  // low 32 bits, then 22 bits of score, 6 bits of depth, 2 bits of bound,
+  // and 2 bits of generation.
+
+const uint64_t k_SCORE_MASK = (1ULL << 22) - 1;
+const uint64_t k_DEPTH_MASK = (1ULL << 6) - 1;
+const uint64_t k_BOUND_MASK = 3;
+const uint64_t k_GENERATION_MASK = 3;
+  // Masks of the fields of a packed entry, once shifted down.
+
+}  // close unnamed namespace
+
+// CREATORS
+TranspositionTable::TranspositionTable(unsigned int megabytes, bool hugePages)
+: m_slots(NULL)
+, m_mask(0)
+, m_bytes(0)
+, m_hugePages(false)
+, m_generation(0)
+{
+  uint64_t numSlots = 1;
+  const uint64_t capacity =
+    (static_cast<uint64_t>(megabytes) << 20) / sizeof(slot_t);
+  while (numSlots * 2 <= capacity) {
+    numSlots *= 2;
+  }
+
+  m_mask = numSlots - 1;
+  m_bytes = numSlots * sizeof(slot_t);
+
+  void *storage = NULL;
+#ifdef MAP_HUGETLB
+  if (hugePages && m_bytes % k_HUGE_PAGE_SIZE == 0) {
+    // Explicit huge pages are only there if the system reserved them.
+    storage = mmap(NULL,
+                   m_bytes,
+                   PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                   -1,
+                   0);
+    if (storage == MAP_FAILED) {
+      storage = NULL;
+    } else {
+      m_hugePages = true;
+    }
+  }
+#endif
+
+  if (!storage) {
+    const std::size_t alignment = hugePages && m_bytes >= k_HUGE_PAGE_SIZE
+                                ? k_HUGE_PAGE_SIZE
+                                : sizeof(slot_t);
+    const int rc = posix_memalign(&storage, alignment, m_bytes);
+    GASSERT(rc == 0 && storage);
+
+#ifdef MADV_HUGEPAGE
+    if (hugePages) {
+      // Advice only; the table works the same if it is not taken.
+      madvise(storage, m_bytes, MADV_HUGEPAGE);
+    }
+#endif
+  }
+
+  m_slots = static_cast<slot_t *>(storage);
+  for (uint64_t idx = 0; idx < numSlots; idx++) {
+    new (&m_slots[idx]) slot_t();
+  }
+
+  clear();
+}
+
+TranspositionTable::~TranspositionTable(void) {
+  // The slots hold only atomic words, so there is nothing to destroy.
+  if (m_hugePages) {
+    munmap(m_slots, m_bytes);
+  } else {
+    free(m_slots);
+  }
+}
+
+// MANIPULATORS
+void TranspositionTable::clear(void) {
+  for (uint64_t idx = 0; idx <= m_mask; idx++) {
+    m_slots[idx].check.store(0, std::memory_order_relaxed);
+    m_slots[idx].data.store(0, std::memory_order_relaxed);
+  }
+
+  m_generation = 0;
+}
+
+void TranspositionTable::newSearch(void) {
+  m_generation = (m_generation + 1) & k_GENERATION_MASK;
+}
+
+void TranspositionTable::store(uint64_t key, const entry_t& entry) {
+  GASSERT(entry.score >= -k_MAX_SCORE && entry.score <= k_MAX_SCORE);
+  GASSERT(entry.depth <= k_MAX_DEPTH);
+
+  slot_t& slot = m_slots[key & m_mask];
+  const uint64_t old = slot.data.load(std::memory_order_relaxed);
+  const bool same = (slot.check.load(std::memory_order_relaxed) ^ old) == key;
+
+  if (((old >> k_GENERATION_SHIFT) & k_GENERATION_MASK) == m_generation &&
+      ((old >> k_DEPTH_SHIFT) & k_DEPTH_MASK) > entry.depth) {
+    // A deeper result of the current search is worth more than this one.
+    return;
+  }
+
+  uint32_t move = entry.move.encode();
+  if (same && entry.move.type() == Move::MOVE_TYPE_NONE) {
+    move = static_cast<uint32_t>(old);
+  }
+
+  const uint64_t data =
+    static_cast<uint64_t>(move) |
+    static_cast<uint64_t>(entry.score + k_MAX_SCORE + 1) << k_SCORE_SHIFT |
+    static_cast<uint64_t>(entry.depth) << k_DEPTH_SHIFT |
+    static_cast<uint64_t>(entry.bound) << k_BOUND_SHIFT |
+    static_cast<uint64_t>(m_generation) << k_GENERATION_SHIFT;
+
+  slot.data.store(data, std::memory_order_relaxed);
+  slot.check.store(key ^ data, std::memory_order_relaxed);
+}
+
+// ACCESSORS
+bool TranspositionTable::probe(uint64_t key, entry_t& entry) const {
+  const slot_t& slot = m_slots[key & m_mask];
+  const uint64_t data = slot.data.load(std::memory_order_relaxed);
+  const uint64_t check = slot.check.load(std::memory_order_relaxed);
+  if ((check ^ data) != key || data == 0) {
+    // The slot holds another position, a torn write, or nothing.
+    return false;
+  }
+
+  entry.move = Move::decode(static_cast<uint32_t>(data));
+  entry.score = static_cast<int>((data >> k_SCORE_SHIFT) & k_SCORE_MASK)
+              - k_MAX_SCORE - 1;
+  entry.depth = static_cast<unsigned int>((data >> k_DEPTH_SHIFT)
+                                          & k_DEPTH_MASK);
+  entry.bound = static_cast<bound_t>((data >> k_BOUND_SHIFT) & k_BOUND_MASK);
+  return true;
+}
+
+}  // close 'gungi' namespace
@@ -14,22 +14,16 @@
 namespace gungi {
 
 // PRIVATE MANIPULATORS
-void Unit::reset(void) {
+void Unit::reset(const Builder& builder) {
   error_t err;
 
-  m_effectBitField = m_builder.effects(m_identifier, err);
+  m_effectBitField = builder.effects(id(), err);
   if (err != GUNGI_ERROR_NONE) {
     m_identifier = GUNGI_PIECE_NONE;
     return;
   }
 
-  m_immuneBitField = m_builder.immunities(m_identifier, err);
-  if (err != GUNGI_ERROR_NONE) {
-    m_identifier = GUNGI_PIECE_NONE;
-    return;
-  }
-
-  m_movesPtr = m_builder.moveset(m_identifier, err);
+  m_immuneBitField = builder.immunities(id(), err);
   if (err != GUNGI_ERROR_NONE) {
     m_identifier = GUNGI_PIECE_NONE;
     return;
@@ -37,20 +31,33 @@ void Unit::reset(void) {
 }
 
 // CREATORS
+Unit::Unit(void)
+: m_tower(0)
+, m_identifier(GUNGI_PIECE_NONE)
+, m_back(GUNGI_PIECE_NONE)
+, m_colour(0)
+, m_tier(0)
+, m_effectBitField(0)
+, m_immuneBitField(0)
+, m_slots()
+{
+  // DO NOTHING
+}
+
 Unit::Unit(piece_id_t     front,
            piece_id_t     back,
            colour_t       colour,
            const Builder& builder)
-: m_builder(builder)
+: m_tower(0)
 , m_identifier(front)
 , m_back(back)
 , m_colour(colour)
+, m_tier(0)
 , m_effectBitField(0)
 , m_immuneBitField(0)
-, m_movesPtr(0)
-, m_tower(0)
+, m_slots()
 {
-  reset();
+  reset(builder);
 }
 
 Unit::~Unit(void) {
@@ -68,19 +75,26 @@ void Unit::flip(error_t& err) {
 
   std::swap(m_identifier, m_back);
 
-  reset();
+  reset(Builder());
 }
 
 void Unit::setColour(colour_t colour) {
   m_colour = colour;
 }
 
-void Unit::setTower(Tower const *towerPtr) {
+void Unit::setTower(Tower const *towerPtr, tier_t tier) {
   m_tower = towerPtr;
+  m_tier = tier;
 }
 
 void Unit::clearTower(void) {
   m_tower = NULL;
+  m_tier = 0;
+}
+
+void Unit::setSlot(slot_t slot, unsigned int index) {
+  GASSERT(index <= UINT8_MAX);
+  m_slots[slot] = index;
 }
 
 void Unit::addEffect(effect_t effect) {
@@ -108,30 +122,39 @@ bool Unit::isActive(void) const {
   return (m_tower != NULL);
 }
 
-const piece_id_t& Unit::id(void) const {
-  return m_identifier;
+piece_id_t Unit::id(void) const {
+  return static_cast<piece_id_t>(m_identifier);
 }
 
-const piece_id_t& Unit::front(void) const {
+piece_id_t Unit::front(void) const {
   return id();
 }
 
-const piece_id_t& Unit::back(void) const {
-  return m_back;
+piece_id_t Unit::back(void) const {
+  return static_cast<piece_id_t>(m_back);
 }
 
-const colour_t& Unit::colour(void) const {
-  return m_colour;
+colour_t Unit::colour(void) const {
+  return static_cast<colour_t>(m_colour);
 }
 
 const_moveset_ptr_t Unit::moveset(void) const {
-  return m_movesPtr;
+  error_t err;
+  return Builder().moveset(id(), err);
 }
 
 Tower const *Unit::tower(void) const {
   return m_tower;
 }
 
+tier_t Unit::tier(void) const {
+  return m_tier;
+}
+
+unsigned int Unit::slot(slot_t slot) const {
+  return m_slots[slot];
+}
+
 effect_bitfield_t Unit::effectField(void) const {
   return m_effectBitField;
 }
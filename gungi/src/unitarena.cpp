@@ -0,0 +1,37 @@
+// unitarena.cpp                                                      -*-C++-*-
+#include "unitarena.hpp"
+
+#include "builder.hpp"
+#include "gtypes.hpp"
+#include "unit.hpp"
+
+namespace gungi {
+
+// CREATORS
+UnitArena::UnitArena(void)
+: m_units()
+, m_size(0)
+{
+  // DO NOTHING
+}
+
+UnitArena::~UnitArena(void) {
+  // DO NOTHING
+}
+
+// MANIPULATORS
+unit_handle_t UnitArena::create(piece_id_t     front,
+                                piece_id_t     back,
+                                colour_t       colour,
+                                const Builder& builder) {
+  GASSERT(m_size < k_CAPACITY);
+
+  m_units[m_size] = Unit(front, back, colour, builder);
+  return static_cast<unit_handle_t>(m_size++);
+}
+
+void UnitArena::reset(void) {
+  m_size = 0;
+}
+
+}  // close 'gungi' namespace
@@ -98,27 +98,13 @@ std::string Util::toUpperCase(const std::string& str) {
   return newstr;
 }
 
-SharedUnitPtrVector::iterator Util::find(SharedUnitPtrVector& v,
-                                         const Unit          *unit) {
-  SharedUnitPtrVector::iterator it;
-  for (it = v.begin(); it != v.end(); it++) {
-    if ((*it).get() == unit) {
-      return it;
-    }
-  }
-  return it;
+UnitPtrVector::iterator Util::find(UnitPtrVector& v, const Unit *unit) {
+  return std::find(v.begin(), v.end(), unit);
 }
 
-SharedUnitPtrVector::const_iterator Util::find(
-                                             const SharedUnitPtrVector& v,
-                                             const Unit                *unit) {
-  SharedUnitPtrVector::const_iterator it;
-  for (it = v.begin(); it != v.end(); it++) {
-    if ((*it).get() == unit) {
-      return it;
-    }
-  }
-  return it;
+UnitPtrVector::const_iterator Util::find(const UnitPtrVector& v,
+                                         const Unit          *unit) {
+  return std::find(v.begin(), v.end(), unit);
 }
 
 PosnSet::const_iterator Util::find(const PosnSet& set, const Posn& posn) {
@@ -131,54 +117,12 @@ bool Util::anyWalk(const Unit *unit,
                    bool        invert) {
   GASSERT(unit);
 
-  const move_vector_t move_vector = unit->moveset()[tier];
-  for (const std::vector<move_t> moves : move_vector) {
-    // Check the moves available at the tier.  Each portion of the move must be
-    // executed in turn to walk towards the 'end' position.
-    Posn pos = start;
-
-    for (const move_t move : moves) {
-      unsigned int dir = move.move_direction;
-      move_mod_t mod = move.move_modifier;
-
-      while (dir) {
-        if (dir & GUNGI_MOVE_DIR_UP) {
-          pos.up(invert);
-          if (!mod) {
-            dir ^= GUNGI_MOVE_DIR_UP;
-          }
-        }
-
-        if (dir & GUNGI_MOVE_DIR_DOWN) {
-          pos.down(invert);
-          if (!mod) {
-            dir ^= GUNGI_MOVE_DIR_DOWN;
-          }
-        }
-
-        if (dir & GUNGI_MOVE_DIR_LEFT) {
-          pos.left(invert);
-          if (!mod) {
-            dir ^= GUNGI_MOVE_DIR_LEFT;
-          }
-        }
-
-        if (dir & GUNGI_MOVE_DIR_RIGHT) {
-          pos.right(invert);
-          if (!mod) {
-            dir ^= GUNGI_MOVE_DIR_RIGHT;
-          }
-        }
-
-        if (mod && pos.isValid()) {
-          return true;
-        } else if (!pos.isValid()) {
-          break;
-        }
-      }
-    }
-
-    if (pos.isValid()) {
+  // Any square on the board reached by an unlimited step, or at the end of a
+  // path, is a square the unit can move to.
+  Walker walker(unit->front(), tier, start, invert);
+  while (walker.next()) {
+    if ((walker.isUnlimited() || walker.isPathEnd()) &&
+        walker.posn().isValid()) {
       return true;
     }
   }
@@ -193,130 +137,69 @@ PosnSet Util::allWalks(const Unit *unit,
   GASSERT(unit);
   PosnSet posns;
 
-  const move_vector_t move_vector = unit->moveset()[tier];
-  for (const std::vector<move_t> moves : move_vector) {
-    // Check the moves available at the tier.  Each portion of the move must be
-    // executed in turn to walk towards the 'end' position.
-    Posn pos = start;
-
-    for (const move_t move : moves) {
-      unsigned int dir = move.move_direction;
-      move_mod_t mod = move.move_modifier;
-
-      while (dir) {
-        if (dir & GUNGI_MOVE_DIR_UP) {
-          pos.up(invert);
-          if (!mod) {
-            dir ^= GUNGI_MOVE_DIR_UP;
-          }
-        }
-
-        if (dir & GUNGI_MOVE_DIR_DOWN) {
-          pos.down(invert);
-          if (!mod) {
-            dir ^= GUNGI_MOVE_DIR_DOWN;
-          }
-        }
-
-        if (dir & GUNGI_MOVE_DIR_LEFT) {
-          pos.left(invert);
-          if (!mod) {
-            dir ^= GUNGI_MOVE_DIR_LEFT;
-          }
-        }
-
-        if (dir & GUNGI_MOVE_DIR_RIGHT) {
-          pos.right(invert);
-          if (!mod) {
-            dir ^= GUNGI_MOVE_DIR_RIGHT;
-          }
-        }
-
-        if (mod && pos.isValid()) {
-          posns.push_back(pos);
-        } else if (!pos.isValid()) {
-          break;
-        }
-      }
-    }
-
-    if (pos.isValid()) {
-      posns.push_back(pos);
+  Walker walker(unit->front(), tier, start, invert);
+  while (walker.next()) {
+    if ((walker.isUnlimited() || walker.isPathEnd()) &&
+        walker.posn().isValid()) {
+      posns.push_back(walker.posn());
     }
   }
 
   return posns;
 }
 
-PosnSet Util::getWalk(const Unit *unit,
-                      tier_t      tier,
-                      const Posn& start,
-                      const Posn& end,
-                      error_t&    error,
-                      bool        invert) {
+unsigned int Util::getWalk(const Unit *unit,
+                           tier_t      tier,
+                           const Posn& start,
+                           const Posn& end,
+                           Posn       *walk,
+                           error_t&    error,
+                           bool        invert) {
   GASSERT(unit);
-
-  const move_vector_t move_vector = unit->moveset()[tier];
-  for (const std::vector<move_t> moves : move_vector) {
-    // Check the moves available at the tier.  Each portion of the move must be
-    // executed in turn to walk towards the 'end' position.
-    PosnSet posn_set;
-    Posn pos = start;
-    posn_set.push_back(pos);
-
-    for (const move_t move : moves) {
-      unsigned int dir = move.move_direction;
-      move_mod_t mod = move.move_modifier;
-
-      while (dir) {
-        if (dir & GUNGI_MOVE_DIR_UP) {
-          pos.up(invert);
-          if (!mod) {
-            dir ^= GUNGI_MOVE_DIR_UP;
-          }
-        }
-
-        if (dir & GUNGI_MOVE_DIR_DOWN) {
-          pos.down(invert);
-          if (!mod) {
-            dir ^= GUNGI_MOVE_DIR_DOWN;
-          }
-        }
-
-        if (dir & GUNGI_MOVE_DIR_LEFT) {
-          pos.left(invert);
-          if (!mod) {
-            dir ^= GUNGI_MOVE_DIR_LEFT;
-          }
-        }
-
-        if (dir & GUNGI_MOVE_DIR_RIGHT) {
-          pos.right(invert);
-          if (!mod) {
-            dir ^= GUNGI_MOVE_DIR_RIGHT;
-          }
-        }
-
-        posn_set.push_back(pos);
-        if (pos == end || !pos.isValid()) {
-          break;
-        }
+  GASSERT(walk);
+
+  // Each path of the moves available at the tier must be executed in turn to
+  // walk towards the 'end' position.
+  unsigned int length = 1;
+  walk[0] = start;
+
+  Walker walker(unit->front(), tier, start, end, invert);
+  while (walker.next()) {
+    GASSERT(length < k_MAX_WALK_LENGTH);
+    walk[length++] = walker.posn();
+
+    if (walker.isPathEnd()) {
+      if (walker.posn() == end) {
+        // If the position is the ending position, then it means that we
+        // have successfully reached the target position.
+        error = GUNGI_ERROR_NONE;
+        return length;
       }
-    }
 
-    if (pos != end) {
-      continue;
+      // Start the walk of the next path over from the start position.
+      length = 1;
     }
-
-    // If the position is the ending position, then it mens that we have
-    // successfully reached the target position, return the set of points
-    // walked to reach the target.
-    error = GUNGI_ERROR_NONE;
-    return posn_set;
   }
 
   error = GUNGI_ERROR_NO_WALK;
-  return PosnSet();
+  return 0;
+}
+
+PosnSet Util::getWalk(const Unit *unit,
+                      tier_t      tier,
+                      const Posn& start,
+                      const Posn& end,
+                      error_t&    error,
+                      bool        invert) {
+  Posn walk[k_MAX_WALK_LENGTH];
+  const unsigned int length = getWalk(unit,
+                                      tier,
+                                      start,
+                                      end,
+                                      walk,
+                                      error,
+                                      invert);
+  return PosnSet(walk, walk + length);
 }
 
 PosnSet Util::crossed(const Posn& a, const Posn& b) {
@@ -0,0 +1,42 @@
+// zobrist.cpp                                                        -*-C++-*-
+#include "zobrist.hpp"
+
+#include "gtypes.hpp"
+#include "player.hpp"
+#include "tower.hpp"
+#include "unit.hpp"
+#include "unitarena.hpp"
+
+#include <cstdint>
+
+namespace gungi {
+
+// STATIC CLASS METHODS
+uint64_t Zobrist::board(const board_t& board, const UnitArena& arena) {
+  uint64_t key = 0;
+  error_t error;
+  for (const Tower& tower : board) {
+    const unsigned int square = tower.posn().index();
+    for (tier_t tier = 0; tier < static_cast<tier_t>(tower.height()); tier++) {
+      const Unit& member = arena[tower.at(tier, error)];
+      key ^= unit(square,
+                  tier,
+                  member.colour(),
+                  member.front(),
+                  member.back());
+    }
+  }
+  return key;
+}
+
+uint64_t Zobrist::hand(const Player& player) {
+  uint64_t key = 0;
+  for (const Unit *member : player.units()) {
+    if (!member->tower()) {
+      key += hand(member->colour(), member->front(), member->back());
+    }
+  }
+  return key;
+}
+
+}  // close 'gungi' namespace
@@ -0,0 +1,159 @@
+// attacktable_unit_tests.cpp                                         -*-C++-*-
+#include "attacktable.hpp"
+
+#include "bitboard.hpp"
+#include "builder.hpp"
+#include "gtypes.hpp"
+#include "posn.hpp"
+#include "unit.hpp"
+#include "util.hpp"
+
+#include <CppUTest/TestHarness.h>
+
+using namespace gungi;
+
+TEST_GROUP(AttackTableTest) {
+  void setup(void) {
+    return;
+  }
+
+  void teardown(void) {
+    return;
+  }
+};
+
+TEST(AttackTableTest, reach_matches_walks) {
+  const Builder builder;
+  error_t error;
+
+  for (int piece = 0; piece < GUNGI_NUM_PIECES; piece++) {
+    const Unit unit(static_cast<piece_id_t>(piece),
+                    GUNGI_PIECE_NONE,
+                    BLACK,
+                    builder);
+
+    for (unsigned int from = 0; from < Bitboard::k_NUM_SQUARES; from += 5) {
+      const Posn start(from % k_BOARD_LENGTH, from / k_BOARD_LENGTH);
+      for (unsigned int to = 0; to < Bitboard::k_NUM_SQUARES; to++) {
+        const Posn end(to % k_BOARD_LENGTH, to / k_BOARD_LENGTH);
+        for (tier_t tier = 0; tier < k_MAX_TOWER_SIZE; tier++) {
+          for (int inverted = 0; inverted < 2; inverted++) {
+            Util::getWalk(&unit, tier, start, end, error, inverted);
+            CHECK_EQUAL(error == GUNGI_ERROR_NONE,
+                        AttackTable::reach(unit.front(),
+                                           tier,
+                                           from,
+                                           inverted).test(to));
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(AttackTableTest, reach_of_pawn) {
+  const Posn start(4, 4);
+  const Bitboard& reach = AttackTable::reach(GUNGI_PIECE_PAWN,
+                                             0,
+                                             start.index(),
+                                             false);
+
+  CHECK_EQUAL(1, reach.count());
+  CHECK_TRUE(reach.test(Posn(4, 5)));
+
+  const Bitboard& inverted = AttackTable::reach(GUNGI_PIECE_PAWN,
+                                                0,
+                                                start.index(),
+                                                true);
+  CHECK_EQUAL(1, inverted.count());
+  CHECK_TRUE(inverted.test(Posn(4, 3)));
+}
+
+TEST(AttackTableTest, between_matches_crossed) {
+  for (unsigned int from = 0; from < Bitboard::k_NUM_SQUARES; from++) {
+    const Posn a(from % k_BOARD_LENGTH, from / k_BOARD_LENGTH);
+    for (unsigned int to = 0; to < Bitboard::k_NUM_SQUARES; to++) {
+      const Posn b(to % k_BOARD_LENGTH, to / k_BOARD_LENGTH);
+
+      Bitboard expected;
+      for (const Posn& posn : Util::crossed(a, b)) {
+        expected.set(posn);
+      }
+
+      CHECK_TRUE(expected == AttackTable::between(from, to));
+    }
+  }
+}
+
+TEST(AttackTableTest, between_excludes_endpoints) {
+  const Bitboard& between = AttackTable::between(Posn(0, 0).index(),
+                                                 Posn(0, 3).index());
+
+  CHECK_EQUAL(2, between.count());
+  CHECK_TRUE(between.test(Posn(0, 1)));
+  CHECK_TRUE(between.test(Posn(0, 2)));
+  CHECK_TRUE(AttackTable::between(0, 1).none());
+}
+
+TEST(AttackTableTest, lines_cover_every_reachable_square) {
+  for (int piece = 0; piece < GUNGI_NUM_PIECES; piece++) {
+    for (unsigned int from = 0; from < Bitboard::k_NUM_SQUARES; from += 4) {
+      for (tier_t tier = 0; tier < k_MAX_TOWER_SIZE; tier++) {
+        for (int inverted = 0; inverted < 2; inverted++) {
+          Bitboard expected;
+          Bitboard targets = AttackTable::reach(static_cast<piece_id_t>(piece),
+                                                tier,
+                                                from,
+                                                inverted);
+          while (targets.any()) {
+            expected |= AttackTable::between(from, targets.pop());
+          }
+
+          CHECK_TRUE(expected ==
+                     AttackTable::lines(static_cast<piece_id_t>(piece),
+                                        tier,
+                                        from,
+                                        inverted));
+        }
+      }
+    }
+  }
+}
+
+TEST(AttackTableTest, expansion_of_fortress_is_column_ahead) {
+  const Bitboard& white = AttackTable::expansion(
+                                         GUNGI_EFFECT_MOBILE_RANGE_EXPANSION_1,
+                                         Posn(4, 1).index(),
+                                         WHITE);
+  CHECK_TRUE(white ==
+             (Bitboard::file(4) - Bitboard::square(Posn(4, 0).index())));
+
+  const Bitboard& black = AttackTable::expansion(
+                                         GUNGI_EFFECT_MOBILE_RANGE_EXPANSION_1,
+                                         Posn(4, 7).index(),
+                                         BLACK);
+  CHECK_TRUE(black ==
+             (Bitboard::file(4) - Bitboard::square(Posn(4, 8).index())));
+}
+
+TEST(AttackTableTest, expansion_of_catapult_is_diamond_in_territory) {
+  const Bitboard& white = AttackTable::expansion(
+                                         GUNGI_EFFECT_MOBILE_RANGE_EXPANSION_2,
+                                         Posn(4, 1).index(),
+                                         WHITE);
+  CHECK_EQUAL(11, white.count());
+  CHECK_TRUE(white.test(Posn(2, 1)));
+  CHECK_TRUE(white.test(Posn(6, 1)));
+  CHECK_TRUE(white.test(Posn(3, 0)));
+  CHECK_TRUE(white.test(Posn(5, 2)));
+  CHECK_FALSE(white.test(Posn(4, 3)));
+
+  const Bitboard& black = AttackTable::expansion(
+                                         GUNGI_EFFECT_MOBILE_RANGE_EXPANSION_2,
+                                         Posn(0, 8).index(),
+                                         BLACK);
+  CHECK_EQUAL(6, black.count());
+  CHECK_TRUE(black.test(Posn(0, 6)));
+  CHECK_TRUE(black.test(Posn(2, 8)));
+  CHECK_FALSE(black.test(Posn(3, 8)));
+}
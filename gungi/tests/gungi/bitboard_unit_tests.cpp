@@ -0,0 +1,162 @@
+// bitboard_unit_tests.cpp                                            -*-C++-*-
+#include "bitboard.hpp"
+
+#include "gtypes.hpp"
+#include "posn.hpp"
+
+#include <CppUTest/TestHarness.h>
+
+#include <cstdint>
+
+using namespace gungi;
+
+TEST_GROUP(BitboardTest) {
+  void setup(void) {
+    return;
+  }
+
+  void teardown(void) {
+    return;
+  }
+};
+
+TEST(BitboardTest, constructor_creates_empty_set) {
+  Bitboard board;
+
+  CHECK_TRUE(board.none());
+  CHECK_FALSE(board.any());
+  CHECK_EQUAL(0, board.count());
+}
+
+TEST(BitboardTest, set_and_test_every_square) {
+  for (unsigned int idx = 0; idx < Bitboard::k_NUM_SQUARES; idx++) {
+    Bitboard board;
+    board.set(idx);
+
+    CHECK_TRUE(board.test(idx));
+    CHECK_EQUAL(1, board.count());
+
+    for (unsigned int other = 0; other < Bitboard::k_NUM_SQUARES; other++) {
+      if (other != idx) {
+        CHECK_FALSE(board.test(other));
+      }
+    }
+  }
+}
+
+TEST(BitboardTest, reset_removes_square) {
+  Bitboard board;
+  board.set(Posn(4, 4));
+  board.set(Posn(8, 8));
+
+  CHECK_EQUAL(2, board.count());
+
+  board.reset(Posn(8, 8));
+
+  CHECK_EQUAL(1, board.count());
+  CHECK_TRUE(board.test(Posn(4, 4)));
+  CHECK_FALSE(board.test(Posn(8, 8)));
+
+  board.clear();
+
+  CHECK_TRUE(board.none());
+}
+
+TEST(BitboardTest, all_contains_every_square) {
+  CHECK_EQUAL(Bitboard::k_NUM_SQUARES, Bitboard::all().count());
+  CHECK_TRUE((~Bitboard()) == Bitboard::all());
+  CHECK_TRUE((~Bitboard::all()).none());
+}
+
+TEST(BitboardTest, constructor_discards_bits_off_the_board) {
+  Bitboard board(0, ~0ULL);
+
+  CHECK_EQUAL(Bitboard::k_NUM_SQUARES - 64, board.count());
+}
+
+TEST(BitboardTest, file_and_rank_masks) {
+  for (unsigned int i = 0; i < k_BOARD_LENGTH; i++) {
+    const Bitboard file = Bitboard::file(i);
+    const Bitboard rank = Bitboard::rank(i);
+
+    CHECK_EQUAL(k_BOARD_LENGTH, file.count());
+    CHECK_EQUAL(k_BOARD_LENGTH, rank.count());
+
+    for (unsigned int j = 0; j < k_BOARD_LENGTH; j++) {
+      CHECK_TRUE(file.test(Posn(i, j)));
+      CHECK_TRUE(rank.test(Posn(j, i)));
+    }
+
+    CHECK_TRUE((file & rank) == Bitboard::square(Posn(i, i).index()));
+  }
+}
+
+TEST(BitboardTest, set_operations) {
+  Bitboard a;
+  a.set(1);
+  a.set(70);
+
+  Bitboard b;
+  b.set(70);
+  b.set(80);
+
+  CHECK_TRUE((a & b) == Bitboard::square(70));
+  CHECK_EQUAL(3, (a | b).count());
+  CHECK_EQUAL(2, (a ^ b).count());
+  CHECK_FALSE((a ^ b).test(70));
+  CHECK_TRUE(a != b);
+
+  Bitboard c = a;
+  c |= b;
+  c &= ~Bitboard::square(1);
+
+  CHECK_TRUE(c == b);
+
+  c ^= b;
+
+  CHECK_TRUE(c.none());
+}
+
+TEST(BitboardTest, difference_removes_squares) {
+  Bitboard a;
+  a.set(3);
+  a.set(70);
+
+  const Bitboard b = Bitboard::square(70);
+
+  CHECK_TRUE((a - b) == Bitboard::square(3));
+  CHECK_TRUE((b - a).none());
+
+  a -= b;
+
+  CHECK_TRUE(a == Bitboard::square(3));
+}
+
+TEST(BitboardTest, pop_visits_squares_in_index_order) {
+  Bitboard board;
+  board.set(80);
+  board.set(5);
+  board.set(63);
+  board.set(64);
+
+  const unsigned int expected[] = { 5, 63, 64, 80 };
+  for (unsigned int i = 0; i < 4; i++) {
+    CHECK_EQUAL(expected[i], board.first());
+    CHECK_EQUAL(expected[i], board.pop());
+  }
+
+  CHECK_TRUE(board.none());
+}
+
+TEST(BitboardTest, converts_to_and_from_posns) {
+  const PosnSet posns = { Posn(8, 8), Posn(0, 0), Posn(4, 1), Posn(9, 0) };
+  const Bitboard board = Bitboard::fromPosns(posns);
+
+  CHECK_EQUAL(3, board.count());
+
+  const PosnSet squares = board.toPosns();
+  CHECK_EQUAL(3, squares.size());
+  CHECK_TRUE(Posn(0, 0) == squares[0]);
+  CHECK_TRUE(Posn(4, 1) == squares[1]);
+  CHECK_TRUE(Posn(8, 8) == squares[2]);
+}
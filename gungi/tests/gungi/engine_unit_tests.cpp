@@ -0,0 +1,220 @@
+// engine_unit_tests.cpp                                              -*-C++-*-
+#include "engine.hpp"
+
+#include "gtypes.hpp"
+#include "logician.hpp"
+#include "move.hpp"
+
+#include <CppUTest/TestHarness.h>
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+using namespace gungi;
+
+class EngineFixture {
+  // Fixture for testing the search engine.
+
+public:
+  // STATIC CLASS MEMBERS
+  static void playout(Logician& game, uint32_t seed, unsigned int plies) {
+    // Plays up to the given number of 'plies' of random moves chosen by the
+    // given 'seed' in the given 'game'.
+    error_t error;
+    for (unsigned int ply = 0; ply < plies; ply++) {
+      MoveList moves;
+      game.generateMoves(moves);
+      if (moves.empty() || game.isOver()) {
+        return;
+      }
+
+      seed = seed * 1103515245 + 12345;
+      game.playMove(moves[(seed >> 16) % moves.size()], error);
+      GASSERT(error == GUNGI_ERROR_NONE);
+    }
+  }
+
+  static bool findMateInOne(Logician& game, uint32_t seed) {
+    // Plays random moves chosen by the given 'seed' in the given 'game' until
+    // the player whose turn it is can checkmate in one move, and returns
+    // 'true', otherwise returns 'false' if the game ends first.
+    error_t error;
+    for (unsigned int ply = 0; ply < 400; ply++) {
+      MoveList moves;
+      game.generateMoves(moves);
+      if (moves.empty() || game.isOver()) {
+        return false;
+      }
+
+      for (const Move& move : moves) {
+        Logician::turn_t turn;
+        game.makeMove(move, turn, error);
+        const bool mate = game.isInCheckmate();
+        game.unmakeMove(turn);
+        if (mate) {
+          return true;
+        }
+      }
+
+      seed = seed * 1103515245 + 12345;
+      game.playMove(moves[(seed >> 16) % moves.size()], error);
+      GASSERT(error == GUNGI_ERROR_NONE);
+    }
+
+    return false;
+  }
+};
+
+TEST_GROUP(EngineTest) {
+  void setup(void) {
+    return;
+  }
+
+  void teardown(void) {
+    return;
+  }
+};
+
+TEST(EngineTest, evaluate_new_game_is_even) {
+  Logician game;
+  CHECK_EQUAL(0, Engine::evaluate(game));
+}
+
+TEST(EngineTest, value_of_commander_is_zero) {
+  CHECK_EQUAL(0, Engine::value(GUNGI_PIECE_COMMANDER));
+  CHECK_TRUE(Engine::value(GUNGI_PIECE_PAWN) > 0);
+}
+
+TEST(EngineTest, search_returns_legal_move_and_line) {
+  Logician game;
+  EngineFixture::playout(game, 7919, 80);
+  const uint64_t key = game.key();
+
+  Engine::limits_t limits = { 2, 0, 0 };
+  Engine engine;
+  const Move best = engine.search(game, limits);
+
+  MoveList moves;
+  game.generateMoves(moves);
+  CHECK_TRUE(moves.contains(best));
+  CHECK_TRUE(key == game.key());
+
+  CHECK_EQUAL(2, engine.depth());
+  CHECK_TRUE(engine.nodes() > moves.size());
+  CHECK_FALSE(engine.principalVariation().empty());
+  CHECK_TRUE(best == engine.principalVariation()[0]);
+
+  // The line is made of legal moves.
+  error_t error;
+  for (const Move& move : engine.principalVariation()) {
+    game.playMove(move, error);
+    CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+  }
+}
+
+TEST(EngineTest, search_respects_node_limit) {
+  Logician game;
+  EngineFixture::playout(game, 104729, 80);
+
+  Engine::limits_t limits = { 0, 500, 0 };
+  Engine engine;
+  const Move best = engine.search(game, limits);
+
+  MoveList moves;
+  game.generateMoves(moves);
+  CHECK_TRUE(moves.contains(best));
+  CHECK_TRUE(engine.nodes() <= 501);
+  CHECK_TRUE(engine.depth() < Engine::k_MAX_PLY);
+}
+
+TEST(EngineTest, search_respects_time_limit) {
+  Logician game;
+  EngineFixture::playout(game, 15485863, 80);
+
+  Engine::limits_t limits = { 0, 0, 50 };
+  Engine engine;
+
+  const std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+  const Move best = engine.search(game, limits);
+  const std::chrono::steady_clock::duration elapsed =
+    std::chrono::steady_clock::now() - start;
+
+  MoveList moves;
+  game.generateMoves(moves);
+  CHECK_TRUE(moves.contains(best));
+  CHECK_TRUE(elapsed < std::chrono::seconds(5));
+}
+
+TEST(EngineTest, search_finds_mate_in_one) {
+  Logician game;
+  uint32_t seed = 1;
+  while (!EngineFixture::findMateInOne(game, seed * 7919)) {
+    game.newGame();
+    seed++;
+  }
+
+  Engine::limits_t limits = { 3, 0, 0 };
+  Engine engine;
+  const Move best = engine.search(game, limits);
+
+  CHECK_EQUAL(Engine::k_MATE_SCORE - 1, engine.score());
+  CHECK_EQUAL(1, engine.depth());
+
+  error_t error;
+  game.playMove(best, error);
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+  CHECK_TRUE(game.isInCheckmate());
+
+  CHECK_TRUE(engine.search(game, limits) == Move());
+}
+
+TEST(EngineTest, search_again_reuses_table) {
+  Logician game;
+  EngineFixture::playout(game, 7919, 80);
+
+  Engine::limits_t limits = { 3, 0, 0 };
+  Engine engine;
+  const Move first = engine.search(game, limits);
+  const uint64_t nodes = engine.nodes();
+
+  // The second search finds the results of the first in the table.
+  const Move second = engine.search(game, limits);
+  CHECK_TRUE(first == second);
+  CHECK_TRUE(engine.nodes() < nodes);
+
+  engine.clear();
+  engine.search(game, limits);
+  CHECK_EQUAL(nodes, engine.nodes());
+}
+
+TEST(EngineTest, search_on_threads_returns_legal_move) {
+  Logician game;
+  EngineFixture::playout(game, 104729, 80);
+  const uint64_t key = game.key();
+
+  Engine::limits_t limits = { 3, 0, 0 };
+  Engine engine(4, 1);
+  CHECK_EQUAL(4, engine.numThreads());
+
+  const Move best = engine.search(game, limits);
+  MoveList moves;
+  game.generateMoves(moves);
+  CHECK_TRUE(moves.contains(best));
+  CHECK_TRUE(key == game.key());
+  CHECK_EQUAL(3, engine.depth());
+  CHECK_TRUE(best == engine.principalVariation()[0]);
+
+  // The limits hold over every thread.
+  limits.depth = 0;
+  limits.milliseconds = 50;
+  const std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+  CHECK_TRUE(moves.contains(engine.search(game, limits)));
+  CHECK_TRUE(std::chrono::steady_clock::now() - start <
+             std::chrono::seconds(5));
+
+  Engine hardware(0, 1);
+  CHECK_TRUE(hardware.numThreads() > 0);
+}
@@ -0,0 +1,352 @@
+// gnarchive_unit_tests.cpp                                           -*-C++-*-
+#include "gnarchive.hpp"
+
+#include "gndecoder.hpp"
+#include "gnencoder.hpp"
+#include "gnreader.hpp"
+#include "gtypes.hpp"
+#include "logician.hpp"
+#include "move.hpp"
+
+#include <CppUTest/TestHarness.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace gungi;
+
+class GNArchiveFixture {
+  // Fixture for testing the archive of games.
+
+public:
+  // STATIC CLASS MEMBERS
+  static std::vector<Move> playout(uint32_t seed, unsigned int plies) {
+    // Returns up to the given number of 'plies' of random moves chosen by the
+    // given 'seed', played from the start of a game.
+    std::vector<Move> played;
+    Logician game;
+    error_t error;
+    for (unsigned int ply = 0; ply < plies; ply++) {
+      MoveList moves;
+      game.generateMoves(moves);
+      if (moves.empty() || game.isOver()) {
+        break;
+      }
+
+      seed = seed * 1103515245 + 12345;
+      const Move& move = moves[(seed >> 16) % moves.size()];
+      game.playMove(move, error);
+      GASSERT(error == GUNGI_ERROR_NONE);
+      played.push_back(move);
+    }
+    return played;
+  }
+
+  static GNMetadata metadata(uint32_t seed) {
+    // Returns the metadata of a game, whose players are chosen by the given
+    // 'seed'.
+    GNMetadata md;
+    md.setEvent("Selection");
+    md.setDate("2013.10.30");
+    md.setLocation("NGL, Mitene Union");
+    md.setWhite(seed % 2 ? "Komugi" : "Meruem");
+    md.setBlack(seed % 2 ? "Meruem" : "Komugi");
+    return md;
+  }
+
+  static std::string read(const std::string& path) {
+    // Returns the contents of the file at the given 'path', which is removed.
+    std::ifstream ifs(path.c_str(), std::ios::binary);
+    std::ostringstream oss;
+    oss << ifs.rdbuf();
+    std::remove(path.c_str());
+    return oss.str();
+  }
+};
+
+TEST_GROUP(GNArchiveTest) {
+  void setup(void) {
+    return;
+  }
+
+  void teardown(void) {
+    return;
+  }
+};
+
+TEST(GNArchiveTest, pack_move_round_trips) {
+  const char *moves[] = {
+    "PZ<1-2-0>3-4-1",
+    "PZ*1-2-0",
+    "O-*8-8-2",
+    "O-<8-7-2x6-5-1",
+    "PZ<1-2-0x1",
+    "PZ+1-2-0",
+    "HK^0-0-0",
+    "CN=4-4-1",
+    "PZ<1-2-0&3-4-1",
+    "PZ<1-2-0&2"
+  };
+
+  for (const char *move : moves) {
+    const std::string text(move);
+    GNDecoder::token_t token;
+    CHECK_TRUE(GNDecoder::parseMove(text.c_str(), text.size(), token));
+
+    uint8_t bytes[GNArchive::k_PLY_SIZE];
+    CHECK_TRUE(GNArchive::packMove(token, bytes));
+
+    GNDecoder::token_t unpacked;
+    CHECK_TRUE(GNArchive::unpackMove(bytes, unpacked));
+    if (unpacked.front == '\0') {
+      // Board moves leave out the identifiers of their unit.
+      CHECK_TRUE(text[2] == '<');
+      unpacked.front = token.front;
+      unpacked.back = token.back;
+    }
+
+    char encoded[GNEncoder::k_MAX_MOVE_LENGTH];
+    const size_t length = GNEncoder::encodeMove(unpacked, encoded);
+    CHECK_TRUE(text == std::string(encoded, length));
+  }
+}
+
+TEST(GNArchiveTest, pack_move_malformed) {
+  GNDecoder::token_t token;
+  CHECK_TRUE(GNDecoder::parseMove("PZ*1-2-0", 8, token));
+
+  uint8_t bytes[GNArchive::k_PLY_SIZE];
+  token.col = 9;
+  CHECK_FALSE(GNArchive::packMove(token, bytes));
+
+  token.col = 1;
+  token.front = '?';
+  CHECK_FALSE(GNArchive::packMove(token, bytes));
+
+  token.front = '-';
+  CHECK_FALSE(GNArchive::packMove(token, bytes));
+
+  token.front = 'P';
+  token.tier = k_MAX_TOWER_SIZE;
+  CHECK_FALSE(GNArchive::packMove(token, bytes));
+
+  token.tier = 0;
+  token.type = GNDecoder::TOKEN_NONE;
+  CHECK_FALSE(GNArchive::packMove(token, bytes));
+
+  // Bytes of no square, or of no kind of move, are malformed.
+  const uint8_t square[GNArchive::k_PLY_SIZE] = { 0xF1, 0x07, 0x00 };
+  CHECK_FALSE(GNArchive::unpackMove(square, token));
+
+  const uint8_t type[GNArchive::k_PLY_SIZE] = { 0x0F, 0x00, 0x00 };
+  CHECK_FALSE(GNArchive::unpackMove(type, token));
+
+  // Nor are bytes of a tier past the top of a tower.
+  const uint8_t tier[GNArchive::k_PLY_SIZE] = { 0x01, 0x18, 0x00 };
+  CHECK_FALSE(GNArchive::unpackMove(tier, token));
+}
+
+TEST(GNArchiveTest, archive_round_trips_through_encoder) {
+  // Games written as Gungi Notation, moved into an archive, and written back
+  // out give the same text.
+  std::vector<char> buffer(1024 * 1024);
+  GNEncoder expected(&buffer[0], buffer.size());
+  for (uint32_t seed = 1; seed <= 6; seed++) {
+    CHECK_TRUE(expected.writeGame(GNArchiveFixture::metadata(seed),
+                                  GNArchiveFixture::playout(seed, 250)));
+  }
+  CHECK_TRUE(expected.writeGame(GNMetadata(), std::vector<Move>()));
+  const std::string text(&buffer[0], expected.size());
+
+  const std::string path("gnarchive_unit_tests.gna");
+  const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  CHECK_TRUE(fd >= 0);
+  {
+    GNArchiveWriter writer(fd);
+    GNReader reader(text.c_str(), text.size());
+    CHECK_EQUAL(7, reader.read([&writer](const GNReader::game_t& game) {
+      return writer.addGame(game);
+    }));
+    CHECK_EQUAL(7, writer.numGames());
+    CHECK_TRUE(writer.finish());
+    CHECK_TRUE(writer.size() < text.size() / 2);
+  }
+  ::close(fd);
+
+  GNArchive archive;
+  CHECK_TRUE(archive.open(path));
+  std::remove(path.c_str());
+  CHECK_EQUAL(7, archive.numGames());
+
+  std::vector<char> output(buffer.size());
+  GNEncoder encoder(&output[0], output.size());
+  for (size_t game = 0; game < archive.numGames(); game++) {
+    CHECK_TRUE(archive.write(game, encoder));
+  }
+  CHECK_TRUE(text == std::string(&output[0], encoder.size()));
+}
+
+TEST(GNArchiveTest, archive_seeks_to_ply) {
+  const std::string path("gnarchive_unit_tests_seek.gna");
+  const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  CHECK_TRUE(fd >= 0);
+
+  std::vector<std::vector<Move> > games;
+  {
+    GNArchiveWriter writer(fd);
+    for (uint32_t seed = 1; seed <= 4; seed++) {
+      games.push_back(GNArchiveFixture::playout(seed, 120));
+      CHECK_TRUE(writer.addGame(GNArchiveFixture::metadata(seed),
+                                games.back()));
+    }
+
+    // A game with an illegal move is not added.
+    std::vector<Move> illegal = GNArchiveFixture::playout(1, 4);
+    illegal.push_back(illegal.back());
+    CHECK_FALSE(writer.addGame(GNMetadata(), illegal));
+    CHECK_EQUAL(4, writer.numGames());
+
+    // The archive is finished as the writer is destroyed.
+  }
+  ::close(fd);
+
+  const std::string data = GNArchiveFixture::read(path);
+  GNArchive archive;
+  CHECK_TRUE(archive.open(data.c_str(), data.size()));
+  CHECK_EQUAL(data.size(), archive.size());
+  CHECK_EQUAL(4, archive.numGames());
+
+  for (size_t game = 0; game < games.size(); game++) {
+    const unsigned int ply = games[game].size() / 2;
+    CHECK_EQUAL(games[game].size(), archive.numPlies(game));
+
+    Controller expected;
+    GNDecoder::token_t expectedToken;
+    error_t error = GUNGI_ERROR_NONE;
+    for (unsigned int idx = 0; idx <= ply; idx++) {
+      if (idx == ply) {
+        CHECK_TRUE(GNEncoder::tokenize(expected,
+                                       games[game][idx],
+                                       expectedToken));
+        break;
+      }
+      expected.playMove(games[game][idx], error);
+    }
+
+    // The move at a ply is read without reading the moves before it.
+    GNDecoder::token_t token;
+    CHECK_TRUE(archive.move(game, ply, token));
+    CHECK_EQUAL(expectedToken.type, token.type);
+    CHECK_EQUAL(expectedToken.col, token.col);
+    CHECK_EQUAL(expectedToken.row, token.row);
+    CHECK_EQUAL(expectedToken.toTier, token.toTier);
+
+    Controller controller;
+    unsigned int plies;
+    CHECK_TRUE(archive.replay(game, ply, controller, plies));
+    CHECK_EQUAL(ply, plies);
+    CHECK_TRUE(controller.key() == expected.key());
+  }
+
+  GNDecoder::token_t token;
+  CHECK_FALSE(archive.move(0, archive.numPlies(0), token));
+  CHECK_FALSE(archive.move(4, 0, token));
+}
+
+TEST(GNArchiveTest, archive_stores_each_string_once) {
+  const std::string path("gnarchive_unit_tests_strings.gna");
+  const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  CHECK_TRUE(fd >= 0);
+
+  uint64_t size = 0;
+  {
+    GNArchiveWriter writer(fd);
+    CHECK_TRUE(writer.addGame(GNArchiveFixture::metadata(1),
+                              std::vector<Move>()));
+    size = writer.size();
+    for (uint32_t seed = 2; seed <= 10; seed++) {
+      CHECK_TRUE(writer.addGame(GNArchiveFixture::metadata(seed),
+                                std::vector<Move>()));
+    }
+
+    // Each game after the first adds an entry to the table, but no strings.
+    CHECK_TRUE(writer.finish());
+    CHECK_FALSE(writer.addGame(GNMetadata(), std::vector<Move>()));
+  }
+  ::close(fd);
+
+  const std::string data = GNArchiveFixture::read(path);
+  CHECK_EQUAL(size + 10 * GNArchive::k_GAME_SIZE + 6 * 8 +
+              std::string("Selection2013.10.30NGL, Mitene UnionKomugiMeruem")
+                                                                     .size() +
+              GNArchive::k_FOOTER_SIZE,
+              data.size());
+
+  GNArchive archive;
+  CHECK_TRUE(archive.open(data.c_str(), data.size()));
+  GNMetadata md;
+  CHECK_TRUE(archive.metadata(3, md));
+  CHECK_TRUE(md.white() == "Meruem");
+  CHECK_TRUE(md.black() == "Komugi");
+  CHECK_TRUE(md.location() == "NGL, Mitene Union");
+  CHECK_TRUE(md.date() == "2013.10.30");
+}
+
+TEST(GNArchiveTest, archive_malformed) {
+  GNArchive archive;
+  CHECK_FALSE(archive.open("gnarchive_unit_tests_missing.gna"));
+  CHECK_FALSE(archive.open("", 0));
+  CHECK_FALSE(archive.open("GNARCHIV", 8));
+
+  const std::string path("gnarchive_unit_tests_malformed.gna");
+  const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  CHECK_TRUE(fd >= 0);
+  {
+    GNArchiveWriter writer(fd);
+    CHECK_TRUE(writer.addGame(GNArchiveFixture::metadata(1),
+                              GNArchiveFixture::playout(1, 10)));
+  }
+  ::close(fd);
+
+  std::string data = GNArchiveFixture::read(path);
+  CHECK_TRUE(archive.open(data.c_str(), data.size()));
+
+  // An archive cut short, or whose table of games is past its end, is not
+  // read.
+  CHECK_FALSE(archive.open(data.c_str(), data.size() - 1));
+  CHECK_EQUAL(0, archive.numGames());
+
+  std::string table(data);
+  table[table.size() - GNArchive::k_FOOTER_SIZE + 7] = '\x7F';
+  CHECK_FALSE(archive.open(table.c_str(), table.size()));
+
+  // A table of games that is not a whole number of games is not read, even
+  // if it holds as many whole games as the footer gives.
+  std::string offset(data);
+  const size_t footer = offset.size() - GNArchive::k_FOOTER_SIZE;
+  CHECK_TRUE(offset[footer] != 0);
+  offset[footer] = static_cast<char>(offset[footer] - 1);
+  CHECK_FALSE(archive.open(offset.c_str(), offset.size()));
+
+  // A game whose moves are past the table of games has none.
+  const size_t entry = 8 + 10 * GNArchive::k_PLY_SIZE;
+  data[entry + 8] = '\x7F';
+  CHECK_TRUE(archive.open(data.c_str(), data.size()));
+  CHECK_EQUAL(0, archive.numPlies(0));
+
+  // A move that is malformed is not played.
+  data[entry + 8] = 10;
+  data[8] = '\x0F';
+  CHECK_TRUE(archive.open(data.c_str(), data.size()));
+  Controller controller;
+  unsigned int plies;
+  CHECK_FALSE(archive.replay(0, 10, controller, plies));
+  CHECK_EQUAL(0, plies);
+}
@@ -9,6 +9,8 @@
 
 #include <CppUTest/TestHarness.h>
 
+#include <cstdint>
+#include <cstring>
 #include <sstream>
 #include <string>
 
@@ -399,6 +401,86 @@ TEST(GNDecoderTest, decode_move_valid) {
   CHECK_TRUE(GNDecoder::decodeMove("PZ*0-0-0", controller));
 }
 
+TEST(GNDecoderTest, decode_move_slice) {
+  // Only the given length of the move is decoded.
+  const std::string movetext("PZ*0-8-0 PZ*0-0-0");
+  Controller controller;
+  CHECK_TRUE(GNDecoder::decodeMove(movetext.c_str(), 8, controller));
+  CHECK_TRUE(GNDecoder::decodeMove(movetext.c_str() + 9, 8, controller));
+  CHECK_TRUE(GNDecoder::decodeMove(movetext.c_str(), 0, controller));
+  CHECK_TRUE(controller.isPlayersTurn(BLACK));
+}
+
+TEST(GNDecoderTest, parse_move_kinds) {
+  typedef struct entry_t {
+    const char  *move;
+    uint8_t      type;
+  } entry_t;
+
+  const entry_t moves[] = {
+    { "PZ<1-2-0>3-4-1", GNDecoder::TOKEN_MOVE },
+    { "PZ*1-2-0", GNDecoder::TOKEN_DROP },
+    { "PZ<1-2-0x3-4-1", GNDecoder::TOKEN_MOBILE_STRIKE },
+    { "PZ<1-2-0x1", GNDecoder::TOKEN_IMMOBILE_STRIKE },
+    { "PZ+1-2-0", GNDecoder::TOKEN_RECOVER },
+    { "PZ^1-2-0", GNDecoder::TOKEN_RECOVER_TO_OPPONENT },
+    { "PZ=1-2-0", GNDecoder::TOKEN_NO_RECOVER },
+    { "PZ<1-2-0&3-4-1", GNDecoder::TOKEN_SUBSTITUTION },
+    { "PZ<1-2-0&2", GNDecoder::TOKEN_TIER_EXCHANGE }
+  };
+
+  for (const entry_t& entry : moves) {
+    GNDecoder::token_t token;
+    const std::string move(entry.move);
+    CHECK_TRUE(GNDecoder::parseMove(move.c_str(), move.size(), token));
+    CHECK_EQUAL(entry.type, token.type);
+    CHECK_EQUAL('P', token.front);
+    CHECK_EQUAL('Z', token.back);
+    CHECK_EQUAL(1, token.col);
+    CHECK_EQUAL(2, token.row);
+    CHECK_EQUAL(0, token.tier);
+  }
+
+  GNDecoder::token_t token;
+  CHECK_TRUE(GNDecoder::parseMove("O-<8-7-2x6-5-1", 14, token));
+  CHECK_EQUAL('O', token.front);
+  CHECK_EQUAL('-', token.back);
+  CHECK_EQUAL(8, token.col);
+  CHECK_EQUAL(7, token.row);
+  CHECK_EQUAL(2, token.tier);
+  CHECK_EQUAL(6, token.toCol);
+  CHECK_EQUAL(5, token.toRow);
+  CHECK_EQUAL(1, token.toTier);
+
+  CHECK_TRUE(GNDecoder::parseMove("PZ<1-2-0&2", 10, token));
+  CHECK_EQUAL(2, token.toTier);
+}
+
+TEST(GNDecoderTest, parse_move_malformed) {
+  const char *moves[] = {
+    "",
+    "PZ*0-8",
+    "PZ*0-8-0-",
+    "PZ*10-8-0",
+    "PZ*0_8-0",
+    "PZ*a-8-0",
+    "PZ>0-8-0",
+    "PZ<0-8-0",
+    "PZ<0-8-0x",
+    "PZ<0-8-0>1",
+    "PZ*0-8-0>1-2-0",
+    "PZ<0-8-0*1-2-0",
+    "PZ<0-8-0x1-2",
+    "PZ<0-8-0&1-2-",
+    "dafadill"
+  };
+
+  for (const char *move : moves) {
+    GNDecoder::token_t token;
+    CHECK_FALSE(GNDecoder::parseMove(move, std::strlen(move), token));
+  }
+}
+
 TEST(GNDecoderTest, decode_invalid_missing_move_indicator) {
   std::ostringstream oss;
   oss
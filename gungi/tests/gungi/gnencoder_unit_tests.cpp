@@ -0,0 +1,340 @@
+// gnencoder_unit_tests.cpp                                           -*-C++-*-
+#include "gnencoder.hpp"
+
+#include "gndecoder.hpp"
+#include "gnreader.hpp"
+#include "gtypes.hpp"
+#include "logician.hpp"
+#include "move.hpp"
+
+#include <CppUTest/TestHarness.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace gungi;
+
+class GNEncoderFixture {
+  // Fixture for testing the Gungi Notation encoder.
+
+public:
+  // STATIC CLASS MEMBERS
+  static std::vector<Move> playout(uint32_t seed, unsigned int plies) {
+    // Returns up to the given number of 'plies' of random moves chosen by the
+    // given 'seed', played from the start of a game.
+    std::vector<Move> played;
+    Logician game;
+    error_t error;
+    for (unsigned int ply = 0; ply < plies; ply++) {
+      MoveList moves;
+      game.generateMoves(moves);
+      if (moves.empty() || game.isOver()) {
+        break;
+      }
+
+      seed = seed * 1103515245 + 12345;
+      const Move& move = moves[(seed >> 16) % moves.size()];
+      game.playMove(move, error);
+      GASSERT(error == GUNGI_ERROR_NONE);
+      played.push_back(move);
+    }
+    return played;
+  }
+
+  static GNMetadata metadata(void) {
+    // Returns the metadata of a game.
+    GNMetadata md;
+    md.setEvent("Selection");
+    md.setDate("2013.10.30");
+    md.setLocation("NGL, Mitene Union");
+    md.setWhite("Komugi");
+    md.setBlack("Meruem");
+    return md;
+  }
+};
+
+TEST_GROUP(GNEncoderTest) {
+  void setup(void) {
+    return;
+  }
+
+  void teardown(void) {
+    return;
+  }
+};
+
+TEST(GNEncoderTest, encode_move_matches_parse_move) {
+  const char *moves[] = {
+    "PZ<1-2-0>3-4-1",
+    "PZ*1-2-0",
+    "O-<8-7-2x6-5-1",
+    "PZ<1-2-0x1",
+    "PZ+1-2-0",
+    "PZ^1-2-0",
+    "PZ=1-2-0",
+    "PZ<1-2-0&3-4-1",
+    "PZ<1-2-0&2"
+  };
+
+  for (const char *move : moves) {
+    const std::string expected(move);
+    GNDecoder::token_t token;
+    CHECK_TRUE(GNDecoder::parseMove(expected.c_str(),
+                                    expected.size(),
+                                    token));
+
+    char text[GNEncoder::k_MAX_MOVE_LENGTH];
+    const size_t length = GNEncoder::encodeMove(token, text);
+    CHECK_EQUAL(expected.size(), length);
+    CHECK_TRUE(expected == std::string(text, length));
+  }
+}
+
+TEST(GNEncoderTest, encode_move_malformed) {
+  GNDecoder::token_t token;
+  CHECK_TRUE(GNDecoder::parseMove("PZ*1-2-0", 8, token));
+
+  char text[GNEncoder::k_MAX_MOVE_LENGTH];
+  token.type = GNDecoder::TOKEN_NONE;
+  CHECK_EQUAL(0, GNEncoder::encodeMove(token, text));
+
+  token.type = GNDecoder::TOKEN_DROP;
+  token.col = 10;
+  CHECK_EQUAL(0, GNEncoder::encodeMove(token, text));
+
+  // A malformed move is not written.
+  char buffer[64];
+  GNEncoder encoder(buffer, sizeof(buffer));
+  CHECK_FALSE(encoder.writeMove(token, BLACK));
+  CHECK_EQUAL(0, encoder.size());
+  CHECK_TRUE(encoder.good());
+}
+
+TEST(GNEncoderTest, write_header_matches_metadata) {
+  const GNMetadata md = GNEncoderFixture::metadata();
+  Controller controller;
+
+  char buffer[256];
+  GNEncoder encoder(buffer, sizeof(buffer));
+  CHECK_TRUE(encoder.writeHeader(md, controller));
+  CHECK_TRUE(std::string(buffer, encoder.size()) == md.header(controller));
+
+  // Empty tags are left out, so that the header is read back.
+  GNEncoder empty(buffer, sizeof(buffer));
+  CHECK_TRUE(empty.writeHeader(GNMetadata(), controller));
+  const std::string text(buffer, empty.size());
+  CHECK_TRUE(text == "[Result \"*\"]\n");
+
+  GNMetadata decodedMd;
+  Controller decoded;
+  CHECK_TRUE(GNDecoder::decode(text, decodedMd, decoded));
+}
+
+TEST(GNEncoderTest, write_move_numbers_pairs_of_moves) {
+  // Each move indicator is followed by up to two moves, with one period when
+  // it is black's turn and three when it is white's.
+  const char *moves[] = {
+    "PZ*0-7-0", "O-*0-2-0", "HK*0-6-0", "PZ*0-0-0", "PZ*1-6-0"
+  };
+
+  Controller controller;
+  char buffer[256];
+  GNEncoder encoder(buffer, sizeof(buffer));
+  for (const char *move : moves) {
+    GNDecoder::token_t token;
+    CHECK_TRUE(GNDecoder::parseMove(move, 8, token));
+    CHECK_TRUE(encoder.writeMove(token,
+                                 controller.isPlayersTurn(BLACK) ? BLACK
+                                                                 : WHITE));
+    CHECK_TRUE(GNDecoder::applyMove(token, controller));
+  }
+
+  // A move with no unit is not written.
+  CHECK_FALSE(encoder.writeMove(controller, Move()));
+
+  CHECK_TRUE(encoder.endGame());
+  CHECK_TRUE(std::string(buffer, encoder.size()) ==
+             "1. PZ*0-7-0 O-*0-2-0 2. HK*0-6-0 PZ*0-0-0 3. PZ*1-6-0\n");
+
+  GNEncoder white(buffer, sizeof(buffer));
+  GNDecoder::token_t token;
+  CHECK_TRUE(GNDecoder::parseMove("PZ*0-1-0", 8, token));
+  CHECK_TRUE(white.writeMove(token, WHITE));
+  CHECK_TRUE(white.writeMove(token, BLACK));
+  CHECK_TRUE(white.writeMove(token, WHITE));
+  CHECK_TRUE(std::string(buffer, white.size()) ==
+             "1... PZ*0-1-0 PZ*0-1-0 2... PZ*0-1-0");
+}
+
+TEST(GNEncoderTest, write_move_wraps_lines) {
+  GNDecoder::token_t token;
+  CHECK_TRUE(GNDecoder::parseMove("PZ<1-2-0>3-4-1", 14, token));
+
+  char buffer[1024];
+  GNEncoder encoder(buffer, sizeof(buffer));
+  for (unsigned int idx = 0; idx < 40; idx++) {
+    CHECK_TRUE(encoder.writeMove(token, idx % 2 ? WHITE : BLACK));
+  }
+
+  std::istringstream iss(std::string(buffer, encoder.size()));
+  std::string line;
+  unsigned int numLines = 0;
+  while (std::getline(iss, line)) {
+    CHECK_TRUE(line.size() <= GNEncoder::k_LINE_WIDTH);
+    CHECK_TRUE(line[0] >= '1' && line[0] <= '9');
+    numLines++;
+  }
+  CHECK_TRUE(numLines > 1);
+}
+
+TEST(GNEncoderTest, write_game_round_trips_through_decoder) {
+  const GNMetadata md = GNEncoderFixture::metadata();
+  for (uint32_t seed = 1; seed <= 8; seed++) {
+    const std::vector<Move> moves = GNEncoderFixture::playout(seed, 300);
+
+    Controller expected;
+    error_t error = GUNGI_ERROR_NONE;
+    for (const Move& move : moves) {
+      expected.playMove(move, error);
+    }
+
+    std::vector<char> buffer(64 * 1024);
+    GNEncoder encoder(&buffer[0], buffer.size());
+    CHECK_TRUE(encoder.writeGame(md, moves));
+    const std::string text(&buffer[0], encoder.size());
+    CHECK_TRUE(text.compare(0, md.header(expected).size(),
+                            md.header(expected)) == 0);
+
+    GNMetadata decodedMd;
+    Controller decoded;
+    CHECK_TRUE(GNDecoder::decode(text, decodedMd, decoded));
+    CHECK_TRUE(decoded.key() == expected.key());
+    CHECK_TRUE(decodedMd.event() == md.event());
+    CHECK_TRUE(decodedMd.black() == md.black());
+
+    GNReader reader(text.c_str(), text.size());
+    unsigned int plies = 0;
+    bool played = false;
+    reader.read([&](const GNReader::game_t& game) {
+      Controller controller;
+      played = GNReader::replay(game, controller, plies);
+      return true;
+    });
+    CHECK_TRUE(played);
+    CHECK_EQUAL(moves.size(), plies);
+  }
+}
+
+TEST(GNEncoderTest, write_game_round_trips_forced_recoveries) {
+  // This game declines a recovery, recovers a unit to its own hand, then
+  // recovers a unit to the opponent's hand after a capture.
+  const GNMetadata md = GNEncoderFixture::metadata();
+  const std::vector<Move> moves = GNEncoderFixture::playout(2, 240);
+  CHECK_EQUAL(240, moves.size());
+
+  Controller expected;
+  error_t error = GUNGI_ERROR_NONE;
+  for (const Move& move : moves) {
+    expected.playMove(move, error);
+    CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+  }
+
+  std::vector<char> buffer(64 * 1024);
+  GNEncoder encoder(&buffer[0], buffer.size());
+  CHECK_TRUE(encoder.writeGame(md, moves));
+  const std::string text(&buffer[0], encoder.size());
+  const std::string movetext = text.substr(md.header(expected).size());
+  CHECK_TRUE(movetext.find('=') != std::string::npos);
+  CHECK_TRUE(movetext.find('+') != std::string::npos);
+  CHECK_TRUE(movetext.find('^') != std::string::npos);
+
+  GNMetadata decodedMd;
+  Controller decoded;
+  CHECK_TRUE(GNDecoder::decode(text, decodedMd, decoded));
+  CHECK_TRUE(decoded.key() == expected.key());
+  CHECK_EQUAL(expected.state(), decoded.state());
+  CHECK_EQUAL(expected.black().inactiveUnits().size(),
+              decoded.black().inactiveUnits().size());
+  CHECK_EQUAL(expected.white().inactiveUnits().size(),
+              decoded.white().inactiveUnits().size());
+}
+
+TEST(GNEncoderTest, write_game_rejects_illegal_move) {
+  std::vector<Move> moves = GNEncoderFixture::playout(1, 4);
+  moves.push_back(moves.back());
+
+  char buffer[1024];
+  GNEncoder encoder(buffer, sizeof(buffer));
+  CHECK_FALSE(encoder.writeGame(GNMetadata(), moves));
+  CHECK_EQUAL(0, encoder.size());
+  CHECK_TRUE(encoder.good());
+}
+
+TEST(GNEncoderTest, write_games_are_read_one_after_another) {
+  const GNMetadata md = GNEncoderFixture::metadata();
+  std::vector<char> buffer(64 * 1024);
+  GNEncoder encoder(&buffer[0], buffer.size());
+  for (uint32_t seed = 1; seed <= 3; seed++) {
+    CHECK_TRUE(encoder.writeGame(md, GNEncoderFixture::playout(seed, 20)));
+  }
+
+  GNReader reader(&buffer[0], encoder.size());
+  unsigned int numPlayed = 0;
+  CHECK_EQUAL(3, reader.read([&](const GNReader::game_t& game) {
+    Controller controller;
+    unsigned int plies;
+    numPlayed += game.valid && GNReader::replay(game, controller, plies);
+    return true;
+  }));
+  CHECK_EQUAL(3, numPlayed);
+}
+
+TEST(GNEncoderTest, write_fails_when_buffer_is_full) {
+  const GNMetadata md = GNEncoderFixture::metadata();
+  char buffer[64];
+  GNEncoder encoder(buffer, sizeof(buffer));
+  CHECK_FALSE(encoder.writeHeader(md, Controller()));
+  CHECK_FALSE(encoder.good());
+  CHECK_TRUE(encoder.size() <= sizeof(buffer));
+
+  // Nothing is written once a write has failed.
+  const size_t size = encoder.size();
+  CHECK_FALSE(encoder.endGame());
+  CHECK_EQUAL(size, encoder.size());
+}
+
+TEST(GNEncoderTest, write_to_file_descriptor) {
+  const GNMetadata md = GNEncoderFixture::metadata();
+  const std::vector<Move> moves = GNEncoderFixture::playout(2, 100);
+
+  std::vector<char> buffer(64 * 1024);
+  GNEncoder expected(&buffer[0], buffer.size());
+  CHECK_TRUE(expected.writeGame(md, moves));
+  CHECK_TRUE(expected.writeGame(md, moves));
+
+  const std::string path("gnencoder_unit_tests.gn");
+  const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  CHECK_TRUE(fd >= 0);
+  {
+    GNEncoder encoder(fd);
+    CHECK_TRUE(encoder.writeGame(md, moves));
+    CHECK_TRUE(encoder.writeGame(md, moves));
+    CHECK_EQUAL(expected.size(), encoder.size());
+
+    // The text written is flushed as the encoder is destroyed.
+  }
+  ::close(fd);
+
+  std::ifstream ifs(path.c_str());
+  std::ostringstream oss;
+  oss << ifs.rdbuf();
+  std::remove(path.c_str());
+  CHECK_TRUE(oss.str() == std::string(&buffer[0], expected.size()));
+}
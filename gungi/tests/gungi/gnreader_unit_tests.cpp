@@ -0,0 +1,275 @@
+// gnreader_unit_tests.cpp                                            -*-C++-*-
+#include "gnreader.hpp"
+
+#include "gndecoder.hpp"
+#include "gtypes.hpp"
+#include "logician.hpp"
+
+#include <CppUTest/TestHarness.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace gungi;
+
+class GNReaderFixture {
+  // Fixture for testing the Gungi Notation reader.
+
+public:
+  // STRUCTURES
+  typedef struct game_t {
+    // Copy of a game handed to the callback of a reader.
+    GNMetadata   metadata;
+    std::string  text;
+    std::string  movetext;
+    size_t       offset;
+    bool         valid;
+  } game_t;
+
+  // STATIC CLASS MEMBERS
+  static std::string corpus(void) {
+    // Returns three games, one after another, with comments between them.
+    std::ostringstream oss;
+    oss
+      << "# The archive starts with a comment."
+      << std::endl
+      << "[Event \"Selection\"]"
+      << std::endl
+      << "[Date \"2013.10.30\"]"
+      << std::endl
+      << "[White \"Komugi\"]"
+      << std::endl
+      << "[Black \"Meruem\"]"
+      << std::endl
+      << "[Result \"*\"]"
+      << std::endl
+      << "1. PZ*0-8-0 PZ*0-0-0 (an inline comment"
+      << std::endl
+      << "[that is not a header]) 2. PZ*8-8-0"
+      << std::endl
+      << "# [Neither is this]"
+      << std::endl
+      << std::endl
+      << "[event \"Rematch\"] (the name is in any case)"
+      << std::endl
+      << "[Location \"NGL, Mitene Union\"]"
+      << std::endl
+      << "1. PZ*0-8-0"
+      << std::endl
+      << "[Black \"Meruem\"]"
+      << std::endl
+      << "[Result \"*\"]"
+      << std::endl;
+    return oss.str();
+  }
+
+  static std::vector<game_t> read(const GNReader& reader) {
+    // Returns a copy of every game read by the given 'reader'.
+    std::vector<game_t> games;
+    reader.read([&games](const GNReader::game_t& game) {
+      game_t copy;
+      copy.metadata = game.metadata;
+      copy.text.assign(game.text.data, game.text.length);
+      copy.movetext.assign(game.movetext.data, game.movetext.length);
+      copy.offset = game.offset;
+      copy.valid = game.valid;
+      games.push_back(copy);
+      return true;
+    });
+    return games;
+  }
+};
+
+TEST_GROUP(GNReaderTest) {
+  void setup(void) {
+    return;
+  }
+
+  void teardown(void) {
+    return;
+  }
+};
+
+TEST(GNReaderTest, read_empty_has_no_games) {
+  GNReader reader;
+  CHECK_EQUAL(0, reader.size());
+  CHECK_EQUAL(0, GNReaderFixture::read(reader).size());
+
+  // Whitespace alone has no games, but a comment is a game with no moves, as
+  // it is to the decoder.
+  const std::string space(" \n\t");
+  GNReader blank(space.c_str(), space.size());
+  CHECK_EQUAL(0, GNReaderFixture::read(blank).size());
+
+  const std::string text(" \n# Only a comment.\n");
+  GNReader comment(text.c_str(), text.size());
+  CHECK_EQUAL(text.size(), comment.size());
+  CHECK_EQUAL(1, GNReaderFixture::read(comment).size());
+}
+
+TEST(GNReaderTest, read_splits_games_at_headers) {
+  const std::string text(GNReaderFixture::corpus());
+  GNReader reader(text.c_str(), text.size());
+  const std::vector<GNReaderFixture::game_t> games =
+    GNReaderFixture::read(reader);
+  CHECK_EQUAL(3, games.size());
+
+  for (const GNReaderFixture::game_t& game : games) {
+    CHECK_TRUE(game.valid);
+    CHECK_TRUE(text.compare(game.offset, game.text.size(), game.text) == 0);
+  }
+
+  CHECK_EQUAL(0, games[0].offset);
+  CHECK_TRUE(games[0].metadata.event() == "Selection");
+  CHECK_TRUE(games[0].metadata.date() == "2013.10.30");
+  CHECK_TRUE(games[0].metadata.location() == "");
+  CHECK_TRUE(games[0].metadata.white() == "Komugi");
+  CHECK_TRUE(games[0].metadata.black() == "Meruem");
+  CHECK_TRUE(games[0].movetext ==
+             "1. PZ*0-8-0 PZ*0-0-0 (an inline comment\n"
+             "[that is not a header]) 2. PZ*8-8-0\n"
+             "# [Neither is this]");
+
+  // The metadata of a game does not carry over to the next.
+  CHECK_EQUAL(text.find("[event"), games[1].offset);
+  CHECK_TRUE(games[1].metadata.event() == "Rematch");
+  CHECK_TRUE(games[1].metadata.date() == "");
+  CHECK_TRUE(games[1].metadata.location() == "NGL, Mitene Union");
+  CHECK_TRUE(games[1].metadata.white() == "");
+  CHECK_TRUE(games[1].metadata.black() == "");
+  CHECK_TRUE(games[1].movetext == "1. PZ*0-8-0");
+
+  // A header with no movetext is a game with no moves.
+  CHECK_EQUAL(text.find("[Black", games[1].offset), games[2].offset);
+  CHECK_TRUE(games[2].metadata.black() == "Meruem");
+  CHECK_TRUE(games[2].movetext.empty());
+  CHECK_TRUE(games[2].text == "[Black \"Meruem\"]\n[Result \"*\"]");
+}
+
+TEST(GNReaderTest, read_stops_when_callback_returns_false) {
+  const std::string text(GNReaderFixture::corpus());
+  GNReader reader(text.c_str(), text.size());
+
+  unsigned int calls = 0;
+  CHECK_EQUAL(2, reader.read([&calls](const GNReader::game_t&) {
+    return ++calls < 2;
+  }));
+  CHECK_EQUAL(2, calls);
+}
+
+TEST(GNReaderTest, read_malformed_header_skips_to_next_game) {
+  std::ostringstream oss;
+  oss
+    << "[Event \"Selection\"]"
+    << std::endl
+    << "[Date \"2013.10.32\"]"
+    << std::endl
+    << "[White \"Komugi\"]"
+    << std::endl
+    << "1. PZ*0-8-0"
+    << std::endl
+    << "[Event \"Rematch\"]"
+    << std::endl
+    << "[Locatio \"NGL, Mitene Union\"] (this comment doesn't end"
+    << std::endl
+    << "[Event \"Unread\"]"
+    << std::endl;
+
+  const std::string text(oss.str());
+  GNReader reader(text.c_str(), text.size());
+  const std::vector<GNReaderFixture::game_t> games =
+    GNReaderFixture::read(reader);
+  CHECK_EQUAL(2, games.size());
+
+  // The tags after the malformed one belong to the same game.
+  CHECK_FALSE(games[0].valid);
+  CHECK_TRUE(games[0].movetext == "1. PZ*0-8-0");
+  CHECK_FALSE(games[1].valid);
+  CHECK_TRUE(games[1].metadata.event() == "Rematch");
+  CHECK_TRUE(games[1].movetext.empty());
+}
+
+TEST(GNReaderTest, replay_matches_decoder) {
+  std::ostringstream oss;
+  oss
+    << "1. PZ*0-7-0 O-*0-2-0 2. HK*0-6-0 (a comment) PZ*0-0-0"
+    << std::endl
+    << "# A comment between moves."
+    << std::endl
+    << "3. PZ*1-6-0 PZ*1-0-0 4. PZ*2-6-0";
+
+  const std::string text(oss.str());
+  GNMetadata md;
+  Controller expected;
+  CHECK_TRUE(GNDecoder::decode(text, md, expected));
+
+  GNReader reader(text.c_str(), text.size());
+  Controller controller;
+  unsigned int plies = 0;
+  bool played = false;
+  CHECK_EQUAL(1, reader.read([&](const GNReader::game_t& game) {
+    played = GNReader::replay(game, controller, plies);
+    return true;
+  }));
+
+  CHECK_TRUE(played);
+  CHECK_EQUAL(7, plies);
+  CHECK_TRUE(controller.key() == expected.key());
+  CHECK_TRUE(controller.isPlayersTurn(WHITE));
+}
+
+TEST(GNReaderTest, replay_stops_at_illegal_move) {
+  const std::string moves[] = {
+    // The second move is illegal, as it is not in white's territory.
+    "1. PZ*0-7-0 PZ*0-8-0",
+    // Wrong move indicator.
+    "1. PZ*0-7-0 O-*0-2-0 3. HK*0-6-0",
+    // Three periods on black's turn.
+    "1... PZ*0-7-0",
+    // No move after the move indicator.
+    "1. PZ*0-7-0 O-*0-2-0 2."
+  };
+  const unsigned int expected[] = { 1, 2, 0, 2 };
+
+  for (unsigned int idx = 0; idx < 4; idx++) {
+    GNReader reader(moves[idx].c_str(), moves[idx].size());
+    Controller controller;
+    unsigned int plies = 0;
+    bool played = true;
+    reader.read([&](const GNReader::game_t& game) {
+      played = GNReader::replay(game, controller, plies);
+      return true;
+    });
+
+    CHECK_FALSE(played);
+    CHECK_EQUAL(expected[idx], plies);
+  }
+}
+
+TEST(GNReaderTest, open_maps_file) {
+  const std::string path("gnreader_unit_tests.gn");
+  const std::string text(GNReaderFixture::corpus());
+  {
+    std::ofstream ofs(path.c_str());
+    ofs << text;
+  }
+
+  GNReader reader;
+  CHECK_TRUE(reader.open(path));
+  CHECK_EQUAL(text.size(), reader.size());
+
+  const std::vector<GNReaderFixture::game_t> games =
+    GNReaderFixture::read(reader);
+  CHECK_EQUAL(3, games.size());
+  CHECK_TRUE(games[1].metadata.event() == "Rematch");
+
+  reader.close();
+  CHECK_EQUAL(0, reader.size());
+  std::remove(path.c_str());
+
+  CHECK_FALSE(reader.open(path));
+  CHECK_EQUAL(0, GNReaderFixture::read(reader).size());
+}
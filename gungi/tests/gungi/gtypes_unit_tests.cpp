@@ -68,3 +68,28 @@ TEST(GtypesTest, gn_identifier_to_piece) {
   CHECK_EQUAL(GUNGI_PIECE_PAWN, gn_identifier_to_piece("P"));
   CHECK_EQUAL(GUNGI_PIECE_NONE, gn_identifier_to_piece("M"));
 }
+
+TEST(GtypesTest, movesets_tile_the_move_tables) {
+  // Every tier of every moveset follows on from the last, and each path
+  // follows on from the last, so the spans cover each table exactly.
+  unsigned int path = 0;
+  unsigned int step = 0;
+
+  for (int piece = 0; piece < GUNGI_NUM_PIECES; piece++) {
+    for (unsigned int tier = 0; tier < k_MAX_TOWER_SIZE; tier++) {
+      const move_span_t& paths = k_UNIT_MOVES[piece][tier];
+      CHECK_EQUAL(path, paths.first);
+
+      for (unsigned int i = 0; i < paths.count; i++) {
+        const move_span_t& steps = k_MOVE_PATHS[path++];
+        CHECK_EQUAL(step, steps.first);
+        CHECK_TRUE(steps.count > 0);
+        CHECK_TRUE(steps.count <= k_MAX_PATH_STEPS);
+        step += steps.count;
+      }
+    }
+  }
+
+  CHECK_EQUAL(k_NUM_MOVE_PATHS, path);
+  CHECK_EQUAL(k_NUM_MOVE_STEPS, step);
+}
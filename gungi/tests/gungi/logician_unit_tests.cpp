@@ -2,6 +2,7 @@
 #include "logician.hpp"
 
 #include "builder.hpp"
+#include "gndecoder.hpp"
 #include "gtypes.hpp"
 #include "player.hpp"
 #include "tower.hpp"
@@ -10,7 +11,9 @@
 
 #include <CppUTest/TestHarness.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <string>
 #include <vector>
 
 using namespace gungi;
@@ -20,11 +23,11 @@ class LogicianFixture {
 
 public:
   // STATIC CLASS MEMBERS
-  static unsigned int hasFront(const SharedUnitPtrVector& units,
-                               piece_id_t                 front) {
+  static unsigned int hasFront(const UnitPtrVector& units,
+                               piece_id_t           front) {
     unsigned int count = 0;
 
-    for (const SharedUnitPtr& unit : units) {
+    for (const Unit *unit : units) {
       if (unit->front() == front) {
         count++;
       }
@@ -33,11 +36,11 @@ public:
     return count;
   }
 
-  static unsigned int hasBack(const SharedUnitPtrVector& units,
-                              piece_id_t                 back) {
+  static unsigned int hasBack(const UnitPtrVector& units,
+                              piece_id_t           back) {
     unsigned int count = 0;
 
-    for (const SharedUnitPtr& unit : units) {
+    for (const Unit *unit : units) {
       if (unit->back() == back) {
         count++;
       }
@@ -46,12 +49,12 @@ public:
     return count;
   }
 
-  static unsigned int hasFrontAndBack(const SharedUnitPtrVector& units,
-                                      piece_id_t                 front,
-                                      piece_id_t                 back) {
+  static unsigned int hasFrontAndBack(const UnitPtrVector& units,
+                                      piece_id_t           front,
+                                      piece_id_t           back) {
     unsigned int count = 0;
 
-    for (const SharedUnitPtr& unit : units) {
+    for (const Unit *unit : units) {
       if (unit->front() == front && unit->back() == back) {
         count++;
       }
@@ -59,6 +62,83 @@ public:
 
     return count;
   }
+
+  static uint32_t encode(const Move& move) {
+    return (static_cast<uint32_t>(move.type()) << 24) |
+           (static_cast<uint32_t>(move.unit()) << 16) |
+           (static_cast<uint32_t>(move.target()) << 8) |
+           move.square();
+  }
+
+  static std::vector<uint32_t> generated(const Logician& logician) {
+    MoveList moves;
+    logician.generateMoves(moves);
+
+    std::vector<uint32_t> codes;
+    for (const Move& move : moves) {
+      codes.push_back(encode(move));
+    }
+    std::sort(codes.begin(), codes.end());
+    return codes;
+  }
+
+  static std::vector<uint32_t> playable(const Logician& logician) {
+    // Returns every move that can be played in the given 'logician', found
+    // by trying each candidate on a copy of the game.
+    std::vector<Move> candidates;
+    if (logician.isForcedRecovery()) {
+      const unit_handle_t handle =
+                               logician.handle(*logician.forcedRecoveryUnit());
+      candidates.push_back(Move::forcedRecovery(handle, true));
+      candidates.push_back(Move::forcedRecovery(handle, false));
+    }
+
+    const Player& player = logician.isPlayersTurn(BLACK) ? logician.black()
+                                                         : logician.white();
+    for (const Unit *unit : player.units()) {
+      const unit_handle_t handle = logician.handle(*unit);
+      const unsigned int kind = Player::handKind(unit->front(), unit->back());
+      if (!unit->tower() && unit != player.handUnit(kind)) {
+        // Units in hand of the same kind are dropped as one.
+        continue;
+      }
+
+      for (unsigned int idx = 0; idx < Bitboard::k_NUM_SQUARES; idx++) {
+        const Posn posn(idx % k_BOARD_LENGTH, idx / k_BOARD_LENGTH);
+        candidates.push_back(unit->tower() ? Move::move(handle, posn)
+                                           : Move::drop(handle, posn));
+      }
+
+      if (!unit->tower()) {
+        continue;
+      }
+
+      for (const Player *owner : { &logician.black(), &logician.white() }) {
+        for (const Unit *other : owner->units()) {
+          const unit_handle_t target = logician.handle(*other);
+          candidates.push_back(Move::immobileStrike(handle, target));
+          candidates.push_back(Move::exchange(GUNGI_EFFECT_1_3_TIER_EXCHANGE,
+                                              handle,
+                                              target));
+          candidates.push_back(Move::exchange(GUNGI_EFFECT_SUBSTITUTION,
+                                              handle,
+                                              target));
+        }
+      }
+    }
+
+    std::vector<uint32_t> codes;
+    for (const Move& move : candidates) {
+      Logician fork(logician);
+      error_t error;
+      fork.playMove(move, error);
+      if (error == GUNGI_ERROR_NONE) {
+        codes.push_back(encode(move));
+      }
+    }
+    std::sort(codes.begin(), codes.end());
+    return codes;
+  }
 };
 
 TEST_GROUP(LogicianTest) {
@@ -107,7 +187,7 @@ TEST(LogicianTest, black_returns_black_player) {
 TEST(LogicianTest, black_initial_hand) {
   Logician logician;
 
-  const SharedUnitPtrVector& units = logician.black().units();
+  const UnitPtrVector& units = logician.black().units();
   CHECK_EQUAL(k_START_PIECE_COUNT, units.size());
 
   CHECK_EQUAL(9, LogicianFixture::hasFront(units, GUNGI_PIECE_PAWN));
@@ -152,7 +232,7 @@ TEST(LogicianTest, white_returns_white_player) {
 TEST(LogicianTest, white_initial_hand) {
   Logician logician;
 
-  const SharedUnitPtrVector& units = logician.white().units();
+  const UnitPtrVector& units = logician.white().units();
   CHECK_EQUAL(k_START_PIECE_COUNT, units.size());
 
   CHECK_EQUAL(9, LogicianFixture::hasFront(units, GUNGI_PIECE_PAWN));
@@ -624,3 +704,881 @@ TEST(LogicianTest, mobile_range_expansion_2) {
     }
   }
 }
+
+TEST(LogicianTest, bitboards_track_drops) {
+  Logician logician;
+  error_t error;
+
+  CHECK_TRUE(logician.occupied().none());
+
+  logician.dropUnit(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, Posn(0, 8), error);
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+
+  logician.dropUnit(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, Posn(0, 0), error);
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+
+  logician.dropUnit(GUNGI_PIECE_CAPTAIN, GUNGI_PIECE_PISTOL, Posn(0, 8), error);
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+
+  CHECK_EQUAL(2, logician.occupied().count());
+  CHECK_TRUE(logician.occupied(BLACK, 0).test(Posn(0, 8)));
+  CHECK_TRUE(logician.occupied(BLACK, 1).test(Posn(0, 8)));
+  CHECK_FALSE(logician.occupied(BLACK, 2).test(Posn(0, 8)));
+  CHECK_TRUE(logician.occupied(WHITE, 0).test(Posn(0, 0)));
+  CHECK_FALSE(logician.occupied(WHITE).test(Posn(0, 8)));
+
+  CHECK_TRUE(logician.pieces(BLACK, GUNGI_PIECE_PAWN).test(Posn(0, 8)));
+  CHECK_TRUE(logician.pieces(BLACK, GUNGI_PIECE_CAPTAIN).test(Posn(0, 8)));
+  CHECK_TRUE(logician.pieces(WHITE, GUNGI_PIECE_PAWN).test(Posn(0, 0)));
+  CHECK_FALSE(logician.pieces(WHITE, GUNGI_PIECE_CAPTAIN).any());
+
+  CHECK_TRUE(logician.topped(BLACK).test(Posn(0, 8)));
+  CHECK_TRUE(logician.topped(WHITE).test(Posn(0, 0)));
+  CHECK_TRUE(logician.full().none());
+}
+
+TEST(LogicianTest, bitboards_track_full_towers) {
+  Logician logician;
+  error_t error;
+
+  logician.dropUnit(GUNGI_PIECE_CAPTAIN, GUNGI_PIECE_PISTOL, Posn(0, 8), error);
+  logician.dropUnit(GUNGI_PIECE_CAPTAIN, GUNGI_PIECE_PISTOL, Posn(0, 0), error);
+  logician.dropUnit(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, Posn(0, 8), error);
+  logician.dropUnit(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, Posn(0, 0), error);
+  logician.dropUnit(GUNGI_PIECE_PRODIGY, GUNGI_PIECE_PHOENIX, Posn(0, 8), error);
+  logician.dropUnit(GUNGI_PIECE_PRODIGY, GUNGI_PIECE_PHOENIX, Posn(0, 0), error);
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+
+  CHECK_EQUAL(2, logician.full().count());
+  CHECK_TRUE(logician.full().test(Posn(0, 8)));
+  CHECK_TRUE(logician.full().test(Posn(0, 0)));
+
+  logician.newGame();
+
+  CHECK_TRUE(logician.occupied().none());
+  CHECK_TRUE(logician.full().none());
+}
+
+TEST(LogicianTest, copy_constructor_forks_game) {
+  Logician logician;
+  error_t error;
+
+  logician.dropUnit(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, Posn(0, 8), error);
+  logician.dropUnit(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, Posn(0, 0), error);
+
+  Logician copy(logician);
+
+  CHECK_TRUE(copy.occupied() == logician.occupied());
+  CHECK_TRUE(copy.isPlayersTurn(BLACK));
+  CHECK_EQUAL(logician.black().units().size(), copy.black().units().size());
+  CHECK_EQUAL(logician.white().units().size(), copy.white().units().size());
+
+  // The copy refers only to its own units and towers.
+  error_t tempError;
+  const Tower& tower = copy.board()[Posn(0, 8).index()];
+  const Unit *unit = copy.unit(tower.at(0, tempError));
+  CHECK_EQUAL(GUNGI_ERROR_NONE, tempError);
+  POINTERS_EQUAL(&tower, unit->tower());
+  const Tower& original = logician.board()[Posn(0, 8).index()];
+  CHECK_FALSE(unit == logician.unit(original.at(0, tempError)));
+  CHECK_TRUE(Util::find(copy.black().units(), unit) !=
+             copy.black().units().end());
+
+  copy.dropUnit(GUNGI_PIECE_CAPTAIN, GUNGI_PIECE_PISTOL, Posn(1, 8), error);
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+
+  CHECK_EQUAL(3, copy.occupied().count());
+  CHECK_EQUAL(2, logician.occupied().count());
+  CHECK_TRUE(copy.isPlayersTurn(WHITE));
+  CHECK_TRUE(logician.isPlayersTurn(BLACK));
+  CHECK_EQUAL(0, logician.board()[Posn(1, 8).index()].height());
+}
+
+TEST(LogicianTest, assignment_restores_game) {
+  Logician logician;
+  error_t error;
+
+  logician.dropUnit(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, Posn(0, 8), error);
+  logician.dropUnit(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, Posn(0, 0), error);
+
+  const Logician saved(logician);
+
+  logician.dropUnit(GUNGI_PIECE_CAPTAIN, GUNGI_PIECE_PISTOL, Posn(0, 8), error);
+  logician.dropUnit(GUNGI_PIECE_CAPTAIN, GUNGI_PIECE_PISTOL, Posn(0, 0), error);
+
+  CHECK_EQUAL(2, logician.board()[Posn(0, 8).index()].height());
+
+  logician = saved;
+
+  CHECK_TRUE(logician.occupied() == saved.occupied());
+  CHECK_TRUE(logician.isPlayersTurn(BLACK));
+  CHECK_EQUAL(1, logician.board()[Posn(0, 8).index()].height());
+  CHECK_TRUE(logician.pieces(BLACK, GUNGI_PIECE_CAPTAIN).none());
+
+  logician.dropUnit(GUNGI_PIECE_CAPTAIN, GUNGI_PIECE_PISTOL, Posn(0, 8), error);
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+
+  const Tower& tower = logician.board()[Posn(0, 8).index()];
+  error_t tempError;
+  for (tier_t tier = 0; tier < tower.height(); tier++) {
+    POINTERS_EQUAL(&tower, logician.unit(tower.at(tier, tempError))->tower());
+  }
+  CHECK_EQUAL(1, saved.board()[Posn(0, 8).index()].height());
+}
+
+TEST(LogicianTest, board_recorder_counts_repetitions) {
+  BoardRecorder recorder;
+
+  CHECK_EQUAL(0, recorder.repetitions(42));
+  CHECK_EQUAL(0, recorder.record(42));
+  CHECK_EQUAL(1, recorder << 42);
+  CHECK_EQUAL(2, recorder.repetitions(42));
+  CHECK_EQUAL(0, recorder.repetitions(43));
+
+  CHECK_EQUAL(2, recorder.count());
+
+  recorder << 43;
+  recorder.truncate(1);
+
+  CHECK_EQUAL(1, recorder.repetitions(42));
+  CHECK_EQUAL(0, recorder.repetitions(43));
+  CHECK_EQUAL(1, recorder.count());
+
+  recorder.reset();
+
+  CHECK_EQUAL(0, recorder.repetitions(42));
+  CHECK_EQUAL(0, recorder.count());
+}
+
+TEST(LogicianTest, key_identifies_position_not_move_order) {
+  Logician a;
+  Logician b;
+  error_t error;
+
+  CHECK_TRUE(a.key() == b.key());
+
+  const uint64_t initial = a.key();
+
+  a.dropUnit(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, Posn(0, 8), error);
+  a.dropUnit(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, Posn(0, 0), error);
+
+  CHECK_TRUE(a.key() != initial);
+
+  a.dropUnit(GUNGI_PIECE_CAPTAIN, GUNGI_PIECE_PISTOL, Posn(1, 8), error);
+
+  const uint64_t whiteToMove = a.key();
+
+  a.dropUnit(GUNGI_PIECE_CAPTAIN, GUNGI_PIECE_PISTOL, Posn(1, 0), error);
+
+  CHECK_TRUE(a.key() != whiteToMove);
+
+  b.dropUnit(GUNGI_PIECE_CAPTAIN, GUNGI_PIECE_PISTOL, Posn(1, 8), error);
+  b.dropUnit(GUNGI_PIECE_CAPTAIN, GUNGI_PIECE_PISTOL, Posn(1, 0), error);
+  b.dropUnit(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, Posn(0, 8), error);
+  b.dropUnit(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, Posn(0, 0), error);
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+
+  CHECK_TRUE(a.key() == b.key());
+
+  Logician copy(b);
+
+  CHECK_TRUE(copy.key() == b.key());
+}
+
+TEST(LogicianTest, generate_moves_collapses_identical_drops) {
+  Logician logician;
+  MoveList moves;
+  logician.generateMoves(moves);
+
+  // Every unit starts in hand, so the initial arrangement lists one drop of
+  // each kind of unit onto each square of black's territory.
+  unsigned int kinds = 0;
+  const UnitPtrVector& units = logician.black().units();
+  for (unsigned int i = 0; i < units.size(); i++) {
+    bool duplicate = false;
+    for (unsigned int j = 0; j < i; j++) {
+      duplicate = duplicate || (units[i]->front() == units[j]->front() &&
+                                units[i]->back() == units[j]->back());
+    }
+    kinds += duplicate ? 0 : 1;
+  }
+
+  CHECK_EQUAL(kinds * 3 * k_BOARD_LENGTH, moves.size());
+  for (const Move& move : moves) {
+    CHECK_EQUAL(Move::MOVE_TYPE_DROP, move.type());
+    CHECK_TRUE(logician.isInTerritory(move.to(), BLACK));
+  }
+}
+
+TEST(LogicianTest, generate_moves_matches_playable_moves) {
+  Logician logician;
+  error_t error;
+  uint32_t seed = 12345;
+
+  for (unsigned int ply = 0; ply < 160; ply++) {
+    const std::vector<uint32_t> codes = LogicianFixture::generated(logician);
+    if (ply % 8 == 0 || !logician.isInitialArrangement()) {
+      CHECK_TRUE(codes == LogicianFixture::playable(logician));
+    }
+
+    if (logician.isForcedRecovery()) {
+      // The only choice is whether to recover the unit.
+      CHECK_EQUAL(2, codes.size());
+    }
+
+    MoveList moves;
+    logician.generateMoves(moves);
+    if (moves.empty()) {
+      CHECK_TRUE(logician.isOver());
+      break;
+    }
+
+    seed = seed * 1103515245 + 12345;
+    logician.playMove(moves[(seed >> 16) % moves.size()], error);
+    CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+  }
+
+  CHECK_FALSE(logician.isInitialArrangement());
+}
+
+TEST(LogicianTest, attack_maps_match_walks) {
+  Logician logician;
+  error_t error;
+  uint32_t seed = 54321;
+
+  for (unsigned int ply = 0; ply < 240; ply++) {
+    for (const Player *player : { &logician.black(), &logician.white() }) {
+      const colour_t enemy = player->colour() == BLACK ? WHITE : BLACK;
+      Bitboard attacked;
+      for (const Unit *unit : player->units()) {
+        // A unit attacks the squares at the end of its walks whose lines cross
+        // only empty towers, or, for a unit that jumps, towers not topped by an
+        // enemy unit in the enemy's mobile range expansion.
+        Bitboard expected;
+        const Tower *tower = unit->tower();
+        for (unsigned int idx = 0;
+             tower && unit->tier() == tower->height() - 1 &&
+             idx < Bitboard::k_NUM_SQUARES;
+             idx++) {
+          const Posn target(idx % k_BOARD_LENGTH, idx / k_BOARD_LENGTH);
+          Util::getWalk(unit,
+                        unit->tier(),
+                        tower->posn(),
+                        target,
+                        error,
+                        logician.isInverted(unit->colour()));
+          if (error != GUNGI_ERROR_NONE) {
+            continue;
+          }
+
+          bool blocked = false;
+          for (const Posn& posn : Util::crossed(tower->posn(), target)) {
+            const Unit *top =
+              logician.unit(logician.board()[posn.index()].top());
+            blocked = blocked ||
+              (top && (!(unit->effectField() & GUNGI_EFFECT_JUMP) ||
+                       (top->colour() == enemy &&
+                        logician.isInMobileRangeExpansion(posn, enemy))));
+          }
+
+          if (!blocked) {
+            expected.set(idx);
+          }
+        }
+
+        CHECK_TRUE(expected == logician.attacks(*unit));
+        attacked |= expected;
+      }
+
+      CHECK_TRUE(attacked == logician.attacked(player->colour()));
+    }
+
+    MoveList moves;
+    logician.generateMoves(moves);
+    if (moves.empty()) {
+      break;
+    }
+
+    seed = seed * 1103515245 + 12345;
+    logician.playMove(moves[(seed >> 16) % moves.size()], error);
+    CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+  }
+
+  Logician copy(logician);
+  for (const Unit *unit : copy.black().units()) {
+    const Unit *original = logician.unit(copy.handle(*unit));
+    CHECK_TRUE(copy.attacks(*unit) == logician.attacks(*original));
+  }
+}
+
+TEST(LogicianTest, active_units_track_board) {
+  Logician logician;
+  error_t error;
+  uint32_t seed = 2468;
+
+  for (unsigned int ply = 0; ply < 240; ply++) {
+    for (const Player *player : { &logician.black(), &logician.white() }) {
+      for (const Unit *unit : player->activeUnits()) {
+        CHECK_TRUE(unit->isActive());
+      }
+
+      for (const Unit *unit : player->inactiveUnits()) {
+        CHECK_FALSE(unit->isActive());
+      }
+
+      CHECK_EQUAL(player->units().size(),
+                  player->activeUnits().size() +
+                  player->inactiveUnits().size());
+    }
+
+    MoveList moves;
+    logician.generateMoves(moves);
+    if (moves.empty()) {
+      break;
+    }
+
+    seed = seed * 1103515245 + 12345;
+    logician.playMove(moves[(seed >> 16) % moves.size()], error);
+    CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+  }
+}
+
+TEST(LogicianTest, evasions_leave_commander_safe) {
+  error_t error;
+  unsigned int checks = 0;
+
+  for (uint32_t game = 1; game <= 12; game++) {
+    Logician logician;
+    uint32_t seed = game * 7919;
+
+    for (unsigned int ply = 0; ply < 240; ply++) {
+      if (logician.isInCheck() && !logician.isInitialArrangement()) {
+        // Every move out of check, but those of the Commander, must leave no
+        // enemy unit attacking the Commander, pinned units included.
+        checks++;
+        const colour_t colour = logician.isPlayersTurn(BLACK) ? BLACK : WHITE;
+        const colour_t enemy = colour == BLACK ? WHITE : BLACK;
+        MoveList moves;
+        logician.generateMoves(moves);
+        for (const Move& move : moves) {
+          const Unit *unit = logician.unit(move.unit());
+          if (unit->front() == GUNGI_PIECE_COMMANDER ||
+              move.type() == Move::MOVE_TYPE_SUBSTITUTION ||
+              move.type() == Move::MOVE_TYPE_TIER_EXCHANGE) {
+            continue;
+          }
+
+          Logician copy(logician);
+          copy.playMove(move, error);
+          CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+
+          const Player& player = colour == BLACK ? copy.black()
+                                                 : copy.white();
+          const Posn& posn = player.commander()->tower()->posn();
+          CHECK_FALSE(copy.attacked(enemy).test(posn));
+        }
+      }
+
+      MoveList moves;
+      logician.generateMoves(moves);
+      if (moves.empty() || logician.isOver()) {
+        break;
+      }
+
+      seed = seed * 1103515245 + 12345;
+      logician.playMove(moves[(seed >> 16) % moves.size()], error);
+      if (error != GUNGI_ERROR_NONE) {
+        break;
+      }
+    }
+  }
+
+  CHECK_TRUE(checks > 0);
+}
+
+TEST(LogicianTest, unmake_move_restores_game) {
+  error_t error;
+
+  for (uint32_t game = 1; game <= 6; game++) {
+    Logician logician;
+    uint32_t seed = game * 7919;
+
+    for (unsigned int ply = 0; ply < 160; ply++) {
+      MoveList moves;
+      logician.generateMoves(moves);
+      if (moves.empty() || logician.isOver()) {
+        break;
+      }
+
+      // Every move is made and taken back, and must match playing it on a
+      // copy of the game.
+      const uint64_t key = logician.key();
+      const Logician::game_state_t state = logician.state();
+      const Bitboard black = logician.attacked(BLACK);
+      const Bitboard white = logician.attacked(WHITE);
+      for (const Move& move : moves) {
+        Logician copy(logician);
+        copy.playMove(move, error);
+        CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+
+        Logician::turn_t turn;
+        logician.makeMove(move, turn, error);
+        CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+        CHECK_TRUE(copy.key() == logician.key());
+        CHECK_EQUAL(copy.state(), logician.state());
+
+        logician.unmakeMove(turn);
+        CHECK_TRUE(key == logician.key());
+        CHECK_EQUAL(state, logician.state());
+        CHECK_TRUE(black == logician.attacked(BLACK));
+        CHECK_TRUE(white == logician.attacked(WHITE));
+      }
+
+      MoveList after;
+      logician.generateMoves(after);
+      CHECK_EQUAL(moves.size(), after.size());
+      for (const Move& move : moves) {
+        CHECK_TRUE(after.contains(move));
+      }
+
+      seed = seed * 1103515245 + 12345;
+      logician.playMove(moves[(seed >> 16) % moves.size()], error);
+      if (error != GUNGI_ERROR_NONE) {
+        break;
+      }
+    }
+  }
+}
+
+TEST(LogicianTest, lazy_checkmate_agrees_with_eager) {
+  error_t error;
+  unsigned int checks = 0;
+
+  Logician lazy;
+  CHECK_FALSE(lazy.isLazyCheckmate());
+
+  lazy.setLazyCheckmate(true);
+  CHECK_TRUE(lazy.isLazyCheckmate());
+  CHECK_TRUE(Logician(lazy).isLazyCheckmate());
+
+  for (uint32_t game = 1; game <= 12; game++) {
+    Logician eager;
+    lazy.newGame();
+    CHECK_TRUE(lazy.isLazyCheckmate());
+    uint32_t seed = game * 7919;
+
+    for (unsigned int ply = 0; ply < 240; ply++) {
+      // Check is known after every turn; checkmate once it is asked for.
+      CHECK_EQUAL(eager.isInCheck(), lazy.isInCheck());
+      if (lazy.isInCheck()) {
+        checks++;
+      }
+
+      CHECK_EQUAL(eager.state(), lazy.state());
+
+      MoveList moves;
+      MoveList lazyMoves;
+      eager.generateMoves(moves);
+      lazy.generateMoves(lazyMoves);
+      CHECK_EQUAL(moves.size(), lazyMoves.size());
+      for (unsigned int i = 0; i < moves.size(); i++) {
+        CHECK_TRUE(moves[i] == lazyMoves[i]);
+      }
+
+      if (moves.empty() || eager.isOver()) {
+        break;
+      }
+
+      seed = seed * 1103515245 + 12345;
+      const Move& move = moves[(seed >> 16) % moves.size()];
+      eager.playMove(move, error);
+      if (error != GUNGI_ERROR_NONE) {
+        break;
+      }
+
+      // Playing the move validates it, which decides checkmate first.
+      lazy.playMove(move, error);
+      CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+    }
+  }
+
+  CHECK_TRUE(checks > 0);
+}
+
+TEST(LogicianTest, pinned_unit_cannot_leave_out_of_check) {
+  // The black Samurai on 2-6 stands between its Commander on 1-7 and the
+  // white Prodigy on 6-2, so it may not leave its tower even though black is
+  // not in check.
+  const std::string gn =
+    "[Event \"Pinned Unit Out Of Check\"]\n"
+    "1. PZ*1-8-0 FL*7-1-0 2. YN*4-6-0 YN*8-2-0 3. RX*3-7-0 O-*5-1-0 "
+    "4. FL*7-6-0 BA*5-0-0 5. PZ*5-6-0 BA*7-1-1 6. O-*1-7-0 PZ*3-0-0 "
+    "7. SE*1-6-0 SE*1-1-0 8. HK*4-7-0 HK*5-2-0 9. YN*7-6-1 RX*6-2-0 "
+    "10. SE*8-7-0 PV*2-0-0 11. BA*6-8-0 YN*3-0-1 12. PG*2-8-0 TL*2-1-0 "
+    "13. BA*7-7-0 CI*4-1-0 14. YN*8-8-0 PG*8-1-0 15. PZ*6-6-0 SE*7-2-0 "
+    "16. PZ*4-7-1 CI*0-2-0 17. CI*2-7-0 PZ*0-2-1 18. CI*3-6-0 PZ*1-2-0 "
+    "19. PV*8-7-1 YN*1-2-1 20. PZ*7-7-1 PZ*4-0-0 21. PZ*3-7-1 PZ*6-1-0 "
+    "22. TL*0-8-0 PZ*7-2-1 23. PZ*0-8-1 PZ*5-2-1 24. SE<1-6-0>2-6-0 "
+    "O-<5-1-0>5-0-1";
+  GNMetadata md;
+  Logician logician;
+  CHECK_TRUE(GNDecoder::decode(gn, md, logician));
+  CHECK_FALSE(logician.isInCheck());
+  CHECK_EQUAL(36, LogicianFixture::generated(logician).size());
+
+  Logician exposed;
+  CHECK_FALSE(GNDecoder::decode(gn + " 25. SE<2-6-0>1-5-0", md, exposed));
+}
+
+TEST(LogicianTest, bronze_cannot_betray_into_duplicate) {
+  // The white Bronze on 3-8 cannot take the black Commander on 2-8, as the
+  // black Bronze below it would betray to white and the tower would hold two
+  // white Bronzes, so black is not in check.
+  const std::string gn =
+    "[Event \"Betraying Bronze\"]\n"
+    "1. YN*8-7-0 FL*7-0-0 2. PZ*4-7-0 SE*5-1-0 3. FL*4-6-0 PV*7-1-0 "
+    "4. PZ*2-8-0 HK*7-1-1 5. SE*5-8-0 RX*1-2-0 6. CI*1-7-0 TL*5-0-0 "
+    "7. YN*1-7-1 PZ*6-1-0 8. HK*6-6-0 SE*7-1-2 9. TL*6-7-0 PZ*0-1-0 "
+    "10. PZ*7-6-0 YN*5-0-1 11. RX*8-8-0 CI*8-2-0 12. O-*3-8-0 CI*1-2-1 "
+    "13. PV*8-6-0 YN*7-0-1 14. SE*1-8-0 O-*8-1-0 15. PZ*0-7-0 BA*2-1-0 "
+    "16. PG*6-8-0 BA*0-1-1 17. BA*6-8-1 YN*4-2-0 18. BA*2-6-0 PZ*3-2-0 "
+    "19. CI*6-6-1 PZ*1-1-0 20. YN*1-8-1 PZ*2-0-0 21. PZ*5-6-0 PZ*5-2-0 "
+    "22. PZ*1-6-0 PZ*8-0-0 23. PZ*3-6-0 PG*4-0-0 24. YN<1-7-1>0-6-0 "
+    "YN<5-0-1>4-1-0 25. CI<1-7-0>0-8-0 PZ<3-2-0>3-3-0 26. YN<0-6-0>1-4-0 "
+    "SE<5-1-0>4-1-1 27. CI<0-8-0>0-7-1 PZ<5-2-0>5-3-0 28. YN<1-8-1>0-6-0 "
+    "O-<8-1-0>7-0-2 29. CI<6-6-1>6-7-1 PG<4-0-0>4-1-2 30. HK<6-6-0x6-1-0 "
+    "SE<7-1-2x6-1-0 31. RX<8-8-0x3-3-0 KH*4-3-0 32. RX<3-3-0x4-2-0 "
+    "KH<4-3-0x4-6-0 33. CI<0-7-1>0-8-0 O-<7-0-2>8-1-0 34. ZP*2-5-0 "
+    "KH<4-6-0x3-6-0 35. ZP*3-7-0 LF*6-3-0 36. BA<2-6-0>0-6-1 KH<3-6-0x2-5-0 "
+    "37. RX<4-2-0x2-0-0 KH<2-5-0x1-4-0 38. RX<2-0-0x1-1-0 SE<6-1-0>7-1-2 "
+    "39. NY*2-4-0 NY*1-3-0 40. NY<2-4-0x1-2-1 ZP*7-7-0 41. NY<1-2-1x0-1-1 "
+    "LF<6-3-0>6-6-0 42. ZP*1-7-0 PZ<0-1-0x1 43. ZP*5-7-0 RX<1-2-0x5-6-0 "
+    "44. PZ<1-6-0>1-5-0 LF<6-6-0x6-7-1 45. AB*1-0-0 KH<1-4-0x1-5-0 "
+    "46. RX<1-1-0x7-7-0 YN*4-8-0 47. BA<6-8-1x6-7-1 CI<8-2-0>8-3-0 "
+    "48. RX<7-7-0>0-0-0 PZ*6-0-0 49. SE<5-8-0x4-8-0 RX<5-6-0x4-7-0 "
+    "50. ZP<3-7-0x4-7-0 IC*2-4-0 51. AB<1-0-0x0-1-0 BA<2-1-0x0-1-0 "
+    "52. SE<1-8-0>1-7-1 KH<1-5-0x0-6-1 53. PZ<0-7-0x0-6-1 ZP*8-4-0 "
+    "54. XR*2-1-0 BA<0-1-0x2-1-0 55. IC*7-0-2 O-<8-1-0x7-0-2 56. FL*0-7-0 "
+    "ZP*4-2-0 57. SE<4-8-0>5-7-1 BA*1-8-0 58. O-<3-8-0>3-7-0 RX*0-2-0 "
+    "59. PZ*3-8-0 BA<1-8-0x3-8-0 60. NY*7-7-0 CI*7-8-0 61. NY<7-7-0x7-8-0 "
+    "ZP*3-1-0 62. O-<3-7-0x3-8-0 AB*2-3-0 63. AB*7-5-0 AB<2-3-0>2-2-0 "
+    "64. IC*5-0-1 TL<5-0-0x1 65. RX<0-0-0x2-2-0 CI*5-1-0 66. RX<2-2-0x3-1-0 "
+    "RX<0-2-0>2-0-0 67. HK*8-2-0 RX<2-0-0x3-1-0 68. BA*1-6-0 SE<7-1-2x8-2-0 "
+    "69. PZ<2-8-0>2-7-0 XR*0-7-1 70. CI<0-8-0x0-7-1 SE<8-2-0>7-2-0 "
+    "71. RX*2-2-0 RX<3-1-0x2-2-0 72. ZP*2-8-0 KH*5-6-0 73. PZ*3-2-0 XR*7-7-0 "
+    "74. O-<3-8-0>2-8-1 ZP*3-8-0";
+  GNMetadata md;
+  Logician logician;
+  CHECK_TRUE(GNDecoder::decode(gn, md, logician));
+  CHECK_FALSE(logician.isInCheck());
+  CHECK_EQUAL(35, LogicianFixture::generated(logician).size());
+}
+
+TEST(LogicianTest, strike_cannot_lower_enemy_onto_commander) {
+  // The black Pawn at the bottom of 4-6 may not strike the white Hidden
+  // Dragon above it, as the white Bow at the top would drop to the middle
+  // tier, from which it attacks the black Commander on 4-7.
+  const std::string gn =
+    "[Event \"Strike Lowers Bow\"]\n"
+    "1. O-*4-7-0 O-*8-0-0 2. PZ*4-6-0 PZ*0-1-0 3. CI*4-6-1 PZ*1-1-0 "
+    "4. PZ*0-7-0 PZ*2-1-0 5. PZ*1-7-0 PZ*3-1-0 6. PZ*2-7-0 PZ*4-1-0 "
+    "7. PZ*3-7-0 PZ*5-1-0 8. PZ*5-7-0 PZ*6-1-0 9. PZ*6-7-0 PV*7-1-0 "
+    "10. PV*7-7-0 PG*8-1-0 11. PG*8-7-0 HK*4-2-0 12. BA*0-8-0 BA*2-2-0 "
+    "13. BA*1-8-0 BA*6-2-0 14. RX*2-8-0 RX*0-0-0 15. HK*3-8-0 FL*1-0-0 "
+    "16. FL*5-8-0 TL*2-0-0 17. TL*6-8-0 CI*3-0-0 18. CI*7-8-0 CI*4-0-0 "
+    "19. SE*8-8-0 SE*5-0-0 20. SE*0-6-0 SE*6-0-0 21. YN*3-6-0 YN*7-0-0 "
+    "22. YN*1-6-0 YN*0-2-0 23. YN*7-6-0 YN*8-2-0 24. PG<8-7-0>8-6-0 "
+    "HK<4-2-0x4-6-1 25. PG<8-6-0>8-5-0 BA<2-2-0>4-2-0 26. PG<8-5-0>8-4-0 "
+    "BA<4-2-0>4-4-0 27. PG<8-4-0>8-3-0 BA<4-4-0>4-6-2";
+  GNMetadata md;
+  Logician logician;
+  CHECK_TRUE(GNDecoder::decode(gn, md, logician));
+  CHECK_FALSE(logician.isInCheck());
+  CHECK_EQUAL(40, LogicianFixture::generated(logician).size());
+
+  Logician exposed;
+  CHECK_FALSE(GNDecoder::decode(gn + " 28. PZ<4-6-0x1", md, exposed));
+}
+
+TEST(LogicianTest, commander_cannot_uncover_walk_onto_itself) {
+  // The white Commander on 7-1 blocks the walk of the black Spy on 8-2 to
+  // 7-0, so stepping onto 7-0 would let the Spy take it.
+  const std::string gn =
+    "[Event \"Commander Uncovers Walk\"]\n"
+    "1. BA*1-8-0 FL*2-2-0 2. BA*0-6-0 PV*1-2-0 3. PZ*0-6-1 YN*4-2-0 "
+    "4. PG*2-6-0 BA*6-0-0 5. O-*7-8-0 SE*8-2-0 6. TL*2-7-0 PG*4-1-0 "
+    "7. PV*5-8-0 O-*6-0-1 8. SE*5-7-0 PZ*7-0-0 9. HK*2-7-1 BA*7-1-0 "
+    "10. FL*0-7-0 HK*6-2-0 11. YN*5-6-0 RX*3-0-0 12. PZ*8-6-0 YN*6-1-0 "
+    "13. RX*2-8-0 CI*6-2-1 14. CI*7-7-0 CI*4-0-0 15. CI*3-7-0 YN*0-0-0 "
+    "16. SE*3-7-1 PZ*3-0-1 17. PZ*6-8-0 TL*5-1-0 18. PZ*4-8-0 PZ*5-1-1 "
+    "19. YN*5-8-1 PZ*2-2-1 20. YN*4-7-0 SE*2-1-0 21. PZ*1-6-0 PZ*0-2-0 "
+    "22. PZ*7-6-0 PZ*8-0-0 23. PZ*3-6-0 PZ*6-2-2 24. HK<2-7-1>1-6-1 "
+    "BA<7-1-0>5-1-2 25. O-<7-8-0>6-8-1 BA<5-1-2>3-1-0 26. PZ<3-6-0>3-5-0 "
+    "O-<6-0-1>7-1-0 27. O-<6-8-1>5-7-1 SE<8-2-0>8-3-0 28. YN<5-6-0>6-4-0 "
+    "SE<2-1-0>3-1-1 29. PZ<0-6-1>0-5-0 PZ<6-2-2>5-3-0 30. SE<3-7-1>2-7-1 "
+    "CI<6-2-1>6-1-1 31. O-<5-7-1>4-7-1 PZ<3-0-1>3-1-2 32. YN<5-8-1>4-6-0 "
+    "CI<6-1-1>6-0-1 33. PG<2-6-0>2-5-0 HK<6-2-0x6-4-0 34. O-<4-7-1>3-6-0 "
+    "HK<6-4-0x6-8-0 35. CI<7-7-0x6-8-0 NY*4-6-1 36. O-<3-6-0x4-6-1 ZP*4-2-1 "
+    "37. YN*8-2-0";
+  GNMetadata md;
+  Logician logician;
+  CHECK_TRUE(GNDecoder::decode(gn, md, logician));
+  CHECK_FALSE(logician.isInCheck());
+  CHECK_EQUAL(34, LogicianFixture::generated(logician).size());
+
+  Logician exposed;
+  CHECK_FALSE(GNDecoder::decode(gn + " O-<7-1-0>7-0-1", md, exposed));
+}
+
+TEST(LogicianTest, commander_escapes_behind_its_tower) {
+  // The white Hidden Dragon on 1-7 checks the black Commander at the top of
+  // 2-7.  The black Prodigy below keeps blocking the walk along the rank once
+  // the Commander leaves, so the Commander can escape to 3-7.
+  const std::string gn =
+    "[Event \"Escape Behind Tower\"]\n"
+    "1. PV*6-8-0 RX*5-0-0 2. RX*2-7-0 PZ*3-1-0 3. CI*5-7-0 PV*7-0-0 "
+    "4. TL*8-8-0 O-*7-1-0 5. CI*3-7-0 BA*5-1-0 6. PZ*8-7-0 CI*0-0-0 "
+    "7. BA*4-8-0 BA*2-0-0 8. PZ*3-6-0 YN*6-0-0 9. HK*4-8-1 HK*1-2-0 "
+    "10. PG*0-8-0 FL*8-1-0 11. YN*5-8-0 YN*2-2-0 12. BA*3-8-0 YN*4-0-0 "
+    "13. O-*2-7-1 PG*8-2-0 14. FL*6-6-0 TL*4-1-0 15. PZ*7-6-0 CI*4-1-1 "
+    "16. YN*7-6-1 SE*3-0-0 17. SE*8-7-1 SE*8-2-1 18. SE*4-8-2 PZ*1-0-0 "
+    "19. YN*5-7-1 PZ*4-2-0 20. PZ*4-6-0 PZ*0-2-0 21. PZ*1-7-0 PZ*2-0-1 "
+    "22. PZ*2-8-0 PZ*6-2-0 23. PZ*5-6-0 PZ*5-2-0 24. YN<5-8-0>6-6-1 "
+    "HK<1-2-0x1-7-0";
+  GNMetadata md;
+  Logician logician;
+  CHECK_TRUE(GNDecoder::decode(gn, md, logician));
+  CHECK_TRUE(logician.isInCheck());
+  CHECK_EQUAL(6, LogicianFixture::generated(logician).size());
+
+  Logician escaped;
+  CHECK_TRUE(GNDecoder::decode(gn + " 25. O-<2-7-1>3-7-1", md, escaped));
+  CHECK_FALSE(escaped.isInCheck());
+}
+
+TEST(LogicianTest, last_drop_cannot_place_commander_in_reach) {
+  // The white Commander is the last unit of the Initial Arrangement, and
+  // black moves right after it is placed, so it may not be dropped on the
+  // file of the black Hidden Dragon on 4-6.
+  const std::string gn =
+    "[Event \"Last Drop Is Commander\"]\n"
+    "1. O-*8-8-0 PZ*0-1-0 2. HK*4-6-0 PZ*1-1-0 3. PZ*0-7-0 PZ*2-1-0 "
+    "4. PZ*1-7-0 PZ*3-1-0 5. PZ*2-7-0 PZ*4-1-0 6. PZ*3-7-0 PZ*5-1-0 "
+    "7. PZ*4-7-0 PZ*6-1-0 8. PZ*5-7-0 PV*7-1-0 9. PZ*6-7-0 PG*8-1-0 "
+    "10. PV*7-7-0 HK*1-2-0 11. PG*8-7-0 BA*2-2-0 12. BA*0-8-0 BA*6-2-0 "
+    "13. BA*1-8-0 RX*0-0-0 14. RX*2-8-0 FL*1-0-0 15. FL*5-8-0 TL*2-0-0 "
+    "16. TL*6-8-0 CI*3-0-0 17. CI*7-8-0 CI*4-0-0 18. CI*3-8-0 SE*5-0-0 "
+    "19. SE*0-6-0 SE*6-0-0 20. SE*1-6-0 YN*7-0-0 21. YN*2-6-0 YN*0-2-0 "
+    "22. YN*6-6-0 YN*8-2-0 23. YN*7-6-0";
+  GNMetadata md;
+  Logician logician;
+  CHECK_TRUE(GNDecoder::decode(gn, md, logician));
+  CHECK_TRUE(logician.isInitialArrangement());
+  CHECK_EQUAL(22, LogicianFixture::generated(logician).size());
+
+  Logician exposed;
+  CHECK_FALSE(GNDecoder::decode(gn + " O-*4-2-0", md, exposed));
+}
+
+TEST(LogicianTest, enemy_below_commander_is_check) {
+  // The white Hidden Dragon struck the black Pawn between it and the black
+  // Commander on 4-5, so it is right below the Commander and can strike it.
+  // Only the Commander leaving the tower stops the check.
+  const std::string gn =
+    "[Event \"Enemy Below Commander\"]\n"
+    "1. O-*3-6-0 O-*8-0-0 2. PZ*4-6-0 RX*0-1-0 3. PZ*0-7-0 HK*4-2-0 "
+    "4. PZ*1-7-0 PZ*0-2-0 5. PZ*2-7-0 PZ*1-1-0 6. PZ*3-7-0 PZ*2-1-0 "
+    "7. PZ*5-7-0 PZ*3-1-0 8. PZ*6-7-0 PZ*4-1-0 9. PV*7-7-0 PZ*5-1-0 "
+    "10. PG*8-7-0 PZ*6-1-0 11. BA*0-8-0 PV*7-1-0 12. BA*1-8-0 PG*8-1-0 "
+    "13. RX*2-8-0 BA*2-2-0 14. HK*3-8-0 BA*6-2-0 15. FL*5-8-0 FL*1-0-0 "
+    "16. TL*6-8-0 TL*2-0-0 17. CI*7-8-0 CI*3-0-0 18. CI*4-8-0 CI*4-0-0 "
+    "19. SE*8-8-0 SE*5-0-0 20. SE*0-6-0 SE*6-0-0 21. YN*1-6-0 YN*7-0-0 "
+    "22. YN*6-6-0 YN*0-0-0 23. YN*7-6-0 YN*8-2-0 24. PG<8-7-0>8-6-0 "
+    "HK<4-2-0>4-5-0 25. PG<8-6-0>8-5-0 RX<0-1-0>4-5-1 26. PZ<4-6-0x4-5-1 "
+    "PV<7-1-0>7-2-0 27. O-<3-6-0>4-5-2 HK<4-5-0x1";
+  GNMetadata md;
+  Logician logician;
+  CHECK_TRUE(GNDecoder::decode(gn, md, logician));
+  CHECK_TRUE(logician.isInCheck());
+  CHECK_EQUAL(4, LogicianFixture::generated(logician).size());
+
+  Logician ignored;
+  CHECK_FALSE(GNDecoder::decode(gn + " 28. PZ<1-7-0>1-6-1", md, ignored));
+}
+
+TEST(LogicianTest, substitution_cannot_put_commander_onto_enemy) {
+  // The white Spy on 2-4 checks the black Commander on 3-6.  The black
+  // Samurai on 4-5 stands right above the white Hidden Dragon, so trading
+  // places with the Commander would leave the Commander to its strike.
+  const std::string gn =
+    "[Event \"Substitution Onto Enemy\"]\n"
+    "1. O-*3-6-0 O-*8-0-0 2. SE*4-6-0 RX*0-1-0 3. PZ*0-7-0 HK*4-2-0 "
+    "4. PZ*1-7-0 YN*3-2-0 5. PZ*2-7-0 PZ*0-0-0 6. PZ*3-7-0 PZ*1-1-0 "
+    "7. PZ*4-7-0 PZ*2-1-0 8. PZ*5-7-0 PZ*3-1-0 9. PZ*6-7-0 PZ*4-1-0 "
+    "10. PV*7-7-0 PZ*5-1-0 11. PG*8-7-0 PZ*6-1-0 12. BA*0-8-0 PV*7-1-0 "
+    "13. BA*1-8-0 PG*8-1-0 14. RX*2-8-0 BA*2-2-0 15. HK*3-8-0 BA*6-2-0 "
+    "16. FL*5-8-0 FL*1-0-0 17. TL*6-8-0 TL*2-0-0 18. CI*7-8-0 CI*3-0-0 "
+    "19. CI*4-8-0 CI*4-0-0 20. SE*8-8-0 SE*5-0-0 21. YN*0-6-0 SE*6-0-0 "
+    "22. YN*6-6-0 YN*7-0-0 23. YN*7-6-0 YN*0-2-0 24. PG<8-7-0>8-6-0 "
+    "HK<4-2-0>4-5-0 25. PG<8-6-0>8-5-0 RX<0-1-0>4-5-1 26. SE<4-6-0x4-5-1 "
+    "YN<3-2-0>2-4-0";
+  GNMetadata md;
+  Logician logician;
+  CHECK_TRUE(GNDecoder::decode(gn, md, logician));
+  CHECK_TRUE(logician.isInCheck());
+  CHECK_EQUAL(9, LogicianFixture::generated(logician).size());
+
+  Logician exposed;
+  CHECK_FALSE(GNDecoder::decode(gn + " 27. SE<4-5-1&3-6-0", md, exposed));
+}
+
+TEST(LogicianTest, strike_cannot_free_bronze_file) {
+  // The white Bronze at the bottom of 4-5 keeps the white Bronze on 5-7 out
+  // of the file of the black Commander on 4-7, so the black Pawn above it
+  // may not strike it.
+  const std::string gn =
+    "[Event \"Strike Frees Bronze\"]\n"
+    "1. O-*4-7-0 O-*4-0-0 2. PZ*0-6-0 HK*0-2-0 3. PZ*1-6-0 PZ*0-1-0 "
+    "4. PZ*4-6-0 PZ*1-1-0 5. PZ*2-7-0 PZ*2-1-0 6. PZ*3-7-0 PZ*3-1-0 "
+    "7. PZ*6-7-0 PZ*4-1-0 8. PZ*5-8-0 PZ*5-1-0 9. PV*7-7-0 PZ*6-1-0 "
+    "10. PG*8-7-0 PV*7-1-0 11. BA*0-8-0 PG*8-1-0 12. BA*1-8-0 BA*2-2-0 "
+    "13. RX*2-8-0 BA*6-2-0 14. HK*3-8-0 RX*1-0-0 15. FL*4-8-0 FL*2-0-0 "
+    "16. TL*6-8-0 TL*3-0-0 17. CI*7-8-0 CI*5-0-0 18. CI*8-8-0 CI*6-0-0 "
+    "19. SE*0-7-0 SE*7-0-0 20. SE*6-6-0 SE*8-0-0 21. YN*2-6-0 YN*1-2-0 "
+    "22. YN*3-6-0 YN*7-2-0 23. YN*7-6-0 YN*3-2-0 24. PG<8-7-0>8-6-0 "
+    "HK<0-2-0x0-6-0 25. PG<8-6-0>8-5-0 HK<0-6-0x1-6-0 26. PG<8-5-0>8-4-0 "
+    "ZP*4-5-0 27. PG<8-4-0>8-3-0 HK<1-6-0>1-5-0 28. SE<0-7-0>0-6-0 "
+    "HK<1-5-0>4-5-1 29. PZ<4-6-0x4-5-1 ZP*5-7-0";
+  GNMetadata md;
+  Logician logician;
+  CHECK_TRUE(GNDecoder::decode(gn, md, logician));
+  CHECK_FALSE(logician.isInCheck());
+  CHECK_EQUAL(93, LogicianFixture::generated(logician).size());
+
+  Logician exposed;
+  CHECK_FALSE(GNDecoder::decode(gn + " 30. PZ<4-5-1x0", md, exposed));
+}
+
+TEST(LogicianTest, capture_cannot_free_duplicate) {
+  // The white Bronze right above the black Commander on 4-6 keeps the white
+  // Bronze on 5-6 off the tower.  Taking it lets the other Bronze onto the
+  // tower, so neither the black Pawn nor the black Prodigy may take it, and
+  // the black Commander is checkmated.
+  const std::string gn =
+    "[Event \"Capture Frees Bronze\"]\n"
+    "1. O-*4-6-0 O-*4-0-0 2. PZ*0-6-0 HK*0-2-0 3. PZ*1-6-0 PZ*0-1-0 "
+    "4. PZ*4-7-0 PZ*1-1-0 5. PZ*2-7-0 PZ*2-1-0 6. PZ*3-6-0 PZ*3-1-0 "
+    "7. PZ*6-7-0 PZ*4-1-0 8. PZ*5-8-0 PZ*5-1-0 9. PV*7-7-0 PZ*6-1-0 "
+    "10. PG*8-7-0 PV*7-1-0 11. BA*0-8-0 PG*8-1-0 12. BA*1-8-0 BA*2-2-0 "
+    "13. RX*2-8-0 BA*6-2-0 14. HK*1-7-0 RX*1-0-0 15. FL*4-8-0 FL*2-0-0 "
+    "16. TL*6-8-0 TL*3-0-0 17. CI*7-8-0 CI*5-0-0 18. CI*8-8-0 CI*6-0-0 "
+    "19. SE*0-7-0 SE*7-0-0 20. SE*6-6-0 SE*8-0-0 21. YN*3-8-0 YN*1-2-0 "
+    "22. YN*8-6-0 YN*7-2-0 23. YN*7-6-0 YN*3-2-0 24. YN<3-8-0>4-6-1 "
+    "HK<0-2-0x0-6-0 25. PZ<5-8-0>5-7-0 HK<0-6-0x1-6-0 26. YN<8-6-0>7-4-0 "
+    "ZP*4-6-2 27. YN<7-6-0>8-4-0 ZP*5-6-0 28. PG<8-7-0>8-6-0 ZP<4-6-2x1";
+  GNMetadata md;
+  Logician logician;
+  CHECK_TRUE(GNDecoder::decode(gn, md, logician));
+  CHECK_TRUE(logician.isInCheck());
+  CHECK_TRUE(logician.isInCheckmate());
+  CHECK_EQUAL(0, LogicianFixture::generated(logician).size());
+
+  Logician exposed;
+  CHECK_FALSE(GNDecoder::decode(gn + " 29. PZ<4-7-0x4-6-1", md, exposed));
+}
+
+TEST(LogicianTest, leaving_cannot_expose_commander) {
+  // The black Bronze in the tower of the black Commander on 4-6 would betray
+  // to the white Bronze on 3-6 were it at the top, which keeps the white
+  // Bronze off the tower.  The black Pawn at the top may not leave, as the
+  // black Bronze would then be the top that the white Bronze takes.
+  const std::string gn =
+    "[Event \"Pawn Exposes Commander\"]\n"
+    "1. O-*4-6-0 O-*4-0-0 2. PZ*0-6-0 HK*0-2-0 3. PZ*1-6-0 PZ*0-1-0 "
+    "4. PZ*4-7-0 PZ*1-1-0 5. PZ*2-7-0 PZ*2-1-0 6. PZ*3-7-0 PZ*3-1-0 "
+    "7. PZ*6-7-0 PZ*4-1-0 8. PZ*5-7-0 PZ*5-1-0 9. PV*7-7-0 PZ*6-1-0 "
+    "10. PG*8-7-0 PV*7-1-0 11. BA*0-8-0 PG*8-1-0 12. BA*1-8-0 BA*2-2-0 "
+    "13. RX*2-8-0 BA*6-2-0 14. HK*5-6-0 RX*1-0-0 15. FL*4-8-0 FL*2-0-0 "
+    "16. TL*6-8-0 TL*3-0-0 17. CI*7-8-0 CI*5-0-0 18. CI*8-8-0 CI*6-0-0 "
+    "19. SE*0-7-0 SE*7-0-0 20. SE*6-6-0 SE*8-0-0 21. YN*2-6-0 YN*1-2-0 "
+    "22. YN*8-6-0 YN*7-2-0 23. YN*7-6-0 YN*3-2-0 24. HK<5-6-0x5-1-0 "
+    "HK<0-2-0x0-6-0 25. ZP*5-6-0 PZ<4-1-0>4-2-0 26. ZP<5-6-0>4-6-1 "
+    "PZ<0-1-0>0-2-0 27. PZ<4-7-0>4-6-2 ZP*3-6-0";
+  GNMetadata md;
+  Logician logician;
+  CHECK_TRUE(GNDecoder::decode(gn, md, logician));
+  CHECK_FALSE(logician.isInCheck());
+  CHECK_EQUAL(42, LogicianFixture::generated(logician).size());
+
+  Logician exposed;
+  CHECK_FALSE(GNDecoder::decode(gn + " 28. PZ<4-6-2>3-5-0", md, exposed));
+}
+
+TEST(LogicianTest, tier_exchange_cannot_expose_commander) {
+  // The black Bronze at the bottom of the tower of the black Commander on
+  // 4-6 keeps the white Bronze on 3-6 off the tower.  Exchanging it with the
+  // black Captain at the top would leave it to be taken instead.
+  const std::string gn =
+    "[Event \"Exchange Exposes Commander\"]\n"
+    "1. O-*4-7-0 O-*4-0-0 2. PZ*0-6-0 HK*0-2-0 3. PZ*1-6-0 PZ*0-1-0 "
+    "4. PZ*4-8-0 PZ*1-1-0 5. PZ*2-7-0 PZ*2-1-0 6. PZ*3-7-0 PZ*3-1-0 "
+    "7. PZ*6-7-0 PZ*4-1-0 8. PZ*5-8-0 PZ*5-1-0 9. PV*7-7-0 PZ*6-1-0 "
+    "10. PG*8-7-0 PV*7-1-0 11. BA*0-8-0 PG*8-1-0 12. BA*1-8-0 BA*2-2-0 "
+    "13. RX*2-8-0 BA*6-2-0 14. HK*5-6-0 RX*1-0-0 15. FL*3-8-0 FL*2-0-0 "
+    "16. TL*6-8-0 TL*3-0-0 17. CI*5-7-0 CI*5-0-0 18. CI*8-8-0 CI*6-0-0 "
+    "19. SE*0-7-0 SE*7-0-0 20. SE*6-6-0 SE*8-0-0 21. YN*2-6-0 YN*1-2-0 "
+    "22. YN*8-6-0 YN*7-2-0 23. YN*7-6-0 YN*3-2-0 24. HK<5-6-0x5-1-0 "
+    "HK<0-2-0x0-6-0 25. ZP*4-6-0 PZ<4-1-0>4-2-0 26. O-<4-7-0>4-6-1 "
+    "PZ<0-1-0>0-2-0 27. CI<5-7-0>4-6-2 ZP*3-6-0";
+  GNMetadata md;
+  Logician logician;
+  CHECK_TRUE(GNDecoder::decode(gn, md, logician));
+  CHECK_FALSE(logician.isInCheck());
+  CHECK_EQUAL(48, LogicianFixture::generated(logician).size());
+
+  error_t error;
+  logician.exchangeUnits(GUNGI_EFFECT_1_3_TIER_EXCHANGE,
+                         Posn(4, 6),
+                         2,
+                         Posn(4, 6),
+                         0,
+                         error);
+  CHECK_EQUAL(GUNGI_ERROR_CHECK, error);
+}
+
+TEST(LogicianTest, unit_that_cannot_move_where_it_lands_is_recovered) {
+  // The black Spy lands on 7-1, from where it has no move on black's next
+  // turn, so black has to settle its recovery before white moves.
+  const std::string gn =
+    "[Event \"Forced Recovery\"]\n"
+    "1. TL*2-7-0 PG*3-1-0 2. CI*5-6-0 TL*3-2-0 3. YN*5-8-0 BA*1-2-0 "
+    "4. YN*7-6-0 PZ*6-0-0 5. RX*2-7-1 FL*3-0-0 6. PG*2-6-0 O-*3-1-1 "
+    "7. FL*1-6-0 RX*1-0-0 8. HK*6-8-0 PV*5-1-0 9. PZ*6-6-0 SE*0-1-0 "
+    "10. YN*6-7-0 CI*6-1-0 11. BA*0-7-0 CI*3-2-1 12. CI*1-8-0 SE*0-2-0 "
+    "13. PV*3-8-0 BA*0-1-1 14. BA*5-7-0 PZ*2-2-0 15. O-*0-8-0 YN*4-0-0 "
+    "16. PZ*1-6-1 PZ*0-0-0 17. PZ*8-6-0 HK*4-2-0 18. PZ*0-7-1 YN*1-1-0 "
+    "19. SE*6-8-1 YN*8-1-0 20. SE*4-7-0 PZ*8-2-0 21. PZ*4-6-0 PZ*7-2-0 "
+    "22. PZ*7-8-0 PZ*1-2-1 23. PZ*5-6-1 PZ*4-2-1 24. YN<6-7-0>7-5-0 "
+    "O-<3-1-1>4-0-1 25. YN<7-5-0>6-3-0 RX<1-0-0>3-2-2 26. YN<6-3-0>7-1-0";
+  GNMetadata md;
+  Logician logician;
+  CHECK_TRUE(GNDecoder::decode(gn, md, logician));
+  CHECK_TRUE(logician.isForcedRecovery());
+  CHECK_TRUE(logician.isForcedRecoveryForPlayer(BLACK));
+  CHECK_EQUAL(BLACK, logician.forcedRecoveryColour());
+
+  const Unit *unit = logician.forcedRecoveryUnit();
+  CHECK_TRUE(unit != NULL);
+  CHECK_EQUAL(GUNGI_PIECE_SPY, unit->front());
+  CHECK_TRUE(unit->tower()->posn() == Posn(7, 1));
+  CHECK_EQUAL(2, LogicianFixture::generated(logician).size());
+
+  const size_t inactive = logician.black().inactiveUnits().size();
+  error_t error = GUNGI_ERROR_NONE;
+  logician.forceRecover(true, error);
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+  CHECK_FALSE(logician.isForcedRecovery());
+  CHECK_TRUE(logician.isPlayersTurn(WHITE));
+  CHECK_TRUE(unit->tower() == NULL);
+  CHECK_EQUAL(inactive + 1, logician.black().inactiveUnits().size());
+}
@@ -0,0 +1,199 @@
+// montecarlo_unit_tests.cpp                                          -*-C++-*-
+#include "montecarlo.hpp"
+
+#include "gtypes.hpp"
+#include "logician.hpp"
+#include "move.hpp"
+
+#include <CppUTest/TestHarness.h>
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+using namespace gungi;
+
+class MonteCarloFixture {
+  // Fixture for testing the Monte Carlo tree search.
+
+public:
+  // STATIC CLASS MEMBERS
+  static void playout(Logician& game, uint32_t seed, unsigned int plies) {
+    // Plays up to the given number of 'plies' of random moves chosen by the
+    // given 'seed' in the given 'game'.
+    error_t error;
+    for (unsigned int ply = 0; ply < plies; ply++) {
+      MoveList moves;
+      game.generateMoves(moves);
+      if (moves.empty() || game.isOver()) {
+        return;
+      }
+
+      seed = seed * 1103515245 + 12345;
+      game.playMove(moves[(seed >> 16) % moves.size()], error);
+      GASSERT(error == GUNGI_ERROR_NONE);
+    }
+  }
+
+  static void playToEnd(Logician& game, uint32_t seed) {
+    // Plays random moves chosen by the given 'seed' in the given 'game',
+    // picking a move that checkmates whenever there is one, until the game
+    // is over.
+    error_t error;
+    while (!game.isOver()) {
+      MoveList moves;
+      game.generateMoves(moves);
+      if (moves.empty()) {
+        return;
+      }
+
+      seed = seed * 1103515245 + 12345;
+      Move next = moves[(seed >> 16) % moves.size()];
+      for (const Move& move : moves) {
+        Logician::turn_t turn;
+        game.makeMove(move, turn, error);
+        const bool mate = game.isInCheckmate();
+        game.unmakeMove(turn);
+        if (mate) {
+          next = move;
+          break;
+        }
+      }
+
+      game.playMove(next, error);
+      GASSERT(error == GUNGI_ERROR_NONE);
+    }
+  }
+};
+
+TEST_GROUP(MonteCarloTest) {
+  void setup(void) {
+    return;
+  }
+
+  void teardown(void) {
+    return;
+  }
+};
+
+TEST(MonteCarloTest, search_returns_legal_move_and_analysis) {
+  Logician game;
+  MonteCarloFixture::playout(game, 7919, 80);
+  const uint64_t key = game.key();
+
+  MonteCarlo::limits_t limits = { 64, 0 };
+  MonteCarlo search;
+  const Move best = search.search(game, limits);
+
+  MoveList moves;
+  game.generateMoves(moves);
+  CHECK_TRUE(moves.contains(best));
+  CHECK_TRUE(key == game.key());
+  CHECK_EQUAL(64, search.playouts());
+  CHECK_TRUE(search.size() > moves.size());
+
+  // Every move of the position is listed, most played first, and the
+  // playouts through them add up to those of the search.
+  std::vector<MonteCarlo::stats_t> stats;
+  search.analysis(stats);
+  CHECK_EQUAL(moves.size(), stats.size());
+  CHECK_TRUE(best == stats[0].move);
+
+  uint64_t visits = 0;
+  for (size_t idx = 0; idx < stats.size(); idx++) {
+    CHECK_TRUE(moves.contains(stats[idx].move));
+    CHECK_TRUE(stats[idx].winRate >= 0.0 && stats[idx].winRate <= 1.0);
+    if (idx > 0) {
+      CHECK_TRUE(stats[idx - 1].visits >= stats[idx].visits);
+    }
+    visits += stats[idx].visits;
+  }
+  CHECK_EQUAL(64, visits);
+}
+
+TEST(MonteCarloTest, search_with_same_seed_is_repeatable) {
+  Logician game;
+  MonteCarloFixture::playout(game, 104729, 80);
+
+  MonteCarlo::limits_t limits = { 48, 0 };
+  MonteCarlo first(1, MonteCarlo::k_DEFAULT_NODES, 42);
+  MonteCarlo second(1, MonteCarlo::k_DEFAULT_NODES, 42);
+  CHECK_TRUE(first.search(game, limits) == second.search(game, limits));
+
+  std::vector<MonteCarlo::stats_t> lhs;
+  std::vector<MonteCarlo::stats_t> rhs;
+  first.analysis(lhs);
+  second.analysis(rhs);
+  CHECK_EQUAL(lhs.size(), rhs.size());
+  for (size_t idx = 0; idx < lhs.size(); idx++) {
+    CHECK_TRUE(lhs[idx].move == rhs[idx].move);
+    CHECK_EQUAL(lhs[idx].visits, rhs[idx].visits);
+  }
+
+  // Searching again starts from a new tree.
+  first.search(game, limits);
+  first.analysis(rhs);
+  CHECK_EQUAL(lhs.size(), rhs.size());
+  CHECK_EQUAL(48, first.playouts());
+}
+
+TEST(MonteCarloTest, search_with_full_tree_keeps_playing) {
+  Logician game;
+  MonteCarloFixture::playout(game, 15485863, 80);
+
+  MonteCarlo::limits_t limits = { 32, 0 };
+  MonteCarlo search(1, 1);
+  const Move best = search.search(game, limits);
+
+  MoveList moves;
+  game.generateMoves(moves);
+  CHECK_TRUE(moves.contains(best));
+  CHECK_EQUAL(32, search.playouts());
+  CHECK_TRUE(search.size() <= 1 + MoveList::k_CAPACITY);
+}
+
+TEST(MonteCarloTest, search_over_game_returns_no_move) {
+  Logician game;
+  MonteCarloFixture::playToEnd(game, 7919);
+  CHECK_TRUE(game.isOver());
+
+  MonteCarlo::limits_t limits = { 8, 0 };
+  MonteCarlo search;
+  CHECK_TRUE(search.search(game, limits) == Move());
+  CHECK_EQUAL(0, search.playouts());
+
+  std::vector<MonteCarlo::stats_t> stats;
+  search.analysis(stats);
+  CHECK_TRUE(stats.empty());
+}
+
+TEST(MonteCarloTest, search_on_threads_returns_legal_move) {
+  Logician game;
+  MonteCarloFixture::playout(game, 104729, 80);
+  const uint64_t key = game.key();
+
+  MonteCarlo::limits_t limits = { 64, 0 };
+  MonteCarlo search(4);
+  CHECK_EQUAL(4, search.numThreads());
+
+  const Move best = search.search(game, limits);
+  MoveList moves;
+  game.generateMoves(moves);
+  CHECK_TRUE(moves.contains(best));
+  CHECK_TRUE(key == game.key());
+
+  // The limits hold over every thread.
+  CHECK_EQUAL(64, search.playouts());
+
+  limits.playouts = 0;
+  limits.milliseconds = 50;
+  const std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+  CHECK_TRUE(moves.contains(search.search(game, limits)));
+  CHECK_TRUE(std::chrono::steady_clock::now() - start <
+             std::chrono::seconds(5));
+  CHECK_TRUE(search.playouts() > 0);
+
+  MonteCarlo hardware(0);
+  CHECK_TRUE(hardware.numThreads() > 0);
+}
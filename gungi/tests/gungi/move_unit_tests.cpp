@@ -0,0 +1,146 @@
+// move_unit_tests.cpp                                                -*-C++-*-
+#include "move.hpp"
+
+#include "gtypes.hpp"
+#include "posn.hpp"
+#include "unitarena.hpp"
+
+#include <CppUTest/TestHarness.h>
+
+#include <sstream>
+
+using namespace gungi;
+
+TEST_GROUP(MoveTest) {
+  void setup(void) {
+    return;
+  }
+
+  void teardown(void) {
+    return;
+  }
+};
+
+TEST(MoveTest, constructor_creates_none_move) {
+  Move move;
+
+  CHECK_EQUAL(Move::MOVE_TYPE_NONE, move.type());
+  CHECK_EQUAL(UnitArena::k_NULL_HANDLE, move.unit());
+  CHECK_EQUAL(UnitArena::k_NULL_HANDLE, move.target());
+}
+
+TEST(MoveTest, move_is_four_bytes) {
+  CHECK_EQUAL(4, sizeof(Move));
+}
+
+TEST(MoveTest, drop_and_move_record_destination) {
+  Move drop = Move::drop(3, Posn(4, 7));
+  Move move = Move::move(5, Posn(8, 8));
+
+  CHECK_EQUAL(Move::MOVE_TYPE_DROP, drop.type());
+  CHECK_EQUAL(3, drop.unit());
+  CHECK_EQUAL(UnitArena::k_NULL_HANDLE, drop.target());
+  CHECK_EQUAL(Posn(4, 7).index(), drop.square());
+  CHECK_TRUE(drop.to() == Posn(4, 7));
+
+  CHECK_EQUAL(Move::MOVE_TYPE_MOVE, move.type());
+  CHECK_EQUAL(5, move.unit());
+  CHECK_TRUE(move.to() == Posn(8, 8));
+}
+
+TEST(MoveTest, strike_and_exchange_record_target) {
+  Move strike = Move::immobileStrike(1, 2);
+  Move sub = Move::exchange(GUNGI_EFFECT_SUBSTITUTION, 3, 4);
+  Move tier = Move::exchange(GUNGI_EFFECT_1_3_TIER_EXCHANGE, 5, 6);
+
+  CHECK_EQUAL(Move::MOVE_TYPE_IMMOBILE_STRIKE, strike.type());
+  CHECK_EQUAL(1, strike.unit());
+  CHECK_EQUAL(2, strike.target());
+
+  CHECK_EQUAL(Move::MOVE_TYPE_SUBSTITUTION, sub.type());
+  CHECK_EQUAL(3, sub.unit());
+  CHECK_EQUAL(4, sub.target());
+
+  CHECK_EQUAL(Move::MOVE_TYPE_TIER_EXCHANGE, tier.type());
+  CHECK_EQUAL(5, tier.unit());
+  CHECK_EQUAL(6, tier.target());
+}
+
+TEST(MoveTest, forced_recovery_records_choice) {
+  Move recover = Move::forcedRecovery(7, true);
+  Move stay = Move::forcedRecovery(7, false);
+
+  CHECK_EQUAL(Move::MOVE_TYPE_FORCED_RECOVERY, recover.type());
+  CHECK_EQUAL(7, recover.unit());
+  CHECK_EQUAL(UnitArena::k_NULL_HANDLE, recover.target());
+  CHECK_TRUE(recover.recover());
+  CHECK_FALSE(stay.recover());
+  CHECK_TRUE(recover != stay);
+}
+
+TEST(MoveTest, equality_operators) {
+  CHECK_TRUE(Move::drop(1, Posn(0, 0)) == Move::drop(1, Posn(0, 0)));
+  CHECK_TRUE(Move::drop(1, Posn(0, 0)) != Move::move(1, Posn(0, 0)));
+  CHECK_TRUE(Move::drop(1, Posn(0, 0)) != Move::drop(2, Posn(0, 0)));
+  CHECK_TRUE(Move::drop(1, Posn(0, 0)) != Move::drop(1, Posn(0, 1)));
+  CHECK_TRUE(Move() == Move());
+}
+
+TEST(MoveTest, decode_restores_encoded_move) {
+  const Move moves[] = {
+    Move(),
+    Move::drop(1, Posn(8, 8)),
+    Move::move(2, Posn(3, 4)),
+    Move::immobileStrike(3, 4),
+    Move::exchange(GUNGI_EFFECT_SUBSTITUTION, 5, 6),
+    Move::forcedRecovery(7, true),
+    Move::forcedRecovery(7, false),
+  };
+
+  for (const Move& move : moves) {
+    CHECK_TRUE(move == Move::decode(move.encode()));
+  }
+
+  CHECK_TRUE(moves[5].encode() != moves[6].encode());
+}
+
+TEST(MoveTest, output_stream_operator_returns_formatted_output) {
+  std::ostringstream oss;
+  oss << Move::drop(1, Posn(2, 3)) << " " << Move::immobileStrike(4, 5);
+
+  CHECK_TRUE(oss.str() == "Move(Drop, unit=1, to=Posn(2, 3)) "
+                          "Move(ImmobileStrike, unit=4, target=5)");
+}
+
+TEST(MoveTest, move_list_adds_and_clears) {
+  MoveList moves;
+
+  CHECK_TRUE(moves.empty());
+  CHECK_TRUE(moves.begin() == moves.end());
+
+  moves.add(Move::drop(1, Posn(0, 0)));
+  moves.add(Move::move(2, Posn(1, 1)));
+
+  CHECK_EQUAL(2, moves.size());
+  CHECK_FALSE(moves.empty());
+  CHECK_TRUE(moves[1] == Move::move(2, Posn(1, 1)));
+  CHECK_TRUE(moves.contains(Move::drop(1, Posn(0, 0))));
+  CHECK_FALSE(moves.contains(Move::drop(1, Posn(0, 1))));
+
+  unsigned int count = 0;
+  for (const Move& move : moves) {
+    CHECK_TRUE(move == moves[count]);
+    count++;
+  }
+  CHECK_EQUAL(2, count);
+
+  moves.swap(0, 1);
+
+  CHECK_TRUE(moves[0] == Move::move(2, Posn(1, 1)));
+  CHECK_TRUE(moves[1] == Move::drop(1, Posn(0, 0)));
+
+  moves.clear();
+
+  CHECK_TRUE(moves.empty());
+  CHECK_FALSE(moves.contains(Move::drop(1, Posn(0, 0))));
+}
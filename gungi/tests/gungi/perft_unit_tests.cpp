@@ -0,0 +1,69 @@
+// perft_unit_tests.cpp                                               -*-C++-*-
+#include "perft.hpp"
+
+#include "gtypes.hpp"
+#include "logician.hpp"
+#include "move.hpp"
+#include "threadpool.hpp"
+
+#include <CppUTest/TestHarness.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace gungi;
+
+TEST_GROUP(PerftTest) {
+  void setup(void) {
+    return;
+  }
+
+  void teardown(void) {
+    return;
+  }
+};
+
+TEST(PerftTest, count_of_depth_zero_is_one) {
+  Logician game;
+  CHECK_EQUAL(1, Perft::count(game, 0));
+}
+
+TEST(PerftTest, count_of_depth_one_is_number_of_moves) {
+  Logician game;
+  MoveList moves;
+  game.generateMoves(moves);
+
+  CHECK_EQUAL(moves.size(), Perft::count(game, 1));
+}
+
+TEST(PerftTest, count_of_initial_arrangement) {
+  // Each player can drop one unit of any of their 12 kinds of unit onto any
+  // of the 27 squares of their territory.
+  Logician game;
+
+  CHECK_EQUAL(324, Perft::count(game, 1));
+  CHECK_EQUAL(324 * 324, Perft::count(game, 2));
+}
+
+TEST(PerftTest, divide_sums_to_count) {
+  Logician game;
+  ThreadPool pool(4);
+  std::vector<Perft::divide_t> counts;
+
+  const uint64_t nodes = Perft::divide(game, 2, pool, counts);
+  CHECK_EQUAL(Perft::count(game, 2), nodes);
+
+  MoveList moves;
+  game.generateMoves(moves);
+  CHECK_EQUAL(moves.size(), counts.size());
+
+  error_t error;
+  for (unsigned int idx = 0; idx < counts.size(); idx++) {
+    CHECK_TRUE(moves[idx] == counts[idx].move);
+
+    Logician child(game);
+    child.playMove(moves[idx], error);
+    CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+    CHECK_EQUAL(Perft::count(child, 1), counts[idx].nodes);
+  }
+}
@@ -126,15 +126,18 @@ TEST(PlayerTest, active_units_returns_active_units_only) {
 
   CHECK_EQUAL(GUNGI_ERROR_NONE, error);
   CHECK_EQUAL(1, player.activeUnits().size());
-  CHECK_TRUE(&unit1 == player.activeUnits()[0].get());
+  CHECK_TRUE(&unit1 == player.activeUnits()[0]);
 
   player.addUnit(&unit2, error);
 
   CHECK_EQUAL(GUNGI_ERROR_NONE, error);
   CHECK_EQUAL(1, player.activeUnits().size());
-  CHECK_TRUE(&unit1 == player.activeUnits()[0].get());
+  CHECK_TRUE(&unit1 == player.activeUnits()[0]);
 
   unit2.setTower(&tower);
+  player.activate(&unit2, error);
+
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
   CHECK_EQUAL(2, player.activeUnits().size());
 }
 
@@ -161,12 +164,173 @@ TEST(PlayerTest, inactive_unit_returns_inactive_units_only) {
 
   CHECK_EQUAL(GUNGI_ERROR_NONE, error);
   CHECK_EQUAL(1, player.inactiveUnits().size());
-  CHECK_TRUE(&unit2 == player.inactiveUnits()[0].get());
+  CHECK_TRUE(&unit2 == player.inactiveUnits()[0]);
 
   unit2.setTower(&tower);
+  player.activate(&unit2, error);
+
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
   CHECK_EQUAL(0, player.inactiveUnits().size());
 }
 
+TEST(PlayerTest, deactivate_moves_unit_to_inactive_units) {
+  Player player(BLACK);
+
+  const Builder builder;
+  Unit unit1(GUNGI_PIECE_PAWN, GUNGI_PIECE_NONE, player.colour(), builder);
+  Unit unit2(GUNGI_PIECE_PAWN, GUNGI_PIECE_NONE, player.colour(), builder);
+
+  Posn posn(0, 1);
+  Tower tower(posn);
+  unit1.setTower(&tower);
+
+  error_t error;
+  player.addUnit(&unit1, error);
+  player.addUnit(&unit2, error);
+
+  player.activate(&unit1, error);
+  CHECK_EQUAL(GUNGI_ERROR_NOT_A_MEMBER, error);
+
+  player.deactivate(&unit2, error);
+  CHECK_EQUAL(GUNGI_ERROR_NOT_A_MEMBER, error);
+
+  unit1.setTower(NULL);
+  player.deactivate(&unit1, error);
+
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+  CHECK_EQUAL(0, player.activeUnits().size());
+  CHECK_EQUAL(2, player.inactiveUnits().size());
+  CHECK_EQUAL(2, player.units().size());
+
+  player.removeUnit(&unit1, error);
+
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+  CHECK_EQUAL(1, player.inactiveUnits().size());
+  CHECK_TRUE(&unit2 == player.inactiveUnits()[0]);
+}
+
+TEST(PlayerTest, hand_kind_distinguishes_flipped_units) {
+  const unsigned int pawn = Player::handKind(GUNGI_PIECE_PAWN,
+                                             GUNGI_PIECE_BRONZE);
+  const unsigned int bronze = Player::handKind(GUNGI_PIECE_BRONZE,
+                                               GUNGI_PIECE_PAWN);
+  const unsigned int commander = Player::handKind(GUNGI_PIECE_COMMANDER,
+                                                  GUNGI_PIECE_NONE);
+
+  CHECK_TRUE(pawn < Player::k_NUM_HAND_KINDS);
+  CHECK_TRUE(bronze < Player::k_NUM_HAND_KINDS);
+  CHECK_TRUE(commander < Player::k_NUM_HAND_KINDS);
+  CHECK_TRUE(pawn != bronze);
+  CHECK_EQUAL(Player::k_NUM_HAND_KINDS,
+              Player::handKind(GUNGI_PIECE_PAWN, GUNGI_PIECE_NONE));
+}
+
+TEST(PlayerTest, hand_counts_track_units_in_hand) {
+  Player player(BLACK);
+
+  const Builder builder;
+  Unit unit1(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, player.colour(), builder);
+  Unit unit2(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, player.colour(), builder);
+  Unit unit3(GUNGI_PIECE_BOW, GUNGI_PIECE_ARROW, player.colour(), builder);
+
+  const unsigned int pawn = Player::handKind(GUNGI_PIECE_PAWN,
+                                             GUNGI_PIECE_BRONZE);
+  const unsigned int bow = Player::handKind(GUNGI_PIECE_BOW,
+                                            GUNGI_PIECE_ARROW);
+
+  error_t error;
+  player.addUnit(&unit1, error);
+  player.addUnit(&unit2, error);
+  player.addUnit(&unit3, error);
+
+  CHECK_EQUAL(2, player.handCount(pawn));
+  CHECK_EQUAL(1, player.handCount(bow));
+  CHECK_EQUAL(0, player.handCount(Player::k_NUM_HAND_KINDS));
+  CHECK_TRUE(&unit2 == player.handUnit(pawn));
+
+  Posn posn(0, 1);
+  Tower tower(posn);
+  unit2.setTower(&tower);
+  player.activate(&unit2, error);
+
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+  CHECK_EQUAL(1, player.handCount(pawn));
+  CHECK_TRUE(&unit1 == player.handUnit(pawn));
+
+  player.removeUnit(&unit1, error);
+
+  CHECK_EQUAL(0, player.handCount(pawn));
+  CHECK_TRUE(NULL == player.handUnit(pawn));
+
+  unit2.setTower(NULL);
+  player.deactivate(&unit2, error);
+
+  CHECK_EQUAL(1, player.handCount(pawn));
+  CHECK_TRUE(&unit2 == player.handUnit(pawn));
+
+  player.reset();
+
+  CHECK_EQUAL(0, player.handCount(pawn));
+  CHECK_EQUAL(0, player.handCount(bow));
+}
+
+TEST(PlayerTest, remove_unit_from_middle_keeps_other_units) {
+  Player player(BLACK);
+
+  const Builder builder;
+  Unit unit1(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, player.colour(), builder);
+  Unit unit2(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, player.colour(), builder);
+  Unit unit3(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, player.colour(), builder);
+
+  const unsigned int pawn = Player::handKind(GUNGI_PIECE_PAWN,
+                                             GUNGI_PIECE_BRONZE);
+
+  error_t error;
+  player.addUnit(&unit1, error);
+  player.addUnit(&unit2, error);
+  player.addUnit(&unit3, error);
+
+  player.removeUnit(&unit2, error);
+
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+  CHECK_EQUAL(2, player.units().size());
+  CHECK_EQUAL(2, player.inactiveUnits().size());
+  CHECK_EQUAL(2, player.handCount(pawn));
+  CHECK_TRUE(&unit1 == player.units()[0]);
+  CHECK_TRUE(&unit3 == player.units()[1]);
+  CHECK_TRUE(&unit1 == player.inactiveUnits()[0]);
+  CHECK_TRUE(&unit3 == player.inactiveUnits()[1]);
+
+  player.removeUnit(&unit2, error);
+
+  CHECK_EQUAL(GUNGI_ERROR_NOT_A_MEMBER, error);
+
+  // The unit moved into the place of the removed one is still found.
+  Posn posn(0, 1);
+  Tower tower(posn);
+  unit3.setTower(&tower);
+  player.activate(&unit3, error);
+
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+  CHECK_EQUAL(1, player.activeUnits().size());
+  CHECK_EQUAL(1, player.inactiveUnits().size());
+  CHECK_EQUAL(1, player.handCount(pawn));
+  CHECK_TRUE(&unit1 == player.handUnit(pawn));
+
+  player.removeUnit(&unit3, error);
+
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+  CHECK_EQUAL(1, player.units().size());
+  CHECK_EQUAL(0, player.activeUnits().size());
+  CHECK_TRUE(&unit1 == player.units()[0]);
+
+  player.addUnit(&unit2, error);
+
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+  CHECK_EQUAL(2, player.units().size());
+  CHECK_EQUAL(2, player.handCount(pawn));
+}
+
 TEST(PlayerTest, units_returns_empty) {
   const Builder builder;
   Player player(BLACK);
@@ -0,0 +1,78 @@
+// threadpool_unit_tests.cpp                                          -*-C++-*-
+#include "threadpool.hpp"
+
+#include <CppUTest/TestHarness.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace gungi;
+
+TEST_GROUP(ThreadPoolTest) {
+  void setup(void) {
+    return;
+  }
+
+  void teardown(void) {
+    return;
+  }
+};
+
+TEST(ThreadPoolTest, constructor_creates_workers) {
+  ThreadPool pool(3);
+  CHECK_EQUAL(3, pool.size());
+
+  ThreadPool hardware;
+  CHECK_TRUE(hardware.size() > 0);
+}
+
+TEST(ThreadPoolTest, run_calls_every_task_once) {
+  ThreadPool pool(4);
+  std::vector<unsigned int> calls(1000, 0);
+
+  pool.run(calls.size(), [&](unsigned int idx) {
+    calls[idx]++;
+  });
+
+  for (unsigned int idx = 0; idx < calls.size(); idx++) {
+    CHECK_EQUAL(1, calls[idx]);
+  }
+}
+
+TEST(ThreadPoolTest, run_can_be_repeated) {
+  ThreadPool pool(2);
+  std::atomic<unsigned int> total(0);
+
+  for (unsigned int batch = 0; batch < 50; batch++) {
+    pool.run(batch, [&](unsigned int idx) {
+      total += idx + 1;
+    });
+  }
+
+  // Batch 'n' adds '1 + 2 + ... + n'.
+  unsigned int expected = 0;
+  for (unsigned int batch = 0; batch < 50; batch++) {
+    expected += batch * (batch + 1) / 2;
+  }
+  CHECK_EQUAL(expected, total.load());
+}
+
+TEST(ThreadPoolTest, idle_workers_steal_tasks) {
+  ThreadPool pool(2);
+  std::atomic<unsigned int> done(0);
+
+  // The even tasks are dealt to the first worker's queue, and the first of
+  // them holds up whichever worker runs it until every other task has
+  // finished, which can only happen if the other worker steals.
+  pool.run(8, [&](unsigned int idx) {
+    if (idx == 0) {
+      while (done.load() < 7) {
+        std::this_thread::yield();
+      }
+    }
+    done++;
+  });
+
+  CHECK_EQUAL(8, done.load());
+}
@@ -3,6 +3,7 @@
 
 #include "builder.hpp"
 #include "unit.hpp"
+#include "unitarena.hpp"
 
 #include <CppUTest/TestHarness.h>
 
@@ -12,17 +13,27 @@ using namespace gungi;
 
 const Builder builder;
 const Posn posn(0, 1);
-Unit pawn(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, WHITE, builder);
-Unit spy(GUNGI_PIECE_SPY, GUNGI_PIECE_CLANDESTINITE, WHITE, builder);
-Unit bow(GUNGI_PIECE_BOW, GUNGI_PIECE_ARROW, WHITE, builder);
-Unit pike(GUNGI_PIECE_PIKE, GUNGI_PIECE_SAMURAI, WHITE, builder);
+UnitArena arena;
+const unit_handle_t pawnHandle =
+  arena.create(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, WHITE, builder);
+const unit_handle_t spyHandle =
+  arena.create(GUNGI_PIECE_SPY, GUNGI_PIECE_CLANDESTINITE, WHITE, builder);
+const unit_handle_t bowHandle =
+  arena.create(GUNGI_PIECE_BOW, GUNGI_PIECE_ARROW, WHITE, builder);
+const unit_handle_t pikeHandle =
+  arena.create(GUNGI_PIECE_PIKE, GUNGI_PIECE_SAMURAI, WHITE, builder);
+const unit_handle_t newPawnHandle =
+  arena.create(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, WHITE, builder);
+Unit& pawn = arena[pawnHandle];
+Unit& spy = arena[spyHandle];
+Unit& bow = arena[bowHandle];
+Unit& pike = arena[pikeHandle];
 
 TEST_GROUP(TowerTest) {
   void setup(void) {
-    pawn.clearTower();
-    spy.clearTower();
-    bow.clearTower();
-    pike.clearTower();
+    for (Unit& unit : arena) {
+      unit.clearTower();
+    }
   }
 
   void teardown(void) {
@@ -82,7 +93,7 @@ TEST(TowerTest, add_unit_to_tower_succeeds) {
   Tower tower(posn);
   error_t error;
 
-  tower.add(&pawn, error);
+  tower.add(pawnHandle, arena, error);
 
   CHECK_EQUAL(1, tower.height());
   POINTERS_EQUAL(&tower, pawn.tower());
@@ -93,23 +104,23 @@ TEST(TowerTest, add_unit_to_tower_returns_duplicate_on_member) {
   Tower tower(posn);
   error_t error;
 
-  tower.add(&pawn, error);
+  tower.add(pawnHandle, arena, error);
 
   CHECK_EQUAL(1, tower.height());
   POINTERS_EQUAL(&tower, pawn.tower());
   CHECK_EQUAL(GUNGI_ERROR_NONE, error);
 
-  tower.add(&pawn, error);
+  tower.add(pawnHandle, arena, error);
 
   CHECK_EQUAL(1, tower.height());
   POINTERS_EQUAL(&tower, pawn.tower());
   CHECK_EQUAL(GUNGI_ERROR_DUPLICATE, error);
 
-  Unit newPawn(pawn);
+  const Unit& newPawn = arena[newPawnHandle];
   CHECK_EQUAL(pawn.colour(), newPawn.colour());
   CHECK_EQUAL(pawn.front(), newPawn.front());
 
-  tower.add(&newPawn, error);
+  tower.add(newPawnHandle, arena, error);
   CHECK_EQUAL(1, tower.height());
   CHECK_EQUAL(GUNGI_ERROR_DUPLICATE, error);
 }
@@ -118,19 +129,19 @@ TEST(TowerTest, add_unit_to_tower_returns_full_on_full_tower) {
   Tower tower(posn);
   error_t error;
 
-  tower.add(&pawn, error);
+  tower.add(pawnHandle, arena, error);
   CHECK_EQUAL(GUNGI_ERROR_NONE, error);
 
-  tower.add(&spy, error);
+  tower.add(spyHandle, arena, error);
   CHECK_EQUAL(GUNGI_ERROR_NONE, error);
 
-  tower.add(&bow, error);
+  tower.add(bowHandle, arena, error);
   CHECK_EQUAL(GUNGI_ERROR_NONE, error);
 
   CHECK_EQUAL(Tower::k_MAX_HEIGHT, tower.height());
   CHECK_EQUAL(GUNGI_ERROR_NONE, error);
 
-  tower.add(&pike, error);
+  tower.add(pikeHandle, arena, error);
 
   CHECK_EQUAL(Tower::k_MAX_HEIGHT, tower.height());
   CHECK_EQUAL(GUNGI_ERROR_FULL_TOWER, error);
@@ -141,11 +152,11 @@ TEST(TowerTest, remove_succeeds_if_unit_member) {
   Tower tower(posn);
   error_t error;
 
-  tower.add(&pawn, error);
+  tower.add(pawnHandle, arena, error);
 
   POINTERS_EQUAL(&tower, pawn.tower());
 
-  tower.remove(&pawn, error);
+  tower.remove(pawnHandle, arena, error);
 
   CHECK_EQUAL(0, tower.height());
   CHECK_EQUAL(GUNGI_ERROR_NONE, error);
@@ -156,7 +167,7 @@ TEST(TowerTest, remove_fails_with_not_a_member_if_unit_not_a_member) {
   Tower tower(posn);
   error_t error;
 
-  tower.remove(&pawn, error);
+  tower.remove(pawnHandle, arena, error);
 
   CHECK_EQUAL(GUNGI_ERROR_NOT_A_MEMBER, error);
 }
@@ -165,7 +176,7 @@ TEST(TowerTest, reset_resets_the_tower) {
   Tower tower(posn);
   error_t error;
 
-  tower.add(&pawn, error);
+  tower.add(pawnHandle, arena, error);
 
   CHECK_EQUAL(1, tower.height());
 
@@ -192,7 +203,7 @@ TEST(TowerTest, height_returns_one_on_add) {
 
   CHECK_EQUAL(0, tower.height());
 
-  tower.add(&pawn, error);
+  tower.add(pawnHandle, arena, error);
 
   CHECK_EQUAL(1, tower.height());
 }
@@ -212,13 +223,13 @@ TEST(TowerTest, tier_returns_correct_tier_for_member) {
   error_t error;
   tier_t tier;
 
-  tower.add(&pawn, error);
+  tower.add(pawnHandle, arena, error);
   CHECK_EQUAL(GUNGI_ERROR_NONE, error);
 
-  tower.add(&spy, error);
+  tower.add(spyHandle, arena, error);
   CHECK_EQUAL(GUNGI_ERROR_NONE, error);
 
-  tower.add(&bow, error);
+  tower.add(bowHandle, arena, error);
   CHECK_EQUAL(GUNGI_ERROR_NONE, error);
 
   tier = tower.tier(&pawn, error);
@@ -242,74 +253,74 @@ TEST(TowerTest, at_test) {
   error_t error;
   tier_t tier;
 
-  const Unit *u = NULL;
+  unit_handle_t u = UnitArena::k_NULL_HANDLE;
 
   u = tower.at(0, error);
 
   CHECK_EQUAL(GUNGI_ERROR_OUT_OF_RANGE, error);
-  POINTERS_EQUAL((void *)NULL, u);
+  CHECK_EQUAL(UnitArena::k_NULL_HANDLE, u);
 
   u = tower.at(1, error);
 
   CHECK_EQUAL(GUNGI_ERROR_OUT_OF_RANGE, error);
-  POINTERS_EQUAL((void *)NULL, u);
+  CHECK_EQUAL(UnitArena::k_NULL_HANDLE, u);
 
   u = tower.at(2, error);
 
   CHECK_EQUAL(GUNGI_ERROR_OUT_OF_RANGE, error);
-  POINTERS_EQUAL((void *)NULL, u);
+  CHECK_EQUAL(UnitArena::k_NULL_HANDLE, u);
 
-  tower.add(&pawn, error);
+  tower.add(pawnHandle, arena, error);
 
   u = tower.at(0, error);
 
   CHECK_EQUAL(GUNGI_ERROR_NONE, error);
-  POINTERS_EQUAL(&pawn, u);
+  CHECK_EQUAL(pawnHandle, u);
 
   u = tower.at(1, error);
 
   CHECK_EQUAL(GUNGI_ERROR_OUT_OF_RANGE, error);
-  POINTERS_EQUAL((void *)NULL, u);
+  CHECK_EQUAL(UnitArena::k_NULL_HANDLE, u);
 
   u = tower.at(2, error);
 
   CHECK_EQUAL(GUNGI_ERROR_OUT_OF_RANGE, error);
-  POINTERS_EQUAL((void *)NULL, u);
+  CHECK_EQUAL(UnitArena::k_NULL_HANDLE, u);
 
-  tower.add(&spy, error);
+  tower.add(spyHandle, arena, error);
   CHECK_EQUAL(GUNGI_ERROR_NONE, error);
 
   u = tower.at(0, error);
 
   CHECK_EQUAL(GUNGI_ERROR_NONE, error);
-  POINTERS_EQUAL(&pawn, u);
+  CHECK_EQUAL(pawnHandle, u);
 
   u = tower.at(1, error);
 
   CHECK_EQUAL(GUNGI_ERROR_NONE, error);
-  POINTERS_EQUAL(&spy, u);
+  CHECK_EQUAL(spyHandle, u);
 
   u = tower.at(2, error);
 
   CHECK_EQUAL(GUNGI_ERROR_OUT_OF_RANGE, error);
-  POINTERS_EQUAL((void *)NULL, u);
+  CHECK_EQUAL(UnitArena::k_NULL_HANDLE, u);
 
-  tower.add(&bow, error);
+  tower.add(bowHandle, arena, error);
 
   u = tower.at(0, error);
 
   CHECK_EQUAL(GUNGI_ERROR_NONE, error);
-  POINTERS_EQUAL(&pawn, u);
+  CHECK_EQUAL(pawnHandle, u);
 
   u = tower.at(1, error);
 
   CHECK_EQUAL(GUNGI_ERROR_NONE, error);
-  POINTERS_EQUAL(&spy, u);
+  CHECK_EQUAL(spyHandle, u);
 
   u = tower.at(2, error);
 
   CHECK_EQUAL(GUNGI_ERROR_NONE, error);
-  POINTERS_EQUAL(&bow, u);
+  CHECK_EQUAL(bowHandle, u);
 }
 
 TEST(TowerTest, posn_returns_tower_posn) {
@@ -318,21 +329,139 @@ TEST(TowerTest, posn_returns_tower_posn) {
   CHECK_TRUE(posn == tower.posn());
 }
 
-TEST(TowerTest, members_returns_empty_on_empty_tower) {
+TEST(TowerTest, top_returns_null_on_empty_tower) {
   Tower tower(posn);
 
-  CHECK_EQUAL(0, tower.members().size());
+  CHECK_EQUAL(UnitArena::k_NULL_HANDLE, tower.top());
 }
 
-TEST(TowerTest, members_returns_constant_vector) {
+TEST(TowerTest, top_returns_highest_unit) {
   Tower tower(posn);
   error_t error;
-  tower.add(&pawn, error);
 
-  const SharedUnitPtrVector& members = tower.members();
-  CHECK_EQUAL(1, members.size());
+  tower.add(pawnHandle, arena, error);
+  CHECK_EQUAL(pawnHandle, tower.top());
 
-  for (const SharedUnitPtr& ptr : members) {
-    POINTERS_EQUAL(&pawn, ptr.get());
-  }
+  tower.add(spyHandle, arena, error);
+  CHECK_EQUAL(spyHandle, tower.top());
+
+  tower.remove(spyHandle, arena, error);
+  CHECK_EQUAL(pawnHandle, tower.top());
+}
+
+TEST(TowerTest, remove_shifts_units_above_down_a_tier) {
+  Tower tower(posn);
+  error_t error;
+
+  tower.add(pawnHandle, arena, error);
+  tower.add(spyHandle, arena, error);
+  tower.add(bowHandle, arena, error);
+
+  tower.remove(pawnHandle, arena, error);
+
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+  CHECK_EQUAL(2, tower.height());
+  CHECK_EQUAL(spyHandle, tower.at(0, error));
+  CHECK_EQUAL(bowHandle, tower.at(1, error));
+  CHECK_EQUAL(0, spy.tier());
+  CHECK_EQUAL(1, bow.tier());
+  CHECK_EQUAL(0, tower.tier(&spy, error));
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+
+  tower.tier(&pawn, error);
+
+  CHECK_EQUAL(GUNGI_ERROR_NOT_A_MEMBER, error);
+}
+
+TEST(TowerTest, insert_shifts_units_up_a_tier) {
+  Tower tower(posn);
+  error_t error;
+
+  tower.add(pawnHandle, arena, error);
+  tower.add(bowHandle, arena, error);
+
+  tower.insert(1, spyHandle, arena, error);
+
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+  CHECK_EQUAL(3, tower.height());
+  CHECK_EQUAL(pawnHandle, tower.at(0, error));
+  CHECK_EQUAL(spyHandle, tower.at(1, error));
+  CHECK_EQUAL(bowHandle, tower.at(2, error));
+  CHECK_EQUAL(1, spy.tier());
+  CHECK_EQUAL(2, bow.tier());
+  POINTERS_EQUAL(&tower, spy.tower());
+
+  tower.insert(0, spyHandle, arena, error);
+
+  CHECK_EQUAL(GUNGI_ERROR_FULL_TOWER, error);
+
+  tower.remove(spyHandle, arena, error);
+  tower.insert(3, spyHandle, arena, error);
+
+  CHECK_EQUAL(GUNGI_ERROR_OUT_OF_RANGE, error);
+  CHECK_EQUAL(2, tower.height());
+}
+
+TEST(TowerTest, tier_returns_not_a_member_for_unit_in_other_tower) {
+  Tower tower(posn);
+  Tower other(Posn(1, 1));
+  error_t error;
+
+  tower.add(pawnHandle, arena, error);
+  other.add(spyHandle, arena, error);
+
+  tower.tier(&spy, error);
+
+  CHECK_EQUAL(GUNGI_ERROR_NOT_A_MEMBER, error);
+}
+
+TEST(TowerTest, exchange_swaps_tiers) {
+  Tower tower(posn);
+  error_t error;
+
+  tower.add(pawnHandle, arena, error);
+  tower.add(spyHandle, arena, error);
+  tower.add(bowHandle, arena, error);
+
+  tower.exchange(0, 2, arena, error);
+
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+  CHECK_EQUAL(bowHandle, tower.at(0, error));
+  CHECK_EQUAL(pawnHandle, tower.at(2, error));
+  CHECK_EQUAL(0, bow.tier());
+  CHECK_EQUAL(2, pawn.tier());
+
+  tower.exchange(0, 3, arena, error);
+
+  CHECK_EQUAL(GUNGI_ERROR_OUT_OF_RANGE, error);
+}
+
+TEST(TowerTest, replace_swaps_units_between_towers) {
+  Tower tower(posn);
+  Tower other(Posn(1, 1));
+  error_t error;
+
+  tower.add(pawnHandle, arena, error);
+  other.add(spyHandle, arena, error);
+  other.add(bowHandle, arena, error);
+
+  unit_handle_t replaced = tower.replace(0, bowHandle, arena, error);
+
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+  CHECK_EQUAL(pawnHandle, replaced);
+
+  other.replace(1, replaced, arena, error);
+
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+  CHECK_EQUAL(bowHandle, tower.top());
+  CHECK_EQUAL(pawnHandle, other.top());
+  POINTERS_EQUAL(&tower, bow.tower());
+  POINTERS_EQUAL(&other, pawn.tower());
+  CHECK_EQUAL(0, bow.tier());
+  CHECK_EQUAL(1, pawn.tier());
+
+  replaced = tower.replace(1, pikeHandle, arena, error);
+
+  CHECK_EQUAL(GUNGI_ERROR_OUT_OF_RANGE, error);
+  CHECK_EQUAL(UnitArena::k_NULL_HANDLE, replaced);
 }
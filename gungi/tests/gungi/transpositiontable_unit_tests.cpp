@@ -0,0 +1,138 @@
+// transpositiontable_unit_tests.cpp                                  -*-C++-*-
+#include "transpositiontable.hpp"
+
+#include "move.hpp"
+#include "posn.hpp"
+
+#include <CppUTest/TestHarness.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace gungi;
+
+TEST_GROUP(TranspositionTableTest) {
+  void setup(void) {
+    return;
+  }
+
+  void teardown(void) {
+    return;
+  }
+};
+
+TEST(TranspositionTableTest, constructor_creates_power_of_two_slots) {
+  TranspositionTable table(1);
+  CHECK_EQUAL(65536, table.size());
+  CHECK_FALSE(table.isHugePages());
+
+  TranspositionTable tiny(0);
+  CHECK_EQUAL(1, tiny.size());
+
+  // Huge pages are a request, which the system may turn down.
+  TranspositionTable huge(4, true);
+  CHECK_EQUAL(262144, huge.size());
+}
+
+TEST(TranspositionTableTest, probe_returns_stored_entry) {
+  TranspositionTable table(1);
+  TranspositionTable::entry_t entry;
+  CHECK_FALSE(table.probe(0, entry));
+  CHECK_FALSE(table.probe(12345, entry));
+
+  TranspositionTable::entry_t stored;
+  stored.move = Move::move(3, Posn(4, 5));
+  stored.score = -TranspositionTable::k_MAX_SCORE;
+  stored.depth = TranspositionTable::k_MAX_DEPTH;
+  stored.bound = TranspositionTable::BOUND_LOWER;
+  table.store(12345, stored);
+
+  CHECK_TRUE(table.probe(12345, entry));
+  CHECK_TRUE(stored.move == entry.move);
+  CHECK_EQUAL(stored.score, entry.score);
+  CHECK_EQUAL(stored.depth, entry.depth);
+  CHECK_EQUAL(stored.bound, entry.bound);
+
+  // Another key in the same slot does not match.
+  CHECK_FALSE(table.probe(12345 + table.size(), entry));
+
+  table.clear();
+  CHECK_FALSE(table.probe(12345, entry));
+}
+
+TEST(TranspositionTableTest, store_keeps_deeper_entry_of_search) {
+  TranspositionTable table(1);
+  const uint64_t key = 42;
+  const uint64_t other = key + table.size();
+
+  TranspositionTable::entry_t deep;
+  deep.move = Move::drop(1, Posn(0, 0));
+  deep.score = 100;
+  deep.depth = 6;
+  deep.bound = TranspositionTable::BOUND_EXACT;
+  table.store(key, deep);
+
+  TranspositionTable::entry_t shallow;
+  shallow.move = Move();
+  shallow.score = -100;
+  shallow.depth = 2;
+  shallow.bound = TranspositionTable::BOUND_UPPER;
+  table.store(other, shallow);
+
+  TranspositionTable::entry_t entry;
+  CHECK_TRUE(table.probe(key, entry));
+  CHECK_FALSE(table.probe(other, entry));
+
+  // A result of a new search takes the slot, whatever its depth.
+  table.newSearch();
+  table.store(other, shallow);
+  CHECK_FALSE(table.probe(key, entry));
+  CHECK_TRUE(table.probe(other, entry));
+  CHECK_EQUAL(-100, entry.score);
+
+  // A deeper result of the same position without a move keeps its move.
+  table.store(key, deep);
+  deep.move = Move();
+  deep.depth = 7;
+  table.store(key, deep);
+  CHECK_TRUE(table.probe(key, entry));
+  CHECK_TRUE(Move::drop(1, Posn(0, 0)) == entry.move);
+  CHECK_EQUAL(7, entry.depth);
+}
+
+TEST(TranspositionTableTest, concurrent_stores_never_return_torn_entries) {
+  // Every thread stores entries whose fields are derived from the key, into
+  // a table small enough that the threads collide on its slots; any entry
+  // found must belong to the key it is found for.
+  TranspositionTable table(0);
+  std::atomic<unsigned int> torn(0);
+  std::vector<std::thread> threads;
+  for (unsigned int id = 0; id < 4; id++) {
+    threads.push_back(std::thread([&table, &torn, id](void) {
+      for (uint64_t i = 0; i < 20000; i++) {
+        const uint64_t key = (i * 4 + id) * 0x9E3779B97F4A7C15ULL;
+
+        TranspositionTable::entry_t stored;
+        stored.move = Move::drop(key % 64, Posn(key % 9, (key >> 8) % 9));
+        stored.score = static_cast<int>(key % 1000);
+        stored.depth = (key >> 16) % 32;
+        stored.bound = TranspositionTable::BOUND_EXACT;
+        table.store(key, stored);
+
+        TranspositionTable::entry_t entry;
+        if (table.probe(key, entry) &&
+            (entry.move != stored.move || entry.score != stored.score)) {
+          torn++;
+        }
+      }
+    }));
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  CHECK_EQUAL(0, torn.load());
+}
@@ -82,6 +82,20 @@ TEST(UnitTest, set_tower_sets_tower) {
   CHECK_EQUAL((void *)NULL, u.tower());
 }
 
+TEST(UnitTest, set_tower_sets_tier) {
+  Unit u(GUNGI_PIECE_PAWN, GUNGI_PIECE_NONE, BLACK, builder);
+  Posn posn(0, 1);
+  Tower tower(posn);
+
+  u.setTower(&tower, 2);
+
+  CHECK_EQUAL(2, u.tier());
+
+  u.clearTower();
+
+  CHECK_EQUAL(0, u.tier());
+}
+
 TEST(UnitTest, clear_tower_clears_tower) {
   Unit u(GUNGI_PIECE_PAWN, GUNGI_PIECE_NONE, BLACK, builder);
   Posn posn(0, 1);
@@ -0,0 +1,103 @@
+// unitarena_unit_tests.cpp                                           -*-C++-*-
+#include "unitarena.hpp"
+
+#include "builder.hpp"
+#include "gtypes.hpp"
+#include "unit.hpp"
+
+#include <CppUTest/TestHarness.h>
+
+using namespace gungi;
+
+TEST_GROUP(UnitArenaTest) {
+  void setup(void) {
+    return;
+  }
+
+  void teardown(void) {
+    return;
+  }
+};
+
+TEST(UnitArenaTest, constructor_creates_empty_arena) {
+  UnitArena arena;
+
+  CHECK_EQUAL(0, arena.size());
+  POINTERS_EQUAL(arena.begin(), arena.end());
+}
+
+TEST(UnitArenaTest, create_returns_sequential_handles) {
+  const Builder builder;
+  UnitArena arena;
+
+  unit_handle_t pawn = arena.create(GUNGI_PIECE_PAWN,
+                                    GUNGI_PIECE_BRONZE,
+                                    BLACK,
+                                    builder);
+  unit_handle_t commander = arena.create(GUNGI_PIECE_COMMANDER,
+                                         GUNGI_PIECE_NONE,
+                                         WHITE,
+                                         builder);
+
+  CHECK_EQUAL(0, pawn);
+  CHECK_EQUAL(1, commander);
+  CHECK_EQUAL(2, arena.size());
+
+  CHECK_EQUAL(GUNGI_PIECE_PAWN, arena[pawn].front());
+  CHECK_EQUAL(GUNGI_PIECE_BRONZE, arena[pawn].back());
+  CHECK_EQUAL(BLACK, arena[pawn].colour());
+  CHECK_EQUAL(GUNGI_PIECE_COMMANDER, arena[commander].front());
+  CHECK_EQUAL(WHITE, arena[commander].colour());
+  POINTERS_EQUAL(NULL, arena[commander].tower());
+}
+
+TEST(UnitArenaTest, handle_and_get_are_inverses) {
+  const Builder builder;
+  UnitArena arena;
+
+  for (unsigned int i = 0; i < UnitArena::k_CAPACITY; i++) {
+    unit_handle_t handle = arena.create(GUNGI_PIECE_PAWN,
+                                        GUNGI_PIECE_NONE,
+                                        BLACK,
+                                        builder);
+    CHECK_EQUAL(i, handle);
+    CHECK_EQUAL(handle, arena.handle(arena.get(handle)));
+  }
+
+  CHECK_EQUAL(UnitArena::k_CAPACITY, arena.size());
+  CHECK_EQUAL(UnitArena::k_CAPACITY, arena.end() - arena.begin());
+}
+
+TEST(UnitArenaTest, null_handle_and_foreign_units) {
+  const Builder builder;
+  UnitArena arena;
+  Unit unit(GUNGI_PIECE_PAWN, GUNGI_PIECE_NONE, BLACK, builder);
+
+  POINTERS_EQUAL(NULL, arena.get(UnitArena::k_NULL_HANDLE));
+  CHECK_EQUAL(UnitArena::k_NULL_HANDLE, arena.handle(NULL));
+  CHECK_EQUAL(UnitArena::k_NULL_HANDLE, arena.handle(&unit));
+}
+
+TEST(UnitArenaTest, reset_reuses_storage) {
+  const Builder builder;
+  UnitArena arena;
+
+  unit_handle_t handle = arena.create(GUNGI_PIECE_PAWN,
+                                      GUNGI_PIECE_NONE,
+                                      BLACK,
+                                      builder);
+  const Unit *first = arena.get(handle);
+
+  arena.reset();
+
+  CHECK_EQUAL(0, arena.size());
+  CHECK_EQUAL(UnitArena::k_NULL_HANDLE, arena.handle(first));
+
+  handle = arena.create(GUNGI_PIECE_SPY,
+                        GUNGI_PIECE_CLANDESTINITE,
+                        WHITE,
+                        builder);
+
+  POINTERS_EQUAL(first, arena.get(handle));
+  CHECK_EQUAL(GUNGI_PIECE_SPY, arena[handle].front());
+}
@@ -71,6 +71,60 @@ TEST(NilDeleterTest, nil_deleter_does_not_delete) {
   delete ptr;
 }
 
+TEST_GROUP(WalkerTest) {
+  void setup(void) {
+    return;
+  }
+
+  void teardown(void) {
+    return;
+  }
+};
+
+TEST(WalkerTest, walks_each_path_from_the_start) {
+  // The second tier Pawn can move up one, or two to either side.
+  Walker walker(GUNGI_PIECE_PAWN, 1, Posn(4, 4));
+  const Posn expected[] = {
+    Posn(4, 5), Posn(3, 4), Posn(2, 4), Posn(5, 4), Posn(6, 4)
+  };
+  const bool pathEnds[] = { true, false, true, false, true };
+
+  for (unsigned int i = 0; i < 5; i++) {
+    CHECK_TRUE(walker.next());
+    CHECK_TRUE(expected[i] == walker.posn());
+    CHECK_EQUAL(pathEnds[i], walker.isPathEnd());
+    CHECK_FALSE(walker.isUnlimited());
+  }
+
+  CHECK_FALSE(walker.next());
+}
+
+TEST(WalkerTest, unlimited_steps_stop_at_the_end) {
+  Walker walker(GUNGI_PIECE_LANCE, 0, Posn(4, 0), Posn(4, 3));
+
+  CHECK_TRUE(walker.next());
+  CHECK_TRUE(walker.isUnlimited());
+  CHECK_FALSE(walker.isPathEnd());
+  CHECK_TRUE(walker.next());
+  CHECK_TRUE(walker.next());
+  CHECK_TRUE(Posn(4, 3) == walker.posn());
+  CHECK_TRUE(walker.isPathEnd());
+  CHECK_FALSE(walker.next());
+}
+
+TEST(WalkerTest, unlimited_steps_stop_off_the_board) {
+  Walker walker(GUNGI_PIECE_LANCE, 0, Posn(4, 6));
+  unsigned int squares = 0;
+
+  while (walker.next()) {
+    squares++;
+  }
+
+  // Two squares on the board, then the first square off the board.
+  CHECK_EQUAL(3, squares);
+  CHECK_FALSE(walker.posn().isValid());
+}
+
 TEST_GROUP(UtilTest) {
   void setup(void) {
     return;
@@ -203,29 +257,31 @@ TEST(UtilTest, to_uppercase_uppercases_string) {
   }
 }
 
-TEST(UtilTest, find_shared_unit_ptr_vector_returns_iterator) {
+TEST(UtilTest, find_unit_ptr_vector_returns_iterator) {
   const Builder builder;
   Unit pawn(GUNGI_PIECE_PAWN, GUNGI_PIECE_NONE, BLACK, builder);
-  SharedUnitPtrVector v;
-  v.push_back(SharedUnitPtr(new Unit(pawn)));
-  v.push_back(SharedUnitPtr(new Unit(pawn)));
+  Unit units[] = { pawn, pawn };
+  UnitPtrVector v;
+  v.push_back(&units[0]);
+  v.push_back(&units[1]);
 
   CHECK_TRUE(Util::find(v, &pawn) == v.end());
-  CHECK_TRUE(Util::find(v, v[0].get()) == v.begin());
-  CHECK_TRUE(Util::find(v, v[1].get()) == (v.begin() + 1));
+  CHECK_TRUE(Util::find(v, &units[0]) == v.begin());
+  CHECK_TRUE(Util::find(v, &units[1]) == (v.begin() + 1));
 }
 
-TEST(UtilTest, find_const_shared_unit_ptr_vector_returns_iterator) {
+TEST(UtilTest, find_const_unit_ptr_vector_returns_iterator) {
   const Builder builder;
   Unit pawn(GUNGI_PIECE_PAWN, GUNGI_PIECE_NONE, BLACK, builder);
-  SharedUnitPtrVector v;
-  v.push_back(SharedUnitPtr(new Unit(pawn)));
-  v.push_back(SharedUnitPtr(new Unit(pawn)));
+  Unit units[] = { pawn, pawn };
+  UnitPtrVector v;
+  v.push_back(&units[0]);
+  v.push_back(&units[1]);
 
-  const SharedUnitPtrVector& v2 = v;
+  const UnitPtrVector& v2 = v;
   CHECK_TRUE(Util::find(v2, &pawn) == v2.end());
-  CHECK_TRUE(Util::find(v2, v[0].get()) == v2.begin());
-  CHECK_TRUE(Util::find(v2, v[1].get()) == (v2.begin() + 1));
+  CHECK_TRUE(Util::find(v2, &units[0]) == v2.begin());
+  CHECK_TRUE(Util::find(v2, &units[1]) == (v2.begin() + 1));
 }
 
 TEST(UtilTest, find_posn_set_returns_iterator) {
@@ -342,6 +398,30 @@ TEST(UtilTest, get_walk_returns_control_points_on_successful_walk) {
   CHECK_TRUE(end == points[1]);
 }
 
+TEST(UtilTest, get_walk_loads_walk_into_buffer) {
+  const Builder builder;
+  Unit lance(GUNGI_PIECE_LANCE, GUNGI_PIECE_NONE, BLACK, builder);
+
+  Posn walk[Util::k_MAX_WALK_LENGTH];
+  error_t error;
+  unsigned int length = Util::getWalk(&lance,
+                                      0,
+                                      Posn(4, 0),
+                                      Posn(4, 3),
+                                      walk,
+                                      error);
+
+  CHECK_EQUAL(GUNGI_ERROR_NONE, error);
+  CHECK_EQUAL(4, length);
+  for (unsigned int i = 0; i < length; i++) {
+    CHECK_TRUE(Posn(4, i) == walk[i]);
+  }
+
+  length = Util::getWalk(&lance, 0, Posn(4, 3), Posn(4, 0), walk, error);
+  CHECK_EQUAL(GUNGI_ERROR_NO_WALK, error);
+  CHECK_EQUAL(0, length);
+}
+
 TEST(UtilTest, get_walk_returns_empty_set_on_unsuccesful_walk) {
   const Builder builder;
   Unit pawn(GUNGI_PIECE_PAWN, GUNGI_PIECE_NONE, BLACK, builder);
@@ -0,0 +1,128 @@
+// zobrist_unit_tests.cpp                                             -*-C++-*-
+#include "zobrist.hpp"
+
+#include "builder.hpp"
+#include "gtypes.hpp"
+#include "player.hpp"
+#include "posn.hpp"
+#include "tower.hpp"
+#include "unit.hpp"
+#include "unitarena.hpp"
+
+#include <CppUTest/TestHarness.h>
+
+#include <cstdint>
+#include <set>
+
+using namespace gungi;
+
+TEST_GROUP(ZobristTest) {
+  void setup(void) {
+    return;
+  }
+
+  void teardown(void) {
+    return;
+  }
+};
+
+TEST(ZobristTest, unit_keys_are_distinct) {
+  std::set<uint64_t> keys;
+  const colour_t colours[] = { BLACK, WHITE };
+  unsigned int count = 0;
+
+  for (unsigned int square = 0; square < k_BOARD_LENGTH * k_BOARD_LENGTH;
+       square += 10) {
+    for (tier_t tier = 0; tier < k_MAX_TOWER_SIZE; tier++) {
+      for (colour_t colour : colours) {
+        for (int front = 0; front < GUNGI_NUM_PIECES; front++) {
+          for (int back = GUNGI_PIECE_NONE; back < GUNGI_NUM_PIECES; back++) {
+            keys.insert(Zobrist::unit(square,
+                                      tier,
+                                      colour,
+                                      static_cast<piece_id_t>(front),
+                                      static_cast<piece_id_t>(back)));
+            count++;
+          }
+        }
+      }
+    }
+  }
+
+  CHECK_EQUAL(count, keys.size());
+}
+
+TEST(ZobristTest, hand_and_side_keys_differ_from_unit_keys) {
+  const uint64_t unit = Zobrist::unit(0,
+                                      0,
+                                      BLACK,
+                                      GUNGI_PIECE_PAWN,
+                                      GUNGI_PIECE_BRONZE);
+  const uint64_t hand = Zobrist::hand(BLACK,
+                                      GUNGI_PIECE_PAWN,
+                                      GUNGI_PIECE_BRONZE);
+
+  CHECK_TRUE(unit != hand);
+  CHECK_TRUE(unit != Zobrist::side());
+  CHECK_TRUE(hand != Zobrist::side());
+  CHECK_TRUE(hand != Zobrist::hand(WHITE,
+                                   GUNGI_PIECE_PAWN,
+                                   GUNGI_PIECE_BRONZE));
+}
+
+TEST(ZobristTest, board_key_ignores_placement_order) {
+  const Builder builder;
+  UnitArena arena;
+  const unit_handle_t pawn =
+    arena.create(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, BLACK, builder);
+  const unit_handle_t spy =
+    arena.create(GUNGI_PIECE_SPY, GUNGI_PIECE_CLANDESTINITE, WHITE, builder);
+  board_t board;
+  for (unsigned int i = 0; i < board.size(); i++) {
+    board[i] = Tower(Posn(i % k_BOARD_LENGTH, i / k_BOARD_LENGTH));
+  }
+  error_t error;
+
+  CHECK_EQUAL(0, Zobrist::board(board, arena));
+
+  board[0].add(pawn, arena, error);
+  board[1].add(spy, arena, error);
+
+  const uint64_t expected =
+    Zobrist::unit(0, 0, BLACK, GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE) ^
+    Zobrist::unit(1, 0, WHITE, GUNGI_PIECE_SPY, GUNGI_PIECE_CLANDESTINITE);
+
+  CHECK_TRUE(expected == Zobrist::board(board, arena));
+
+  board[1].remove(spy, arena, error);
+  board[0].add(spy, arena, error);
+
+  CHECK_TRUE(expected != Zobrist::board(board, arena));
+}
+
+TEST(ZobristTest, hand_key_counts_identical_units) {
+  const Builder builder;
+  UnitArena arena;
+  const unit_handle_t a =
+    arena.create(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, BLACK, builder);
+  const unit_handle_t b =
+    arena.create(GUNGI_PIECE_PAWN, GUNGI_PIECE_BRONZE, BLACK, builder);
+  Tower tower(Posn(0, 0));
+  Player player(BLACK);
+  error_t error;
+
+  player.addUnit(&arena[a], error);
+  const uint64_t one = Zobrist::hand(player);
+
+  player.addUnit(&arena[b], error);
+  const uint64_t two = Zobrist::hand(player);
+
+  CHECK_TRUE(one != two);
+  CHECK_TRUE(two == 2 * Zobrist::hand(BLACK,
+                                      GUNGI_PIECE_PAWN,
+                                      GUNGI_PIECE_BRONZE));
+
+  tower.add(b, arena, error);
+
+  CHECK_TRUE(one == Zobrist::hand(player));
+}
@@ -0,0 +1,229 @@
+// main.cpp                                                           -*-C++-*-
+//@DESCRIPTION:
+//  This component provides the entry point of the Monte Carlo tree search
+//  tool, which searches a position with random playouts, lists the moves of
+//  the position with how often they were played and won, and reports how
+//  fast the playouts were played.  With '--bench', the search is repeated on
+//  one thread, then two, up to the given thread count, and the playout rate
+//  of each is reported.  The position is the start of a new game, or the
+//  position reached by a '.gn' file.
+#include <gungi/gungi.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const uint64_t k_DEFAULT_PLAYOUTS = 10000;
+  // Number of playouts of a search that is given no limit.
+
+static std::string usage(const std::string& progName);
+  // Returns a string specifying the program usage for the program with the
+  // given 'progName'.
+
+static bool readFile(const std::string& path, std::string& contents);
+  // Loads into the given output parameter, 'contents', the contents of the
+  // file at the given 'path'.  Returns 'true' on success, otherwise 'false'.
+
+static bool parseNumber(const std::string& value, unsigned int& number);
+  // Loads into the given output parameter, 'number', the non-negative number
+  // in the given 'value'.  Returns 'true' on success, otherwise 'false'.
+
+std::string usage(const std::string& progName) {
+  std::ostringstream oss;
+  oss
+    << progName
+    << " [ optional arguments ]"
+    << std::endl
+    << std::endl
+    << "Optional Args:"
+    << std::endl
+    << "  -h, --help                          show this dialog"
+    << std::endl
+    << "  -i FILE, --input FILE               input '.gn' file to start from"
+    << std::endl
+    << "  -p COUNT, --playouts COUNT          number of playouts "
+    << "(default: " << k_DEFAULT_PLAYOUTS << ")"
+    << std::endl
+    << "  -m MS, --milliseconds MS            time to search for"
+    << std::endl
+    << "  -t COUNT, --threads COUNT           number of threads (default: all)"
+    << std::endl
+    << "  -b, --bench                         search on 1 to COUNT threads";
+  return oss.str();
+}
+
+bool readFile(const std::string& path, std::string& contents) {
+  std::ifstream ifs(path.c_str());
+  if (ifs.fail()) {
+    return false;
+  }
+
+  std::ostringstream oss;
+  oss << ifs.rdbuf();
+  contents = oss.str();
+  return true;
+}
+
+bool parseNumber(const std::string& value, unsigned int& number) {
+  if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos) {
+    return false;
+  }
+
+  number = static_cast<unsigned int>(std::strtoul(value.c_str(), NULL, 10));
+  return true;
+}
+
+}  // close unnamed namespace
+
+int main(int argc, char *argv[]) {
+  const std::string progName(argv[0]);
+  gungi::Controller controller;
+  gungi::GNMetadata metadata;
+  unsigned int numThreads = 0;
+  unsigned int playouts = 0;
+  unsigned int milliseconds = 0;
+  bool bench = false;
+
+  for (int i = 1; i < argc; i++) {
+    const std::string opt(argv[i]);
+    if (opt == "-h" || opt == "--help") {
+      std::cout << usage(progName) << std::endl;
+      return 0;
+    } else if (opt == "-b" || opt == "--bench") {
+      bench = true;
+    } else if ((opt == "-i" || opt == "--input") && i + 1 < argc) {
+      const std::string value(argv[++i]);
+      std::string contents;
+      if (!readFile(value, contents)) {
+        std::cerr
+          << "Invalid input file: "
+          << value
+          << std::endl
+          << usage(progName)
+          << std::endl;
+        return -4;
+      }
+
+      if (!gungi::GNDecoder::decode(contents, metadata, controller)) {
+        std::cerr
+          << "Malformed input file: "
+          << value
+          << std::endl
+          << usage(progName)
+          << std::endl;
+        return -5;
+      }
+    } else if ((opt == "-t" || opt == "--threads") && i + 1 < argc) {
+      if (!parseNumber(argv[++i], numThreads)) {
+        std::cerr
+          << "Invalid thread count: "
+          << argv[i]
+          << std::endl
+          << usage(progName)
+          << std::endl;
+        return -2;
+      }
+    } else if ((opt == "-p" || opt == "--playouts") && i + 1 < argc) {
+      if (!parseNumber(argv[++i], playouts)) {
+        std::cerr
+          << "Invalid playout count: "
+          << argv[i]
+          << std::endl
+          << usage(progName)
+          << std::endl;
+        return -3;
+      }
+    } else if ((opt == "-m" || opt == "--milliseconds") && i + 1 < argc) {
+      if (!parseNumber(argv[++i], milliseconds)) {
+        std::cerr
+          << "Invalid time: "
+          << argv[i]
+          << std::endl
+          << usage(progName)
+          << std::endl;
+        return -3;
+      }
+    } else {
+      std::cerr
+        << "Invalid command or missing argument: "
+        << opt
+        << std::endl
+        << usage(progName)
+        << std::endl;
+      return -1;
+    }
+  }
+
+  if (controller.isOver()) {
+    std::cerr << "The game is over" << std::endl;
+    return -6;
+  }
+
+  if (numThreads == 0) {
+    numThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  gungi::MonteCarlo::limits_t limits;
+  limits.playouts = playouts;
+  limits.milliseconds = milliseconds;
+  if (!playouts && !milliseconds) {
+    limits.playouts = k_DEFAULT_PLAYOUTS;
+  }
+
+  // Without '--bench', only the search on every thread is run.
+  for (unsigned int threads = bench ? 1 : numThreads;
+       threads <= numThreads;
+       threads++) {
+    gungi::MonteCarlo search(threads);
+
+    const std::chrono::steady_clock::time_point start =
+                                              std::chrono::steady_clock::now();
+    search.search(controller, limits);
+    const std::chrono::steady_clock::time_point end =
+                                              std::chrono::steady_clock::now();
+
+    if (!bench) {
+      std::vector<gungi::MonteCarlo::stats_t> stats;
+      search.analysis(stats);
+      for (const gungi::MonteCarlo::stats_t& entry : stats) {
+        const gungi::Unit *unit = controller.unit(entry.move.unit());
+        std::cout
+          << unit->code()
+          << " "
+          << entry.move
+          << ": "
+          << entry.visits
+          << " "
+          << entry.winRate
+          << std::endl;
+      }
+      std::cout << std::endl;
+    }
+
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    const double rate = seconds > 0 ? search.playouts() / seconds : 0;
+    std::cout
+      << "Threads: " << threads << std::endl
+      << "Playouts: " << search.playouts() << std::endl
+      << "Time: " << seconds << "s" << std::endl
+      << "Playouts/second: " << static_cast<uint64_t>(rate) << std::endl
+      << "Playouts/second/thread: "
+      << static_cast<uint64_t>(rate / threads)
+      << std::endl;
+
+    if (threads < numThreads) {
+      std::cout << std::endl;
+    }
+  }
+
+  return 0;
+}
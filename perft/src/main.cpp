@@ -0,0 +1,180 @@
+// main.cpp                                                           -*-C++-*-
+//@DESCRIPTION:
+//  This component provides the entry point of the perft tool, which counts
+//  the leaf nodes of the tree of legal moves from a position to a given depth,
+//  and reports how fast they were counted.  The position is the start of a
+//  new game, or the position reached by a '.gn' file.
+#include <gungi/gungi.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+static std::string usage(const std::string& progName);
+  // Returns a string specifying the program usage for the program with the
+  // given 'progName'.
+
+static bool readFile(const std::string& path, std::string& contents);
+  // Loads into the given output parameter, 'contents', the contents of the
+  // file at the given 'path'.  Returns 'true' on success, otherwise 'false'.
+
+static bool parseNumber(const std::string& value, unsigned int& number);
+  // Loads into the given output parameter, 'number', the non-negative number
+  // in the given 'value'.  Returns 'true' on success, otherwise 'false'.
+
+std::string usage(const std::string& progName) {
+  std::ostringstream oss;
+  oss
+    << progName
+    << " [ optional arguments ] DEPTH"
+    << std::endl
+    << std::endl
+    << "Optional Args:"
+    << std::endl
+    << "  -h, --help                          show this dialog"
+    << std::endl
+    << "  -i FILE, --input FILE               input '.gn' file to start from"
+    << std::endl
+    << "  -d, --divide                        count the nodes below each move"
+    << std::endl
+    << "  -t COUNT, --threads COUNT           number of threads (default: all)";
+  return oss.str();
+}
+
+bool readFile(const std::string& path, std::string& contents) {
+  std::ifstream ifs(path.c_str());
+  if (ifs.fail()) {
+    return false;
+  }
+
+  std::ostringstream oss;
+  oss << ifs.rdbuf();
+  contents = oss.str();
+  return true;
+}
+
+bool parseNumber(const std::string& value, unsigned int& number) {
+  if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos) {
+    return false;
+  }
+
+  number = static_cast<unsigned int>(std::strtoul(value.c_str(), NULL, 10));
+  return true;
+}
+
+}  // close unnamed namespace
+
+int main(int argc, char *argv[]) {
+  const std::string progName(argv[0]);
+  gungi::Controller controller;
+  gungi::GNMetadata metadata;
+  unsigned int numThreads = 0;
+  unsigned int depth = 0;
+  bool hasDepth = false;
+  bool divide = false;
+
+  for (int i = 1; i < argc; i++) {
+    const std::string opt(argv[i]);
+    if (opt == "-h" || opt == "--help") {
+      std::cout << usage(progName) << std::endl;
+      return 0;
+    } else if (opt == "-d" || opt == "--divide") {
+      divide = true;
+    } else if ((opt == "-i" || opt == "--input") && i + 1 < argc) {
+      const std::string value(argv[++i]);
+      std::string contents;
+      if (!readFile(value, contents)) {
+        std::cerr
+          << "Invalid input file: "
+          << value
+          << std::endl
+          << usage(progName)
+          << std::endl;
+        return -4;
+      }
+
+      if (!gungi::GNDecoder::decode(contents, metadata, controller)) {
+        std::cerr
+          << "Malformed input file: "
+          << value
+          << std::endl
+          << usage(progName)
+          << std::endl;
+        return -5;
+      }
+    } else if ((opt == "-t" || opt == "--threads") && i + 1 < argc) {
+      if (!parseNumber(argv[++i], numThreads)) {
+        std::cerr
+          << "Invalid thread count: "
+          << argv[i]
+          << std::endl
+          << usage(progName)
+          << std::endl;
+        return -2;
+      }
+    } else if (!hasDepth && parseNumber(opt, depth)) {
+      hasDepth = true;
+    } else {
+      std::cerr
+        << "Invalid command or missing argument: "
+        << opt
+        << std::endl
+        << usage(progName)
+        << std::endl;
+      return -1;
+    }
+  }
+
+  if (!hasDepth) {
+    std::cerr
+      << "Missing depth"
+      << std::endl
+      << usage(progName)
+      << std::endl;
+    return -3;
+  }
+
+  gungi::ThreadPool pool(numThreads);
+  std::vector<gungi::Perft::divide_t> counts;
+
+  const std::chrono::steady_clock::time_point start =
+                                              std::chrono::steady_clock::now();
+  const uint64_t nodes = depth == 0
+    ? gungi::Perft::count(controller, depth)
+    : gungi::Perft::divide(controller, depth, pool, counts);
+  const std::chrono::steady_clock::time_point end =
+                                              std::chrono::steady_clock::now();
+
+  if (divide) {
+    for (const gungi::Perft::divide_t& entry : counts) {
+      const gungi::Unit *unit = controller.unit(entry.move.unit());
+      std::cout
+        << unit->code()
+        << " "
+        << entry.move
+        << ": "
+        << entry.nodes
+        << std::endl;
+    }
+    std::cout << std::endl;
+  }
+
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  std::cout
+    << "Depth: " << depth << std::endl
+    << "Threads: " << pool.size() << std::endl
+    << "Nodes: " << nodes << std::endl
+    << "Time: " << seconds << "s" << std::endl
+    << "Nodes/second: "
+    << static_cast<uint64_t>(seconds > 0 ? nodes / seconds : 0)
+    << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,571 @@
+// main.cpp                                                           -*-C++-*-
+//@DESCRIPTION:
+//  This component provides the entry point of the validation tool, which
+//  replays every game of a corpus of Gungi Notation games by the rules of
+//  the library.  The corpus is given as '.gn' files of one or more games,
+//  archives of games ('.gna'), or directories holding them.  Each file passes
+//  if every game has a well-formed header and only legal moves.  The tool
+//  reports each file, the first illegal move of each game that fails, the
+//  state each game ends in, and totals for the corpus.
+//
+//  The files are validated on one pool of threads, every thread running the
+//  same loop.  One thread at a time reads the next file: it maps the file
+//  into memory, splits it into games, and queues a task per game.  The other
+//  threads meanwhile take the queued games and replay them, so reading a file
+//  overlaps with replaying the files before it.  At most a window of files is
+//  held at a time, so the memory used is bounded by the size of the window
+//  rather than of the corpus; a file is reported, in order of the paths, and
+//  released once every game before it and in it has been replayed.
+#include <gungi/gungi.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+namespace {
+
+// ENUMERATIONS
+typedef enum status_t {
+  STATUS_MALFORMED,
+  STATUS_ILLEGAL,
+  STATUS_WHITE,
+  STATUS_BLACK,
+  STATUS_DRAW,
+  STATUS_ONGOING
+} status_t;
+  // Enumeration of the state a game ends in when it is replayed.
+
+// STRUCTURES
+typedef struct game_t {
+  // Movetext of the game, within the mapping of its file.
+  gungi::GNReader::slice_t  movetext;
+
+  // Offset of the game from the start of its file, in bytes.
+  size_t                    offset;
+
+  // Number of moves played.
+  unsigned int              plies;
+
+  // State the game ends in.
+  uint8_t                   status;
+} game_t;
+
+typedef struct file_t {
+  // Path of the file.
+  std::string          path;
+
+  // Reader of the file, if it is a '.gn' file.
+  gungi::GNReader      reader;
+
+  // Reader of the file, if it is an archive of games.
+  gungi::GNArchive     archive;
+
+  // Games of the file.
+  std::vector<game_t>  games;
+
+  // Number of games of the file that have not been replayed.
+  size_t               remaining;
+
+  // 'true' if the file is an archive of games, otherwise 'false'.
+  bool                 isArchive;
+
+  // 'true' if the file was read, otherwise 'false'.
+  bool                 readable;
+} file_t;
+
+typedef struct statistics_t {
+  // Number of files.
+  uint64_t  files;
+
+  // Number of files that failed.
+  uint64_t  failed;
+
+  // Number of games.
+  uint64_t  games;
+
+  // Number of games with a malformed header.
+  uint64_t  malformed;
+
+  // Number of games with an illegal or malformed move.
+  uint64_t  illegal;
+
+  // Number of moves played.
+  uint64_t  plies;
+
+  // Number of games won by white.
+  uint64_t  white;
+
+  // Number of games won by black.
+  uint64_t  black;
+
+  // Number of games drawn.
+  uint64_t  draws;
+
+  // Number of games not over.
+  uint64_t  ongoing;
+} statistics_t;
+
+typedef struct pipeline_t {
+  // Mutex guarding the members below.
+  std::mutex                                mutex;
+
+  // Signalled when a file is read, or released.
+  std::condition_variable                   changed;
+
+  // Paths of the files to validate, in order.
+  std::vector<std::string>                  paths;
+
+  // Index in 'paths' of the next file to read.
+  size_t                                    next;
+
+  // Maximum number of files held at a time.
+  size_t                                    window;
+
+  // Files read, or being read, that have not been reported, in order.
+  std::deque<std::unique_ptr<file_t> >      files;
+
+  // Games waiting to be replayed, with the file each belongs to.
+  std::deque<std::pair<file_t *, size_t> >  games;
+
+  // Statistics of the files reported.
+  statistics_t                              stats;
+
+  // 'true' if a file is being read, otherwise 'false'.
+  bool                                      reading;
+
+  // 'true' if every game is to be reported, otherwise 'false'.
+  bool                                      verbose;
+} pipeline_t;
+
+static std::string usage(const std::string& progName);
+  // Returns a string specifying the program usage for the program with the
+  // given 'progName'.
+
+static bool parseNumber(const std::string& value, unsigned int& number);
+  // Loads into the given output parameter, 'number', the non-negative number
+  // in the given 'value'.  Returns 'true' on success, otherwise 'false'.
+
+static bool hasExtension(const std::string& path, const std::string& ext);
+  // Returns 'true' if the given 'path' ends with the given extension, 'ext',
+  // otherwise 'false'.
+
+static bool listFiles(const std::string&        path,
+                      std::vector<std::string>& paths);
+  // Appends to the given 'paths' the given 'path', or, if it is a directory,
+  // the '.gn' and '.gna' files below it, in order of their paths.  Returns
+  // 'true' on success, otherwise 'false' if the 'path' does not exist.
+
+static void readFile(file_t& file);
+  // Maps the given 'file' into memory, and splits it into its games.
+
+static void replayGame(const file_t& file, game_t& game);
+  // Plays the moves of the given 'game' of the given 'file' on a new game,
+  // and records the state it ends in.
+
+static const char *describe(const game_t& game);
+  // Returns a description of the state the given 'game' ends in.
+
+static void report(const file_t& file, bool verbose, statistics_t& stats);
+  // Prints whether the given 'file' passed, and its games that failed, or,
+  // if 'verbose' is 'true', every game, and adds its games to the given
+  // 'stats'.
+
+static void release(pipeline_t& pipeline);
+  // Reports and releases the files at the front of the given 'pipeline' that
+  // have every game replayed.  The mutex of the 'pipeline' must be held.
+
+static void validate(pipeline_t& pipeline);
+  // Runs a thread of the given 'pipeline': reads the next file when no other
+  // thread is reading and the window has room, and otherwise replays the
+  // games queued, until every file has been reported.
+
+std::string usage(const std::string& progName) {
+  std::ostringstream oss;
+  oss
+    << progName
+    << " [ optional arguments ] PATH..."
+    << std::endl
+    << std::endl
+    << "Optional Args:"
+    << std::endl
+    << "  -h, --help                          show this dialog"
+    << std::endl
+    << "  -t COUNT, --threads COUNT           number of threads (default: all)"
+    << std::endl
+    << "  -w COUNT, --window COUNT            number of files held at a time"
+    << std::endl
+    << "                                      (default: 4 per thread)"
+    << std::endl
+    << "  -v, --verbose                       show the state of every game";
+  return oss.str();
+}
+
+bool parseNumber(const std::string& value, unsigned int& number) {
+  if (value.empty() ||
+      value.find_first_not_of("0123456789") != std::string::npos) {
+    return false;
+  }
+
+  number = static_cast<unsigned int>(std::strtoul(value.c_str(), NULL, 10));
+  return true;
+}
+
+bool hasExtension(const std::string& path, const std::string& ext) {
+  return path.size() > ext.size() &&
+         path.compare(path.size() - ext.size(), ext.size(), ext) == 0;
+}
+
+bool listFiles(const std::string& path, std::vector<std::string>& paths) {
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0) {
+    return false;
+  } else if (!S_ISDIR(st.st_mode)) {
+    paths.push_back(path);
+    return true;
+  }
+
+  DIR *dir = opendir(path.c_str());
+  if (!dir) {
+    return false;
+  }
+
+  std::vector<std::string> entries;
+  for (struct dirent *entry = readdir(dir); entry; entry = readdir(dir)) {
+    const std::string name(entry->d_name);
+    if (name != "." && name != "..") {
+      entries.push_back(path + "/" + name);
+    }
+  }
+  closedir(dir);
+  std::sort(entries.begin(), entries.end());
+
+  for (const std::string& entry : entries) {
+    if (stat(entry.c_str(), &st) != 0) {
+      continue;
+    } else if (S_ISDIR(st.st_mode)) {
+      listFiles(entry, paths);
+    } else if (hasExtension(entry, ".gn") || hasExtension(entry, ".gna")) {
+      paths.push_back(entry);
+    }
+  }
+  return true;
+}
+
+void readFile(file_t& file) {
+  game_t game = game_t();
+  game.status = STATUS_ONGOING;
+
+  if (file.isArchive) {
+    file.readable = file.archive.open(file.path);
+    for (size_t idx = 0; idx < file.archive.numGames(); idx++) {
+      game.offset = idx;
+      file.games.push_back(game);
+    }
+    return;
+  }
+
+  file.readable = file.reader.open(file.path);
+  if (!file.readable) {
+    return;
+  }
+
+  // The games are kept as slices of the mapping, without their metadata,
+  // which is not needed to replay them.
+  file.reader.read([&](const gungi::GNReader::game_t& entry) {
+    game.movetext = entry.movetext;
+    game.offset = entry.offset;
+    game.status = entry.valid ? STATUS_ONGOING : STATUS_MALFORMED;
+    file.games.push_back(game);
+    return true;
+  });
+}
+
+void replayGame(const file_t& file, game_t& game) {
+  gungi::Controller controller;
+  bool played;
+  if (file.isArchive) {
+    gungi::GNMetadata md;
+    if (!file.archive.metadata(game.offset, md)) {
+      game.status = STATUS_MALFORMED;
+      return;
+    }
+
+    played = file.archive.replay(game.offset,
+                                 file.archive.numPlies(game.offset),
+                                 controller,
+                                 game.plies);
+  } else if (game.status == STATUS_MALFORMED) {
+    return;
+  } else {
+    gungi::GNReader::game_t entry;
+    entry.movetext = game.movetext;
+    entry.offset = game.offset;
+    entry.valid = true;
+    played = gungi::GNReader::replay(entry, controller, game.plies);
+  }
+
+  if (!played) {
+    game.status = STATUS_ILLEGAL;
+  } else if (!controller.isOver()) {
+    game.status = STATUS_ONGOING;
+  } else if (controller.isDraw()) {
+    game.status = STATUS_DRAW;
+  } else {
+    game.status = controller.winner() == gungi::WHITE ? STATUS_WHITE
+                                                       : STATUS_BLACK;
+  }
+}
+
+const char *describe(const game_t& game) {
+  switch (game.status) {
+    case STATUS_MALFORMED:
+      return "malformed header";
+    case STATUS_ILLEGAL:
+      return "illegal or malformed move";
+    case STATUS_WHITE:
+      return "white won";
+    case STATUS_BLACK:
+      return "black won";
+    case STATUS_DRAW:
+      return "draw";
+    default:
+      return "ongoing";
+  }
+}
+
+void report(const file_t& file, bool verbose, statistics_t& stats) {
+  stats.files++;
+  if (!file.readable) {
+    stats.failed++;
+    std::cout << "FAIL " << file.path << ": unreadable" << std::endl;
+    return;
+  }
+
+  uint64_t plies = 0;
+  bool passed = true;
+  for (const game_t& game : file.games) {
+    plies += game.plies;
+    if (game.status == STATUS_MALFORMED) {
+      stats.malformed++;
+      passed = false;
+    } else if (game.status == STATUS_ILLEGAL) {
+      stats.illegal++;
+      passed = false;
+    } else if (game.status == STATUS_WHITE) {
+      stats.white++;
+    } else if (game.status == STATUS_BLACK) {
+      stats.black++;
+    } else if (game.status == STATUS_DRAW) {
+      stats.draws++;
+    } else {
+      stats.ongoing++;
+    }
+  }
+  stats.games += file.games.size();
+  stats.plies += plies;
+  stats.failed += !passed;
+
+  std::cout
+    << (passed ? "PASS " : "FAIL ")
+    << file.path
+    << ": "
+    << file.games.size()
+    << " games, "
+    << plies
+    << " plies"
+    << std::endl;
+
+  for (size_t idx = 0; idx < file.games.size(); idx++) {
+    const game_t& game = file.games[idx];
+    const bool failed = game.status == STATUS_MALFORMED ||
+                        game.status == STATUS_ILLEGAL;
+    if (!failed && !verbose) {
+      continue;
+    }
+
+    std::cout << "  game " << idx + 1;
+    if (!file.isArchive) {
+      std::cout << " (byte " << game.offset << ")";
+    }
+
+    if (game.status == STATUS_ILLEGAL) {
+      std::cout << ": illegal or malformed ply " << game.plies + 1;
+    } else if (game.status == STATUS_MALFORMED) {
+      std::cout << ": " << describe(game);
+    } else {
+      std::cout << ": " << game.plies << " plies, " << describe(game);
+    }
+    std::cout << std::endl;
+  }
+}
+
+void release(pipeline_t& pipeline) {
+  while (!pipeline.files.empty() && pipeline.files.front()->remaining == 0) {
+    report(*pipeline.files.front(), pipeline.verbose, pipeline.stats);
+    pipeline.files.pop_front();
+  }
+  pipeline.changed.notify_all();
+}
+
+void validate(pipeline_t& pipeline) {
+  std::unique_lock<std::mutex> lock(pipeline.mutex);
+  while (true) {
+    if (!pipeline.reading &&
+        pipeline.next < pipeline.paths.size() &&
+        pipeline.files.size() < pipeline.window) {
+      // Read the next file while the other threads replay the games queued
+      // before it.  The file holds its place in 'files' while it is read, so
+      // that no file after it is reported first.
+      file_t *file = new file_t();
+      file->path = pipeline.paths[pipeline.next++];
+      file->isArchive = hasExtension(file->path, ".gna");
+      file->remaining = 1;
+      pipeline.files.emplace_back(file);
+      pipeline.reading = true;
+
+      lock.unlock();
+      readFile(*file);
+      lock.lock();
+
+      pipeline.reading = false;
+      for (size_t idx = 0; idx < file->games.size(); idx++) {
+        pipeline.games.push_back(std::make_pair(file, idx));
+      }
+      file->remaining = file->games.size();
+      release(pipeline);
+    } else if (!pipeline.games.empty()) {
+      const std::pair<file_t *, size_t> entry = pipeline.games.front();
+      pipeline.games.pop_front();
+
+      lock.unlock();
+      replayGame(*entry.first, entry.first->games[entry.second]);
+      lock.lock();
+
+      if (--entry.first->remaining == 0) {
+        release(pipeline);
+      }
+    } else if (pipeline.next == pipeline.paths.size() &&
+               pipeline.files.empty()) {
+      return;
+    } else {
+      pipeline.changed.wait(lock);
+    }
+  }
+}
+
+}  // close unnamed namespace
+
+int main(int argc, char *argv[]) {
+  const std::string progName(argv[0]);
+  std::vector<std::string> paths;
+  unsigned int numThreads = 0;
+  unsigned int window = 0;
+  bool verbose = false;
+
+  for (int i = 1; i < argc; i++) {
+    const std::string opt(argv[i]);
+    if (opt == "-h" || opt == "--help") {
+      std::cout << usage(progName) << std::endl;
+      return 0;
+    } else if (opt == "-v" || opt == "--verbose") {
+      verbose = true;
+    } else if ((opt == "-t" || opt == "--threads") && i + 1 < argc) {
+      if (!parseNumber(argv[++i], numThreads)) {
+        std::cerr
+          << "Invalid thread count: "
+          << argv[i]
+          << std::endl
+          << usage(progName)
+          << std::endl;
+        return -2;
+      }
+    } else if ((opt == "-w" || opt == "--window") && i + 1 < argc) {
+      if (!parseNumber(argv[++i], window) || window == 0) {
+        std::cerr
+          << "Invalid window: "
+          << argv[i]
+          << std::endl
+          << usage(progName)
+          << std::endl;
+        return -3;
+      }
+    } else if (!opt.empty() && opt[0] == '-') {
+      std::cerr
+        << "Invalid command or missing argument: "
+        << opt
+        << std::endl
+        << usage(progName)
+        << std::endl;
+      return -1;
+    } else if (!listFiles(opt, paths)) {
+      std::cerr << "Invalid input path: " << opt << std::endl;
+      return -4;
+    }
+  }
+
+  if (paths.empty()) {
+    std::cerr
+      << "Missing input path"
+      << std::endl
+      << usage(progName)
+      << std::endl;
+    return -1;
+  }
+
+  gungi::ThreadPool pool(numThreads);
+  if (window == 0) {
+    window = 4 * pool.size();
+  }
+
+  pipeline_t pipeline;
+  pipeline.paths.swap(paths);
+  pipeline.next = 0;
+  pipeline.window = window;
+  pipeline.stats = statistics_t();
+  pipeline.reading = false;
+  pipeline.verbose = verbose;
+
+  const std::chrono::steady_clock::time_point start =
+                                              std::chrono::steady_clock::now();
+  pool.run(pool.size(), [&](unsigned int) {
+    validate(pipeline);
+  });
+  const std::chrono::steady_clock::time_point end =
+                                              std::chrono::steady_clock::now();
+
+  const statistics_t& stats = pipeline.stats;
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  std::cout
+    << std::endl
+    << "Files: " << stats.files << std::endl
+    << "Failed files: " << stats.failed << std::endl
+    << "Games: " << stats.games << std::endl
+    << "Malformed headers: " << stats.malformed << std::endl
+    << "Illegal games: " << stats.illegal << std::endl
+    << "White wins: " << stats.white << std::endl
+    << "Black wins: " << stats.black << std::endl
+    << "Draws: " << stats.draws << std::endl
+    << "Ongoing: " << stats.ongoing << std::endl
+    << "Plies: " << stats.plies << std::endl
+    << "Threads: " << pool.size() << std::endl
+    << "Time: " << seconds << "s" << std::endl
+    << "Games/second: "
+    << static_cast<uint64_t>(seconds > 0 ? stats.games / seconds : 0)
+    << std::endl;
+
+  return stats.failed == 0 ? 0 : 1;
+}